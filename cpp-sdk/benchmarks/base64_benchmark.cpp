@@ -0,0 +1,75 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <svm-pay/svm_pay.hpp>
+
+using namespace svm_pay;
+
+namespace {
+
+const char* implementation_name(Base64Implementation implementation) {
+    switch (implementation) {
+        case Base64Implementation::AVX2:
+            return "avx2";
+        case Base64Implementation::SSSE3:
+            return "ssse3";
+        default:
+            return "scalar";
+    }
+}
+
+template <typename Work>
+double measure_mb_per_second(size_t bytes, Work work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(bytes) / elapsed.count() / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? std::stoul(argv[1]) : 200000;
+
+    std::cout << "SVM-Pay C++ SDK - Base64 Benchmark\n";
+    std::cout << "==================================\n\n";
+    std::cout << iterations << " transactions of " << TransactionBuilder::MAX_TRANSACTION_SIZE << " bytes\n\n";
+
+    std::vector<uint8_t> wire(TransactionBuilder::MAX_TRANSACTION_SIZE);
+    for (size_t i = 0; i < wire.size(); ++i) {
+        wire[i] = static_cast<uint8_t>(i * 131 + 17);
+    }
+    std::vector<char> encoded(base64_encoded_size(wire.size()));
+    std::vector<uint8_t> decoded(base64_decoded_max_size(encoded.size()));
+    size_t bytes = iterations * wire.size();
+
+    for (auto implementation : {Base64Implementation::SCALAR, Base64Implementation::SSSE3, Base64Implementation::AVX2}) {
+        if (!set_base64_implementation(implementation)) {
+            std::cout << "   " << std::left << std::setw(8) << implementation_name(implementation) << "not supported\n";
+            continue;
+        }
+        double encode_rate = measure_mb_per_second(bytes, [&]() {
+            for (size_t i = 0; i < iterations; ++i) {
+                base64_encode(wire.data(), wire.size(), encoded.data());
+            }
+        });
+        size_t written = 0;
+        bool valid = true;
+        double decode_rate = measure_mb_per_second(bytes, [&]() {
+            for (size_t i = 0; i < iterations; ++i) {
+                valid &= base64_decode(encoded.data(), encoded.size(), decoded.data(), written);
+            }
+        });
+        if (!valid || written != wire.size()) {
+            std::cerr << "   ✗ " << implementation_name(implementation) << " failed to round-trip\n";
+            return 1;
+        }
+        std::cout << "   " << std::left << std::setw(8) << implementation_name(implementation) << std::right
+                  << "encode " << std::setw(8) << std::fixed << std::setprecision(0) << encode_rate << " MB/s"
+                  << "   decode " << std::setw(8) << decode_rate << " MB/s\n";
+    }
+
+    return 0;
+}
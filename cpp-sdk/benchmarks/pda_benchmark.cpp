@@ -0,0 +1,114 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <svm-pay/svm_pay.hpp>
+
+using namespace svm_pay;
+
+namespace {
+
+template <typename Work>
+double measure_ns_per_operation(size_t operations, Work work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / static_cast<double>(operations);
+}
+
+void report(const std::string& name, double ns, size_t workers = 1) {
+    std::cout << "   " << std::left << std::setw(32) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(1) << ns << " ns/op"
+              << std::setw(14) << std::setprecision(0) << 1e9 / ns * static_cast<double>(workers) << " op/s"
+              << "  (" << workers << " worker" << (workers == 1 ? "" : "s") << ")\n";
+}
+
+// Real wallets are public keys, so take them from keypairs
+PublicKey owner_for(size_t) {
+    return Keypair::generate().public_key();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 20000;
+    size_t workers = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "SVM-Pay C++ SDK - Associated Token Account Benchmark\n";
+    std::cout << "====================================================\n\n";
+    std::cout << count << " distinct wallets, one mint\n\n";
+
+    PublicKey mint = PublicKey::from_base58("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v");
+    std::vector<PublicKey> owners;
+    for (size_t i = 0; i < count; ++i) {
+        owners.push_back(owner_for(i));
+    }
+
+    size_t on_curve = 0;
+    double ns = measure_ns_per_operation(count, [&]() {
+        for (const auto& owner : owners) {
+            on_curve += is_on_curve(owner) ? 1 : 0;
+        }
+    });
+    report("is_on_curve", ns);
+
+    // Cold: every lookup derives
+    size_t bumps = 0;
+    ns = measure_ns_per_operation(count, [&]() {
+        for (const auto& owner : owners) {
+            bumps += 256 - derive_associated_token_address(owner, mint).bump;
+        }
+    });
+    report("derive (cold)", ns);
+    std::cout << "      " << std::setprecision(2) << static_cast<double>(bumps) / static_cast<double>(count)
+              << " hashes per derivation\n";
+
+    AssociatedTokenAddressCacheConfig config;
+    config.capacity = 2 * count;  // Headroom for uneven shards
+    AssociatedTokenAddressCache cache(config);
+    ns = measure_ns_per_operation(count, [&]() {
+        for (const auto& owner : owners) {
+            cache.get(owner, mint);
+        }
+    });
+    report("cache miss", ns);
+
+    // Warm: every lookup hits
+    size_t rounds = 10;
+    ns = measure_ns_per_operation(count * rounds, [&]() {
+        for (size_t round = 0; round < rounds; ++round) {
+            for (const auto& owner : owners) {
+                cache.get(owner, mint);
+            }
+        }
+    });
+    report("cache hit", ns);
+
+    if (workers > 1) {
+        ns = measure_ns_per_operation(count * rounds, [&]() {
+            std::vector<std::thread> threads;
+            for (size_t w = 0; w < workers; ++w) {
+                threads.emplace_back([&, w]() {
+                    for (size_t round = 0; round < rounds; ++round) {
+                        for (size_t i = w; i < count; i += workers) {
+                            cache.get(owners[i], mint);
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        });
+        // Wall time per lookup across all workers
+        report("cache hit", ns * static_cast<double>(workers), workers);
+    }
+
+    if (on_curve != count) {
+        std::cerr << "   ✗ " << count - on_curve << " wallet addresses were off the curve\n";
+        return 1;
+    }
+    return 0;
+}
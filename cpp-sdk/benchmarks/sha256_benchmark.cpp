@@ -0,0 +1,93 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <svm-pay/svm_pay.hpp>
+
+using namespace svm_pay;
+
+namespace {
+
+const char* implementation_name(Sha256Implementation implementation) {
+    switch (implementation) {
+        case Sha256Implementation::SHA_NI:
+            return "sha-ni";
+        case Sha256Implementation::AVX2:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+template <typename Work>
+double measure_per_second(size_t operations, Work work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(operations) / elapsed.count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+    size_t wallets = argc > 2 ? std::stoul(argv[2]) : 20000;
+
+    // Seeds of an associated token account, the bump, program and marker
+    constexpr size_t MESSAGE_SIZE = 150;
+
+    std::cout << "SVM-Pay C++ SDK - SHA-256 Benchmark\n";
+    std::cout << "===================================\n\n";
+    std::cout << count << " messages of " << MESSAGE_SIZE << " bytes, " << wallets
+              << " associated token account derivations\n\n";
+
+    std::vector<uint8_t> data(count * MESSAGE_SIZE);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 131 + 17);
+    }
+    std::vector<const uint8_t*> messages(count);
+    std::vector<size_t> sizes(count, MESSAGE_SIZE);
+    for (size_t i = 0; i < count; ++i) {
+        messages[i] = data.data() + i * MESSAGE_SIZE;
+    }
+    std::vector<uint8_t> digests(count * SHA256_SIZE);
+
+    PublicKey mint = PublicKey::from_base58("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v");
+    std::vector<PublicKey> owners;
+    for (size_t i = 0; i < wallets; ++i) {
+        owners.push_back(Keypair::generate().public_key());
+    }
+    std::vector<ProgramAddress> derived(wallets);
+
+    std::vector<uint8_t> reference;
+    for (auto implementation : {Sha256Implementation::SCALAR, Sha256Implementation::AVX2, Sha256Implementation::SHA_NI}) {
+        if (!set_sha256_implementation(implementation)) {
+            std::cout << "   " << std::left << std::setw(8) << implementation_name(implementation) << "not supported\n";
+            continue;
+        }
+        double single_rate = measure_per_second(count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                sha256(messages[i], MESSAGE_SIZE, digests.data() + i * SHA256_SIZE);
+            }
+        });
+        double many_rate = measure_per_second(count, [&]() {
+            sha256_many(messages.data(), sizes.data(), count, digests.data());
+        });
+        if (reference.empty()) {
+            reference = digests;
+        } else if (digests != reference) {
+            std::cerr << "   ✗ " << implementation_name(implementation) << " disagrees with scalar\n";
+            return 1;
+        }
+        double derive_rate = measure_per_second(wallets, [&]() {
+            derive_associated_token_addresses(owners.data(), wallets, mint, derived.data());
+        });
+        std::cout << "   " << std::left << std::setw(8) << implementation_name(implementation) << std::right
+                  << "lanes " << sha256_lanes() << "   one " << std::setw(10) << std::fixed << std::setprecision(0) << single_rate << " hash/s"
+                  << "   many " << std::setw(10) << many_rate << " hash/s"
+                  << "   ATA batch " << std::setw(8) << derive_rate << " /s\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <svm-pay/svm_pay.hpp>
+
+using namespace svm_pay;
+
+namespace {
+
+// Typical size of a payment transaction message
+constexpr size_t MESSAGE_SIZE = 200;
+
+template <typename Work>
+double measure(size_t operations, Work work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(operations) / elapsed.count();
+}
+
+void report(const std::string& name, double rate, size_t workers) {
+    std::cout << "   " << std::left << std::setw(28) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(0) << rate << " sig/s"
+              << std::setw(12) << rate / static_cast<double>(workers) << " sig/s/core"
+              << "  (" << workers << " worker" << (workers == 1 ? "" : "s") << ")\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::stoul(argv[1]) : 20000;
+    size_t workers = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "SVM-Pay C++ SDK - Ed25519 Signing Benchmark\n";
+    std::cout << "===========================================\n\n";
+    std::cout << count << " messages of " << MESSAGE_SIZE << " bytes\n\n";
+
+    Keypair keypair = Keypair::generate();
+    std::vector<std::vector<uint8_t>> messages(count, std::vector<uint8_t>(MESSAGE_SIZE));
+    std::vector<MessageView> views;
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < MESSAGE_SIZE; ++j) {
+            messages[i][j] = static_cast<uint8_t>(i * 31 + j);
+        }
+        views.push_back({messages[i].data(), messages[i].size()});
+    }
+    std::vector<Signature> signatures(count);
+
+    double rate = measure(count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            signatures[i] = keypair.sign(views[i].data, views[i].size);
+        }
+    });
+    report("Keypair::sign", rate, 1);
+
+    for (size_t n : {static_cast<size_t>(1), workers}) {
+        BatchSignerConfig config;
+        config.workers = n;
+        BatchSigner batch(config);
+        rate = measure(count, [&]() { batch.sign(keypair, views.data(), count, signatures.data()); });
+        report("BatchSigner::sign", rate, n);
+
+        std::vector<SignatureCheck> checks;
+        checks.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            checks.push_back({keypair.public_key(), views[i], signatures[i]});
+        }
+        std::unique_ptr<bool[]> results(new bool[count]);
+        size_t valid = 0;
+        rate = measure(count, [&]() { valid = batch.verify(checks.data(), count, results.get()); });
+        report("BatchSigner::verify", rate, n);
+        if (valid != count) {
+            std::cerr << "   ✗ " << count - valid << " signatures failed to verify\n";
+            return 1;
+        }
+        if (workers == 1) {
+            break;
+        }
+    }
+
+    return 0;
+}
@@ -19,7 +19,7 @@ int main() {
         std::cout << "1. Checking available network adapters...\n";
         
         // Check for Solana adapter
-        NetworkAdapter* solana_adapter = client.get_adapter(SVMNetwork::SOLANA);
+        auto solana_adapter = client.get_adapter(SVMNetwork::SOLANA);
         if (solana_adapter) {
             std::cout << "   ✓ Solana adapter available\n";
             std::cout << "   Network: " << network_to_string(solana_adapter->get_network()) << "\n";
@@ -30,7 +30,7 @@ int main() {
         // Check for other adapters
         std::vector<SVMNetwork> networks = {SVMNetwork::SONIC, SVMNetwork::ECLIPSE, SVMNetwork::SOON};
         for (auto network : networks) {
-            NetworkAdapter* adapter = client.get_adapter(network);
+            auto adapter = client.get_adapter(network);
             if (adapter) {
                 std::cout << "   ✓ " << network_to_string(network) << " adapter available\n";
             } else {
@@ -46,6 +46,7 @@ int main() {
                 "7v91N7iZ9eyTktBwWC2ckrjdLhvmS4R1HqvYZzG5FGvn",
                 "1.5"
             );
+            transfer_request.account = "9WzDXwBbmkg8ZTbNMqUxvQRAyrZzDsGYdLVL9zYtAWWM";
             transfer_request.label = "Test Payment";
             transfer_request.memo = "SDK Example";
             
@@ -24,6 +24,15 @@ public:
      */
     explicit Client(SVMNetwork default_network = SVMNetwork::SOLANA);
     
+    /**
+     * Constructor
+     * 
+     * @param default_network The default network to use for payments
+     * @param executor Executor for the work of calls made through this
+     *                 client's adapters, whoever created them
+     */
+    Client(SVMNetwork default_network, std::shared_ptr<Executor> executor);
+    
     /**
      * Destructor
      */
@@ -84,7 +93,7 @@ public:
     SVMNetwork get_default_network() const;
     
     /**
-     * Register a network adapter
+     * Register a network adapter for every Client in the process
      * 
      * @param network The network
      * @param adapter The network adapter to register
@@ -94,10 +103,23 @@ public:
     /**
      * Get a network adapter
      * 
+     * Returns the adapter registered for the network, e.g. by initialize_sdk.
+     * If there is none, an SvmNetworkAdapter for the network's public
+     * endpoint is registered on first use and shared by every Client. A
+     * client with its own executor returns a view of the shared adapter
+     * that runs each call on that executor unless the call sets one.
+     * 
      * @param network The network to get an adapter for
-     * @return The network adapter, or nullptr if none is registered
+     * @return The network adapter
+     */
+    std::shared_ptr<NetworkAdapter> get_adapter(SVMNetwork network);
+    
+    /**
+     * Get the executor given to this client
+     * 
+     * @return The executor, or nullptr if the client uses the process-wide default
      */
-    NetworkAdapter* get_adapter(SVMNetwork network);
+    std::shared_ptr<Executor> get_executor() const;
     
     /**
      * Check if debug mode is enabled
@@ -131,6 +153,7 @@ private:
     SVMNetwork default_network_;
     bool debug_enabled_;
     size_t max_references_;  // Maximum number of references to parse (default: 10)
+    std::shared_ptr<Executor> executor_;
     
     /**
      * Parse network from options
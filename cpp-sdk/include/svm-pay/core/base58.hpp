@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Encode binary data to base58 (Bitcoin alphabet)
+ * 
+ * @param data The binary data to encode
+ * @param size The size of the data
+ * @return The base58-encoded string
+ */
+std::string encode_base58(const uint8_t* data, size_t size);
+
+/**
+ * Decode base58 to binary data
+ * 
+ * @param encoded The base58-encoded string
+ * @return The decoded binary data
+ * @throws std::invalid_argument if the string contains a non-base58 character
+ */
+std::vector<uint8_t> decode_base58(const std::string& encoded);
+
+/**
+ * Decode base58 into a fixed-size buffer without allocating
+ * 
+ * @param encoded The base58-encoded string
+ * @param out Receives exactly size bytes
+ * @param size The expected decoded size
+ * @return False if the string is not valid base58 or does not decode to exactly size bytes
+ */
+bool decode_base58(const std::string& encoded, uint8_t* out, size_t size);
+
+} // namespace svm_pay
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Get the padded base64 length of a binary payload
+ *
+ * @param size The payload size in bytes
+ * @return The encoded length
+ */
+constexpr size_t base64_encoded_size(size_t size) {
+    return 4 * ((size + 2) / 3);
+}
+
+/**
+ * Get the largest payload a base64 string of the given length can decode to
+ *
+ * @param size The encoded length
+ * @return The buffer size base64_decode needs
+ */
+constexpr size_t base64_decoded_max_size(size_t size) {
+    return size / 4 * 3;
+}
+
+/**
+ * Codec implementations, fastest last
+ */
+enum class Base64Implementation {
+    SCALAR,
+    SSSE3,
+    AVX2
+};
+
+/**
+ * Get the implementation in use; the fastest one the CPU supports unless overridden
+ *
+ * @return The active implementation
+ */
+Base64Implementation base64_implementation();
+
+/**
+ * Override the implementation, e.g. for benchmarking
+ *
+ * @param implementation The implementation to use
+ * @return False if the CPU does not support it; the active implementation is unchanged
+ */
+bool set_base64_implementation(Base64Implementation implementation);
+
+/**
+ * Encode into a caller-supplied buffer (standard alphabet, padded)
+ *
+ * @param data The binary data
+ * @param size The size of the data
+ * @param out Receives base64_encoded_size(size) characters; no terminator is written
+ * @return The number of characters written
+ */
+size_t base64_encode(const uint8_t* data, size_t size, char* out);
+
+/**
+ * Encode onto the end of a string without an intermediate copy
+ *
+ * @param data The binary data
+ * @param size The size of the data
+ * @param out The string to append to
+ */
+void base64_encode_append(const uint8_t* data, size_t size, std::string& out);
+
+/**
+ * Encode to a string (standard alphabet, padded)
+ *
+ * @param data The binary data
+ * @param size The size of the data
+ * @return The base64 string
+ */
+std::string base64_encode(const uint8_t* data, size_t size);
+
+/**
+ * Decode strictly into a caller-supplied buffer
+ *
+ * Accepts only the standard alphabet with canonical padding: the length
+ * must be a multiple of 4, '=' may only end the input, unused trailing bits
+ * must be zero and whitespace is rejected.
+ *
+ * @param data The base64 characters
+ * @param size The number of characters
+ * @param out Receives the payload; must hold base64_decoded_max_size(size) bytes
+ * @param written Receives the payload size
+ * @return False if the input is not valid base64
+ */
+bool base64_decode(const char* data, size_t size, uint8_t* out, size_t& written);
+
+/**
+ * Decode strictly to a byte vector
+ *
+ * @param encoded The base64 string
+ * @return The payload
+ * @throws std::invalid_argument if the string is not valid base64
+ */
+std::vector<uint8_t> base64_decode(const std::string& encoded);
+
+} // namespace svm_pay
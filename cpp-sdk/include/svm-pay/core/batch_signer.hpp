@@ -0,0 +1,125 @@
+#pragma once
+
+#include "keypair.hpp"
+#include "executor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Non-owning view of a message to sign or verify
+ */
+struct MessageView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+/**
+ * One signature to verify
+ */
+struct SignatureCheck {
+    PublicKey key;
+    MessageView message;
+    Signature signature;
+};
+
+/**
+ * Configuration for a BatchSigner
+ */
+struct BatchSignerConfig {
+    // Parallel workers; 0 uses the hardware concurrency
+    size_t workers = 0;
+
+    // Batches smaller than this per worker run on fewer workers
+    size_t min_items_per_worker = 64;
+
+    // Public keys each worker keeps prepared for verification; repeat
+    // signers (fee payers, merchants) skip key setup
+    size_t key_cache_capacity = 1024;
+
+    // Runs the chunks the calling thread does not take; nullptr uses default_executor()
+    std::shared_ptr<Executor> executor;
+};
+
+/**
+ * Signs and verifies Ed25519 signatures in bulk
+ *
+ * Batches are split across parallel workers. Each worker borrows a context
+ * from a pool of reusable digest contexts, which also caches prepared
+ * public keys, so steady-state batches allocate no OpenSSL objects. Safe to
+ * use from multiple threads.
+ */
+class BatchSigner {
+public:
+    explicit BatchSigner(const BatchSignerConfig& config = BatchSignerConfig{});
+    ~BatchSigner();
+
+    BatchSigner(const BatchSigner&) = delete;
+    BatchSigner& operator=(const BatchSigner&) = delete;
+
+    /**
+     * Sign messages with one keypair
+     *
+     * @param signer The signing keypair
+     * @param messages The messages
+     * @param count The number of messages
+     * @param signatures Receives count signatures
+     * @throws CryptographicException if signing fails
+     */
+    void sign(const Keypair& signer, const MessageView* messages, size_t count, Signature* signatures);
+
+    /**
+     * Sign messages with one keypair
+     *
+     * @param signer The signing keypair
+     * @param messages The messages
+     * @return One signature per message
+     * @throws CryptographicException if signing fails
+     */
+    std::vector<Signature> sign(const Keypair& signer, const std::vector<MessageView>& messages);
+
+    /**
+     * Verify signatures
+     *
+     * @param checks The signatures to verify
+     * @param count The number of checks
+     * @param results Receives whether each signature is valid
+     * @return The number of valid signatures
+     */
+    size_t verify(const SignatureCheck* checks, size_t count, bool* results);
+
+    /**
+     * Verify signatures
+     *
+     * @param checks The signatures to verify
+     * @return Whether each signature is valid
+     */
+    std::vector<bool> verify(const std::vector<SignatureCheck>& checks);
+
+    /**
+     * Get the number of parallel workers
+     *
+     * @return The worker count
+     */
+    size_t workers() const { return config_.workers; }
+
+private:
+    struct Context;
+
+    Context* acquire();
+    void release(Context* context);
+
+    template <typename Work>
+    void run_parallel(size_t count, Work work);
+
+    BatchSignerConfig config_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Context>> contexts_;  // All contexts ever created
+    std::vector<Context*> idle_;
+};
+
+} // namespace svm_pay
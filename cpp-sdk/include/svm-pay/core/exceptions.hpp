@@ -21,6 +21,57 @@ public:
     explicit NetworkException(const std::string& message) : SVMPayException("Network error: " + message) {}
 };
 
+/**
+ * Exception thrown when a request could not be delivered to an RPC endpoint
+ * (DNS or connection failure), so it certainly had no effect
+ */
+class ConnectionException : public NetworkException {
+public:
+    explicit ConnectionException(const std::string& message) : NetworkException("Connection failed: " + message) {}
+};
+
+/**
+ * Exception thrown when a request is rejected because the endpoint's circuit
+ * breaker is open
+ */
+class CircuitOpenException : public NetworkException {
+public:
+    explicit CircuitOpenException(const std::string& message) : NetworkException("Circuit open: " + message) {}
+};
+
+/**
+ * Exception thrown when an RPC endpoint rejects a request as rate limited (HTTP 429)
+ */
+class RateLimitException : public NetworkException {
+public:
+    explicit RateLimitException(const std::string& message) : NetworkException("Rate limited: " + message) {}
+};
+
+/**
+ * Exception thrown when the SDK sheds load instead of queueing more requests
+ * for an endpoint that is already at its limit
+ */
+class BackpressureException : public NetworkException {
+public:
+    explicit BackpressureException(const std::string& message) : NetworkException("Backpressure: " + message) {}
+};
+
+/**
+ * Exception thrown when a call does not complete before its deadline
+ */
+class TimeoutException : public NetworkException {
+public:
+    explicit TimeoutException(const std::string& message) : NetworkException("Timeout: " + message) {}
+};
+
+/**
+ * Exception thrown when a call is abandoned through its cancellation token
+ */
+class OperationCancelledException : public SVMPayException {
+public:
+    explicit OperationCancelledException(const std::string& message) : SVMPayException("Cancelled: " + message) {}
+};
+
 /**
  * Exception thrown when URL parsing fails
  */
@@ -45,6 +96,23 @@ public:
     explicit ReferenceException(const std::string& message) : SVMPayException("Reference error: " + message) {}
 };
 
+/**
+ * Exception thrown when an RPC payload is not valid JSON or has an
+ * unexpected shape
+ */
+class JsonParseException : public SVMPayException {
+public:
+    explicit JsonParseException(const std::string& message) : SVMPayException("JSON parse error: " + message) {}
+};
+
+/**
+ * Exception thrown when a transaction cannot be built or serialized
+ */
+class TransactionException : public SVMPayException {
+public:
+    explicit TransactionException(const std::string& message) : SVMPayException("Transaction error: " + message) {}
+};
+
 /**
  * Exception thrown when cryptographic operations fail
  */
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Runs the SDK's asynchronous work
+ *
+ * Adapters schedule every future-returning call on an executor instead of
+ * starting a thread per call. Implement this to run SDK work on an
+ * application's own pool.
+ */
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    /**
+     * Run a task at some point, on some thread
+     *
+     * @param task The task; exceptions escaping it are discarded
+     */
+    virtual void execute(std::function<void()> task) = 0;
+};
+
+/**
+ * Run a callable on an executor and get its result as a future
+ *
+ * @param executor The executor
+ * @param work The callable
+ * @return A future for the callable's result or exception
+ */
+template <typename F>
+auto submit(Executor& executor, F&& work) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+    // std::function needs a copyable target, so the task is shared
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(work));
+    std::future<Result> result = task->get_future();
+    executor.execute([task]() { (*task)(); });
+    return result;
+}
+
+/**
+ * Run work(0) .. work(count - 1) on an executor and the calling thread, and
+ * return once all of them ran
+ *
+ * At most count - 1 tasks are queued, each taking the next index not yet
+ * started; the caller takes indexes too and only ever waits on ones
+ * already running, so this cannot deadlock on tasks still queued behind
+ * it, even when called from one of the executor's own workers.
+ *
+ * @param executor The executor
+ * @param count The number of indexes
+ * @param work Called once per index; may run concurrently
+ * @throws The first exception thrown by work, after every index ran
+ */
+void parallel_for(Executor& executor, size_t count, const std::function<void(size_t index)>& work);
+
+/**
+ * Configuration for a WorkStealingExecutor
+ */
+struct WorkStealingConfig {
+    // Worker threads; 0 uses the hardware concurrency, but at least 4 since
+    // adapter calls block a worker for the duration of their RPC
+    size_t threads = 0;
+
+    // Pin each worker to one CPU (Linux only; ignored elsewhere)
+    bool pin_threads = false;
+
+    // CPUs to pin to, assigned round-robin; empty means 0, 1, 2, ...
+    std::vector<int> cpus;
+};
+
+/**
+ * Fixed pool of workers with one task deque each
+ *
+ * Tasks submitted from a worker go to the back of its own deque and are
+ * taken from there (LIFO, cache-warm); idle workers steal from the front
+ * of the others' deques. Tasks from other threads are dealt round-robin.
+ * The destructor runs every queued task before joining the workers.
+ */
+class WorkStealingExecutor : public Executor {
+public:
+    explicit WorkStealingExecutor(const WorkStealingConfig& config = WorkStealingConfig{});
+    ~WorkStealingExecutor() override;
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    void execute(std::function<void()> task) override;
+
+    /**
+     * Get the number of worker threads
+     *
+     * @return The worker count
+     */
+    size_t thread_count() const { return workers_.size(); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        std::thread thread;
+    };
+
+    void run(size_t index);
+    bool take(size_t index, std::function<void()>& task);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<size_t> next_worker_{0};
+
+    std::mutex idle_mutex_;
+    std::condition_variable idle_;
+    size_t queued_ = 0;  // Tasks pushed but not yet taken; guarded by idle_mutex_
+    bool stopping_ = false;
+};
+
+/**
+ * Get the executor adapters use when none is set on them
+ *
+ * A WorkStealingExecutor with the default configuration is created on first
+ * use unless set_default_executor() provided one. Takes no lock, since every
+ * adapter call without an executor of its own comes through here.
+ *
+ * @return The process-wide executor
+ */
+std::shared_ptr<Executor> default_executor();
+
+/**
+ * Replace the process-wide default executor
+ *
+ * Work already scheduled stays on the previous executor.
+ *
+ * @param executor The new default, or nullptr to go back to the built-in pool
+ */
+void set_default_executor(std::shared_ptr<Executor> executor);
+
+} // namespace svm_pay
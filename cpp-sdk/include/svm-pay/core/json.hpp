@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Minimal read-only JSON document used to parse RPC responses
+ *
+ * Numbers keep their source text so 64-bit slots and lamport amounts are
+ * not rounded through double. Object members keep their source order.
+ */
+class JsonValue {
+public:
+    enum class Type {
+        NUL,
+        BOOLEAN,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT
+    };
+
+    JsonValue() = default;
+
+    /**
+     * Parse a JSON document
+     *
+     * @param text The JSON text
+     * @return The root value
+     * @throws JsonParseException if the text is not valid JSON
+     */
+    static JsonValue parse(const std::string& text);
+
+    Type type() const { return type_; }
+    bool is_null() const { return type_ == Type::NUL; }
+    bool is_bool() const { return type_ == Type::BOOLEAN; }
+    bool is_number() const { return type_ == Type::NUMBER; }
+    bool is_string() const { return type_ == Type::STRING; }
+    bool is_array() const { return type_ == Type::ARRAY; }
+    bool is_object() const { return type_ == Type::OBJECT; }
+
+    /**
+     * Typed accessors
+     *
+     * @throws JsonParseException if the value has a different type
+     */
+    bool as_bool() const;
+    int64_t as_int64() const;
+    uint64_t as_uint64() const;
+    double as_double() const;
+    const std::string& as_string() const;
+    const std::vector<JsonValue>& as_array() const;
+    const std::vector<std::pair<std::string, JsonValue>>& as_object() const;
+
+    /**
+     * Look up an object member
+     *
+     * @param key The member name
+     * @return The member, or nullptr if absent or this is not an object
+     */
+    const JsonValue* find(const std::string& key) const;
+
+    /**
+     * Look up an object member, yielding null when absent
+     *
+     * @param key The member name
+     * @return The member or a null value
+     */
+    const JsonValue& operator[](const std::string& key) const;
+
+    /**
+     * Access an array element, yielding null when out of range
+     *
+     * @param index The element index
+     * @return The element or a null value
+     */
+    const JsonValue& operator[](size_t index) const;
+
+    /**
+     * Get the number of array elements or object members
+     *
+     * @return The size, or 0 for scalars
+     */
+    size_t size() const;
+
+    /**
+     * Serialize back to compact JSON
+     *
+     * @return The JSON text
+     */
+    std::string dump() const;
+
+private:
+    friend class JsonParser;
+
+    Type type_ = Type::NUL;
+    bool bool_ = false;
+    std::string text_;  // String contents or number literal
+    std::vector<JsonValue> array_;
+    std::vector<std::pair<std::string, JsonValue>> object_;
+};
+
+/**
+ * Escape a string for inclusion in a JSON document (without quotes)
+ *
+ * @param value The raw string
+ * @return The escaped string
+ */
+std::string json_escape(const std::string& value);
+
+} // namespace svm_pay
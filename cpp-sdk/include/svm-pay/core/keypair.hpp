@@ -0,0 +1,111 @@
+#pragma once
+
+#include "public_key.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// OpenSSL's EVP_PKEY
+struct evp_pkey_st;
+
+namespace svm_pay {
+
+// Ed25519 signature as it appears in a transaction
+using Signature = std::array<uint8_t, 64>;
+
+/**
+ * Ed25519 keypair
+ *
+ * The OpenSSL key is created once and shared by copies, so signing does
+ * not re-derive it. The seed is wiped when the last copy goes away.
+ */
+class Keypair {
+public:
+    static constexpr size_t SEED_SIZE = 32;
+
+    // Secret key layout used by Solana tooling: seed followed by public key
+    static constexpr size_t SECRET_KEY_SIZE = 64;
+
+    /**
+     * Generate a random keypair
+     *
+     * @return The keypair
+     * @throws CryptographicException if the key cannot be generated
+     */
+    static Keypair generate();
+
+    /**
+     * Derive a keypair from a 32-byte seed
+     *
+     * @param seed The seed
+     * @return The keypair
+     * @throws CryptographicException if the key cannot be created
+     */
+    static Keypair from_seed(const uint8_t* seed);
+
+    /**
+     * Load a 64-byte secret key (seed || public key)
+     *
+     * @param secret_key The secret key bytes
+     * @param size The number of bytes; must be SECRET_KEY_SIZE
+     * @return The keypair
+     * @throws CryptographicException if the size is wrong or the public half does not match the seed
+     */
+    static Keypair from_secret_key(const uint8_t* secret_key, size_t size);
+
+    /**
+     * Load a base58-encoded 64-byte secret key, as exported by wallets
+     *
+     * @param secret_key The base58 secret key
+     * @return The keypair
+     * @throws CryptographicException if the key is malformed
+     */
+    static Keypair from_base58(const std::string& secret_key);
+
+    const PublicKey& public_key() const { return public_key_; }
+
+    /**
+     * Get the 64-byte secret key (seed || public key)
+     *
+     * @return The secret key
+     */
+    std::array<uint8_t, SECRET_KEY_SIZE> secret_key() const;
+
+    /**
+     * Sign a message
+     *
+     * @param message The message bytes
+     * @param size The message size
+     * @return The signature
+     * @throws CryptographicException if signing fails
+     */
+    Signature sign(const uint8_t* message, size_t size) const;
+
+private:
+    friend class BatchSigner;
+
+    struct Key;
+
+    evp_pkey_st* evp_key() const;
+
+    Keypair(std::shared_ptr<const Key> key, const PublicKey& public_key)
+        : key_(std::move(key)), public_key_(public_key) {}
+
+    std::shared_ptr<const Key> key_;
+    PublicKey public_key_;
+};
+
+/**
+ * Verify an Ed25519 signature
+ *
+ * @param key The signer's public key
+ * @param message The signed bytes
+ * @param size The message size
+ * @param signature The signature
+ * @return True if the signature is valid
+ */
+bool verify_signature(const PublicKey& key, const uint8_t* message, size_t size, const Signature& signature);
+
+} // namespace svm_pay
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "transaction.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Limits and compute-unit estimates for packing transfers into transactions
+ */
+struct PayoutPackerConfig {
+    // Lookup tables to load recipients from; when empty, only legacy messages are built
+    std::vector<std::shared_ptr<const AddressLookupTable>> lookup_tables;
+
+    // Runtime limit on the accounts one transaction may lock
+    size_t max_accounts = 64;
+
+    // Mints of the SPL token requests, e.g. from a MintCache; other mints are rejected
+    std::vector<MintInfo> mints;
+
+    // Cap on transfers per transaction; 0 for none
+    size_t max_transfers = 0;
+
+    // Compute units one transaction may request
+    uint32_t max_compute_units = 1400000;
+
+    // Estimated cost of each instruction; the sum becomes the requested limit
+    uint32_t system_transfer_units = 150;
+    uint32_t token_transfer_units = 6200;
+    uint32_t memo_units = 10000;
+    uint32_t compute_budget_units = 150;
+
+    // Prepend SetComputeUnitLimit with the estimated total
+    bool set_compute_unit_limit = true;
+
+    // Prepend SetComputeUnitPrice with this priority fee, in micro-lamports
+    std::optional<uint64_t> compute_unit_price;
+};
+
+/**
+ * One transaction of a packed batch
+ */
+struct PackedTransaction {
+    // Unsigned; the fee payer and each request's paying account must sign
+    TransactionBuilder transaction;
+
+    // Indexes into the packed requests, in instruction order
+    std::vector<size_t> requests;
+
+    // Serialized size, at most TransactionBuilder::MAX_TRANSACTION_SIZE
+    size_t size = 0;
+
+    // Estimated compute units, as requested by SetComputeUnitLimit
+    uint32_t compute_units = 0;
+};
+
+/**
+ * Pack transfer requests into as few transactions as fit
+ *
+ * Requests are taken in order and added to the current transaction until
+ * the next one would exceed the transaction size, account, transfer or
+ * compute-unit limits; it then starts the next transaction. A request's
+ * memo and references travel with its transfer. SPL token requests become
+ * TransferChecked instructions between the associated token accounts of
+ * the paying and receiving wallets, which must already exist; the token
+ * accounts, mint and token program count against the account limit. With
+ * lookup tables, each transaction is built as a v0 message when that is
+ * smaller and as a legacy message otherwise.
+ *
+ * @param requests The payouts; those without an account are paid by the fee payer
+ * @param fee_payer The account paying the fees
+ * @param blockhash A recent blockhash or durable nonce; may be replaced before signing
+ * @param config Limits and estimates
+ * @return The transactions, covering every request exactly once
+ * @throws AddressValidationException if a request has an invalid address
+ * @throws TransactionException if a request has an invalid amount, is for
+ *         a mint not in the config, or does not fit in a transaction on its own
+ */
+std::vector<PackedTransaction> pack_transfers(const std::vector<TransferRequest>& requests, const PublicKey& fee_payer,
+                                              const Blockhash& blockhash,
+                                              const PayoutPackerConfig& config = PayoutPackerConfig{});
+
+} // namespace svm_pay
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "public_key.hpp"
+#include "transaction.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * One seed of a program derived address
+ */
+struct SeedView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    SeedView() = default;
+    SeedView(const uint8_t* data, size_t size) : data(data), size(size) {}
+    SeedView(const PublicKey& key) : data(key.data()), size(PublicKey::SIZE) {}
+    SeedView(const std::string& text) : data(reinterpret_cast<const uint8_t*>(text.data())), size(text.size()) {}
+    SeedView(const std::vector<uint8_t>& bytes) : data(bytes.data()), size(bytes.size()) {}
+};
+
+/**
+ * A program derived address and the bump seed that moved it off the curve
+ */
+struct ProgramAddress {
+    PublicKey address;
+    uint8_t bump = 0;
+};
+
+// Most seeds, and longest seed, a program derived address may have
+constexpr size_t MAX_SEEDS = 16;
+constexpr size_t MAX_SEED_LENGTH = 32;
+
+/**
+ * Check whether 32 bytes decompress to an ed25519 point
+ *
+ * Program derived addresses must not, so that no private key can sign
+ * for them.
+ *
+ * @param key The candidate address
+ * @return True if the key is a valid compressed point
+ */
+bool is_on_curve(const PublicKey& key);
+
+/**
+ * Derive a program address from seeds that already include the bump
+ *
+ * @param seeds The seeds
+ * @param count The number of seeds
+ * @param program_id The program the address belongs to
+ * @param out Receives the address
+ * @return False if the hash landed on the curve
+ * @throws std::invalid_argument if there are too many seeds or one is too long
+ */
+bool create_program_address(const SeedView* seeds, size_t count, const PublicKey& program_id, PublicKey& out);
+
+/**
+ * Find the program address with the highest bump seed that is off the curve
+ *
+ * @param seeds The seeds, without a bump
+ * @param count The number of seeds; at most MAX_SEEDS - 1
+ * @param program_id The program the address belongs to
+ * @return The address and its bump
+ * @throws std::invalid_argument if there are too many seeds or one is too long
+ * @throws CryptographicException if no bump works, which is vanishingly unlikely
+ */
+ProgramAddress find_program_address(const SeedView* seeds, size_t count, const PublicKey& program_id);
+ProgramAddress find_program_address(std::initializer_list<SeedView> seeds, const PublicKey& program_id);
+
+/**
+ * Derive an associated token account without caching
+ *
+ * @param owner The wallet
+ * @param mint The token mint
+ * @param token_program The program owning the mint
+ * @return The account's address and bump
+ */
+ProgramAddress derive_associated_token_address(const PublicKey& owner, const PublicKey& mint,
+                                               const PublicKey& token_program = token_program_id());
+
+/**
+ * Derive the associated token accounts of many wallets without caching
+ *
+ * Hashes the wallets' bump candidates side by side, one SHA-256 lane each,
+ * which is what a payout run with hundreds of recipients wants.
+ *
+ * @param owners The wallets
+ * @param count The number of wallets
+ * @param mint The token mint
+ * @param out Receives count addresses and bumps, in order
+ * @param token_program The program owning the mint
+ */
+void derive_associated_token_addresses(const PublicKey* owners, size_t count, const PublicKey& mint,
+                                       ProgramAddress* out, const PublicKey& token_program = token_program_id());
+
+/**
+ * Configuration for an AssociatedTokenAddressCache
+ */
+struct AssociatedTokenAddressCacheConfig {
+    // Independently locked parts of the cache; rounded up to a power of two
+    size_t shards = 16;
+
+    // Most addresses kept across all shards
+    size_t capacity = 65536;
+};
+
+/**
+ * Least-recently-used cache of associated token account derivations
+ *
+ * Derivation hashes until an address lands off the curve, about two
+ * SHA-256 and point checks on average; a hit is a hash map lookup. Keys
+ * are spread over shards, each with its own lock, so concurrent payment
+ * builders rarely wait on each other. Thread-safe.
+ */
+class AssociatedTokenAddressCache {
+public:
+    explicit AssociatedTokenAddressCache(
+        const AssociatedTokenAddressCacheConfig& config = AssociatedTokenAddressCacheConfig{});
+
+    AssociatedTokenAddressCache(const AssociatedTokenAddressCache&) = delete;
+    AssociatedTokenAddressCache& operator=(const AssociatedTokenAddressCache&) = delete;
+
+    /**
+     * Get the associated token account of a wallet, deriving it on a miss
+     *
+     * @param owner The wallet
+     * @param mint The token mint
+     * @param token_program The program owning the mint
+     * @return The account's address
+     */
+    PublicKey get(const PublicKey& owner, const PublicKey& mint, const PublicKey& token_program = token_program_id());
+
+    /**
+     * Get the associated token accounts of many wallets, deriving the misses
+     * together
+     *
+     * @param owners The wallets
+     * @param count The number of wallets
+     * @param mint The token mint
+     * @param out Receives count addresses, in order
+     * @param token_program The program owning the mint
+     */
+    void get_many(const PublicKey* owners, size_t count, const PublicKey& mint, PublicKey* out,
+                  const PublicKey& token_program = token_program_id());
+
+    /**
+     * Drop every cached address
+     */
+    void clear();
+
+    /**
+     * Get the number of cached addresses
+     *
+     * @return The address count
+     */
+    size_t size() const;
+
+    /**
+     * Get the cache shared by the SDK's transfer builders
+     *
+     * @return The cache
+     */
+    static AssociatedTokenAddressCache& shared();
+
+private:
+    struct Key {
+        PublicKey owner;
+        PublicKey mint;
+        PublicKey program;
+
+        bool operator==(const Key& other) const {
+            return owner == other.owner && mint == other.mint && program == other.program;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<std::pair<Key, PublicKey>> entries;  // Most recently used first
+        std::unordered_map<Key, std::list<std::pair<Key, PublicKey>>::iterator, KeyHash> index;
+    };
+
+    Shard& shard_for(const Key& key);
+    bool lookup(Shard& shard, const Key& key, PublicKey& out);
+    void insert(Shard& shard, const Key& key, const PublicKey& address);
+
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_mask_;
+    size_t shard_capacity_;
+};
+
+/**
+ * Get the associated token account of a wallet through the shared cache
+ *
+ * @param owner The wallet
+ * @param mint The token mint
+ * @param token_program The program owning the mint
+ * @return The account's address
+ */
+PublicKey associated_token_address(const PublicKey& owner, const PublicKey& mint,
+                                   const PublicKey& token_program = token_program_id());
+
+} // namespace svm_pay
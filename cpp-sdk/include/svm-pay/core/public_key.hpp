@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace svm_pay {
+
+/**
+ * 32-byte Solana account address
+ */
+class PublicKey {
+public:
+    static constexpr size_t SIZE = 32;
+
+    PublicKey() = default;
+    explicit PublicKey(const std::array<uint8_t, SIZE>& bytes) : bytes_(bytes) {}
+
+    /**
+     * Parse a base58 address
+     * 
+     * @param address The base58-encoded address
+     * @return The public key
+     * @throws AddressValidationException if the address is not 32 bytes of valid base58
+     */
+    static PublicKey from_base58(const std::string& address);
+
+    /**
+     * Parse a base58 address without throwing
+     * 
+     * @param address The base58-encoded address
+     * @param out Receives the key on success
+     * @return False if the address is invalid
+     */
+    static bool try_from_base58(const std::string& address, PublicKey& out);
+
+    /**
+     * Encode as base58
+     * 
+     * @return The base58-encoded address
+     */
+    std::string to_base58() const;
+
+    const std::array<uint8_t, SIZE>& bytes() const { return bytes_; }
+    const uint8_t* data() const { return bytes_.data(); }
+    uint8_t* data() { return bytes_.data(); }
+
+    bool operator==(const PublicKey& other) const { return bytes_ == other.bytes_; }
+    bool operator!=(const PublicKey& other) const { return bytes_ != other.bytes_; }
+    bool operator<(const PublicKey& other) const {
+        return std::memcmp(bytes_.data(), other.bytes_.data(), SIZE) < 0;
+    }
+
+private:
+    std::array<uint8_t, SIZE> bytes_{};
+};
+
+// Blockhashes share the 32-byte base58 representation of addresses
+using Blockhash = PublicKey;
+
+/**
+ * Hash functor for unordered containers keyed by PublicKey
+ */
+struct PublicKeyHash {
+    size_t operator()(const PublicKey& key) const {
+        // Keys are hashes or curve points, so any 8 bytes are uniformly distributed
+        size_t result;
+        std::memcpy(&result, key.data(), sizeof(result));
+        return result;
+    }
+};
+
+} // namespace svm_pay
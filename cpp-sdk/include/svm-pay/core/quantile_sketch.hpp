@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Streaming quantile estimator over non-negative integers
+ *
+ * Values fall into logarithmic buckets whose bounds grow by a constant
+ * factor, so every quantile is answered within a fixed relative error
+ * whatever the distribution, and memory grows with the logarithm of the
+ * largest value rather than with the number of samples: about 2,200
+ * counters at 1% cover the whole uint64 range. Zeros are counted apart.
+ *
+ * Not thread-safe.
+ */
+class QuantileSketch {
+public:
+    /**
+     * Constructor
+     *
+     * @param relative_accuracy Largest relative error of a quantile, in (0, 1)
+     * @throws std::invalid_argument if the accuracy is out of range
+     */
+    explicit QuantileSketch(double relative_accuracy = 0.01);
+
+    /**
+     * Record a value
+     *
+     * @param value The value
+     * @param count How many times it occurred
+     */
+    void add(uint64_t value, uint64_t count = 1);
+
+    /**
+     * Add the samples of another sketch
+     *
+     * @param other A sketch with the same relative accuracy
+     * @throws std::invalid_argument if the accuracies differ
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * Estimate a quantile
+     *
+     * @param q The quantile in [0, 1]; clamped
+     * @return The estimate, within the relative accuracy of a recorded
+     *         value and never outside [min, max], which are exact; 0 when empty
+     */
+    uint64_t quantile(double q) const;
+
+    /**
+     * Drop all samples but keep the buckets' capacity
+     */
+    void clear();
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double relative_accuracy() const { return relative_accuracy_; }
+
+private:
+    size_t bucket_of(uint64_t value) const;
+    uint64_t bucket_value(size_t bucket) const;
+
+    double relative_accuracy_;
+    double gamma_;
+    double log_gamma_;
+
+    uint64_t zeros_ = 0;
+    std::vector<uint64_t> buckets_;  // Bucket k counts values in (gamma^(k-1), gamma^k]
+    uint64_t count_ = 0;
+    uint64_t min_ = 0;
+    uint64_t max_ = 0;
+};
+
+} // namespace svm_pay
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace svm_pay {
+
+// Size of a SHA-256 digest
+constexpr size_t SHA256_SIZE = 32;
+
+/**
+ * Hash implementations
+ */
+enum class Sha256Implementation {
+    SCALAR,
+    AVX2,    // Eight messages at once, one per 32-bit lane
+    SHA_NI   // The SHA extensions, two messages interleaved
+};
+
+/**
+ * Get the implementation in use; SHA-NI, then AVX2, when the CPU supports
+ * them unless overridden
+ *
+ * @return The active implementation
+ */
+Sha256Implementation sha256_implementation();
+
+/**
+ * Override the implementation, e.g. for benchmarking
+ *
+ * @param implementation The implementation to use
+ * @return False if the CPU does not support it; the active implementation is unchanged
+ */
+bool set_sha256_implementation(Sha256Implementation implementation);
+
+/**
+ * Get how many messages sha256_many hashes side by side
+ *
+ * Callers searching for a hash with some property, like a program address
+ * bump search, can hash this many candidates per call at little more than
+ * the cost of one.
+ *
+ * @return The lane count of the active implementation
+ */
+size_t sha256_lanes();
+
+/**
+ * Hash a message
+ *
+ * Uses the SHA extensions when active and scalar code otherwise, since a
+ * single message fills only one AVX2 lane.
+ *
+ * @param data The message
+ * @param size The size of the message
+ * @param out Receives SHA256_SIZE bytes
+ */
+void sha256(const uint8_t* data, size_t size, uint8_t* out);
+
+/**
+ * Hash independent messages, side by side where the implementation allows
+ *
+ * Messages may differ in length; with SHA-NI, the longer of two finishes
+ * on its own once the shorter is done.
+ *
+ * @param messages The messages
+ * @param sizes Their sizes
+ * @param count The number of messages
+ * @param out Receives count digests of SHA256_SIZE bytes, in order
+ */
+void sha256_many(const uint8_t* const* messages, const size_t* sizes, size_t count, uint8_t* out);
+
+} // namespace svm_pay
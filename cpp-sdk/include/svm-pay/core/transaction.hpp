@@ -0,0 +1,411 @@
+#pragma once
+
+#include "keypair.hpp"
+#include "public_key.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Well-known program ids
+ */
+const PublicKey& system_program_id();
+const PublicKey& token_program_id();
+const PublicKey& token_2022_program_id();
+const PublicKey& associated_token_program_id();
+const PublicKey& memo_program_id();
+const PublicKey& compute_budget_program_id();
+const PublicKey& sysvar_recent_blockhashes_id();
+const PublicKey& sysvar_rent_id();
+
+// 1 SOL = 10^9 lamports
+constexpr uint8_t LAMPORTS_DECIMALS = 9;
+
+// Size of a System program nonce account
+constexpr uint64_t NONCE_ACCOUNT_SIZE = 80;
+
+/**
+ * What a transfer needs to know about a token mint
+ */
+struct MintInfo {
+    PublicKey mint;
+    PublicKey program;     // Token or Token-2022 program owning the mint
+    uint8_t decimals = 0;
+};
+
+/**
+ * Account referenced by an instruction
+ */
+struct AccountMeta {
+    PublicKey key;
+    bool is_signer = false;
+    bool is_writable = false;
+};
+
+/**
+ * Program invocation inside a transaction
+ */
+struct Instruction {
+    PublicKey program_id;
+    std::vector<AccountMeta> accounts;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * On-chain address lookup table, as used by v0 messages
+ */
+struct AddressLookupTable {
+    PublicKey key;
+    std::vector<PublicKey> addresses;
+};
+
+enum class MessageVersion {
+    LEGACY,
+    V0
+};
+
+/**
+ * Create a System program transfer instruction
+ *
+ * @param from The funding account (signer)
+ * @param to The recipient
+ * @param lamports The amount in lamports
+ * @return The instruction
+ */
+Instruction system_transfer(const PublicKey& from, const PublicKey& to, uint64_t lamports);
+
+/**
+ * Create a System program CreateAccount instruction
+ *
+ * @param from The funding account (signer)
+ * @param new_account The account to create (signer)
+ * @param lamports The balance to fund it with
+ * @param space The size of its data
+ * @param owner The program that will own it
+ * @return The instruction
+ */
+Instruction system_create_account(const PublicKey& from, const PublicKey& new_account, uint64_t lamports,
+                                  uint64_t space, const PublicKey& owner);
+
+/**
+ * Create a System program InitializeNonceAccount instruction
+ *
+ * @param nonce_account A system-owned account of NONCE_ACCOUNT_SIZE bytes
+ * @param authority The account allowed to advance the nonce
+ * @return The instruction
+ */
+Instruction nonce_initialize(const PublicKey& nonce_account, const PublicKey& authority);
+
+/**
+ * Create a System program AdvanceNonceAccount instruction
+ *
+ * @param nonce_account The nonce account
+ * @param authority The nonce authority (signer)
+ * @return The instruction
+ */
+Instruction nonce_advance(const PublicKey& nonce_account, const PublicKey& authority);
+
+/**
+ * Create a Compute Budget SetComputeUnitLimit instruction
+ *
+ * @param units The most compute units the transaction may consume
+ * @return The instruction
+ */
+Instruction compute_unit_limit(uint32_t units);
+
+/**
+ * Create a Compute Budget SetComputeUnitPrice instruction
+ *
+ * @param micro_lamports The priority fee per compute unit, in micro-lamports
+ * @return The instruction
+ */
+Instruction compute_unit_price(uint64_t micro_lamports);
+
+/**
+ * Create an SPL Token TransferChecked instruction
+ *
+ * @param source The source token account
+ * @param mint The token mint
+ * @param destination The destination token account
+ * @param owner The owner of the source account (signer)
+ * @param amount The amount in base units
+ * @param decimals The mint's decimals
+ * @param token_program The token program owning the mint
+ * @return The instruction
+ */
+Instruction spl_transfer_checked(const PublicKey& source, const PublicKey& mint, const PublicKey& destination,
+                                 const PublicKey& owner, uint64_t amount, uint8_t decimals,
+                                 const PublicKey& token_program = token_program_id());
+
+/**
+ * Create a Memo program instruction
+ *
+ * @param memo The UTF-8 memo text
+ * @param signers Accounts that must sign the memo
+ * @return The instruction
+ */
+Instruction memo_instruction(const std::string& memo, const std::vector<PublicKey>& signers = {});
+
+/**
+ * Write a compact-u16 (the 1-3 byte varint used for lengths in the wire format)
+ *
+ * @param value The value to encode
+ * @param out Receives up to 3 bytes
+ * @return The number of bytes written
+ */
+size_t encode_compact_u16(uint16_t value, uint8_t* out);
+
+/**
+ * Read a compact-u16
+ *
+ * @param data The encoded bytes
+ * @param size The number of bytes available
+ * @param value Receives the value
+ * @return The number of bytes consumed, 0 if the encoding is truncated or invalid
+ */
+size_t decode_compact_u16(const uint8_t* data, size_t size, uint16_t& value);
+
+/**
+ * Verify every signature of a wire-format transaction against its message
+ *
+ * @param data The serialized transaction
+ * @param size The transaction size
+ * @return False if a signature is invalid or the transaction is malformed
+ */
+bool verify_transaction(const uint8_t* data, size_t size);
+
+/**
+ * Get the fee payer's signature, which is the transaction's id on chain
+ *
+ * @param data The serialized transaction
+ * @param size The transaction size
+ * @return The base58 signature
+ * @throws TransactionException if the transaction is malformed or unsigned
+ */
+std::string transaction_signature(const uint8_t* data, size_t size);
+
+/**
+ * Convert a decimal amount string to base units
+ *
+ * @param amount The amount, e.g. "1.5"
+ * @param decimals The number of decimal places of the unit (9 for SOL)
+ * @return The amount in base units
+ * @throws TransactionException if the amount is malformed, too precise or overflows
+ */
+uint64_t parse_token_amount(const std::string& amount, uint8_t decimals);
+
+/**
+ * Builds and serializes Solana transactions in the wire format
+ *
+ * Instructions are stored in flat buffers that keep their capacity across
+ * clear_instructions(), so a builder reused for many payments does not
+ * allocate in steady state. Compilation deduplicates accounts, orders them
+ * fee payer first, then writable signers, read-only signers, writable and
+ * read-only non-signers (each group by key), and for v0 messages moves
+ * eligible non-signer accounts into the configured lookup tables.
+ *
+ * Serialized transactions are unsigned: signature slots are zero-filled
+ * for the wallet to fill in.
+ */
+class TransactionBuilder {
+public:
+    // Largest transaction a validator accepts (IPv6 MTU minus headers)
+    static constexpr size_t MAX_TRANSACTION_SIZE = 1232;
+
+    // Account indexes are a single byte
+    static constexpr size_t MAX_ACCOUNTS = 256;
+
+    TransactionBuilder() = default;
+
+    TransactionBuilder& set_version(MessageVersion version);
+    TransactionBuilder& set_fee_payer(const PublicKey& fee_payer);
+    TransactionBuilder& set_recent_blockhash(const Blockhash& blockhash);
+
+    /**
+     * Build against a durable nonce instead of a recent blockhash
+     *
+     * The nonce value takes the blockhash's place and an AdvanceNonceAccount
+     * instruction is compiled in ahead of every added instruction, so the
+     * transaction stays valid until the nonce is advanced rather than for
+     * about 150 blocks. Kept across clear_instructions().
+     *
+     * @param nonce_account The nonce account
+     * @param authority The nonce authority, which must sign
+     * @param nonce The nonce account's current value
+     */
+    TransactionBuilder& set_durable_nonce(const PublicKey& nonce_account, const PublicKey& authority,
+                                          const Blockhash& nonce);
+
+    /**
+     * Go back to recent-blockhash mode; the nonce value stays set as the blockhash
+     */
+    TransactionBuilder& clear_durable_nonce();
+
+    /**
+     * Make a lookup table available to v0 compilation; ignored for legacy messages
+     *
+     * @param table The lookup table contents
+     */
+    TransactionBuilder& add_lookup_table(std::shared_ptr<const AddressLookupTable> table);
+
+    TransactionBuilder& add_instruction(const Instruction& instruction);
+    TransactionBuilder& add_instruction(const PublicKey& program_id, const AccountMeta* accounts,
+                                        size_t account_count, const uint8_t* data, size_t data_size);
+
+    /**
+     * Allocation-free equivalents of the instruction factory functions
+     */
+    TransactionBuilder& add_system_transfer(const PublicKey& from, const PublicKey& to, uint64_t lamports);
+    TransactionBuilder& add_transfer_checked(const PublicKey& source, const PublicKey& mint,
+                                             const PublicKey& destination, const PublicKey& owner,
+                                             uint64_t amount, uint8_t decimals,
+                                             const PublicKey& token_program = token_program_id());
+    TransactionBuilder& add_memo(const std::string& memo);
+
+    /**
+     * Attach Solana Pay reference keys to the most recently added instruction
+     * as read-only, non-signer accounts
+     *
+     * @param references The reference keys
+     * @throws TransactionException if no instruction was added yet
+     */
+    TransactionBuilder& add_references(const std::vector<PublicKey>& references);
+
+    /**
+     * Drop all instructions but keep the fee payer, blockhash, version and
+     * lookup tables, along with buffer capacity
+     */
+    void clear_instructions();
+
+    /**
+     * Drop the instructions added after the first count, e.g. to back out of
+     * one that made the transaction too large
+     *
+     * @param count The number of instructions to keep
+     */
+    void truncate_instructions(size_t count);
+
+    /**
+     * Get the number of instructions added, not counting AdvanceNonceAccount
+     *
+     * @return The instruction count
+     */
+    size_t instruction_count() const { return instructions_.size(); }
+
+    /**
+     * Get the number of signatures the transaction needs
+     *
+     * @return The signer count
+     * @throws TransactionException if the transaction cannot be compiled
+     */
+    size_t num_required_signatures() const;
+
+    /**
+     * Get the compiled static account keys in wire order
+     *
+     * @return The account keys; signers come first
+     * @throws TransactionException if the transaction cannot be compiled
+     */
+    std::vector<PublicKey> account_keys() const;
+
+    /**
+     * Get the number of distinct accounts the transaction locks, including
+     * those loaded from lookup tables
+     *
+     * @return The account count
+     * @throws TransactionException if the transaction cannot be compiled
+     */
+    size_t num_accounts() const;
+
+    /**
+     * Get the size of the serialized unsigned transaction
+     *
+     * @return The size in bytes, which may exceed MAX_TRANSACTION_SIZE
+     * @throws TransactionException if the transaction cannot be compiled
+     */
+    size_t serialized_size() const;
+
+    /**
+     * Serialize only the message (the bytes that are signed)
+     *
+     * @param out The destination buffer
+     * @param capacity The size of the buffer
+     * @return The number of bytes written
+     * @throws TransactionException if the transaction is incomplete or the buffer too small
+     */
+    size_t serialize_message(uint8_t* out, size_t capacity) const;
+
+    /**
+     * Serialize the unsigned transaction into a caller buffer
+     *
+     * @param out The destination buffer
+     * @param capacity The size of the buffer; MAX_TRANSACTION_SIZE always suffices
+     * @return The number of bytes written
+     * @throws TransactionException if the transaction is incomplete, exceeds
+     *         MAX_TRANSACTION_SIZE or does not fit the buffer
+     */
+    size_t serialize(uint8_t* out, size_t capacity) const;
+
+    /**
+     * Serialize the transaction signed by the given keypairs
+     *
+     * @param signers Keypairs for all required signers, in any order
+     * @param out The destination buffer
+     * @param capacity The size of the buffer
+     * @return The number of bytes written
+     * @throws TransactionException if a required signer is missing or the
+     *         transaction cannot be serialized
+     */
+    size_t serialize_signed(const std::vector<Keypair>& signers, uint8_t* out, size_t capacity) const;
+
+    /**
+     * Serialize the unsigned transaction
+     *
+     * @return The transaction bytes
+     */
+    std::vector<uint8_t> serialize() const;
+
+    /**
+     * Serialize the unsigned transaction as base64, as accepted by wallets
+     * and sendTransaction
+     *
+     * @return The base64 transaction
+     */
+    std::string serialize_base64() const;
+
+private:
+    struct InstructionRecord {
+        PublicKey program_id;
+        uint32_t account_offset;
+        uint32_t account_count;
+        uint32_t data_offset;
+        uint32_t data_size;
+    };
+
+    struct Compiled;
+    class Writer;
+
+    void compile(Compiled& compiled) const;
+    void write_message(const Compiled& compiled, Writer& writer) const;
+
+    MessageVersion version_ = MessageVersion::LEGACY;
+    PublicKey fee_payer_;
+    Blockhash blockhash_;
+    bool has_fee_payer_ = false;
+    bool has_blockhash_ = false;
+
+    std::vector<InstructionRecord> instructions_;
+    std::vector<AccountMeta> accounts_;  // Flat account lists of all instructions
+    std::vector<uint8_t> data_;          // Flat data of all instructions
+    std::vector<std::shared_ptr<const AddressLookupTable>> lookup_tables_;
+
+    // AdvanceNonceAccount accounts when in durable-nonce mode
+    bool has_nonce_ = false;
+    AccountMeta nonce_accounts_[3];
+};
+
+} // namespace svm_pay
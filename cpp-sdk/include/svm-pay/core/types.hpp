@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -18,6 +19,9 @@ enum class SVMNetwork {
     SOON
 };
 
+// Number of SVMNetwork values, for tables indexed by network
+constexpr size_t SVM_NETWORK_COUNT = 4;
+
 /**
  * Supported EVM networks for cross-chain payments
  */
@@ -89,6 +93,7 @@ struct PaymentRequest {
 struct TransferRequest : public PaymentRequest {
     std::string amount;
     std::optional<std::string> spl_token;
+    std::optional<std::string> account;  // Paying wallet; required to build the transaction
     
     TransferRequest(SVMNetwork network, const std::string& recipient, const std::string& amount)
         : PaymentRequest(RequestType::TRANSFER, network, recipient), amount(amount) {}
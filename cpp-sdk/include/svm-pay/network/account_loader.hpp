@@ -0,0 +1,122 @@
+#pragma once
+
+#include "svm_adapter.hpp"
+#include "../core/public_key.hpp"
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Configuration for an AccountLoader
+ */
+struct AccountLoaderConfig {
+    // How long a batch stays open for more keys after its first one
+    std::chrono::microseconds window{1000};
+
+    // Keys per getMultipleAccounts call; a full batch goes out at once
+    size_t max_batch = SvmNetworkAdapter::MAX_MULTIPLE_ACCOUNTS;
+
+    // Limit for each getMultipleAccounts call
+    std::chrono::milliseconds request_timeout{5000};
+};
+
+/**
+ * Merges concurrent account lookups into getMultipleAccounts calls
+ *
+ * The first load opens a batch for one window; loads arriving in the
+ * meantime join it, and a key asked for twice is fetched once. The batch
+ * goes out when the window closes or when it holds max_batch keys, and
+ * each waiter receives its own account. Windows are timers on the
+ * adapter's transport I/O thread, so the loader holds no thread.
+ */
+class AccountLoader {
+public:
+    /**
+     * Constructor
+     *
+     * @param adapter The adapter to load through; must outlive the loader
+     * @param config Batching options
+     */
+    explicit AccountLoader(SvmNetworkAdapter& adapter, const AccountLoaderConfig& config = AccountLoaderConfig{});
+
+    /**
+     * Destructor; sends the open batch and waits for batches in flight
+     */
+    ~AccountLoader();
+
+    AccountLoader(const AccountLoader&) = delete;
+    AccountLoader& operator=(const AccountLoader&) = delete;
+
+    /**
+     * Load an account with the next batch
+     *
+     * @param key The account address
+     * @param on_done Receives the account, unset if it does not exist, or the
+     *        batch's error; runs on the I/O thread and must not block
+     */
+    void load_async(const PublicKey& key, Completion<std::optional<AccountInfo>> on_done);
+
+    /**
+     * Load an account with the next batch
+     *
+     * @param key The account address
+     * @return A future that resolves to the account, unset if it does not exist
+     */
+    std::future<std::optional<AccountInfo>> load(const PublicKey& key);
+
+    /**
+     * Load several accounts with the next batches
+     *
+     * @param keys The account addresses
+     * @param on_done Receives one entry per key, or the first error; runs on
+     *        the I/O thread and must not block
+     */
+    void load_many_async(const std::vector<PublicKey>& keys,
+                         Completion<std::vector<std::optional<AccountInfo>>> on_done);
+
+    /**
+     * Load several accounts with the next batches
+     *
+     * @param keys The account addresses
+     * @return A future that resolves to one entry per key
+     */
+    std::future<std::vector<std::optional<AccountInfo>>> load_many(const std::vector<PublicKey>& keys);
+
+    /**
+     * Send the open batch without waiting for its window to close
+     */
+    void flush();
+
+    /**
+     * Get the number of loads requested
+     *
+     * @return The load count
+     */
+    uint64_t load_count() const;
+
+    /**
+     * Get the number of distinct keys sent to the node
+     *
+     * @return The key count
+     */
+    uint64_t key_count() const;
+
+    /**
+     * Get the number of getMultipleAccounts calls made
+     *
+     * @return The call count
+     */
+    uint64_t batch_count() const;
+
+private:
+    struct State;
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace svm_pay
@@ -1,15 +1,31 @@
 #pragma once
 
 #include "../core/types.hpp"
+#include "../core/executor.hpp"
+#include "call_options.hpp"
 #include <string>
+#include <exception>
 #include <future>
-#include <mutex>
+#include <functional>
+#include <memory>
 
 namespace svm_pay {
 
+/**
+ * Receives the outcome of an asynchronous adapter call: the value, or the
+ * exception the matching future would have thrown
+ */
+template <typename T>
+using Completion = std::function<void(T value, std::exception_ptr error)>;
+
 /**
  * Network adapter interface
  * Each supported SVM network must implement this interface
+ * 
+ * Every method accepts CallOptions carrying a deadline and a cancellation
+ * token. Implementations must fail the returned future with
+ * TimeoutException or OperationCancelledException and release the
+ * underlying connection when either fires.
  */
 class NetworkAdapter {
 public:
@@ -29,56 +45,129 @@ public:
      */
     SVMNetwork get_network() const { return network_; }
     
+    /**
+     * Run this adapter's asynchronous work on the given executor
+     * 
+     * Safe to call while calls are in flight; they finish where they started.
+     * 
+     * @param executor The executor, or nullptr for the process-wide default
+     */
+    void set_executor(std::shared_ptr<Executor> executor);
+    
+    /**
+     * Get the executor this adapter schedules its work on
+     * 
+     * @return The adapter's executor, or default_executor() if none was set
+     */
+    std::shared_ptr<Executor> get_executor() const;
+    
+    /**
+     * Get the executor a call runs its work on
+     * 
+     * @param options The call's options
+     * @return options.executor if set, else get_executor()
+     */
+    std::shared_ptr<Executor> get_executor(const CallOptions& options) const;
+    
     /**
      * Create a transaction from a transfer request
      * 
      * @param request The transfer request to create a transaction for
+     * @param options Deadline and cancellation for the call
      * @return A future that resolves to the transaction string
      */
-    virtual std::future<std::string> create_transfer_transaction(const TransferRequest& request) = 0;
+    virtual std::future<std::string> create_transfer_transaction(const TransferRequest& request,
+                                                                const CallOptions& options = CallOptions{}) = 0;
     
     /**
      * Fetch a transaction from a transaction request
      * 
      * @param request The transaction request to fetch a transaction for
+     * @param options Deadline and cancellation for the call
      * @return A future that resolves to the transaction string
      */
-    virtual std::future<std::string> fetch_transaction(const TransactionRequest& request) = 0;
+    virtual std::future<std::string> fetch_transaction(const TransactionRequest& request,
+                                                      const CallOptions& options = CallOptions{}) = 0;
     
     /**
      * Submit a signed transaction to the network
      * 
+     * The default waits on submit_transaction_async() through a promise, so
+     * no thread is held while the call is in flight.
+     * 
      * @param transaction The transaction to submit
      * @param signature The signature for the transaction
+     * @param options Deadline and cancellation for the call
      * @return A future that resolves to the transaction signature
      */
     virtual std::future<std::string> submit_transaction(const std::string& transaction, 
-                                                       const std::string& signature) = 0;
+                                                       const std::string& signature,
+                                                       const CallOptions& options = CallOptions{});
     
     /**
      * Check the status of a transaction
      * 
+     * The default waits on check_transaction_status_async() through a promise.
+     * 
      * @param signature The signature of the transaction to check
+     * @param options Deadline and cancellation for the call
      * @return A future that resolves to the payment status
      */
-    virtual std::future<PaymentStatus> check_transaction_status(const std::string& signature) = 0;
+    virtual std::future<PaymentStatus> check_transaction_status(const std::string& signature,
+                                                               const CallOptions& options = CallOptions{});
+    
+    /**
+     * Submit a signed transaction without waiting for the result
+     * 
+     * The primitive every adapter implements; it must not block the caller
+     * or park a thread on the network.
+     * 
+     * @param transaction The transaction to submit
+     * @param signature The signature for the transaction
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the transaction signature or the error, on any thread
+     */
+    virtual void submit_transaction_async(const std::string& transaction, const std::string& signature,
+                                          const CallOptions& options, Completion<std::string> on_done) = 0;
+    
+    /**
+     * Check the status of a transaction without waiting for the result
+     * 
+     * @param signature The signature of the transaction to check
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the payment status or the error, on any thread
+     */
+    virtual void check_transaction_status_async(const std::string& signature, const CallOptions& options,
+                                                Completion<PaymentStatus> on_done) = 0;
 
 protected:
     SVMNetwork network_;
+    
+private:
+    std::shared_ptr<Executor> executor_;  // Accessed atomically
 };
 
 /**
  * Factory for creating network adapters
+ * 
+ * The registry is an immutable snapshot republished on every registration,
+ * so lookups never wait on a registration: one acquire load of a plain
+ * pointer and an index by network, with no lock and no counter shared by
+ * all readers. Superseded snapshots are kept rather than freed, since a
+ * reader may still be indexing one; they hold only weak references.
+ * Lookups hand out shared ownership; an adapter replaced by a later
+ * registration is destroyed, with its background work, once the last
+ * caller holding it lets go.
  */
 class NetworkAdapterFactory {
 public:
     /**
-     * Register a network adapter
+     * Register a network adapter, replacing any previous one for the network
      * 
      * @param network The network
-     * @param adapter The network adapter to register
+     * @param adapter The network adapter to register; a std::unique_ptr converts implicitly
      */
-    static void register_adapter(SVMNetwork network, std::unique_ptr<NetworkAdapter> adapter);
+    static void register_adapter(SVMNetwork network, std::shared_ptr<NetworkAdapter> adapter);
     
     /**
      * Get a network adapter for a specific network
@@ -86,7 +175,20 @@ public:
      * @param network The network to get an adapter for
      * @return The network adapter, or nullptr if none is registered
      */
-    static NetworkAdapter* get_adapter(SVMNetwork network);
+    static std::shared_ptr<NetworkAdapter> get_adapter(SVMNetwork network);
+    
+    /**
+     * Get the adapter for a network, registering one first if there is none
+     * 
+     * Concurrent callers for the same network all receive the same adapter;
+     * create runs at most once per registration.
+     * 
+     * @param network The network to get an adapter for
+     * @param create Builds the adapter when none is registered
+     * @return The registered network adapter
+     */
+    static std::shared_ptr<NetworkAdapter> get_or_register_adapter(
+        SVMNetwork network, const std::function<std::shared_ptr<NetworkAdapter>()>& create);
     
     /**
      * Check if an adapter is registered for a network
@@ -96,9 +198,6 @@ public:
      */
     static bool has_adapter(SVMNetwork network);
 
-private:
-    static std::unordered_map<SVMNetwork, std::unique_ptr<NetworkAdapter>> adapters_;
-    static std::mutex adapters_mutex_;  // Thread safety for adapter registration/access
 };
 
 } // namespace svm_pay
\ No newline at end of file
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "periodic_task.hpp"
+#include "svm_adapter.hpp"
+#include "../core/public_key.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+namespace svm_pay {
+
+/**
+ * Blockhash held by a BlockhashCache
+ */
+struct CachedBlockhash {
+    Blockhash blockhash;
+    uint64_t last_valid_block_height = 0;  // Transactions using the hash expire after this height
+    uint64_t slot = 0;                     // Slot the node answered at
+    std::chrono::steady_clock::time_point fetched_at;
+};
+
+/**
+ * Configuration for a BlockhashCache
+ */
+struct BlockhashCacheConfig {
+    // Expected slot time, used to estimate progress between slot notifications
+    std::chrono::milliseconds slot_time{400};
+
+    // Slots after which the blockhash is refreshed
+    uint64_t refresh_slots = 10;
+
+    // Remaining blocks below which the blockhash counts as stale; get()
+    // waits for a refresh rather than return a stale one
+    uint64_t stale_margin_blocks = 40;
+
+    // Delay before retrying a failed refresh
+    std::chrono::milliseconds retry_delay{500};
+
+    // Invoked on the transport's I/O thread while the cached blockhash is
+    // stale, i.e. refreshes keep failing; must not block
+    std::function<void(const CachedBlockhash& blockhash, uint64_t remaining_blocks)> on_stale;
+};
+
+/**
+ * Keeps a recent blockhash ready for transaction building
+ *
+ * Timers on the transport refresh the blockhash every few slots, so the
+ * cache holds no thread of its own. The latest value sits in a
+ * sequence-locked slot, so current() is lock-free and never touches the
+ * network. Progress is estimated from the slot time and, when
+ * a slot feed is connected through notify_slot(), from observed slots;
+ * both run ahead of block height, so the expiry estimate errs on the safe
+ * side.
+ */
+class BlockhashCache {
+public:
+    // Starts a getLatestBlockhash call; reports the result or the error through on_done
+    using Fetcher = std::function<void(Completion<LatestBlockhash> on_done)>;
+
+    // Blocks a blockhash stays valid after it is produced
+    static constexpr uint64_t VALID_BLOCKHASH_AGE = 150;
+
+    /**
+     * Constructor; refreshes through a network adapter
+     *
+     * @param adapter The adapter to query; must outlive the cache
+     * @param config Refresh options
+     */
+    explicit BlockhashCache(SvmNetworkAdapter& adapter, const BlockhashCacheConfig& config = BlockhashCacheConfig{});
+
+    /**
+     * Constructor; refreshes on the shared transport's timers
+     *
+     * @param fetcher Fetches the latest blockhash; runs on the I/O thread and must not block
+     * @param config Refresh options
+     */
+    explicit BlockhashCache(Fetcher fetcher, const BlockhashCacheConfig& config = BlockhashCacheConfig{});
+
+    ~BlockhashCache();
+
+    BlockhashCache(const BlockhashCache&) = delete;
+    BlockhashCache& operator=(const BlockhashCache&) = delete;
+
+    /**
+     * Get the cached blockhash without blocking
+     *
+     * @return The blockhash, or nothing before the first successful refresh
+     */
+    std::optional<CachedBlockhash> current() const;
+
+    /**
+     * Get a blockhash outside the stale margin, waiting for a refresh if needed
+     *
+     * A stale blockhash is not returned even before it expires, since a
+     * transaction built on it may not land in time.
+     *
+     * @param timeout How long to wait for a refresh
+     * @return The blockhash
+     * @throws TimeoutException if no usable blockhash arrives in time
+     */
+    CachedBlockhash get(std::chrono::milliseconds timeout);
+
+    /**
+     * Estimate how many blocks remain before a blockhash expires
+     *
+     * @param blockhash A blockhash obtained from this cache
+     * @return The estimated remaining blocks, 0 once expired
+     */
+    uint64_t remaining_blocks(const CachedBlockhash& blockhash) const;
+
+    /**
+     * Check whether a blockhash is within the stale margin of expiring
+     *
+     * @param blockhash A blockhash obtained from this cache
+     * @return True if stale
+     */
+    bool is_stale(const CachedBlockhash& blockhash) const;
+
+    /**
+     * Report the cluster's current slot, e.g. from a slot subscription
+     *
+     * Triggers a refresh once the blockhash is refresh_slots old.
+     *
+     * @param slot The observed slot
+     */
+    void notify_slot(uint64_t slot);
+
+    /**
+     * Request an immediate refresh
+     */
+    void refresh();
+
+    /**
+     * Get the number of successful refreshes
+     *
+     * @return The refresh count
+     */
+    uint64_t refresh_count() const { return refreshes_.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    BlockhashCache(RpcTransport& transport, Fetcher fetcher, const BlockhashCacheConfig& config);
+
+    void run(PeriodicTask::Done done);
+    void publish(const LatestBlockhash& latest, Clock::time_point fetched_at);
+    uint64_t slots_elapsed(const CachedBlockhash& blockhash) const;
+
+    Fetcher fetcher_;
+    BlockhashCacheConfig config_;
+
+    // Sequence lock over the published value: odd while a refresh writes,
+    // so readers retry instead of waiting
+    static constexpr size_t WORDS = PublicKey::SIZE / 8 + 3;
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> words_[WORDS];
+
+    std::atomic<uint64_t> observed_slot_{0};
+    std::atomic<uint64_t> refreshes_{0};
+
+    // Signalled after every refresh, for get()
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    // Last, so a refresh in flight finishes before anything it touches goes away
+    std::optional<PeriodicTask> refresher_;
+};
+
+} // namespace svm_pay
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "request_scheduler.hpp"
+#include "../core/executor.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace svm_pay {
+
+/**
+ * Read side of a cooperative cancellation signal
+ *
+ * Tokens are cheap to copy and all copies observe the same signal. A
+ * default-constructed token can never be cancelled.
+ */
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    /**
+     * Check whether cancellation was requested
+     *
+     * @return True once the owning CancellationSource was cancelled
+     */
+    bool is_cancelled() const;
+
+    /**
+     * Check whether this token is connected to a source
+     *
+     * @return False for default-constructed tokens
+     */
+    bool can_be_cancelled() const { return static_cast<bool>(state_); }
+
+    /**
+     * Throw if cancellation was requested
+     *
+     * @throws OperationCancelledException if cancelled
+     */
+    void throw_if_cancelled() const;
+
+    /**
+     * Sleep until the timeout elapses or cancellation is requested
+     *
+     * @param timeout Maximum time to sleep
+     * @return True if woken by cancellation
+     */
+    bool wait_for(std::chrono::steady_clock::duration timeout) const;
+
+private:
+    friend class CancellationSource;
+
+    struct State {
+        std::atomic<bool> cancelled{false};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+
+    explicit CancellationToken(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * Owner of a cancellation signal
+ */
+class CancellationSource {
+public:
+    CancellationSource();
+
+    /**
+     * Get a token observing this source
+     *
+     * @return The token
+     */
+    CancellationToken token() const;
+
+    /**
+     * Request cancellation; wakes every waiter and aborts in-flight transfers
+     */
+    void cancel();
+
+    /**
+     * Check whether cancellation was requested
+     *
+     * @return True once cancel() was called
+     */
+    bool is_cancelled() const;
+
+private:
+    std::shared_ptr<CancellationToken::State> state_;
+};
+
+/**
+ * Per-call options accepted by every NetworkAdapter method
+ */
+struct CallOptions {
+    using Clock = std::chrono::steady_clock;
+
+    // Relative time limit; the SDK-wide default applies when unset
+    std::optional<std::chrono::milliseconds> timeout;
+
+    // Absolute time limit; the earlier of deadline and timeout wins
+    std::optional<Clock::time_point> deadline;
+
+    // Cooperative cancellation; aborts the underlying transfer when signalled
+    CancellationToken cancellation;
+
+    // Scheduling class of the call's requests; derived from the RPC method when unset
+    std::optional<RequestPriority> priority;
+
+    // Runs the call's work; the adapter's executor when unset
+    std::shared_ptr<Executor> executor;
+
+    /**
+     * Compute the effective deadline for a call starting now
+     *
+     * @return The deadline
+     */
+    Clock::time_point resolve_deadline() const;
+};
+
+/**
+ * Set the SDK-wide default timeout for calls without an explicit limit
+ *
+ * @param timeout The default timeout
+ */
+void set_default_call_timeout(std::chrono::milliseconds timeout);
+
+/**
+ * Get the SDK-wide default call timeout
+ *
+ * @return The default timeout (30 seconds unless configured)
+ */
+std::chrono::milliseconds get_default_call_timeout();
+
+/**
+ * Set the SDK-wide limit for establishing a connection
+ *
+ * @param timeout The connect timeout
+ */
+void set_default_connect_timeout(std::chrono::milliseconds timeout);
+
+/**
+ * Get the SDK-wide connect timeout
+ *
+ * @return The connect timeout (5 seconds unless configured)
+ */
+std::chrono::milliseconds get_default_connect_timeout();
+
+} // namespace svm_pay
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "svm_adapter.hpp"
+#include "../core/types.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Configuration for a ConfirmationWatcher
+ */
+struct ConfirmationWatcherConfig {
+    // Timing wheel resolution
+    std::chrono::milliseconds tick{50};
+
+    // Expected slot time; a signature is first checked one slot after it is watched
+    std::chrono::milliseconds slot_time{400};
+
+    // Poll interval ceiling for signatures that have been pending a long time
+    std::chrono::milliseconds max_interval{5000};
+
+    // A signature the node has never reported is EXPIRED after this long
+    std::chrono::milliseconds expiry{90000};
+
+    // Commitment that counts as CONFIRMED: "confirmed" or "finalized"
+    std::string target_commitment = "confirmed";
+
+    // Signatures per getSignatureStatuses call and concurrent calls per tick
+    size_t batch_size = SvmNetworkAdapter::MAX_SIGNATURE_STATUS_BATCH;
+    size_t max_concurrent_batches = 4;
+
+    // Runs the calls of a tick alongside the watcher thread; nullptr uses the
+    // adapter's executor, or default_executor() with a custom status source
+    std::shared_ptr<Executor> executor;
+
+    // Terminal states remembered for late watchers, oldest evicted first
+    size_t memo_capacity = 100000;
+
+    // Callbacks kept per signature; further watchers are rejected
+    size_t max_callbacks_per_signature = 16;
+};
+
+/**
+ * Tracks pending transaction signatures until they reach a terminal state
+ *
+ * Signatures sit in a hashed timing wheel. Each one is polled at a cadence
+ * that starts at one slot and stretches with its age, so fresh transactions
+ * are noticed quickly while stragglers cost little. On every tick the due
+ * signatures are batched into getSignatureStatuses calls. CONFIRMED, FAILED
+ * and EXPIRED are terminal: subscribers are notified once, the entry is
+ * released, and the result is memoized for later watchers.
+ *
+ * Callbacks run on the watcher thread and must not block.
+ */
+class ConfirmationWatcher {
+public:
+    using Callback = std::function<void(const std::string& signature, PaymentStatus status)>;
+
+    // Status lookup for a batch; one entry per signature, unset if unknown to the node
+    using StatusFetcher = std::function<std::vector<std::optional<SignatureStatus>>(
+        const std::vector<std::string>& signatures)>;
+
+    /**
+     * Constructor; polls through a network adapter
+     *
+     * @param adapter The adapter to query; must outlive the watcher
+     * @param config Cadence and batching options
+     */
+    explicit ConfirmationWatcher(SvmNetworkAdapter& adapter,
+                                 const ConfirmationWatcherConfig& config = ConfirmationWatcherConfig{});
+
+    /**
+     * Constructor; polls through a custom status source
+     *
+     * @param fetcher Function returning statuses for a batch of signatures
+     * @param config Cadence and batching options
+     */
+    explicit ConfirmationWatcher(StatusFetcher fetcher,
+                                 const ConfirmationWatcherConfig& config = ConfirmationWatcherConfig{});
+
+    /**
+     * Destructor; stops polling without notifying pending watchers
+     */
+    ~ConfirmationWatcher();
+
+    ConfirmationWatcher(const ConfirmationWatcher&) = delete;
+    ConfirmationWatcher& operator=(const ConfirmationWatcher&) = delete;
+
+    /**
+     * Watch a signature until it reaches a terminal state
+     *
+     * If the outcome is already memoized the callback runs immediately on
+     * the calling thread.
+     *
+     * @param signature The transaction signature
+     * @param callback Invoked once with CONFIRMED, FAILED or EXPIRED
+     * @throws BackpressureException if the signature already has the maximum number of callbacks
+     */
+    void watch(const std::string& signature, Callback callback);
+
+    /**
+     * Watch a signature through a future
+     *
+     * @param signature The transaction signature
+     * @return A future that resolves to CONFIRMED, FAILED or EXPIRED
+     */
+    std::future<PaymentStatus> wait(const std::string& signature);
+
+    /**
+     * Get a memoized terminal state
+     *
+     * @param signature The transaction signature
+     * @return The terminal state, if known
+     */
+    std::optional<PaymentStatus> cached_status(const std::string& signature) const;
+
+    /**
+     * Get the number of signatures still being polled
+     *
+     * @return The pending count
+     */
+    size_t pending_count() const;
+
+    /**
+     * Compute the poll interval for a signature of a given age
+     *
+     * @param age Time since the signature was first watched
+     * @param config Cadence options
+     * @return Roughly a quarter of the age, between one slot and max_interval
+     */
+    static std::chrono::milliseconds poll_interval(std::chrono::milliseconds age,
+                                                   const ConfirmationWatcherConfig& config);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string signature;
+        Clock::time_point watched_at;
+        std::optional<Clock::time_point> first_seen;
+        uint64_t due_tick = 0;
+        uint32_t generation = 0;  // Bumped when the slot is reused, invalidating stale wheel references
+        bool in_use = false;
+        std::vector<Callback> callbacks;
+    };
+
+    struct WheelRef {
+        uint32_t index;
+        uint32_t generation;
+    };
+
+    struct Notification {
+        std::string signature;
+        PaymentStatus status;
+        std::vector<Callback> callbacks;
+    };
+
+    void run();
+    uint64_t current_tick(Clock::time_point now) const;
+    void schedule_locked(uint32_t index, Clock::time_point due);
+    std::vector<uint32_t> collect_due_locked(uint64_t tick);
+    void poll(const std::vector<uint32_t>& due);
+    void apply_locked(uint32_t index, const std::optional<SignatureStatus>& status, Clock::time_point now,
+                      std::vector<Notification>& notifications);
+    void finish_locked(uint32_t index, PaymentStatus status, std::vector<Notification>& notifications);
+    void remember_locked(const std::string& signature, PaymentStatus status);
+
+    StatusFetcher fetcher_;
+    ConfirmationWatcherConfig config_;
+    Clock::time_point epoch_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+    std::vector<Entry> entries_;                          // Slab of tracked signatures
+    std::vector<uint32_t> free_entries_;
+    std::unordered_map<std::string, uint32_t> pending_;   // Signature -> entry index
+    std::vector<std::vector<WheelRef>> wheel_;
+    uint64_t processed_tick_ = 0;
+
+    std::unordered_map<std::string, PaymentStatus> memo_;
+    std::deque<std::string> memo_order_;
+
+    std::thread thread_;
+};
+
+} // namespace svm_pay
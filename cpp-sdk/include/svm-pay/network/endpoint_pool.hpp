@@ -0,0 +1,245 @@
+#pragma once
+
+#include "rate_limiter.hpp"
+#include "retry_policy.hpp"
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Configuration for a set of RPC endpoints serving the same network
+ */
+struct EndpointPoolConfig {
+    std::vector<std::string> urls;
+
+    // Send a duplicate of slow idempotent reads to a second endpoint
+    bool hedging_enabled = false;
+
+    // Latency quantile of the primary endpoint after which a hedge is sent
+    double hedge_quantile = 0.95;
+
+    // Bounds for the hedge delay (also used until enough samples exist)
+    std::chrono::milliseconds min_hedge_delay{10};
+    std::chrono::milliseconds max_hedge_delay{1000};
+
+    // Smoothing factor for the latency and error-rate EWMAs (0 < alpha <= 1)
+    double ewma_alpha = 0.2;
+
+    // Pacing and concurrency limits applied to each endpoint separately
+    RateLimitConfig rate_limit;
+
+    // Retries across endpoints, and per-endpoint fail-fast when a node is down
+    RetryPolicy retry;
+    CircuitBreakerConfig circuit_breaker;
+};
+
+/**
+ * Live routing statistics and admission control for a single RPC endpoint
+ *
+ * Statistics are lock-free and may be updated from any thread.
+ */
+class Endpoint {
+public:
+    /**
+     * Constructor
+     *
+     * @param url The endpoint URL
+     * @param ewma_alpha Smoothing factor for latency and error-rate averages
+     * @param rate_limit Pacing and concurrency limits for this endpoint
+     * @param circuit_breaker Circuit breaker settings for this endpoint
+     */
+    explicit Endpoint(std::string url, double ewma_alpha = 0.2,
+                      const RateLimitConfig& rate_limit = RateLimitConfig{},
+                      const CircuitBreakerConfig& circuit_breaker = CircuitBreakerConfig{});
+
+    /**
+     * Get the endpoint URL
+     *
+     * @return The URL
+     */
+    const std::string& url() const { return url_; }
+
+    /**
+     * Get the admission controller for this endpoint
+     *
+     * @return The rate limiter
+     */
+    RateLimiter& limiter() { return limiter_; }
+    const RateLimiter& limiter() const { return limiter_; }
+
+    /**
+     * Get the circuit breaker for this endpoint
+     *
+     * @return The circuit breaker
+     */
+    CircuitBreaker& breaker() { return breaker_; }
+    const CircuitBreaker& breaker() const { return breaker_; }
+
+    /**
+     * Mark a request as started on this endpoint
+     */
+    void on_request_start() { in_flight_.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * Mark a started request as given up by the caller, without a sample
+     */
+    void on_request_abandoned();
+
+    /**
+     * Record a successful response
+     *
+     * @param latency Time from request start to response
+     */
+    void record_success(std::chrono::microseconds latency);
+
+    /**
+     * Record a failed request
+     *
+     * @param latency Time from request start to failure
+     */
+    void record_failure(std::chrono::microseconds latency);
+
+    /**
+     * Get the smoothed latency in microseconds
+     *
+     * @return The EWMA latency, or 0 if no samples were recorded
+     */
+    double latency_ewma_us() const { return latency_ewma_us_.load(std::memory_order_relaxed); }
+
+    /**
+     * Get the smoothed error rate
+     *
+     * @return The EWMA error rate in [0, 1]
+     */
+    double error_rate() const { return error_rate_.load(std::memory_order_relaxed); }
+
+    /**
+     * Get the number of requests currently in flight
+     *
+     * @return The in-flight request count
+     */
+    uint32_t in_flight() const { return in_flight_.load(std::memory_order_relaxed); }
+
+    /**
+     * Get the number of latency samples in the histogram
+     *
+     * @return The (decayed) sample count
+     */
+    uint64_t sample_count() const { return sample_count_.load(std::memory_order_relaxed); }
+
+    /**
+     * Estimate a latency quantile from the recent latency histogram
+     *
+     * @param quantile The quantile in [0, 1]
+     * @return The estimated latency, or zero if no samples were recorded
+     */
+    std::chrono::microseconds latency_quantile(double quantile) const;
+
+    /**
+     * Routing cost of this endpoint (lower is better)
+     *
+     * Combines the latency EWMA, current queue depth and error rate, and
+     * penalizes endpoints that asked us to back off.
+     *
+     * @return The cost
+     */
+    double cost() const;
+
+private:
+    // Log-linear buckets: 4 per power of two from 1us up to ~68s
+    static constexpr size_t kBucketCount = 4 * 26;
+    static constexpr uint64_t kDecayThreshold = 2048;
+
+    static size_t bucket_for(uint64_t micros);
+    static uint64_t bucket_upper_bound(size_t bucket);
+
+    void record_latency(std::chrono::microseconds latency, bool failed);
+
+    std::string url_;
+    double ewma_alpha_;
+    RateLimiter limiter_;
+    CircuitBreaker breaker_;
+    std::atomic<double> latency_ewma_us_{0.0};
+    std::atomic<double> error_rate_{0.0};
+    std::atomic<uint32_t> in_flight_{0};
+    std::atomic<uint64_t> sample_count_{0};
+    std::array<std::atomic<uint32_t>, kBucketCount> buckets_{};
+};
+
+/**
+ * Immutable view of the configured endpoints
+ *
+ * A snapshot is never modified after publication; reconfiguration publishes
+ * a new snapshot, so in-flight requests keep a consistent view.
+ */
+struct EndpointSet {
+    EndpointPoolConfig config;
+    std::vector<std::shared_ptr<Endpoint>> endpoints;
+};
+
+/**
+ * Set of interchangeable RPC endpoints with latency-aware routing
+ *
+ * Endpoints are selected with power-of-two-choices over their EWMA cost.
+ * The configuration is held in an atomically swappable snapshot, so it can
+ * be replaced while requests are in flight.
+ */
+class EndpointPool {
+public:
+    /**
+     * Constructor
+     *
+     * @param config The initial endpoint configuration
+     * @throws std::invalid_argument if no URLs are configured
+     */
+    explicit EndpointPool(const EndpointPoolConfig& config);
+
+    /**
+     * Replace the endpoint configuration
+     *
+     * Statistics and learned limits are carried over for URLs present in both
+     * configurations.
+     *
+     * @param config The new configuration
+     * @throws std::invalid_argument if no URLs are configured
+     */
+    void configure(const EndpointPoolConfig& config);
+
+    /**
+     * Get the current configuration snapshot
+     *
+     * @return The snapshot; remains valid for as long as it is held
+     */
+    std::shared_ptr<const EndpointSet> snapshot() const;
+
+    /**
+     * Pick an endpoint using power-of-two-choices
+     *
+     * Endpoints with an open circuit are only returned if no other is usable.
+     *
+     * @param set The snapshot to pick from
+     * @param exclude Endpoint to avoid if any other is available (may be nullptr)
+     * @return The chosen endpoint
+     */
+    static std::shared_ptr<Endpoint> pick(const EndpointSet& set, const Endpoint* exclude = nullptr);
+
+    /**
+     * Compute the hedge delay for a request sent to an endpoint
+     *
+     * @param set The snapshot holding the hedging configuration
+     * @param endpoint The primary endpoint
+     * @return The delay after which a hedged request should be sent
+     */
+    static std::chrono::microseconds hedge_delay(const EndpointSet& set, const Endpoint& endpoint);
+
+private:
+    std::shared_ptr<const EndpointSet> snapshot_;
+};
+
+} // namespace svm_pay
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "account_loader.hpp"
+#include "periodic_task.hpp"
+#include "svm_adapter.hpp"
+#include "../core/public_key.hpp"
+#include "../core/transaction.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Decode a token mint from its raw state
+ *
+ * @param address The mint's address
+ * @param account The account as loaded
+ * @return The mint's program and decimals
+ * @throws TransactionException if it is not an initialized Token or Token-2022 mint
+ */
+MintInfo decode_mint(const PublicKey& address, const AccountInfo& account);
+
+/**
+ * Configuration for a MintCache
+ */
+struct MintCacheConfig {
+    // File the cache persists to; empty to keep it in memory only
+    std::string path;
+
+    // Most mints kept; past it the mint loaded longest ago is evicted
+    size_t capacity = 4096;
+
+    // Age after which a mint is loaded again in the background
+    std::chrono::seconds max_age{24 * 3600};
+
+    // Delay before retrying a failed background refresh
+    std::chrono::milliseconds retry_delay{5000};
+
+    // Batching of loads for mints not in the cache
+    AccountLoaderConfig loader;
+};
+
+/**
+ * Keeps token mint programs and decimals ready for transfers
+ *
+ * Lookups probe an in-memory open-addressing table whose slots are
+ * sequence-locked, so find() is lock-free. Each mint is also written to a
+ * memory-mapped file, which the next process reads at startup instead of
+ * asking the node again. Timers on the adapter's transport reload mints
+ * older than max_age, oldest first, so the cache holds no thread of its
+ * own. Misses are loaded through an AccountLoader, so
+ * concurrent misses share getMultipleAccounts calls. Once capacity mints
+ * are cached, a new one takes the place, and the file record, of the mint
+ * loaded longest ago.
+ */
+class MintCache {
+public:
+    /**
+     * Constructor
+     *
+     * @param adapter The adapter to load mints through; must outlive the cache
+     * @param config Cache options
+     * @throws SVMPayException if the file cannot be opened or is not a mint cache
+     */
+    explicit MintCache(SvmNetworkAdapter& adapter, const MintCacheConfig& config = MintCacheConfig{});
+
+    /**
+     * Destructor; writes the file back to disk
+     */
+    ~MintCache();
+
+    MintCache(const MintCache&) = delete;
+    MintCache& operator=(const MintCache&) = delete;
+
+    /**
+     * Look up a mint without touching the network
+     *
+     * @param mint The mint address
+     * @return The mint, or nothing if it is not cached
+     */
+    std::optional<MintInfo> find(const PublicKey& mint) const;
+
+    /**
+     * Look up a mint, loading it on a miss
+     *
+     * @param mint The mint address
+     * @param on_done Receives the mint or the error, on the calling thread for
+     *        a hit and on the I/O thread otherwise; must not block
+     */
+    void get_async(const PublicKey& mint, Completion<MintInfo> on_done);
+
+    /**
+     * Look up a mint, loading it on a miss
+     *
+     * @param mint The mint address
+     * @return A future that resolves to the mint
+     */
+    std::future<MintInfo> get(const PublicKey& mint);
+
+    /**
+     * Add or replace a mint, e.g. one decoded from an account loaded elsewhere
+     *
+     * @param info The mint
+     */
+    void put(const MintInfo& info);
+
+    /**
+     * Reload every cached mint in the background now
+     */
+    void refresh();
+
+    /**
+     * Write the file back to disk
+     */
+    void sync();
+
+    /**
+     * Get the number of cached mints
+     *
+     * @return The mint count
+     */
+    size_t size() const;
+
+    /**
+     * Get the number of mints evicted to make room for others
+     *
+     * @return The eviction count
+     */
+    uint64_t eviction_count() const;
+
+    /**
+     * Get the number of mints asked of the node, on misses or refreshes
+     *
+     * @return The load count
+     */
+    uint64_t load_count() const { return loader_.key_count(); }
+
+private:
+    struct Slot;
+    class Storage;
+
+    // insert false only updates a mint that is still cached
+    void store(const MintInfo& info, uint64_t loaded_at, bool insert = true);
+    size_t take_record_locked();
+    void publish_locked(const MintInfo& info);
+    void unpublish_locked(const PublicKey& mint);
+    void run(PeriodicTask::Done done);
+
+    MintCacheConfig config_;
+
+    std::unique_ptr<Slot[]> slots_;  // Power of two, at least twice the capacity
+    size_t mask_ = 0;
+    std::unique_ptr<Storage> storage_;
+
+    // Writers only: file record and load time of each cached mint
+    struct Entry {
+        size_t record;
+        uint64_t loaded_at;  // Seconds since the epoch
+        uint64_t stored;     // Order of the last store, breaking ties of loaded_at
+    };
+    std::unordered_map<PublicKey, Entry, PublicKeyHash> entries_;
+    std::vector<size_t> free_records_;  // Below next_record_ but holding no mint
+    size_t next_record_ = 0;
+    uint64_t stores_ = 0;
+    uint64_t evictions_ = 0;
+
+    mutable std::mutex mutex_;
+    bool refresh_requested_ = false;
+
+    // Destroyed first, then the loader, so loads in flight finish before
+    // anything they store into goes away
+    AccountLoader loader_;
+    std::optional<PeriodicTask> refresher_;
+};
+
+} // namespace svm_pay
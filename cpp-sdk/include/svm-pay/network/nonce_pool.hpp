@@ -0,0 +1,194 @@
+#pragma once
+
+#include "svm_adapter.hpp"
+#include "../core/keypair.hpp"
+#include "../core/transaction.hpp"
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Build a signed transaction that creates and initializes a nonce account
+ *
+ * @param payer Funds the account and pays the fee
+ * @param nonce_account Keypair of the new account
+ * @param authority The account allowed to advance the nonce
+ * @param lamports The rent-exempt balance for NONCE_ACCOUNT_SIZE bytes
+ * @param recent_blockhash A recent blockhash
+ * @return The base64 wire-format transaction
+ */
+std::string create_nonce_account_transaction(const Keypair& payer, const Keypair& nonce_account,
+                                             const PublicKey& authority, uint64_t lamports,
+                                             const Blockhash& recent_blockhash);
+
+/**
+ * Build a signed transaction that only advances a nonce
+ *
+ * Built against the nonce itself, so no blockhash is needed. Advancing
+ * invalidates every unsent transaction built on the current value.
+ *
+ * @param authority The nonce authority; also pays the fee
+ * @param account The nonce account's current state
+ * @return The base64 wire-format transaction
+ */
+std::string advance_nonce_transaction(const Keypair& authority, const NonceAccount& account);
+
+/**
+ * Configuration for a NoncePool
+ */
+struct NoncePoolConfig {
+    // First delay before re-reading a nonce that a transaction consumed; doubles up to max_refresh_interval
+    std::chrono::milliseconds refresh_interval{400};
+    std::chrono::milliseconds max_refresh_interval{5000};
+
+    // Limit for each getAccountInfo call
+    std::chrono::milliseconds request_timeout{5000};
+
+    // How long a used nonce may stay unchanged on chain before it is handed
+    // out again as is: the transaction was dropped, and whichever
+    // transaction built on the nonce lands first makes the others fail
+    std::chrono::milliseconds used_nonce_timeout{60000};
+
+    // Called on the I/O thread when an account is dropped from the pool
+    // because it is not an initialized nonce account; must not block
+    std::function<void(const PublicKey& account, std::exception_ptr error)> on_dropped;
+};
+
+class NonceLease;
+
+/**
+ * Set of durable nonce accounts leased out to concurrent submitters
+ *
+ * Each account carries one nonce, and a nonce backs one transaction at a
+ * time, so N accounts let N pre-signed transactions be outstanding at
+ * once. Acquiring a lease needs no RPC: current values are read when the
+ * pool starts and again, off the caller's path, after each use. Refreshes
+ * run as timers on the adapter's transport I/O thread. Network errors are
+ * retried; an account that does not hold an initialized nonce is dropped
+ * for good and reported through on_dropped.
+ */
+class NoncePool {
+public:
+    /**
+     * Constructor; starts reading every account
+     *
+     * @param adapter The adapter to read through; must outlive the pool
+     * @param accounts Addresses of initialized nonce accounts
+     * @param config Refresh options
+     */
+    NoncePool(SvmNetworkAdapter& adapter, const std::vector<PublicKey>& accounts,
+              const NoncePoolConfig& config = NoncePoolConfig{});
+
+    /**
+     * Destructor; stops refreshing and waits for reads in flight. Leases may
+     * outlive the pool; releasing them then does nothing.
+     */
+    ~NoncePool();
+
+    NoncePool(const NoncePool&) = delete;
+    NoncePool& operator=(const NoncePool&) = delete;
+
+    /**
+     * Lease a nonce, waiting for one to become free
+     *
+     * @param timeout How long to wait
+     * @return The lease
+     * @throws TimeoutException if no nonce becomes free in time
+     * @throws TransactionException if every account has been dropped
+     */
+    NonceLease acquire(std::chrono::milliseconds timeout);
+
+    /**
+     * Lease a nonce if one is free right now
+     *
+     * @return The lease, or nothing
+     */
+    std::optional<NonceLease> try_acquire();
+
+    /**
+     * Get the number of nonces ready to lease
+     *
+     * @return The available count
+     */
+    size_t available() const;
+
+    /**
+     * Get the number of accounts in the pool, including dropped ones
+     *
+     * @return The account count
+     */
+    size_t size() const;
+
+    /**
+     * Get the number of accounts dropped because they are not nonce accounts
+     *
+     * @return The dropped count
+     */
+    size_t dropped() const;
+
+private:
+    friend class NonceLease;
+    struct State;
+
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * Exclusive use of one nonce account, returned to the pool on destruction
+ *
+ * A lease that is dropped without mark_used() returns its nonce as is. Once
+ * a transaction built on it has been sent, call mark_used(): the pool then
+ * re-reads the account and hands it out again once the nonce has advanced
+ * on chain, or with the same nonce after used_nonce_timeout.
+ */
+class NonceLease {
+public:
+    NonceLease(NonceLease&& other) noexcept;
+    NonceLease& operator=(NonceLease&& other) noexcept;
+    NonceLease(const NonceLease&) = delete;
+    NonceLease& operator=(const NonceLease&) = delete;
+    ~NonceLease();
+
+    /**
+     * Get the leased account and its current nonce
+     *
+     * @return The account
+     */
+    const NonceAccount& account() const { return account_; }
+
+    /**
+     * Put the builder in durable-nonce mode on this nonce
+     *
+     * @param builder The builder
+     */
+    void apply(TransactionBuilder& builder) const;
+
+    /**
+     * Record that a transaction using the nonce was sent
+     */
+    void mark_used() { used_ = true; }
+
+    /**
+     * Return the account to the pool now
+     */
+    void release();
+
+private:
+    friend class NoncePool;
+
+    NonceLease(std::shared_ptr<NoncePool::State> pool, size_t index, NonceAccount account);
+
+    std::shared_ptr<NoncePool::State> pool_;
+    size_t index_ = 0;
+    NonceAccount account_;
+    bool used_ = false;
+};
+
+} // namespace svm_pay
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "rpc_transport.hpp"
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace svm_pay {
+
+/**
+ * Runs a step over and over on a transport's timers, holding no thread
+ *
+ * A step starts its work, typically an asynchronous adapter call, and
+ * calls done with the delay before the next run once the work finishes.
+ * Runs never overlap; a run requested while one is in flight starts as
+ * soon as that one is done. Steps start on the I/O thread and must not
+ * block or throw.
+ */
+class PeriodicTask {
+public:
+    using Done = std::function<void(std::chrono::milliseconds next)>;
+    using Step = std::function<void(Done done)>;
+
+    /**
+     * Constructor; the first run starts at once
+     *
+     * @param transport The transport whose timers pace the runs
+     * @param step The work of one run; must call done exactly once
+     */
+    PeriodicTask(RpcTransport& transport, Step step);
+
+    /**
+     * Destructor; stops the task
+     */
+    ~PeriodicTask();
+
+    PeriodicTask(const PeriodicTask&) = delete;
+    PeriodicTask& operator=(const PeriodicTask&) = delete;
+
+    /**
+     * Start a run now instead of at its scheduled time
+     */
+    void run_now();
+
+    /**
+     * Stop scheduling runs and wait for the one in flight
+     *
+     * A timer already set still fires but runs nothing; it keeps only the
+     * task's small shared state alive until then.
+     */
+    void stop();
+
+private:
+    struct State;
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace svm_pay
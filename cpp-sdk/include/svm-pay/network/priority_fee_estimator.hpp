@@ -0,0 +1,138 @@
+#pragma once
+
+#include "periodic_task.hpp"
+#include "svm_adapter.hpp"
+#include "../core/public_key.hpp"
+#include "../core/quantile_sketch.hpp"
+#include "../core/transaction.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Configuration for a PriorityFeeEstimator
+ */
+struct PriorityFeeEstimatorConfig {
+    // Sample only transactions that write these accounts; empty for the whole cluster
+    std::vector<PublicKey> accounts;
+
+    // Time between refreshes
+    std::chrono::milliseconds refresh_interval{2000};
+
+    // Delay before retrying a failed refresh
+    std::chrono::milliseconds retry_delay{500};
+
+    // Most recent slots to take samples from; nodes keep up to 150
+    uint64_t window_slots = 150;
+
+    // Largest relative error of an answer
+    double relative_accuracy = 0.01;
+
+    // Answer given until the first refresh succeeds, in micro-lamports per compute unit
+    uint64_t default_fee = 0;
+};
+
+/**
+ * Keeps recent priority fees ready for transaction building
+ *
+ * Timers on the transport sample getRecentPrioritizationFees, so the
+ * estimator holds no thread of its own. The samples of the last
+ * window_slots slots go into a QuantileSketch, and a table of its
+ * percentiles is published in a sequence-locked slot, so
+ * fee_for_percentile() is lock-free and never touches the network.
+ */
+class PriorityFeeEstimator {
+public:
+    // Starts a getRecentPrioritizationFees call; reports the result or the error through on_done
+    using Fetcher = std::function<void(Completion<std::vector<PrioritizationFee>> on_done)>;
+
+    /**
+     * Constructor; samples through a network adapter
+     *
+     * @param adapter The adapter to query; must outlive the estimator
+     * @param config Sampling options
+     */
+    explicit PriorityFeeEstimator(SvmNetworkAdapter& adapter,
+                                  const PriorityFeeEstimatorConfig& config = PriorityFeeEstimatorConfig{});
+
+    /**
+     * Constructor; samples on the shared transport's timers
+     *
+     * @param fetcher Fetches recent per-slot fees; runs on the I/O thread and must not block
+     * @param config Sampling options; accounts are ignored
+     */
+    explicit PriorityFeeEstimator(Fetcher fetcher,
+                                  const PriorityFeeEstimatorConfig& config = PriorityFeeEstimatorConfig{});
+
+    ~PriorityFeeEstimator();
+
+    PriorityFeeEstimator(const PriorityFeeEstimator&) = delete;
+    PriorityFeeEstimator& operator=(const PriorityFeeEstimator&) = delete;
+
+    /**
+     * Get a percentile of the recent per-slot minimum fees
+     *
+     * Paying the 75th percentile would have been enough to land in about
+     * three quarters of the sampled slots.
+     *
+     * @param percentile The percentile in [0, 100]; clamped
+     * @return The fee in micro-lamports per compute unit, or default_fee
+     *         before the first refresh
+     */
+    uint64_t fee_for_percentile(double percentile) const;
+
+    /**
+     * Add a SetComputeUnitPrice instruction at the given percentile
+     *
+     * @param builder The builder
+     * @param percentile The percentile in [0, 100]
+     */
+    void apply(TransactionBuilder& builder, double percentile) const;
+
+    /**
+     * Get the number of samples behind the current answers
+     *
+     * @return The sample count, 0 before the first refresh
+     */
+    uint64_t sample_count() const;
+
+    /**
+     * Request an immediate refresh
+     */
+    void refresh();
+
+    /**
+     * Get the number of successful refreshes
+     *
+     * @return The refresh count
+     */
+    uint64_t refresh_count() const { return refreshes_.load(std::memory_order_relaxed); }
+
+private:
+    PriorityFeeEstimator(RpcTransport& transport, Fetcher fetcher, const PriorityFeeEstimatorConfig& config);
+
+    void run(PeriodicTask::Done done);
+    void publish(const std::vector<PrioritizationFee>& fees);
+
+    Fetcher fetcher_;
+    PriorityFeeEstimatorConfig config_;
+    QuantileSketch sketch_;  // Refreshes only; they never overlap
+
+    // Sequence lock over the published table: the sample count, then the
+    // fee at each whole percentile
+    static constexpr size_t WORDS = 102;
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> words_[WORDS];
+
+    std::atomic<uint64_t> refreshes_{0};
+
+    // Last, so a refresh in flight finishes before anything it touches goes away
+    std::optional<PeriodicTask> refresher_;
+};
+
+} // namespace svm_pay
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "../core/json.hpp"
+#include "../core/types.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace svm_pay {
+
+// Forward declaration
+class CurlInitializer;
+
+/**
+ * Configuration for a PubSubClient
+ */
+struct PubSubConfig {
+    // WebSocket endpoint of the Solana PubSub API
+    std::string url = "wss://api.mainnet-beta.solana.com";
+
+    // Number of sockets subscriptions are spread across
+    size_t connections = 2;
+
+    // Commitment level requested for every subscription
+    std::string commitment = "confirmed";
+
+    // Reconnect backoff, doubled after each failed attempt
+    std::chrono::milliseconds reconnect_delay{250};
+    std::chrono::milliseconds max_reconnect_delay{10000};
+
+    // Idle sockets are pinged at this interval so proxies keep them open
+    std::chrono::milliseconds ping_interval{20000};
+};
+
+/**
+ * Status change of a watched transaction signature
+ */
+struct SignatureUpdate {
+    std::string signature;
+    PaymentStatus status;
+    uint64_t slot = 0;
+    std::optional<std::string> error;
+};
+
+/**
+ * Change to a watched account
+ */
+struct AccountUpdate {
+    std::string address;
+    uint64_t slot = 0;
+    uint64_t lamports = 0;
+    JsonValue value;  // The full account object as sent by the node
+};
+
+/**
+ * WebSocket client for the Solana PubSub API
+ *
+ * Multiplexes any number of signatureSubscribe and accountSubscribe
+ * subscriptions over a small, fixed set of connections. Each connection is
+ * serviced by its own thread, which reconnects with backoff after a drop and
+ * re-issues every subscription assigned to it.
+ *
+ * Callbacks run on connection threads and must not block.
+ */
+class PubSubClient {
+public:
+    using SubscriptionId = uint64_t;
+    using SignatureCallback = std::function<void(const SignatureUpdate&)>;
+    using AccountCallback = std::function<void(const AccountUpdate&)>;
+
+    /**
+     * Constructor; starts the connection threads
+     *
+     * @param config Endpoint and connection options
+     * @throws NetworkException if libcurl lacks WebSocket support
+     */
+    explicit PubSubClient(const PubSubConfig& config = PubSubConfig{});
+
+    /**
+     * Destructor; closes every connection and drops pending subscriptions
+     */
+    ~PubSubClient();
+
+    PubSubClient(const PubSubClient&) = delete;
+    PubSubClient& operator=(const PubSubClient&) = delete;
+
+    /**
+     * Watch a transaction signature
+     *
+     * The subscription ends by itself after the final notification, which
+     * reports CONFIRMED or FAILED (PENDING for "processed" commitment).
+     *
+     * @param signature The transaction signature
+     * @param callback Invoked for every status change
+     * @param notify_received Also report PENDING when a node receives the transaction
+     * @return The subscription id
+     */
+    SubscriptionId subscribe_signature(const std::string& signature, SignatureCallback callback,
+                                       bool notify_received = false);
+
+    /**
+     * Watch a transaction signature through a future
+     *
+     * @param signature The transaction signature
+     * @return A future that resolves to the final payment status; it is
+     *         broken if the client is destroyed first
+     */
+    std::future<PaymentStatus> wait_for_signature(const std::string& signature);
+
+    /**
+     * Watch an account for changes
+     *
+     * @param address The account address
+     * @param callback Invoked for every change
+     * @return The subscription id
+     */
+    SubscriptionId subscribe_account(const std::string& address, AccountCallback callback);
+
+    /**
+     * Cancel a subscription; unknown or finished ids are ignored
+     *
+     * @param id The subscription id
+     */
+    void unsubscribe(SubscriptionId id);
+
+    /**
+     * Get the number of live subscriptions
+     *
+     * @return The subscription count
+     */
+    size_t subscription_count() const;
+
+    /**
+     * Get the number of currently open connections
+     *
+     * @return The connection count
+     */
+    size_t connected_count() const;
+
+private:
+    struct Subscription;
+    struct Connection;
+
+    SubscriptionId add_subscription(std::unique_ptr<Subscription> subscription);
+    std::optional<std::string> prepare_subscribe_locked(Connection& connection, SubscriptionId id,
+                                                        Subscription& subscription);
+    void run(Connection& connection);
+    bool connect(Connection& connection);
+    void disconnect(Connection& connection);
+    void resubscribe(Connection& connection);
+    void read_loop(Connection& connection);
+    void handle_message(Connection& connection, const std::string& text);
+    bool send_text(Connection& connection, const std::string& text, uint64_t generation);
+    void wait_for_stop(std::chrono::milliseconds duration);
+
+    PubSubConfig config_;
+    std::shared_ptr<CurlInitializer> curl_initializer_;
+
+    mutable std::mutex mutex_;  // Guards subscriptions and connection bookkeeping
+    std::condition_variable stop_cv_;
+    std::atomic<bool> stopping_{false};
+    std::unordered_map<SubscriptionId, std::unique_ptr<Subscription>> subscriptions_;
+    std::vector<std::unique_ptr<Connection>> connections_;
+    SubscriptionId next_id_ = 1;
+    uint64_t next_request_id_ = 1;
+};
+
+} // namespace svm_pay
@@ -0,0 +1,333 @@
+#pragma once
+
+#include "request_scheduler.hpp"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Client-side pacing and concurrency limits for one RPC endpoint
+ */
+struct RateLimitConfig {
+    // Sustained request rate; 0 disables the token bucket
+    double requests_per_second = 0.0;
+
+    // Token bucket capacity; 0 means one second worth of requests
+    double burst = 0.0;
+
+    // Adaptive concurrency limit (AIMD)
+    uint32_t initial_concurrency = 16;
+    uint32_t min_concurrency = 1;
+    uint32_t max_concurrency = 256;
+
+    // Multiplicative decrease applied when the endpoint throttles us
+    double throttle_backoff = 0.5;
+
+    // Latency above this multiple of the baseline is treated as queueing
+    double latency_tolerance = 2.0;
+
+    // Callers waiting for a permit beyond this are rejected immediately
+    size_t max_queue = 1024;
+
+    // Longest time a caller waits for a permit before being rejected
+    std::chrono::milliseconds max_queue_wait{5000};
+
+    // A caller queued this long is admitted next regardless of priority
+    std::chrono::milliseconds starvation_threshold{250};
+
+    // Pause applied after HTTP 429 without a Retry-After header
+    std::chrono::milliseconds default_retry_after{500};
+};
+
+/**
+ * Token bucket whose refill rate backs off when the server throttles
+ *
+ * Not thread-safe; RateLimiter serializes access.
+ */
+class TokenBucket {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Constructor
+     *
+     * @param rate Tokens added per second; 0 makes the bucket unlimited
+     * @param burst Bucket capacity; 0 means one second worth of tokens
+     */
+    explicit TokenBucket(double rate = 0.0, double burst = 0.0);
+
+    /**
+     * Try to take one token
+     *
+     * @param now The current time
+     * @return True if a token was taken
+     */
+    bool try_acquire(Clock::time_point now);
+
+    /**
+     * Time until the next token becomes available
+     *
+     * @param now The current time
+     * @return Zero if a token is available now
+     */
+    Clock::duration time_until_available(Clock::time_point now);
+
+    /**
+     * Halve the effective rate after the server throttled us
+     */
+    void on_throttled();
+
+    /**
+     * Recover the effective rate towards the configured rate
+     */
+    void on_success();
+
+    /**
+     * Get the current effective rate
+     *
+     * @return Tokens per second, or 0 if unlimited
+     */
+    double effective_rate() const { return effective_rate_; }
+
+private:
+    void refill(Clock::time_point now);
+
+    double rate_;
+    double effective_rate_;
+    double capacity_;
+    double tokens_;
+    Clock::time_point last_refill_;
+};
+
+/**
+ * Per-endpoint admission control
+ *
+ * Combines a token bucket with an AIMD concurrency limit that shrinks on
+ * HTTP 429 and on rising latency, and grows additively while the endpoint
+ * keeps up. Callers wait in one bounded queue, whether they block in
+ * acquire() or queued through enqueue(): the most urgent RequestPriority
+ * goes first and callers of one priority go in arrival order, except that
+ * a caller queued past the starvation threshold goes next. When the queue
+ * is full or the wait would exceed its budget they get a
+ * BackpressureException instead of piling more load onto the endpoint.
+ */
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Outcome of a request made under a permit
+     */
+    enum class Outcome {
+        SUCCESS,    // Response received; latency feeds the limit
+        THROTTLED,  // HTTP 429 / rate-limit response
+        FAILED      // Transport failure; does not affect the limit
+    };
+
+    /**
+     * RAII handle for one admitted request
+     */
+    class Permit {
+    public:
+        Permit() = default;
+        Permit(Permit&& other) noexcept;
+        Permit& operator=(Permit&& other) noexcept;
+        Permit(const Permit&) = delete;
+        Permit& operator=(const Permit&) = delete;
+
+        /**
+         * Releases the permit as FAILED unless release() was called
+         */
+        ~Permit();
+
+        /**
+         * Release the permit and report the request outcome
+         *
+         * @param outcome The outcome
+         * @param latency Request latency (used for SUCCESS)
+         */
+        void release(Outcome outcome, Clock::duration latency = Clock::duration::zero());
+
+    private:
+        friend class RateLimiter;
+        explicit Permit(RateLimiter* limiter) : limiter_(limiter) {}
+
+        RateLimiter* limiter_ = nullptr;
+    };
+
+    /**
+     * Receives the permit of a caller queued through enqueue(), or the
+     * BackpressureException acquire() would have thrown
+     */
+    using Grant = std::function<void(Permit permit, std::exception_ptr error)>;
+
+    /**
+     * A caller's place in the queue
+     */
+    struct Ticket {
+        uint64_t id = 0;                                       // 0 if admitted at once
+        Clock::time_point poll_at = Clock::time_point::max();  // When to call poll() next
+    };
+
+    /**
+     * Constructor
+     *
+     * @param config The limits to enforce
+     */
+    explicit RateLimiter(const RateLimitConfig& config = RateLimitConfig{});
+
+    /**
+     * Replace the configured limits, keeping the learned concurrency limit
+     * within the new bounds
+     *
+     * @param config The new limits
+     */
+    void configure(const RateLimitConfig& config);
+
+    /**
+     * Wait for a permit
+     *
+     * @param deadline Give up at this time even if the queue budget allows more
+     * @param priority The caller's place relative to other queued callers
+     * @return The permit
+     * @throws BackpressureException if the queue is full or the wait budget is exceeded
+     */
+    Permit acquire(Clock::time_point deadline = Clock::time_point::max(),
+                   RequestPriority priority = RequestPriority::READ);
+
+    /**
+     * Get a permit without blocking, queueing for one if none is free
+     *
+     * A queued caller is admitted in turn with those blocked in acquire().
+     * on_grant then runs once, with no lock held, on the thread whose
+     * release() or poll() admitted or expired it; it must not block. A
+     * release wakes the queue by itself, but a wait on the clock (a pause,
+     * the token bucket or the wait budget) is only noticed by the next
+     * acquire(), release() or poll(), so call poll() at ticket.poll_at.
+     *
+     * @param deadline Give up at this time even if the queue budget allows more
+     * @param permit Receives the permit if one is free now; on_grant is not called then
+     * @param on_grant Receives the permit or the error once the caller's turn comes
+     * @param priority The caller's place relative to other queued callers
+     * @return The ticket; its id is 0 if permit was filled
+     * @throws BackpressureException if the queue is full
+     */
+    Ticket enqueue(Clock::time_point deadline, Permit& permit, Grant on_grant,
+                   RequestPriority priority = RequestPriority::READ);
+
+    /**
+     * Admit queued callers that fit now and reject those out of budget
+     *
+     * @return When to call poll() next, or Clock::time_point::max() if nobody waits
+     */
+    Clock::time_point poll();
+
+    /**
+     * Leave the queue without a permit
+     *
+     * @param ticket The id of a ticket from enqueue()
+     * @return True if the caller was still queued; on_grant will not run. False if it already ran or is running.
+     */
+    bool cancel(uint64_t ticket);
+
+    /**
+     * Try to get a permit without waiting
+     *
+     * @param permit Receives the permit on success
+     * @param priority Fails while a caller of this priority or a more urgent one is queued
+     * @return True if a permit was granted
+     */
+    bool try_acquire(Permit& permit, RequestPriority priority = RequestPriority::READ);
+
+    /**
+     * Stop admitting requests for a while, e.g. after a Retry-After header
+     *
+     * @param duration How long to pause
+     */
+    void pause_for(Clock::duration duration);
+
+    /**
+     * Check whether admission is paused after the server throttled us
+     *
+     * @return True while paused
+     */
+    bool paused() const;
+
+    /**
+     * Get the current concurrency limit
+     *
+     * @return The limit
+     */
+    uint32_t concurrency_limit() const;
+
+    /**
+     * Get the number of admitted requests in flight
+     *
+     * @return The in-flight count
+     */
+    uint32_t in_flight() const;
+
+    /**
+     * Get the number of callers waiting for a permit
+     *
+     * @return The queue length
+     */
+    size_t queued() const;
+
+    /**
+     * Get the configured limits
+     *
+     * @return The configuration
+     */
+    RateLimitConfig config() const;
+
+private:
+    struct Waiter {
+        uint64_t id = 0;
+        Clock::time_point queued_at;
+        Clock::time_point give_up;
+        Grant on_grant;  // Empty for a caller blocked in acquire()
+        std::condition_variable resolved;
+        bool done = false;
+        std::exception_ptr error;
+    };
+
+    // A decision for a queued caller, delivered once the lock is released
+    struct Handoff {
+        Grant on_grant;
+        std::exception_ptr error;
+    };
+
+    using Queue = std::list<std::shared_ptr<Waiter>>;  // Oldest first
+
+    bool try_admit_locked(Clock::time_point now, Clock::duration& retry_in);
+    bool must_queue_locked(RequestPriority priority, Clock::time_point now) const;
+    Queue* next_queue_locked(Clock::time_point now);
+    void push_locked(const std::shared_ptr<Waiter>& waiter, RequestPriority priority);
+    Clock::time_point dispatch_locked(Clock::time_point now, std::vector<Handoff>& handoffs);
+    void resolve_locked(Waiter& waiter, std::exception_ptr error, std::vector<Handoff>& handoffs);
+    void hand_off(std::vector<Handoff>& handoffs);
+    void release(Outcome outcome, Clock::duration latency);
+
+    mutable std::mutex mutex_;
+    RateLimitConfig config_;
+    TokenBucket bucket_;
+    double limit_;
+    uint32_t in_flight_ = 0;
+    std::array<Queue, REQUEST_PRIORITY_COUNT> queues_;  // Indexed by RequestPriority
+    size_t queued_ = 0;
+    uint64_t next_ticket_ = 1;
+    double baseline_latency_us_ = 0.0;
+    Clock::time_point paused_until_{};
+};
+
+} // namespace svm_pay
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+
+namespace svm_pay {
+
+/**
+ * Scheduling class of an RPC request, most urgent first
+ */
+enum class RequestPriority {
+    SUBMIT,    // sendTransaction; latency-critical
+    CONFIRM,   // Signature status polling
+    READ,      // Everything else
+    BACKFILL   // History scans and other bulk reads
+};
+
+constexpr size_t REQUEST_PRIORITY_COUNT = 4;
+
+/**
+ * Get the scheduling class an RPC method gets when the caller sets none
+ *
+ * @param method The RPC method name
+ * @return The priority
+ */
+RequestPriority default_rpc_priority(const std::string& method);
+
+/**
+ * Share and limit of one priority class
+ */
+struct PriorityClassConfig {
+    // Relative share of dispatches while several classes are waiting
+    double weight = 1.0;
+
+    // Requests of this class in flight at once; 0 means only the global limit applies
+    size_t max_in_flight = 0;
+};
+
+/**
+ * Configuration for a RequestScheduler
+ */
+struct RequestSchedulerConfig {
+    // Requests in flight at once across all classes; 0 disables queueing
+    size_t max_in_flight = 64;
+
+    // Extra slots only submissions may use, so a scheduler saturated by
+    // polling still sends a transaction at once
+    size_t submit_headroom = 8;
+
+    // Indexed by RequestPriority
+    std::array<PriorityClassConfig, REQUEST_PRIORITY_COUNT> classes{{
+        {8.0, 0},
+        {4.0, 0},
+        {2.0, 0},
+        {1.0, 16},
+    }};
+
+    // A request queued this long is dispatched next regardless of weights
+    std::chrono::milliseconds starvation_threshold{250};
+};
+
+/**
+ * Queueing statistics of one priority class
+ */
+struct PriorityClassMetrics {
+    uint64_t dispatched = 0;  // Requests that left the queue
+    uint64_t queued = 0;      // Requests waiting now
+    uint64_t in_flight = 0;   // Requests dispatched and not yet finished
+    uint64_t starved = 0;     // Dispatches forced by the starvation threshold
+    std::chrono::microseconds total_wait{0};
+    std::chrono::microseconds max_wait{0};
+    std::chrono::microseconds p50_wait{0};  // Upper bound of the histogram bucket
+    std::chrono::microseconds p99_wait{0};
+};
+
+/**
+ * Decides which queued request is sent next
+ *
+ * Classes share dispatches by weight through stride scheduling, a form of
+ * weighted fair queuing: each class advances a virtual pass by 1/weight per
+ * dispatch and the lowest pass goes next. A class returning from idle
+ * starts at the current pass, so it cannot bank credit. Requests older than
+ * the starvation threshold jump the order, and per-class and global caps
+ * bound what is in flight.
+ *
+ * Not thread-safe apart from metrics(); the transport drives it from its
+ * I/O thread.
+ */
+class RequestScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Constructor
+     *
+     * @param config Weights and limits
+     */
+    explicit RequestScheduler(const RequestSchedulerConfig& config = RequestSchedulerConfig{});
+
+    /**
+     * Queue a request
+     *
+     * @param priority The request's class
+     * @param now The current time
+     * @return A ticket identifying the request
+     */
+    uint64_t enqueue(RequestPriority priority, Clock::time_point now);
+
+    /**
+     * Take the next request that may be sent now
+     *
+     * The request counts as in flight until finish() is called for it.
+     *
+     * @param now The current time
+     * @return Its ticket, or nothing if every queue is empty or capped
+     */
+    std::optional<uint64_t> next(Clock::time_point now);
+
+    /**
+     * Remove a request that gave up while queued
+     *
+     * @param ticket The request's ticket
+     * @return False if the ticket is not queued
+     */
+    bool cancel(uint64_t ticket);
+
+    /**
+     * Record that a dispatched request finished, freeing its slot
+     *
+     * @param priority The request's class
+     */
+    void finish(RequestPriority priority);
+
+    /**
+     * Check whether any request is waiting
+     *
+     * @return True if a queue is non-empty
+     */
+    bool has_queued() const;
+
+    /**
+     * Get queueing statistics for one class; safe from any thread
+     *
+     * @param priority The class
+     * @return The metrics
+     */
+    PriorityClassMetrics metrics(RequestPriority priority) const;
+
+private:
+    static constexpr size_t WAIT_BUCKETS = 32;  // log2 microseconds
+
+    struct Waiting {
+        uint64_t ticket;
+        Clock::time_point enqueued_at;
+    };
+
+    struct Class {
+        std::deque<Waiting> queue;
+        double stride = 1.0;
+        double pass = 0.0;
+        size_t in_flight = 0;
+
+        std::atomic<uint64_t> dispatched{0};
+        std::atomic<uint64_t> queued{0};
+        std::atomic<uint64_t> in_flight_count{0};
+        std::atomic<uint64_t> starved{0};
+        std::atomic<uint64_t> total_wait_us{0};
+        std::atomic<uint64_t> max_wait_us{0};
+        std::array<std::atomic<uint64_t>, WAIT_BUCKETS> wait_histogram{};
+    };
+
+    bool may_dispatch(size_t index) const;
+    uint64_t dispatch(size_t index, Clock::time_point now, bool starved);
+
+    RequestSchedulerConfig config_;
+    std::array<Class, REQUEST_PRIORITY_COUNT> classes_;
+    size_t in_flight_ = 0;
+    double current_pass_ = 0.0;
+    uint64_t next_ticket_ = 1;
+};
+
+} // namespace svm_pay
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+
+namespace svm_pay {
+
+/**
+ * Retry behaviour for RPC calls
+ *
+ * Delays use decorrelated jitter: each delay is drawn uniformly from
+ * [base_delay, 3 * previous delay] and capped at max_delay. All attempts of
+ * one call, including the delays between them, share total_budget.
+ */
+struct RetryPolicy {
+    // Attempts for idempotent reads, including the first one
+    uint32_t max_attempts = 3;
+
+    // Attempts for state-changing calls such as sendTransaction. These are
+    // only retried when the request provably never reached a node.
+    uint32_t max_send_attempts = 3;
+
+    std::chrono::milliseconds base_delay{50};
+    std::chrono::milliseconds max_delay{2000};
+    std::chrono::milliseconds total_budget{10000};
+
+    /**
+     * Compute the delay before the next attempt
+     *
+     * @param previous The previous delay (zero before the first retry)
+     * @return The next delay
+     */
+    std::chrono::milliseconds next_delay(std::chrono::milliseconds previous) const;
+};
+
+/**
+ * Check whether an RPC method only reads state and may safely be sent twice
+ *
+ * @param method The JSON-RPC method name
+ * @return True for reads such as getSignatureStatuses or getAccountInfo
+ */
+bool is_idempotent_rpc_method(const std::string& method);
+
+/**
+ * Decide whether a failed attempt may be retried
+ *
+ * Requests that never reached a node (connection failures, HTTP 429, open
+ * circuit) are always retryable. Other network failures are ambiguous and
+ * only retried for idempotent methods. Client-side load shedding and
+ * non-network errors are never retried.
+ *
+ * @param error The failure
+ * @param idempotent Whether the call is an idempotent read
+ * @return True if another attempt may be made
+ */
+bool is_retryable_failure(const std::exception_ptr& error, bool idempotent);
+
+/**
+ * Circuit breaker configuration
+ */
+struct CircuitBreakerConfig {
+    // Consecutive failures that open the circuit; 0 disables the breaker
+    uint32_t failure_threshold = 5;
+
+    // How long the circuit stays open before a probe request is allowed
+    std::chrono::milliseconds open_duration{5000};
+};
+
+/**
+ * Per-endpoint circuit breaker
+ *
+ * Opens after a run of consecutive failures and fails requests fast while
+ * open. After open_duration a single probe is let through (half-open); its
+ * success closes the circuit, its failure re-opens it.
+ */
+class CircuitBreaker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class State {
+        CLOSED,
+        OPEN,
+        HALF_OPEN
+    };
+
+    /**
+     * Constructor
+     *
+     * @param config The breaker configuration
+     */
+    explicit CircuitBreaker(const CircuitBreakerConfig& config = CircuitBreakerConfig{});
+
+    /**
+     * Replace the configuration, keeping the current state
+     *
+     * @param config The new configuration
+     */
+    void configure(const CircuitBreakerConfig& config);
+
+    /**
+     * Check whether a request may be sent
+     *
+     * In the half-open state only one caller is admitted as the probe.
+     *
+     * @return True if the request may proceed
+     */
+    bool allow_request();
+
+    /**
+     * Check, without claiming the probe slot, whether requests would be rejected
+     *
+     * @return True while the circuit is open and the probe delay has not passed
+     */
+    bool is_open() const;
+
+    /**
+     * Record a successful request
+     */
+    void record_success();
+
+    /**
+     * Record a failed request
+     */
+    void record_failure();
+
+    /**
+     * Give back the probe slot of a request that ended without an answer,
+     * leaving the state as it is
+     */
+    void release_probe();
+
+    /**
+     * Get the current state
+     *
+     * @return The state
+     */
+    State state() const;
+
+private:
+    mutable std::mutex mutex_;
+    CircuitBreakerConfig config_;
+    State state_ = State::CLOSED;
+    uint32_t consecutive_failures_ = 0;
+    bool probe_in_flight_ = false;
+    Clock::time_point opened_at_{};
+};
+
+} // namespace svm_pay
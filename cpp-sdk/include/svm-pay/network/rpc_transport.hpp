@@ -0,0 +1,222 @@
+#pragma once
+
+#include "../core/types.hpp"
+#include "request_scheduler.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace svm_pay {
+
+// Forward declarations
+class CurlInitializer;
+
+/**
+ * A single HTTP exchange carried by the transport
+ */
+struct HttpRequest {
+    std::string url;
+    const std::string* body = nullptr;       // POSTed as JSON when set, otherwise a GET
+    SVMNetwork network = SVMNetwork::SOLANA;  // Which network's metrics the request counts towards
+    std::chrono::steady_clock::time_point deadline;
+    std::chrono::milliseconds connect_timeout{5000};
+    std::function<bool()> should_abort;      // Polled while the transfer waits or runs
+    RequestPriority priority = RequestPriority::READ;
+};
+
+/**
+ * Raw HTTP response as seen by the transport
+ */
+struct HttpResponse {
+    long status = 0;
+    std::string body;
+    std::optional<std::chrono::seconds> retry_after;
+};
+
+/**
+ * Receives the outcome of an asynchronous transfer: the response, or the
+ * exception perform() would have thrown
+ */
+using HttpCallback = std::function<void(HttpResponse response, std::exception_ptr error)>;
+
+/**
+ * Configuration for the shared HTTP transport
+ */
+struct RpcTransportConfig {
+    // Connection limits across all networks; 0 means unlimited
+    long max_connections_per_host = 0;
+    long max_total_connections = 0;
+
+    // Idle connections kept open for reuse
+    long max_idle_connections = 64;
+
+    // How often in-flight transfers are checked for cancellation
+    std::chrono::milliseconds abort_poll_interval{10};
+
+    // Orders transfers by priority once max_in_flight are running
+    RequestSchedulerConfig scheduler;
+};
+
+/**
+ * Counters for the requests one network (or all of them) sent through the transport
+ */
+struct TransportMetrics {
+    uint64_t requests = 0;            // Transfers started
+    uint64_t failures = 0;            // Transfers that ended without an HTTP response
+    uint64_t in_flight = 0;           // Transfers currently running
+    uint64_t connections_opened = 0;  // New connections; every other transfer reused a pooled one
+    uint64_t bytes_sent = 0;
+    uint64_t bytes_received = 0;
+    std::chrono::microseconds total_time{0};  // Summed transfer time, for averaging
+};
+
+/**
+ * HTTP engine shared by every network adapter
+ *
+ * One I/O thread drives all transfers through a single libcurl multi
+ * handle, so adapters for different networks share its connection pool,
+ * DNS cache and TLS sessions, and adding a network adds no threads. The
+ * I/O thread starts with the first request, or with warm_up().
+ *
+ * Past the scheduler's in-flight limit, transfers wait in per-priority
+ * queues, so a submission never sits behind a backlog of polling.
+ */
+class RpcTransport {
+public:
+    /**
+     * Get the process-wide transport the adapters use by default
+     *
+     * @return The shared transport
+     */
+    static std::shared_ptr<RpcTransport> shared();
+
+    /**
+     * Constructor
+     *
+     * @param config Connection pool settings
+     */
+    explicit RpcTransport(const RpcTransportConfig& config = RpcTransportConfig{});
+
+    /**
+     * Destructor; fails transfers still in flight with NetworkException
+     */
+    ~RpcTransport();
+
+    RpcTransport(const RpcTransport&) = delete;
+    RpcTransport& operator=(const RpcTransport&) = delete;
+
+    /**
+     * Perform a request and wait for its response
+     *
+     * @param request The request
+     * @return The response; HTTP error statuses are returned, not thrown
+     * @throws TimeoutException if the deadline passes first
+     * @throws ConnectionException if no connection could be made, so nothing was sent
+     * @throws OperationCancelledException if should_abort returned true
+     * @throws NetworkException on any other transfer failure
+     */
+    HttpResponse perform(const HttpRequest& request);
+    
+    /**
+     * Start a request and return at once
+     *
+     * on_done runs exactly once, on the I/O thread, or on the calling thread
+     * if the request fails before it is queued. It must not block: every
+     * other transfer waits while it runs.
+     *
+     * @param request The request; copied, but request.body must stay valid until on_done runs
+     * @param on_done Receives the response or the error
+     */
+    void perform_async(const HttpRequest& request, HttpCallback on_done);
+    
+    /**
+     * Run a task on the I/O thread at a given time
+     *
+     * Used to pace retries without holding a thread. The task must not block.
+     *
+     * @param when When to run the task
+     * @param task Called with false when due, or with true if the transport shuts down first
+     */
+    void schedule(std::chrono::steady_clock::time_point when, std::function<void(bool cancelled)> task);
+    
+    /**
+     * Start the I/O thread ahead of the first request
+     */
+    void warm_up();
+
+    /**
+     * Get counters summed over all networks
+     *
+     * @return The metrics
+     */
+    TransportMetrics metrics() const;
+
+    /**
+     * Get counters for one network
+     *
+     * @param network The network
+     * @return The metrics
+     */
+    TransportMetrics metrics(SVMNetwork network) const;
+
+    /**
+     * Get queueing statistics for one priority class
+     *
+     * @param priority The class
+     * @return The metrics
+     */
+    PriorityClassMetrics queue_metrics(RequestPriority priority) const;
+
+private:
+    struct Transfer;
+
+    struct Counters {
+        std::atomic<uint64_t> requests{0};
+        std::atomic<uint64_t> failures{0};
+        std::atomic<uint64_t> in_flight{0};
+        std::atomic<uint64_t> connections_opened{0};
+        std::atomic<uint64_t> bytes_sent{0};
+        std::atomic<uint64_t> bytes_received{0};
+        std::atomic<uint64_t> total_time_us{0};
+    };
+
+    void start();
+    void run();
+    void prepare(Transfer& transfer);
+    void submit(Transfer& transfer);
+    HttpResponse complete(Transfer& transfer);
+    void signal(Transfer& transfer);
+    void finish(Transfer& transfer, int result);
+    void* acquire_handle();
+    void release_handle(void* handle);
+
+    RpcTransportConfig config_;
+    std::shared_ptr<CurlInitializer> curl_initializer_;
+    void* multi_ = nullptr;  // CURLM*, owned by the I/O thread once started
+    void* share_ = nullptr;  // CURLSH* holding the DNS and TLS session caches
+    std::array<std::mutex, 8> share_locks_;  // One per curl_lock_data kind
+
+    std::mutex mutex_;
+    std::vector<Transfer*> queued_;
+    std::vector<void*> idle_handles_;  // Reset easy handles kept for reuse
+    std::multimap<std::chrono::steady_clock::time_point, std::function<void(bool)>> timers_;
+    bool stopping_ = false;
+
+    std::array<Counters, SVM_NETWORK_COUNT> counters_;
+    RequestScheduler scheduler_;  // Driven by the I/O thread
+
+    std::once_flag start_once_;
+    std::thread io_thread_;
+};
+
+} // namespace svm_pay
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "periodic_task.hpp"
+#include "svm_adapter.hpp"
+#include "../core/public_key.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * Configuration for a SignatureScanner
+ */
+struct SignatureScannerConfig {
+    // File the cursors persist to; empty to keep them in memory only
+    std::string path;
+
+    // Signatures asked for per getSignaturesForAddress call
+    size_t page_size = SvmNetworkAdapter::MAX_SIGNATURES_FOR_ADDRESS;
+
+    // Most pages in flight across all addresses; each endpoint's rate
+    // limiter paces them further
+    size_t max_concurrent_pages = 8;
+
+    // Pause between background scans; 0 scans only when scan() is called
+    std::chrono::milliseconds interval{2000};
+
+    // Deadline of each page request
+    std::chrono::milliseconds request_timeout{10000};
+};
+
+/**
+ * Receives a signature new to a watched address; runs on the transport's
+ * I/O thread and must not block
+ */
+using SignatureCallback = std::function<void(const PublicKey& address, const SignatureInfo& signature)>;
+
+/**
+ * Finds the transactions that touch watched addresses, such as payment
+ * references, without rescanning their history
+ *
+ * Each address keeps an until cursor, the newest signature already
+ * reported. A scan pages getSignaturesForAddress from the newest signature
+ * down to that cursor and reports what it finds, newest first. While a scan
+ * is partway down a long history a before cursor marks its place. Pages for
+ * different addresses go out concurrently; pages of one address follow one
+ * another. Background scans run on timers of the adapter's transport, and
+ * pages are handled as they arrive, so the scanner holds no thread of its
+ * own. Cursors are written to a file after every scan and read back at
+ * startup, so a restarted process resumes where the last one stopped. A
+ * signature is reported at least once: one found after the last write may
+ * be reported again after a crash. Thread-safe.
+ */
+class SignatureScanner {
+public:
+    /**
+     * Constructor
+     *
+     * @param adapter The adapter to page through; must outlive the scanner
+     * @param on_signature Receives each new signature
+     * @param config Scanner options
+     * @throws SVMPayException if the file cannot be read or is not a cursor file
+     */
+    SignatureScanner(SvmNetworkAdapter& adapter, SignatureCallback on_signature,
+                     const SignatureScannerConfig& config = SignatureScannerConfig{});
+
+    /**
+     * Destructor; finishes the scan in progress and writes the cursors back
+     */
+    ~SignatureScanner();
+
+    SignatureScanner(const SignatureScanner&) = delete;
+    SignatureScanner& operator=(const SignatureScanner&) = delete;
+
+    /**
+     * Start watching an address; watching it again changes nothing
+     *
+     * @param address The address
+     * @param until Report only signatures newer than this one; empty for the whole history
+     */
+    void watch(const PublicKey& address, const std::string& until = std::string());
+
+    /**
+     * Stop watching an address and forget its cursors
+     *
+     * @param address The address
+     */
+    void unwatch(const PublicKey& address);
+
+    /**
+     * Check whether an address is watched
+     *
+     * @param address The address
+     * @return True if it is
+     */
+    bool is_watched(const PublicKey& address) const;
+
+    /**
+     * Get the number of watched addresses
+     *
+     * @return The address count
+     */
+    size_t size() const;
+
+    /**
+     * Bring every watched address up to date, waiting for a background scan
+     * in progress first
+     *
+     * An address whose page fails keeps its cursors and is retried on the
+     * next scan. If the callback throws, the scan stops after the pages in
+     * flight and the exception propagates; the page it was handling is
+     * reported again next time.
+     *
+     * @return The number of signatures reported
+     */
+    size_t scan();
+
+    /**
+     * Write the cursors back to disk
+     */
+    void sync();
+
+    /**
+     * Get the number of pages asked of the node
+     *
+     * @return The page count
+     */
+    uint64_t page_count() const;
+
+    /**
+     * Get the number of pages that failed
+     *
+     * @return The failure count
+     */
+    uint64_t failure_count() const;
+
+private:
+    struct Cursor {
+        std::string until;        // Newest signature reported
+        std::string before;       // Oldest signature of the scan in progress
+        std::string scan_newest;  // Newest signature of the scan in progress; until once it finishes
+    };
+
+    struct Pass;
+
+    void start_pass(Completion<size_t> on_done);
+    void run(PeriodicTask::Done done);
+    void load();
+
+    SvmNetworkAdapter& adapter_;
+    SignatureCallback on_signature_;
+    SignatureScannerConfig config_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<PublicKey, Cursor, PublicKeyHash> cursors_;
+    bool dirty_ = false;
+    uint64_t pages_ = 0;
+    uint64_t failures_ = 0;
+
+    // One scan at a time; idle_ is signalled when it finishes
+    bool scanning_ = false;
+    std::condition_variable idle_;
+
+    // Last, so a background scan in flight finishes before anything it touches goes away
+    std::optional<PeriodicTask> scanner_;
+};
+
+} // namespace svm_pay
@@ -1,18 +1,14 @@
 #pragma once
 
-#include "adapter.hpp"
+#include "svm_adapter.hpp"
 #include <string>
-#include <memory>
 
 namespace svm_pay {
 
-// Forward declaration
-class CurlInitializer;
-
 /**
  * Solana network adapter implementation
  */
-class SolanaNetworkAdapter : public NetworkAdapter {
+class SolanaNetworkAdapter : public SvmNetworkAdapter {
 public:
     /**
      * Constructor
@@ -22,73 +18,11 @@ public:
     explicit SolanaNetworkAdapter(const std::string& rpc_url = "https://api.mainnet-beta.solana.com");
     
     /**
-     * Create a transaction from a transfer request
-     * 
-     * @param request The transfer request to create a transaction for
-     * @return A future that resolves to the transaction string
-     */
-    std::future<std::string> create_transfer_transaction(const TransferRequest& request) override;
-    
-    /**
-     * Fetch a transaction from a transaction request
-     * 
-     * @param request The transaction request to fetch a transaction for
-     * @return A future that resolves to the transaction string
-     */
-    std::future<std::string> fetch_transaction(const TransactionRequest& request) override;
-    
-    /**
-     * Submit a signed transaction to the network
-     * 
-     * @param transaction The transaction to submit
-     * @param signature The signature for the transaction
-     * @return A future that resolves to the transaction signature
-     */
-    std::future<std::string> submit_transaction(const std::string& transaction, 
-                                               const std::string& signature) override;
-    
-    /**
-     * Check the status of a transaction
-     * 
-     * @param signature The signature of the transaction to check
-     * @return A future that resolves to the payment status
-     */
-    std::future<PaymentStatus> check_transaction_status(const std::string& signature) override;
-    
-    /**
-     * Set the RPC URL
-     * 
-     * @param rpc_url The new RPC URL
-     */
-    void set_rpc_url(const std::string& rpc_url);
-    
-    /**
-     * Get the current RPC URL
-     * 
-     * @return The current RPC URL
-     */
-    const std::string& get_rpc_url() const;
-
-private:
-    std::string rpc_url_;
-    std::shared_ptr<CurlInitializer> curl_initializer_;  // RAII curl management
-    
-    /**
-     * Make an RPC call to the Solana network
-     * 
-     * @param method The RPC method name
-     * @param params The RPC parameters as JSON string
-     * @return The RPC response as JSON string
-     */
-    std::future<std::string> make_rpc_call(const std::string& method, const std::string& params);
-    
-    /**
-     * Validate a Solana address
+     * Constructor
      * 
-     * @param address The address to validate
-     * @return True if valid, false otherwise
+     * @param endpoints The set of interchangeable RPC endpoints and routing options
      */
-    bool validate_address(const std::string& address) const;
+    explicit SolanaNetworkAdapter(const EndpointPoolConfig& endpoints);
 };
 
-} // namespace svm_pay
\ No newline at end of file
+} // namespace svm_pay
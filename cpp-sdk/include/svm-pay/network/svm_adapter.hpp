@@ -0,0 +1,548 @@
+#pragma once
+
+#include "adapter.hpp"
+#include "endpoint_pool.hpp"
+#include "rpc_transport.hpp"
+#include "../core/public_key.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace svm_pay {
+
+// Forward declarations
+class BlockhashCache;
+class MintCache;
+class PriorityFeeEstimator;
+
+/**
+ * Status of a transaction signature as reported by getSignatureStatuses
+ */
+struct SignatureStatus {
+    uint64_t slot = 0;
+    std::optional<uint64_t> confirmations;     // Unset once the block is rooted
+    std::optional<std::string> err;            // Transaction error as JSON, unset on success
+    std::string confirmation_status;           // "processed", "confirmed" or "finalized"
+};
+
+/**
+ * Recent blockhash as reported by getLatestBlockhash
+ */
+struct LatestBlockhash {
+    std::string blockhash;
+    uint64_t last_valid_block_height = 0;  // Transactions using the hash expire after this height
+    uint64_t slot = 0;                     // Slot the node answered at
+};
+
+/**
+ * Account as returned by getAccountInfo and getMultipleAccounts
+ */
+struct AccountInfo {
+    uint64_t lamports = 0;
+    PublicKey owner;            // Program that owns the account
+    std::vector<uint8_t> data;  // Decoded account data
+    bool executable = false;
+    uint64_t slot = 0;          // Slot the node answered at
+};
+
+/**
+ * State of an initialized System program nonce account
+ */
+struct NonceAccount {
+    PublicKey address;
+    PublicKey authority;                  // Signs AdvanceNonceAccount
+    Blockhash nonce;                      // Used in place of a recent blockhash
+    uint64_t lamports_per_signature = 0;  // Fee rate recorded with the nonce
+};
+
+/**
+ * Lowest priority fee paid by a transaction in one recent slot, as reported
+ * by getRecentPrioritizationFees
+ */
+struct PrioritizationFee {
+    uint64_t slot = 0;
+    uint64_t fee = 0;  // Micro-lamports per compute unit
+};
+
+/**
+ * A transaction that touched an address, as reported by getSignaturesForAddress
+ */
+struct SignatureInfo {
+    std::string signature;
+    uint64_t slot = 0;
+    std::optional<std::string> err;         // Transaction error as JSON, unset on success
+    std::optional<std::string> memo;        // Memo program text, if the transaction had one
+    std::optional<int64_t> block_time;      // Unix seconds, unset when the node does not know
+    std::string confirmation_status;        // "processed", "confirmed" or "finalized"
+};
+
+/**
+ * Window of an address's history for getSignaturesForAddress, which pages
+ * from newest to oldest
+ */
+struct SignatureQuery {
+    // Start below this signature; empty for the newest
+    std::string before;
+
+    // Stop above this signature, which is not returned; empty to go back to the oldest
+    std::string until;
+
+    // Most signatures per page; at most MAX_SIGNATURES_FOR_ADDRESS
+    size_t limit = 1000;
+};
+
+/**
+ * Decode a nonce account from its raw state
+ *
+ * @param address The account's address
+ * @param account The account as loaded
+ * @return The nonce state
+ * @throws TransactionException if it is not an initialized nonce account
+ */
+NonceAccount decode_nonce_account(const PublicKey& address, const AccountInfo& account);
+
+/**
+ * Node-side options for sendTransaction
+ */
+struct SendOptions {
+    // Forward without simulating first; a doomed transaction is then only
+    // noticed through its status
+    bool skip_preflight = false;
+
+    // How often the node itself re-forwards the transaction; unset uses the
+    // node's default. Set 0 when the caller rebroadcasts.
+    std::optional<uint32_t> max_retries;
+};
+
+/**
+ * JSON-RPC adapter for any SVM network
+ * 
+ * Solana, Sonic, Eclipse and s00n expose the same JSON-RPC API, so one
+ * adapter serves them all, parameterized by network and endpoints. Every
+ * adapter sends its requests through a shared RpcTransport, so adapters for
+ * different networks share one I/O thread, connection pool and metrics.
+ */
+class SvmNetworkAdapter : public NetworkAdapter {
+public:
+    /**
+     * Constructor
+     * 
+     * @param network The network this adapter serves
+     * @param endpoints The set of interchangeable RPC endpoints and routing options
+     * @param transport The HTTP engine to send requests through
+     */
+    SvmNetworkAdapter(SVMNetwork network, const EndpointPoolConfig& endpoints,
+                      std::shared_ptr<RpcTransport> transport = RpcTransport::shared());
+    
+    /**
+     * Constructor using the network's default public RPC endpoint
+     * 
+     * @param network The network this adapter serves
+     */
+    explicit SvmNetworkAdapter(SVMNetwork network);
+    
+    /**
+     * Get the public mainnet RPC URL of a network
+     * 
+     * @param network The network
+     * @return The default RPC URL
+     */
+    static std::string default_rpc_url(SVMNetwork network);
+    
+    ~SvmNetworkAdapter() override;
+    
+    /**
+     * Create an unsigned transaction from a transfer request
+     * 
+     * The request's account pays the fee and funds the transfer; the memo
+     * becomes a Memo program instruction ahead of the transfer and the
+     * references are attached to the transfer as read-only accounts. An SPL
+     * token transfer moves tokens between the associated token accounts of
+     * the payer and the recipient, which must already exist.
+     * 
+     * @param request The transfer request to create a transaction for
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to the base64 wire-format transaction
+     * @throws TransactionException if the request has no account or its token is not a mint
+     */
+    std::future<std::string> create_transfer_transaction(const TransferRequest& request,
+                                                        const CallOptions& options = CallOptions{}) override;
+    
+    /**
+     * Fetch a transaction from a transaction request
+     * 
+     * @param request The transaction request to fetch a transaction for
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to the transaction string
+     */
+    std::future<std::string> fetch_transaction(const TransactionRequest& request,
+                                              const CallOptions& options = CallOptions{}) override;
+    
+    /**
+     * Submit a signed transaction to the network
+     * 
+     * The transaction is validated locally before it is sent.
+     * 
+     * @param transaction The base64 wire-format transaction to submit
+     * @param signature The signature for the transaction
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to the transaction signature
+     * @throws TransactionException if the transaction is not strict base64 or exceeds the size limit
+     */
+    std::future<std::string> submit_transaction(const std::string& transaction, 
+                                               const std::string& signature,
+                                               const CallOptions& options = CallOptions{}) override;
+    
+    /**
+     * Submit a signed wire-format transaction, encoding it straight into the request
+     * 
+     * @param transaction The serialized transaction; may be reused once this returns
+     * @param size The size of the transaction
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to the transaction signature
+     * @throws TransactionException if the transaction exceeds the size limit
+     */
+    std::future<std::string> submit_transaction(const uint8_t* transaction, size_t size,
+                                               const CallOptions& options = CallOptions{});
+    
+    /**
+     * Check the status of a transaction
+     * 
+     * @param signature The signature of the transaction to check
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to the payment status
+     */
+    std::future<PaymentStatus> check_transaction_status(const std::string& signature,
+                                                       const CallOptions& options = CallOptions{}) override;
+    
+    /**
+     * Submit a signed transaction without holding a thread
+     * 
+     * The request completes on the transport's I/O thread, and admission
+     * waits and retry delays are timers there, so any number of calls can
+     * be outstanding at once. Reads are not hedged on this path.
+     * 
+     * @param transaction The base64 wire-format transaction to submit
+     * @param signature The signature for the transaction
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the signature or the error; runs on the I/O thread and must not block
+     */
+    void submit_transaction_async(const std::string& transaction, const std::string& signature,
+                                  const CallOptions& options, Completion<std::string> on_done) override;
+    
+    /**
+     * Submit a signed transaction with sendTransaction options, without holding a thread
+     * 
+     * @param transaction The base64 wire-format transaction to submit
+     * @param send Preflight and node-side retry options
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the signature or the error; runs on the I/O thread and must not block
+     */
+    void send_transaction_async(const std::string& transaction, const SendOptions& send, const CallOptions& options,
+                                Completion<std::string> on_done);
+    
+    /**
+     * Check the status of a transaction without holding a thread
+     * 
+     * @param signature The signature of the transaction to check
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the payment status or the error; runs on the I/O thread and must not block
+     */
+    void check_transaction_status_async(const std::string& signature, const CallOptions& options,
+                                        Completion<PaymentStatus> on_done) override;
+    
+    /**
+     * Fetch a recent blockhash without holding a thread
+     * 
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the blockhash or the error; runs on the I/O thread and must not block
+     */
+    void get_latest_blockhash_async(const CallOptions& options, Completion<LatestBlockhash> on_done);
+    
+    /**
+     * Fetch the current block height without holding a thread
+     * 
+     * Read at "confirmed" commitment, like get_latest_blockhash, so it
+     * compares directly with a blockhash's last valid block height.
+     * 
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the block height or the error; runs on the I/O thread and must not block
+     */
+    void get_block_height_async(const CallOptions& options, Completion<uint64_t> on_done);
+    
+    /**
+     * Look up the status of many signatures at once
+     * 
+     * Lists longer than the node's per-call limit are split into concurrent
+     * requests of MAX_SIGNATURE_STATUS_BATCH signatures.
+     * 
+     * @param signatures The transaction signatures
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to one entry per signature, unset when the node does not know it
+     */
+    std::future<std::vector<std::optional<SignatureStatus>>> get_signature_statuses(
+        const std::vector<std::string>& signatures, const CallOptions& options = CallOptions{});
+    
+    /**
+     * Look up the status of many signatures without holding a thread
+     * 
+     * @param signatures The transaction signatures
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives one entry per signature or the error; runs on the I/O thread and must not block
+     */
+    void get_signature_statuses_async(const std::vector<std::string>& signatures, const CallOptions& options,
+                                      Completion<std::vector<std::optional<SignatureStatus>>> on_done);
+    
+    /**
+     * Fetch a recent blockhash to build transactions against
+     * 
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to the blockhash and its expiry height
+     */
+    std::future<LatestBlockhash> get_latest_blockhash(const CallOptions& options = CallOptions{});
+    
+    /**
+     * Read a durable nonce account
+     * 
+     * @param address The nonce account
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to the account's authority and current nonce
+     * @throws TransactionException (through the future) if the account does not exist or is not an initialized nonce account
+     */
+    std::future<NonceAccount> get_nonce_account(const PublicKey& address, const CallOptions& options = CallOptions{});
+    
+    /**
+     * Read a durable nonce account without holding a thread
+     * 
+     * @param address The nonce account
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the account or the error; runs on the I/O thread and must not block
+     */
+    void get_nonce_account_async(const PublicKey& address, const CallOptions& options,
+                                 Completion<NonceAccount> on_done);
+    
+    /**
+     * Load many accounts at once
+     * 
+     * Lists longer than MAX_MULTIPLE_ACCOUNTS keys are split into
+     * concurrent getMultipleAccounts calls.
+     * 
+     * @param keys The account addresses
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to one entry per key, unset when the account does not exist
+     */
+    std::future<std::vector<std::optional<AccountInfo>>> get_multiple_accounts(
+        const std::vector<PublicKey>& keys, const CallOptions& options = CallOptions{});
+    
+    /**
+     * Load up to MAX_MULTIPLE_ACCOUNTS accounts in one call without holding a thread
+     * 
+     * @param keys The account addresses
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives one entry per key or the error; runs on the I/O thread and must not block
+     * @throws std::invalid_argument if there are more than MAX_MULTIPLE_ACCOUNTS keys
+     */
+    void get_multiple_accounts_async(const std::vector<PublicKey>& keys, const CallOptions& options,
+                                     Completion<std::vector<std::optional<AccountInfo>>> on_done);
+    
+    /**
+     * Fetch one page of the transactions that touched an address, newest first
+     * 
+     * @param address The address, e.g. a payment reference
+     * @param query Where the page starts and stops
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to the page; shorter than the limit once the history is exhausted
+     * @throws std::invalid_argument if the limit is 0 or above MAX_SIGNATURES_FOR_ADDRESS
+     */
+    std::future<std::vector<SignatureInfo>> get_signatures_for_address(const PublicKey& address,
+                                                                       const SignatureQuery& query,
+                                                                       const CallOptions& options = CallOptions{});
+    
+    /**
+     * Fetch one page of an address's history without holding a thread
+     * 
+     * @param address The address
+     * @param query Where the page starts and stops
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the page or the error; runs on the I/O thread and must not block
+     * @throws std::invalid_argument if the limit is 0 or above MAX_SIGNATURES_FOR_ADDRESS
+     */
+    void get_signatures_for_address_async(const PublicKey& address, const SignatureQuery& query,
+                                          const CallOptions& options, Completion<std::vector<SignatureInfo>> on_done);
+    
+    /**
+     * Get the balance an account of a given size needs to be rent exempt
+     * 
+     * @param size The account data size, e.g. NONCE_ACCOUNT_SIZE
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to the balance in lamports
+     */
+    std::future<uint64_t> get_minimum_balance_for_rent_exemption(uint64_t size,
+                                                                 const CallOptions& options = CallOptions{});
+    
+    /**
+     * Fetch the priority fees paid in recent slots
+     * 
+     * @param accounts Limit the samples to transactions that write these
+     *        accounts; empty for the whole cluster
+     * @param options Deadline and cancellation for the call
+     * @return A future that resolves to one sample per slot the node remembers
+     */
+    std::future<std::vector<PrioritizationFee>> get_recent_prioritization_fees(
+        const std::vector<PublicKey>& accounts, const CallOptions& options = CallOptions{});
+    
+    /**
+     * Fetch the priority fees paid in recent slots without holding a thread
+     * 
+     * @param accounts Limit the samples to transactions that write these accounts
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the samples or the error; runs on the I/O thread and must not block
+     */
+    void get_recent_prioritization_fees_async(const std::vector<PublicKey>& accounts, const CallOptions& options,
+                                              Completion<std::vector<PrioritizationFee>> on_done);
+    
+    /**
+     * Open a connection to every endpoint ahead of the first payment
+     * 
+     * Sends getHealth to each endpoint so DNS resolution, the TCP and TLS
+     * handshakes and the transport's I/O thread are all done before real
+     * traffic arrives; the connections stay pooled for reuse. Failures are
+     * not errors, they only leave that endpoint cold.
+     * 
+     * @param options Deadline and cancellation for the warm-up
+     * @return A future that resolves to the number of endpoints that answered
+     */
+    std::future<size_t> warm_up(const CallOptions& options = CallOptions{});
+    
+    // Most signatures a node accepts in one getSignatureStatuses call
+    static constexpr size_t MAX_SIGNATURE_STATUS_BATCH = 256;
+    
+    // Most keys a node accepts in one getMultipleAccounts call
+    static constexpr size_t MAX_MULTIPLE_ACCOUNTS = 100;
+    
+    // Most signatures a node returns in one getSignaturesForAddress call
+    static constexpr size_t MAX_SIGNATURES_FOR_ADDRESS = 1000;
+    
+    /**
+     * Set the RPC URL
+     * 
+     * Replaces the endpoint set with a single endpoint. Safe to call while
+     * requests are in flight; they complete against the previous endpoints.
+     * 
+     * @param rpc_url The new RPC URL
+     */
+    void set_rpc_url(const std::string& rpc_url);
+    
+    /**
+     * Get the current RPC URL
+     * 
+     * @return The first configured RPC URL
+     */
+    std::string get_rpc_url() const;
+    
+    /**
+     * Replace the RPC endpoint set
+     * 
+     * @param endpoints The new endpoints and routing options
+     */
+    void set_endpoints(const EndpointPoolConfig& endpoints);
+    
+    /**
+     * Get the RPC endpoint pool
+     * 
+     * @return The endpoint pool, for inspecting routing statistics
+     */
+    const EndpointPool& get_endpoint_pool() const;
+    
+    /**
+     * Get the HTTP engine the adapter sends requests through
+     * 
+     * @return The transport, for inspecting connection and traffic metrics
+     */
+    RpcTransport& transport() const { return *transport_; }
+    
+    /**
+     * Get the blockhash prefetcher, starting it on first use
+     * 
+     * Transaction creation takes blockhashes from it rather than asking the
+     * node each time.
+     * 
+     * @return The adapter's blockhash cache
+     */
+    BlockhashCache& blockhash_cache();
+    
+    /**
+     * Get the cluster-wide priority fee estimator, starting it on first use
+     * 
+     * @return The adapter's priority fee estimator
+     */
+    PriorityFeeEstimator& priority_fee_estimator();
+    
+    /**
+     * Get the in-memory mint metadata cache, starting it on first use
+     * 
+     * SPL token transfers take mint decimals and programs from it.
+     * 
+     * @return The adapter's mint cache
+     */
+    MintCache& mint_cache();
+
+private:
+    EndpointPool endpoint_pool_;
+    std::shared_ptr<RpcTransport> transport_;
+    
+    /**
+     * Make an RPC call on the calling thread
+     * 
+     * For use inside work already running on the executor, which must not
+     * wait on further executor work.
+     * 
+     * @param method The RPC method name
+     * @param params The RPC parameters as JSON string
+     * @param options Deadline and cancellation for the call
+     * @return The RPC response as JSON string
+     */
+    std::string rpc_call(const std::string& method, const std::string& params, const CallOptions& options);
+    
+    /**
+     * Look up signature statuses on the calling thread
+     * 
+     * @param signatures The transaction signatures
+     * @param options Deadline and cancellation for the call
+     * @return One entry per signature, unset when the node does not know it
+     */
+    std::vector<std::optional<SignatureStatus>> fetch_signature_statuses(const std::vector<std::string>& signatures,
+                                                                         const CallOptions& options);
+    
+    /**
+     * Make an RPC call to the network without blocking
+     * 
+     * @param method The RPC method name
+     * @param params The RPC parameters as JSON string
+     * @param options Deadline and cancellation for the call
+     * @param on_done Receives the RPC response as JSON string, or the error
+     */
+    void rpc_call_async(const std::string& method, const std::string& params, const CallOptions& options,
+                        Completion<std::string> on_done);
+    
+    /**
+     * Validate an SVM address
+     * 
+     * @param address The address to validate
+     * @return True if valid, false otherwise
+     */
+    bool validate_address(const std::string& address) const;
+    
+    // Declared last so their refresher threads stop before the rest of the adapter goes away
+    std::once_flag blockhash_cache_once_;
+    std::unique_ptr<BlockhashCache> blockhash_cache_;
+    std::once_flag priority_fee_estimator_once_;
+    std::unique_ptr<PriorityFeeEstimator> priority_fee_estimator_;
+    std::once_flag mint_cache_once_;
+    std::unique_ptr<MintCache> mint_cache_;
+};
+
+} // namespace svm_pay
\ No newline at end of file
@@ -0,0 +1,265 @@
+#pragma once
+
+// Coroutine wrappers over the adapters' completion callbacks. The SDK itself
+// builds as C++17; these are header-only and available to C++20 callers.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#define SVM_PAY_HAS_COROUTINES 1
+
+#include "adapter.hpp"
+#include "svm_adapter.hpp"
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace svm_pay {
+
+template <typename T>
+class task;
+
+namespace detail {
+
+template <typename T>
+struct task_promise_storage {
+    std::optional<T> value;
+
+    void return_value(T result) { value.emplace(std::move(result)); }
+    T take() { return std::move(*value); }
+};
+
+template <>
+struct task_promise_storage<void> {
+    void return_void() {}
+    void take() {}
+};
+
+/**
+ * Coroutine that starts at once and frees itself when done; drives spawn()
+ */
+struct detached_coroutine {
+    struct promise_type {
+        detached_coroutine get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+template <typename T>
+detached_coroutine run_into_promise(task<T> work, std::promise<T> promise) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(work);
+            promise.set_value();
+        } else {
+            promise.set_value(co_await std::move(work));
+        }
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+} // namespace detail
+
+/**
+ * Lazily started coroutine producing a T
+ *
+ * The body runs when the task is awaited, or when it is handed to spawn().
+ * Awaiting resumes the awaiting coroutine on whichever thread finished the
+ * task; for the adapter calls below that is the transport's I/O thread, so
+ * code between awaits must not block.
+ */
+template <typename T>
+class task {
+public:
+    struct promise_type : detail::task_promise_storage<T> {
+        std::exception_ptr error;
+        std::coroutine_handle<> continuation;
+
+        task get_return_object() { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        struct final_awaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                // Symmetric transfer, so long chains of tasks do not grow the stack
+                auto continuation = handle.promise().continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        final_awaiter final_suspend() noexcept { return {}; }
+
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    task(task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+
+    ~task() {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    auto operator co_await() && noexcept {
+        struct awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+            T await_resume() {
+                if (handle.promise().error) {
+                    std::rethrow_exception(handle.promise().error);
+                }
+                return handle.promise().take();
+            }
+        };
+        return awaiter{handle_};
+    }
+
+private:
+    explicit task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * Awaitable that starts a callback-based operation and resumes with its outcome
+ *
+ * @tparam T The value the operation completes with
+ */
+template <typename T>
+class completion_awaitable {
+public:
+    using Start = std::function<void(Completion<T>)>;
+
+    explicit completion_awaitable(Start start) : start_(std::move(start)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        Start start = std::move(start_);
+        start([this, awaiting](T value, std::exception_ptr error) {
+            if (error) {
+                error_ = error;
+            } else {
+                value_.emplace(std::move(value));
+            }
+            // Whichever side comes second resumes; a synchronous completion
+            // lets await_suspend return false instead
+            if (finished_.exchange(true, std::memory_order_acq_rel)) {
+                awaiting.resume();
+            }
+        });
+        return !finished_.exchange(true, std::memory_order_acq_rel);
+    }
+
+    T await_resume() {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        return std::move(*value_);
+    }
+
+private:
+    Start start_;
+    std::optional<T> value_;
+    std::exception_ptr error_;
+    std::atomic<bool> finished_{false};
+};
+
+/**
+ * Start a task on the calling thread without waiting for it
+ *
+ * The task runs until its first suspension before spawn returns.
+ *
+ * @param work The task
+ * @return A future for the task's result; dropping it does not block
+ */
+template <typename T>
+std::future<T> spawn(task<T> work) {
+    std::promise<T> promise;
+    std::future<T> result = promise.get_future();
+    detail::run_into_promise(std::move(work), std::move(promise));
+    return result;
+}
+
+/**
+ * Run a task and block until it finishes; for the edges of a program
+ *
+ * @param work The task
+ * @return The task's result
+ */
+template <typename T>
+T sync_wait(task<T> work) {
+    return spawn(std::move(work)).get();
+}
+
+/**
+ * Submit a signed transaction, suspending until the node answers
+ *
+ * @param adapter The adapter; must outlive the task
+ * @param transaction The base64 wire-format transaction to submit
+ * @param signature The signature for the transaction
+ * @param options Deadline and cancellation for the call
+ * @return The transaction signature
+ */
+inline task<std::string> async_submit_transaction(NetworkAdapter& adapter, std::string transaction,
+                                                  std::string signature = std::string(),
+                                                  CallOptions options = CallOptions{}) {
+    co_return co_await completion_awaitable<std::string>([&](Completion<std::string> on_done) {
+        adapter.submit_transaction_async(transaction, signature, options, std::move(on_done));
+    });
+}
+
+/**
+ * Check the status of a transaction, suspending until the node answers
+ *
+ * @param adapter The adapter; must outlive the task
+ * @param signature The signature of the transaction to check
+ * @param options Deadline and cancellation for the call
+ * @return The payment status
+ */
+inline task<PaymentStatus> async_check_transaction_status(NetworkAdapter& adapter, std::string signature,
+                                                          CallOptions options = CallOptions{}) {
+    co_return co_await completion_awaitable<PaymentStatus>([&](Completion<PaymentStatus> on_done) {
+        adapter.check_transaction_status_async(signature, options, std::move(on_done));
+    });
+}
+
+/**
+ * Fetch a recent blockhash, suspending until the node answers
+ *
+ * @param adapter The adapter; must outlive the task
+ * @param options Deadline and cancellation for the call
+ * @return The blockhash and its expiry height
+ */
+inline task<LatestBlockhash> async_get_latest_blockhash(SvmNetworkAdapter& adapter,
+                                                        CallOptions options = CallOptions{}) {
+    co_return co_await completion_awaitable<LatestBlockhash>([&](Completion<LatestBlockhash> on_done) {
+        adapter.get_latest_blockhash_async(options, std::move(on_done));
+    });
+}
+
+} // namespace svm_pay
+
+#endif
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "svm_adapter.hpp"
+#include "../core/types.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace svm_pay {
+
+/**
+ * Configuration for a TransactionSender
+ */
+struct TransactionSenderConfig {
+    // Time between rebroadcasts; the status and block height are checked at the same cadence
+    std::chrono::milliseconds interval{2000};
+
+    // sendTransaction options for every broadcast. The node's own retries are
+    // off by default, since the sender does the retrying.
+    SendOptions send{false, 0};
+
+    // Limit for each individual RPC call of the pipeline
+    std::chrono::milliseconds request_timeout{5000};
+
+    // Terminal outcomes remembered for resubmissions, oldest evicted first
+    size_t memo_capacity = 10000;
+};
+
+/**
+ * Sends signed transactions until they land or their blockhash expires
+ *
+ * Congested leaders drop transactions, and a single sendTransaction gives
+ * no second chance. The sender re-broadcasts the same signed bytes every
+ * interval, checking the signature's status and the block height in
+ * between. A transaction ends CONFIRMED, FAILED (it landed with an error),
+ * or EXPIRED once the block height passes its last valid block height and
+ * a final status check still does not find it. Failed sends are not
+ * terminal; the next interval tries again.
+ *
+ * Submissions are deduplicated by signature: sending a transaction that is
+ * already in flight joins it, and one that recently finished reports the
+ * remembered outcome. The pipeline runs on the adapter's transport I/O
+ * thread and holds no thread while waiting; callbacks run there too and
+ * must not block.
+ */
+class TransactionSender {
+public:
+    /**
+     * Constructor
+     *
+     * @param adapter The adapter to send through; must outlive the sender
+     * @param config Cadence and send options
+     */
+    explicit TransactionSender(SvmNetworkAdapter& adapter,
+                               const TransactionSenderConfig& config = TransactionSenderConfig{});
+
+    /**
+     * Destructor; stops every pipeline at its next step, failing it with
+     * OperationCancelledException, and waits for them to wind down.
+     * Must not run inside a sender callback.
+     */
+    ~TransactionSender();
+
+    TransactionSender(const TransactionSender&) = delete;
+    TransactionSender& operator=(const TransactionSender&) = delete;
+
+    /**
+     * Broadcast a signed transaction until it reaches a terminal state
+     *
+     * @param transaction The base64 wire-format signed transaction
+     * @param last_valid_block_height Expiry height of the transaction's blockhash
+     * @param on_done Receives CONFIRMED, FAILED or EXPIRED, or the error if
+     *                the options' cancellation fired or the sender shut down
+     * @param options Cancellation and priority for the pipeline's calls; a deadline ends it early with TimeoutException
+     * @throws TransactionException if the transaction is malformed or unsigned
+     */
+    void send(const std::string& transaction, uint64_t last_valid_block_height, Completion<PaymentStatus> on_done,
+              const CallOptions& options = CallOptions{});
+
+    /**
+     * Broadcast a signed transaction through a future
+     *
+     * @param transaction The base64 wire-format signed transaction
+     * @param last_valid_block_height Expiry height of the transaction's blockhash
+     * @param options Cancellation and priority for the pipeline's calls
+     * @return A future that resolves to CONFIRMED, FAILED or EXPIRED
+     * @throws TransactionException if the transaction is malformed or unsigned
+     */
+    std::future<PaymentStatus> send(const std::string& transaction, uint64_t last_valid_block_height,
+                                    const CallOptions& options = CallOptions{});
+
+    /**
+     * Get the number of transactions still being broadcast
+     *
+     * @return The pending count
+     */
+    size_t pending_count() const;
+
+    /**
+     * Get the number of sendTransaction calls made so far
+     *
+     * @return The broadcast count
+     */
+    uint64_t broadcast_count() const;
+
+private:
+    struct Pipeline;
+    struct State;
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace svm_pay
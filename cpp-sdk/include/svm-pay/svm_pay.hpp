@@ -13,8 +13,38 @@
 #include "core/url_scheme.hpp"
 #include "core/reference.hpp"
 #include "core/exceptions.hpp"
+#include "core/json.hpp"
+#include "core/base58.hpp"
+#include "core/base64.hpp"
+#include "core/batch_signer.hpp"
+#include "core/executor.hpp"
+#include "core/keypair.hpp"
+#include "core/payout_packer.hpp"
+#include "core/pda.hpp"
+#include "core/public_key.hpp"
+#include "core/quantile_sketch.hpp"
+#include "core/sha256.hpp"
+#include "core/transaction.hpp"
+#include "network/account_loader.hpp"
 #include "network/adapter.hpp"
+#include "network/blockhash_cache.hpp"
+#include "network/call_options.hpp"
+#include "network/confirmation_watcher.hpp"
+#include "network/endpoint_pool.hpp"
+#include "network/mint_cache.hpp"
+#include "network/nonce_pool.hpp"
+#include "network/periodic_task.hpp"
+#include "network/priority_fee_estimator.hpp"
+#include "network/pubsub.hpp"
+#include "network/rate_limiter.hpp"
+#include "network/request_scheduler.hpp"
+#include "network/retry_policy.hpp"
+#include "network/signature_scanner.hpp"
+#include "network/rpc_transport.hpp"
 #include "network/solana.hpp"
+#include "network/svm_adapter.hpp"
+#include "network/task.hpp"
+#include "network/transaction_sender.hpp"
 
 namespace svm_pay {
 
@@ -33,6 +63,18 @@ constexpr const char* VERSION = "1.0.0";
  */
 void initialize_sdk(const std::unordered_map<std::string, std::string>& options = {});
 
+/**
+ * Initialize the SDK to run its asynchronous work on an application executor
+ * 
+ * The executor is installed before anything else, so no built-in pool is
+ * created and the executor_threads and executor_pin_threads options are
+ * ignored.
+ * 
+ * @param options Configuration options for the SDK
+ * @param executor The executor to make the process-wide default; nullptr behaves like initialize_sdk(options)
+ */
+void initialize_sdk(const std::unordered_map<std::string, std::string>& options, std::shared_ptr<Executor> executor);
+
 /**
  * Clean up the SVM-Pay SDK
  * 
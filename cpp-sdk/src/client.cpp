@@ -1,17 +1,74 @@
 #include "svm-pay/client.hpp"
 #include "svm-pay/core/url_scheme.hpp"
 #include "svm-pay/core/reference.hpp"
-#include "svm-pay/network/solana.hpp"
+#include "svm-pay/network/svm_adapter.hpp"
 #include <sstream>
 
 namespace svm_pay {
 
+namespace {
+
+/**
+ * A shared adapter as seen by a Client with its own executor: calls that
+ * set no executor of their own run on the Client's
+ */
+class ClientAdapter : public NetworkAdapter {
+public:
+    ClientAdapter(std::shared_ptr<NetworkAdapter> adapter, std::shared_ptr<Executor> executor)
+        : NetworkAdapter(adapter->get_network()), adapter_(std::move(adapter)) {
+        set_executor(std::move(executor));
+    }
+
+    std::future<std::string> create_transfer_transaction(const TransferRequest& request,
+                                                         const CallOptions& options) override {
+        return adapter_->create_transfer_transaction(request, on_own_executor(options));
+    }
+
+    std::future<std::string> fetch_transaction(const TransactionRequest& request, const CallOptions& options) override {
+        return adapter_->fetch_transaction(request, on_own_executor(options));
+    }
+
+    std::future<std::string> submit_transaction(const std::string& transaction, const std::string& signature,
+                                                const CallOptions& options) override {
+        return adapter_->submit_transaction(transaction, signature, on_own_executor(options));
+    }
+
+    std::future<PaymentStatus> check_transaction_status(const std::string& signature,
+                                                        const CallOptions& options) override {
+        return adapter_->check_transaction_status(signature, on_own_executor(options));
+    }
+
+    void submit_transaction_async(const std::string& transaction, const std::string& signature,
+                                  const CallOptions& options, Completion<std::string> on_done) override {
+        adapter_->submit_transaction_async(transaction, signature, on_own_executor(options), std::move(on_done));
+    }
+
+    void check_transaction_status_async(const std::string& signature, const CallOptions& options,
+                                        Completion<PaymentStatus> on_done) override {
+        adapter_->check_transaction_status_async(signature, on_own_executor(options), std::move(on_done));
+    }
+
+private:
+    CallOptions on_own_executor(const CallOptions& options) const {
+        CallOptions own = options;
+        own.executor = get_executor(options);
+        return own;
+    }
+
+    std::shared_ptr<NetworkAdapter> adapter_;
+};
+
+} // namespace
+
 Client::Client(SVMNetwork default_network) 
     : default_network_(default_network), debug_enabled_(false), max_references_(10) {
-    
-    // Register default adapters
-    auto solana_adapter = std::make_unique<SolanaNetworkAdapter>();
-    register_adapter(SVMNetwork::SOLANA, std::move(solana_adapter));
+    // Adapters are shared process-wide and created on first use, so a
+    // Client is cheap to construct and never replaces configured adapters
+}
+
+Client::Client(SVMNetwork default_network, std::shared_ptr<Executor> executor)
+    : Client(default_network) {
+    executor_ = std::move(executor);
 }
 
 Client::~Client() = default;
@@ -99,8 +156,18 @@ void Client::register_adapter(SVMNetwork network, std::unique_ptr<NetworkAdapter
     NetworkAdapterFactory::register_adapter(network, std::move(adapter));
 }
 
-NetworkAdapter* Client::get_adapter(SVMNetwork network) {
-    return NetworkAdapterFactory::get_adapter(network);
+std::shared_ptr<NetworkAdapter> Client::get_adapter(SVMNetwork network) {
+    // Adapters configured by initialize_sdk win; otherwise the network's public endpoint is used
+    auto adapter = NetworkAdapterFactory::get_or_register_adapter(
+        network, [network]() { return std::make_shared<SvmNetworkAdapter>(network); });
+    if (!executor_) {
+        return adapter;
+    }
+    return std::make_shared<ClientAdapter>(std::move(adapter), executor_);
+}
+
+std::shared_ptr<Executor> Client::get_executor() const {
+    return executor_;
 }
 
 bool Client::is_debug_enabled() const {
@@ -0,0 +1,125 @@
+#include "svm-pay/core/base58.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace svm_pay {
+
+namespace {
+
+const char BASE58_ALPHABET[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+// Reverse lookup; -1 marks characters outside the alphabet
+struct Base58Table {
+    int8_t values[256];
+
+    Base58Table() {
+        std::fill(std::begin(values), std::end(values), static_cast<int8_t>(-1));
+        for (int i = 0; i < 58; ++i) {
+            values[static_cast<unsigned char>(BASE58_ALPHABET[i])] = static_cast<int8_t>(i);
+        }
+    }
+};
+
+const Base58Table BASE58_TABLE;
+
+} // namespace
+
+std::string encode_base58(const uint8_t* data, size_t size) {
+    size_t leading_zeros = 0;
+    while (leading_zeros < size && data[leading_zeros] == 0) {
+        leading_zeros++;
+    }
+
+    // Base-58 digits, least significant first; log(256) / log(58) < 1.37
+    std::vector<uint8_t> digits((size - leading_zeros) * 137 / 100 + 1);
+    size_t length = 0;
+    for (size_t i = leading_zeros; i < size; i++) {
+        uint32_t carry = data[i];
+        for (size_t j = 0; j < length; j++) {
+            carry += static_cast<uint32_t>(digits[j]) << 8;
+            digits[j] = static_cast<uint8_t>(carry % 58);
+            carry /= 58;
+        }
+        while (carry > 0) {
+            digits[length++] = static_cast<uint8_t>(carry % 58);
+            carry /= 58;
+        }
+    }
+
+    std::string result(leading_zeros + length, '1');
+    for (size_t i = 0; i < length; i++) {
+        result[leading_zeros + i] = BASE58_ALPHABET[digits[length - 1 - i]];
+    }
+    return result;
+}
+
+std::vector<uint8_t> decode_base58(const std::string& encoded) {
+    size_t leading_ones = 0;
+    while (leading_ones < encoded.size() && encoded[leading_ones] == '1') {
+        leading_ones++;
+    }
+
+    // Bytes, least significant first; log(58) / log(256) < 0.733
+    std::vector<uint8_t> bytes((encoded.size() - leading_ones) * 733 / 1000 + 1);
+    size_t length = 0;
+    for (size_t i = leading_ones; i < encoded.size(); i++) {
+        int value = BASE58_TABLE.values[static_cast<unsigned char>(encoded[i])];
+        if (value < 0) {
+            throw std::invalid_argument("Invalid base58 character: " + std::string(1, encoded[i]));
+        }
+        uint32_t carry = static_cast<uint32_t>(value);
+        for (size_t j = 0; j < length; j++) {
+            carry += static_cast<uint32_t>(bytes[j]) * 58;
+            bytes[j] = static_cast<uint8_t>(carry & 0xFF);
+            carry >>= 8;
+        }
+        while (carry > 0) {
+            bytes[length++] = static_cast<uint8_t>(carry & 0xFF);
+            carry >>= 8;
+        }
+    }
+
+    std::vector<uint8_t> result(leading_ones + length, 0);
+    for (size_t i = 0; i < length; i++) {
+        result[leading_ones + i] = bytes[length - 1 - i];
+    }
+    return result;
+}
+
+bool decode_base58(const std::string& encoded, uint8_t* out, size_t size) {
+    // Each character carries less than one byte, so longer input cannot fit
+    if (encoded.empty() || encoded.size() > size * 2) {
+        return false;
+    }
+    size_t leading_ones = 0;
+    while (leading_ones < encoded.size() && encoded[leading_ones] == '1') {
+        leading_ones++;
+    }
+
+    // Accumulate big-endian directly into the output
+    std::fill(out, out + size, static_cast<uint8_t>(0));
+    for (size_t i = leading_ones; i < encoded.size(); i++) {
+        int value = BASE58_TABLE.values[static_cast<unsigned char>(encoded[i])];
+        if (value < 0) {
+            return false;
+        }
+        uint32_t carry = static_cast<uint32_t>(value);
+        for (size_t j = size; j-- > 0;) {
+            carry += static_cast<uint32_t>(out[j]) * 58;
+            out[j] = static_cast<uint8_t>(carry & 0xFF);
+            carry >>= 8;
+        }
+        if (carry != 0) {
+            return false;
+        }
+    }
+
+    // Canonical form: leading '1's map one-to-one onto leading zero bytes
+    size_t leading_zeros = 0;
+    while (leading_zeros < size && out[leading_zeros] == 0) {
+        leading_zeros++;
+    }
+    return leading_zeros == leading_ones;
+}
+
+} // namespace svm_pay
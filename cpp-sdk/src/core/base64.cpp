@@ -0,0 +1,395 @@
+#include "svm-pay/core/base64.hpp"
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SVM_PAY_BASE64_X86 1
+#include <immintrin.h>
+#define SVM_PAY_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace svm_pay {
+
+namespace {
+
+const char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Character to 6-bit value; 0xFF marks characters outside the alphabet
+struct DecodeTable {
+    uint8_t values[256];
+
+    DecodeTable() {
+        for (auto& value : values) {
+            value = 0xFF;
+        }
+        for (uint8_t i = 0; i < 64; ++i) {
+            values[static_cast<uint8_t>(BASE64_ALPHABET[i])] = i;
+        }
+    }
+};
+
+const DecodeTable DECODE_TABLE;
+
+inline uint8_t decode_char(char c) {
+    return DECODE_TABLE.values[static_cast<uint8_t>(c)];
+}
+
+/**
+ * Encode whole 3-byte groups; returns the number of input bytes consumed
+ */
+size_t encode_scalar(const uint8_t* data, size_t size, char* out) {
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3) {
+        uint32_t triple = (static_cast<uint32_t>(data[i]) << 16) |
+                          (static_cast<uint32_t>(data[i + 1]) << 8) |
+                          static_cast<uint32_t>(data[i + 2]);
+        out[0] = BASE64_ALPHABET[(triple >> 18) & 0x3F];
+        out[1] = BASE64_ALPHABET[(triple >> 12) & 0x3F];
+        out[2] = BASE64_ALPHABET[(triple >> 6) & 0x3F];
+        out[3] = BASE64_ALPHABET[triple & 0x3F];
+        out += 4;
+    }
+    return i;
+}
+
+/**
+ * Decode whole unpadded quads; returns false on a character outside the alphabet
+ */
+bool decode_scalar(const char* data, size_t size, uint8_t* out) {
+    for (size_t i = 0; i < size; i += 4) {
+        uint8_t a = decode_char(data[i]);
+        uint8_t b = decode_char(data[i + 1]);
+        uint8_t c = decode_char(data[i + 2]);
+        uint8_t d = decode_char(data[i + 3]);
+        if ((a | b | c | d) & 0x80) {
+            return false;
+        }
+        uint32_t triple = (static_cast<uint32_t>(a) << 18) | (static_cast<uint32_t>(b) << 12) |
+                          (static_cast<uint32_t>(c) << 6) | d;
+        out[0] = static_cast<uint8_t>(triple >> 16);
+        out[1] = static_cast<uint8_t>(triple >> 8);
+        out[2] = static_cast<uint8_t>(triple);
+        out += 3;
+    }
+    return true;
+}
+
+#ifdef SVM_PAY_BASE64_X86
+
+// The vector codecs follow Wojciech Muła's and Alfred Klomp's published
+// SSSE3/AVX2 algorithms: bytes are regrouped into 6-bit indices with
+// multiplies, and translated to and from ASCII with nibble lookup tables.
+
+SVM_PAY_TARGET("ssse3")
+__m128i encode_indices_ssse3(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+    __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+    __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+SVM_PAY_TARGET("ssse3")
+__m128i encode_translate_ssse3(__m128i indices) {
+    // Offset from index to character per range: A-Z, a-z, 0-9, '+', '/'
+    const __m128i offsets = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    range = _mm_sub_epi8(range, _mm_cmpgt_epi8(indices, _mm_set1_epi8(25)));
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range));
+}
+
+SVM_PAY_TARGET("ssse3")
+size_t encode_ssse3(const uint8_t* data, size_t size, char* out) {
+    size_t i = 0;
+    // 12 bytes per round, but the load reads 16
+    for (; i + 16 <= size; i += 12) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i chars = encode_translate_ssse3(encode_indices_ssse3(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+        out += 16;
+    }
+    return i;
+}
+
+SVM_PAY_TARGET("avx2")
+size_t encode_avx2(const uint8_t* data, size_t size, char* out) {
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = _mm256_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0,
+                                             65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+    size_t i = 0;
+    // 24 bytes per round, 12 per lane; the second lane's load reads up to byte 28
+    for (; i + 28 <= size; i += 24) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12));
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        in = _mm256_shuffle_epi8(in, shuffle);
+        __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00));
+        __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0));
+        __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(t1, t3);
+        __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        range = _mm256_sub_epi8(range, _mm256_cmpgt_epi8(indices, _mm256_set1_epi8(25)));
+        __m256i chars = _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), chars);
+        out += 32;
+    }
+    return i;
+}
+
+/**
+ * Decode 16-character blocks while enough input follows that the 4 scratch
+ * bytes of each 16-byte store land in output written later; returns the
+ * characters consumed, or SIZE_MAX on a character outside the alphabet
+ */
+SVM_PAY_TARGET("ssse3")
+size_t decode_ssse3(const char* data, size_t size, uint8_t* out) {
+    // Bit sets per low and high nibble; a character is valid iff they do not intersect
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                         0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                         0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    // Offset from character to index per high nibble ('/' gets its own)
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i slash = _mm_set1_epi8(0x2F);
+
+    size_t i = 0;
+    for (; i + 16 + 8 <= size; i += 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(in, 4), nibble);
+        __m128i lo_nibbles = _mm_and_si128(in, nibble);
+        __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+        __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF) {
+            return SIZE_MAX;
+        }
+        __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(in, slash), hi_nibbles));
+        in = _mm_add_epi8(in, roll);
+        __m128i merged = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+        __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        packed = _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+        out += 12;
+    }
+    return i;
+}
+
+SVM_PAY_TARGET("avx2")
+size_t decode_avx2(const char* data, size_t size, uint8_t* out) {
+    const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                            0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                            0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                              0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i slash = _mm256_set1_epi8(0x2F);
+
+    size_t i = 0;
+    // Each 32-byte store carries 24 bytes; 12 more characters guarantee room for the rest
+    for (; i + 32 + 12 <= size; i += 32) {
+        __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), nibble);
+        __m256i lo_nibbles = _mm256_and_si256(in, nibble);
+        __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+        __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        if (!_mm256_testz_si256(lo, hi)) {
+            return SIZE_MAX;
+        }
+        __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(in, slash), hi_nibbles));
+        in = _mm256_add_epi8(in, roll);
+        __m256i merged = _mm256_maddubs_epi16(in, _mm256_set1_epi32(0x01400140));
+        __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+        packed = _mm256_shuffle_epi8(packed, pack);
+        packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+        out += 24;
+    }
+    return i;
+}
+
+bool cpu_supports(Base64Implementation implementation) {
+    switch (implementation) {
+        case Base64Implementation::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case Base64Implementation::SSSE3:
+            return __builtin_cpu_supports("ssse3");
+        default:
+            return true;
+    }
+}
+
+#else
+
+bool cpu_supports(Base64Implementation implementation) {
+    return implementation == Base64Implementation::SCALAR;
+}
+
+#endif
+
+Base64Implementation detect_implementation() {
+    for (auto implementation : {Base64Implementation::AVX2, Base64Implementation::SSSE3}) {
+        if (cpu_supports(implementation)) {
+            return implementation;
+        }
+    }
+    return Base64Implementation::SCALAR;
+}
+
+std::atomic<Base64Implementation>& active_implementation() {
+    static std::atomic<Base64Implementation> implementation(detect_implementation());
+    return implementation;
+}
+
+/**
+ * Encode whole groups with the active implementation; returns input bytes consumed
+ */
+size_t encode_blocks(const uint8_t* data, size_t size, char* out) {
+    size_t done = 0;
+#ifdef SVM_PAY_BASE64_X86
+    switch (active_implementation().load(std::memory_order_relaxed)) {
+        case Base64Implementation::AVX2:
+            done = encode_avx2(data, size, out);
+            break;
+        case Base64Implementation::SSSE3:
+            done = encode_ssse3(data, size, out);
+            break;
+        default:
+            break;
+    }
+#endif
+    return done + encode_scalar(data + done, size - done, out + done / 3 * 4);
+}
+
+} // namespace
+
+Base64Implementation base64_implementation() {
+    return active_implementation().load(std::memory_order_relaxed);
+}
+
+bool set_base64_implementation(Base64Implementation implementation) {
+    if (!cpu_supports(implementation)) {
+        return false;
+    }
+    active_implementation().store(implementation, std::memory_order_relaxed);
+    return true;
+}
+
+size_t base64_encode(const uint8_t* data, size_t size, char* out) {
+    size_t done = encode_blocks(data, size, out);
+    char* cursor = out + done / 3 * 4;
+    size_t remaining = size - done;
+    if (remaining > 0) {
+        uint32_t triple = static_cast<uint32_t>(data[done]) << 16;
+        if (remaining == 2) {
+            triple |= static_cast<uint32_t>(data[done + 1]) << 8;
+        }
+        cursor[0] = BASE64_ALPHABET[(triple >> 18) & 0x3F];
+        cursor[1] = BASE64_ALPHABET[(triple >> 12) & 0x3F];
+        cursor[2] = remaining == 2 ? BASE64_ALPHABET[(triple >> 6) & 0x3F] : '=';
+        cursor[3] = '=';
+        cursor += 4;
+    }
+    return static_cast<size_t>(cursor - out);
+}
+
+void base64_encode_append(const uint8_t* data, size_t size, std::string& out) {
+    size_t offset = out.size();
+    out.resize(offset + base64_encoded_size(size));
+    base64_encode(data, size, &out[offset]);
+}
+
+std::string base64_encode(const uint8_t* data, size_t size) {
+    std::string result;
+    base64_encode_append(data, size, result);
+    return result;
+}
+
+bool base64_decode(const char* data, size_t size, uint8_t* out, size_t& written) {
+    if (size % 4 != 0) {
+        return false;
+    }
+    if (size == 0) {
+        written = 0;
+        return true;
+    }
+
+    // Everything but the last quad is unpadded
+    size_t body = size - 4;
+    size_t done = 0;
+#ifdef SVM_PAY_BASE64_X86
+    switch (active_implementation().load(std::memory_order_relaxed)) {
+        case Base64Implementation::AVX2:
+            done = decode_avx2(data, body, out);
+            break;
+        case Base64Implementation::SSSE3:
+            done = decode_ssse3(data, body, out);
+            break;
+        default:
+            break;
+    }
+    if (done == SIZE_MAX) {
+        return false;
+    }
+#endif
+    if (!decode_scalar(data + done, body - done, out + done / 4 * 3)) {
+        return false;
+    }
+
+    const char* last = data + body;
+    uint8_t* cursor = out + body / 4 * 3;
+    uint8_t a = decode_char(last[0]);
+    uint8_t b = decode_char(last[1]);
+    if ((a | b) & 0x80) {
+        return false;
+    }
+    if (last[2] == '=') {
+        // One byte; the unused low bits of b must be zero
+        if (last[3] != '=' || (b & 0x0F)) {
+            return false;
+        }
+        cursor[0] = static_cast<uint8_t>((a << 2) | (b >> 4));
+        written = body / 4 * 3 + 1;
+        return true;
+    }
+    uint8_t c = decode_char(last[2]);
+    if (c & 0x80) {
+        return false;
+    }
+    if (last[3] == '=') {
+        if (c & 0x03) {
+            return false;
+        }
+        cursor[0] = static_cast<uint8_t>((a << 2) | (b >> 4));
+        cursor[1] = static_cast<uint8_t>((b << 4) | (c >> 2));
+        written = body / 4 * 3 + 2;
+        return true;
+    }
+    if (!decode_scalar(last, 4, cursor)) {
+        return false;
+    }
+    written = body / 4 * 3 + 3;
+    return true;
+}
+
+std::vector<uint8_t> base64_decode(const std::string& encoded) {
+    std::vector<uint8_t> result(base64_decoded_max_size(encoded.size()));
+    size_t written = 0;
+    if (!base64_decode(encoded.data(), encoded.size(), result.data(), written)) {
+        throw std::invalid_argument("Invalid base64 string");
+    }
+    result.resize(written);
+    return result;
+}
+
+} // namespace svm_pay
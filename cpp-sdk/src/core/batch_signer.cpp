@@ -0,0 +1,152 @@
+#include "svm-pay/core/batch_signer.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <openssl/evp.h>
+#include <algorithm>
+#include <thread>
+#include <unordered_map>
+
+namespace svm_pay {
+
+/**
+ * Reusable per-worker OpenSSL state
+ */
+struct BatchSigner::Context {
+    EVP_MD_CTX* md = nullptr;
+    std::unordered_map<PublicKey, EVP_PKEY*, PublicKeyHash> keys;
+
+    Context() : md(EVP_MD_CTX_new()) {
+        if (!md) {
+            throw CryptographicException("Failed to allocate digest context");
+        }
+    }
+
+    ~Context() {
+        clear_keys();
+        EVP_MD_CTX_free(md);
+    }
+
+    void clear_keys() {
+        for (auto& entry : keys) {
+            EVP_PKEY_free(entry.second);
+        }
+        keys.clear();
+    }
+
+    EVP_PKEY* prepared_key(const PublicKey& key, size_t capacity) {
+        auto it = keys.find(key);
+        if (it != keys.end()) {
+            return it->second;
+        }
+        EVP_PKEY* pkey = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr, key.data(), PublicKey::SIZE);
+        if (!pkey) {
+            return nullptr;
+        }
+        // Start over rather than track recency; repeat signers are re-added at once
+        if (keys.size() >= capacity) {
+            clear_keys();
+        }
+        if (capacity > 0) {
+            keys.emplace(key, pkey);
+        }
+        return pkey;
+    }
+};
+
+BatchSigner::BatchSigner(const BatchSignerConfig& config) : config_(config) {
+    if (config_.workers == 0) {
+        config_.workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    config_.min_items_per_worker = std::max<size_t>(1, config_.min_items_per_worker);
+}
+
+BatchSigner::~BatchSigner() = default;
+
+BatchSigner::Context* BatchSigner::acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!idle_.empty()) {
+        Context* context = idle_.back();
+        idle_.pop_back();
+        return context;
+    }
+    contexts_.push_back(std::make_unique<Context>());
+    return contexts_.back().get();
+}
+
+void BatchSigner::release(Context* context) {
+    // Drop the key reference held by the last operation
+    EVP_MD_CTX_reset(context->md);
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_.push_back(context);
+}
+
+template <typename Work>
+void BatchSigner::run_parallel(size_t count, Work work) {
+    if (count == 0) {
+        return;
+    }
+    size_t chunks = std::min(config_.workers, std::max<size_t>(1, count / config_.min_items_per_worker));
+    size_t chunk_size = (count + chunks - 1) / chunks;
+
+    // The calling thread takes chunks too, so a batch signed from an
+    // executor worker never waits on chunks queued behind it
+    auto executor = config_.executor ? config_.executor : default_executor();
+    parallel_for(*executor, (count + chunk_size - 1) / chunk_size, [&](size_t chunk) {
+        size_t begin = chunk * chunk_size;
+        Context* context = acquire();
+        try {
+            work(*context, begin, std::min(count, begin + chunk_size));
+        } catch (...) {
+            release(context);
+            throw;
+        }
+        release(context);
+    });
+}
+
+void BatchSigner::sign(const Keypair& signer, const MessageView* messages, size_t count, Signature* signatures) {
+    EVP_PKEY* pkey = signer.evp_key();
+    run_parallel(count, [&](Context& context, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            size_t size = signatures[i].size();
+            if (EVP_MD_CTX_reset(context.md) != 1 ||
+                EVP_DigestSignInit(context.md, nullptr, nullptr, nullptr, pkey) != 1 ||
+                EVP_DigestSign(context.md, signatures[i].data(), &size, messages[i].data, messages[i].size) != 1) {
+                throw CryptographicException("Ed25519 signing failed");
+            }
+        }
+    });
+}
+
+std::vector<Signature> BatchSigner::sign(const Keypair& signer, const std::vector<MessageView>& messages) {
+    std::vector<Signature> signatures(messages.size());
+    sign(signer, messages.data(), messages.size(), signatures.data());
+    return signatures;
+}
+
+size_t BatchSigner::verify(const SignatureCheck* checks, size_t count, bool* results) {
+    run_parallel(count, [&](Context& context, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const SignatureCheck& check = checks[i];
+            EVP_PKEY* pkey = context.prepared_key(check.key, config_.key_cache_capacity);
+            results[i] = pkey &&
+                         EVP_MD_CTX_reset(context.md) == 1 &&
+                         EVP_DigestVerifyInit(context.md, nullptr, nullptr, nullptr, pkey) == 1 &&
+                         EVP_DigestVerify(context.md, check.signature.data(), check.signature.size(),
+                                          check.message.data, check.message.size) == 1;
+            if (pkey && config_.key_cache_capacity == 0) {
+                EVP_MD_CTX_reset(context.md);
+                EVP_PKEY_free(pkey);
+            }
+        }
+    });
+    return static_cast<size_t>(std::count(results, results + count, true));
+}
+
+std::vector<bool> BatchSigner::verify(const std::vector<SignatureCheck>& checks) {
+    // Workers write results concurrently, which std::vector<bool> cannot take
+    std::unique_ptr<bool[]> results(new bool[checks.size()]);
+    verify(checks.data(), checks.size(), results.get());
+    return std::vector<bool>(results.get(), results.get() + checks.size());
+}
+
+} // namespace svm_pay
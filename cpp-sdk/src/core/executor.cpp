@@ -0,0 +1,212 @@
+#include "svm-pay/core/executor.hpp"
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace svm_pay {
+
+namespace {
+
+// The pool and worker the current thread belongs to, for local submission
+thread_local const WorkStealingExecutor* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+void pin_current_thread(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+/**
+ * A default set through set_default_executor()
+ *
+ * Weak, so replacing the default releases the previous executor; never
+ * freed, since a reader may still be locking one.
+ */
+struct ConfiguredExecutor {
+    std::weak_ptr<Executor> executor;
+};
+
+// Read on every adapter call without a lock; the owner is only for writers
+std::atomic<const ConfiguredExecutor*> configured_default{nullptr};
+std::mutex configured_owner_mutex;
+std::shared_ptr<Executor> configured_owner;
+
+} // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(const WorkStealingConfig& config) {
+    size_t threads = config.threads;
+    if (threads == 0) {
+        threads = std::max<size_t>(4, std::thread::hardware_concurrency());
+    }
+    size_t cpu_count = std::max(1u, std::thread::hardware_concurrency());
+
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        int cpu = -1;
+        if (config.pin_threads) {
+            cpu = config.cpus.empty() ? static_cast<int>(i % cpu_count) : config.cpus[i % config.cpus.size()];
+        }
+        workers_[i]->thread = std::thread([this, i, cpu]() {
+            if (cpu >= 0) {
+                pin_current_thread(cpu);
+            }
+            run(i);
+        });
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        stopping_ = true;
+    }
+    idle_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+}
+
+void WorkStealingExecutor::execute(std::function<void()> task) {
+    size_t index = current_pool == this ? current_worker
+                                        : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    // Counted before it is visible, so a worker can never take it first
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        ++queued_;
+    }
+    {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+    idle_.notify_one();
+}
+
+bool WorkStealingExecutor::take(size_t index, std::function<void()>& task) {
+    {
+        Worker& own = *workers_[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < workers_.size(); ++offset) {
+        Worker& victim = *workers_[(index + offset) % workers_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingExecutor::run(size_t index) {
+    current_pool = this;
+    current_worker = index;
+    std::function<void()> task;
+    while (true) {
+        if (take(index, task)) {
+            {
+                std::lock_guard<std::mutex> lock(idle_mutex_);
+                --queued_;
+            }
+            try {
+                task();
+            } catch (...) {
+            }
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        // A task counted in queued_ but not yet visible in a deque is
+        // about to be; the next scan finds it
+        idle_.wait(lock, [this]() { return queued_ > 0 || stopping_; });
+        if (stopping_ && queued_ == 0) {
+            return;
+        }
+    }
+}
+
+void parallel_for(Executor& executor, size_t count, const std::function<void(size_t index)>& work) {
+    // Shared with queued tasks that may only run after this returns; those
+    // find no index left and never touch work
+    struct Run {
+        std::atomic<size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable all_done;
+        size_t done = 0;
+        std::exception_ptr error;
+    };
+    auto run = std::make_shared<Run>();
+    auto take_indexes = [run, count, &work]() {
+        for (size_t index = run->next++; index < count; index = run->next++) {
+            std::exception_ptr error;
+            try {
+                work(index);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(run->mutex);
+            if (error && !run->error) {
+                run->error = error;
+            }
+            if (++run->done == count) {
+                run->all_done.notify_all();
+            }
+        }
+    };
+
+    for (size_t i = 1; i < count; ++i) {
+        executor.execute(take_indexes);
+    }
+    take_indexes();
+
+    std::unique_lock<std::mutex> lock(run->mutex);
+    run->all_done.wait(lock, [&run, count]() { return run->done == count; });
+    if (run->error) {
+        std::rethrow_exception(run->error);
+    }
+}
+
+std::shared_ptr<Executor> default_executor() {
+    const ConfiguredExecutor* configured = configured_default.load(std::memory_order_acquire);
+    while (configured) {
+        if (auto executor = configured->executor.lock()) {
+            return executor;
+        }
+        // Expired only if it was replaced since the load, or at exit
+        const ConfiguredExecutor* latest = configured_default.load(std::memory_order_acquire);
+        if (latest == configured) {
+            break;
+        }
+        configured = latest;
+    }
+    static const std::shared_ptr<Executor> built_in = std::make_shared<WorkStealingExecutor>();
+    return built_in;
+}
+
+void set_default_executor(std::shared_ptr<Executor> executor) {
+    // Released after the lock, since destroying a pool joins its workers
+    std::shared_ptr<Executor> previous;
+    std::lock_guard<std::mutex> lock(configured_owner_mutex);
+    configured_default.store(executor ? new ConfiguredExecutor{executor} : nullptr, std::memory_order_release);
+    previous = std::move(configured_owner);
+    configured_owner = std::move(executor);
+}
+
+} // namespace svm_pay
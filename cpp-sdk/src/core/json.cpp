@@ -0,0 +1,427 @@
+#include "svm-pay/core/json.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <cerrno>
+#include <cstdlib>
+
+namespace svm_pay {
+
+namespace {
+
+const JsonValue null_value;
+
+// Nesting limit so hostile payloads cannot exhaust the stack
+constexpr int MAX_DEPTH = 128;
+
+void append_utf8(std::string& out, uint32_t code_point) {
+    if (code_point < 0x80) {
+        out += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+        out += static_cast<char>(0xC0 | (code_point >> 6));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+        out += static_cast<char>(0xE0 | (code_point >> 12));
+        out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code_point >> 18));
+        out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+}
+
+} // namespace
+
+/**
+ * Recursive-descent parser over a single document
+ */
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : text_(text) {}
+
+    JsonValue parse_document() {
+        JsonValue value = parse_value(0);
+        skip_whitespace();
+        if (pos_ != text_.size()) {
+            fail("trailing characters");
+        }
+        return value;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string& what) const {
+        throw JsonParseException(what + " at offset " + std::to_string(pos_));
+    }
+
+    void skip_whitespace() {
+        while (pos_ < text_.size()) {
+            char c = text_[pos_];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                break;
+            }
+            ++pos_;
+        }
+    }
+
+    char peek() const {
+        return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    void expect(char c) {
+        if (peek() != c) {
+            fail(std::string("expected '") + c + "'");
+        }
+        ++pos_;
+    }
+
+    void expect_literal(const char* literal) {
+        for (const char* p = literal; *p; ++p) {
+            expect(*p);
+        }
+    }
+
+    JsonValue parse_value(int depth) {
+        if (depth > MAX_DEPTH) {
+            fail("nesting too deep");
+        }
+        skip_whitespace();
+
+        JsonValue value;
+        switch (peek()) {
+            case '{':
+                value.type_ = JsonValue::Type::OBJECT;
+                parse_object(value, depth);
+                break;
+            case '[':
+                value.type_ = JsonValue::Type::ARRAY;
+                parse_array(value, depth);
+                break;
+            case '"':
+                value.type_ = JsonValue::Type::STRING;
+                value.text_ = parse_string();
+                break;
+            case 't':
+                expect_literal("true");
+                value.type_ = JsonValue::Type::BOOLEAN;
+                value.bool_ = true;
+                break;
+            case 'f':
+                expect_literal("false");
+                value.type_ = JsonValue::Type::BOOLEAN;
+                break;
+            case 'n':
+                expect_literal("null");
+                break;
+            default:
+                value.type_ = JsonValue::Type::NUMBER;
+                value.text_ = parse_number();
+                break;
+        }
+        return value;
+    }
+
+    void parse_object(JsonValue& value, int depth) {
+        expect('{');
+        skip_whitespace();
+        if (peek() == '}') {
+            ++pos_;
+            return;
+        }
+        while (true) {
+            skip_whitespace();
+            std::string key = parse_string();
+            skip_whitespace();
+            expect(':');
+            value.object_.emplace_back(std::move(key), parse_value(depth + 1));
+            skip_whitespace();
+            if (peek() == ',') {
+                ++pos_;
+                continue;
+            }
+            expect('}');
+            return;
+        }
+    }
+
+    void parse_array(JsonValue& value, int depth) {
+        expect('[');
+        skip_whitespace();
+        if (peek() == ']') {
+            ++pos_;
+            return;
+        }
+        while (true) {
+            value.array_.push_back(parse_value(depth + 1));
+            skip_whitespace();
+            if (peek() == ',') {
+                ++pos_;
+                continue;
+            }
+            expect(']');
+            return;
+        }
+    }
+
+    uint32_t parse_hex4() {
+        if (pos_ + 4 > text_.size()) {
+            fail("truncated unicode escape");
+        }
+        uint32_t result = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = text_[pos_++];
+            result <<= 4;
+            if (c >= '0' && c <= '9') {
+                result |= static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                result |= static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                result |= static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                fail("invalid unicode escape");
+            }
+        }
+        return result;
+    }
+
+    std::string parse_string() {
+        expect('"');
+        std::string result;
+        while (true) {
+            if (pos_ >= text_.size()) {
+                fail("unterminated string");
+            }
+            char c = text_[pos_++];
+            if (c == '"') {
+                return result;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                fail("control character in string");
+            }
+            if (c != '\\') {
+                result += c;
+                continue;
+            }
+            if (pos_ >= text_.size()) {
+                fail("unterminated escape");
+            }
+            char escape = text_[pos_++];
+            switch (escape) {
+                case '"': result += '"'; break;
+                case '\\': result += '\\'; break;
+                case '/': result += '/'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'n': result += '\n'; break;
+                case 'r': result += '\r'; break;
+                case 't': result += '\t'; break;
+                case 'u': {
+                    uint32_t code_point = parse_hex4();
+                    if (code_point >= 0xD800 && code_point < 0xDC00) {
+                        expect('\\');
+                        expect('u');
+                        uint32_t low = parse_hex4();
+                        if (low < 0xDC00 || low >= 0xE000) {
+                            fail("invalid surrogate pair");
+                        }
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    append_utf8(result, code_point);
+                    break;
+                }
+                default:
+                    fail("invalid escape");
+            }
+        }
+    }
+
+    std::string parse_number() {
+        size_t start = pos_;
+        if (peek() == '-') {
+            ++pos_;
+        }
+        if (peek() < '0' || peek() > '9') {
+            fail("unexpected character");
+        }
+        while (peek() >= '0' && peek() <= '9') {
+            ++pos_;
+        }
+        if (peek() == '.') {
+            ++pos_;
+            if (peek() < '0' || peek() > '9') {
+                fail("invalid number");
+            }
+            while (peek() >= '0' && peek() <= '9') {
+                ++pos_;
+            }
+        }
+        if (peek() == 'e' || peek() == 'E') {
+            ++pos_;
+            if (peek() == '+' || peek() == '-') {
+                ++pos_;
+            }
+            if (peek() < '0' || peek() > '9') {
+                fail("invalid number");
+            }
+            while (peek() >= '0' && peek() <= '9') {
+                ++pos_;
+            }
+        }
+        return text_.substr(start, pos_ - start);
+    }
+
+    const std::string& text_;
+    size_t pos_ = 0;
+};
+
+JsonValue JsonValue::parse(const std::string& text) {
+    return JsonParser(text).parse_document();
+}
+
+bool JsonValue::as_bool() const {
+    if (type_ != Type::BOOLEAN) {
+        throw JsonParseException("expected boolean");
+    }
+    return bool_;
+}
+
+int64_t JsonValue::as_int64() const {
+    if (type_ != Type::NUMBER) {
+        throw JsonParseException("expected number");
+    }
+    errno = 0;
+    char* end = nullptr;
+    long long result = std::strtoll(text_.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0') {
+        throw JsonParseException("expected integer, got " + text_);
+    }
+    return static_cast<int64_t>(result);
+}
+
+uint64_t JsonValue::as_uint64() const {
+    if (type_ != Type::NUMBER || text_.front() == '-') {
+        throw JsonParseException("expected unsigned number");
+    }
+    errno = 0;
+    char* end = nullptr;
+    unsigned long long result = std::strtoull(text_.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0') {
+        throw JsonParseException("expected integer, got " + text_);
+    }
+    return static_cast<uint64_t>(result);
+}
+
+double JsonValue::as_double() const {
+    if (type_ != Type::NUMBER) {
+        throw JsonParseException("expected number");
+    }
+    return std::strtod(text_.c_str(), nullptr);
+}
+
+const std::string& JsonValue::as_string() const {
+    if (type_ != Type::STRING) {
+        throw JsonParseException("expected string");
+    }
+    return text_;
+}
+
+const std::vector<JsonValue>& JsonValue::as_array() const {
+    if (type_ != Type::ARRAY) {
+        throw JsonParseException("expected array");
+    }
+    return array_;
+}
+
+const std::vector<std::pair<std::string, JsonValue>>& JsonValue::as_object() const {
+    if (type_ != Type::OBJECT) {
+        throw JsonParseException("expected object");
+    }
+    return object_;
+}
+
+const JsonValue* JsonValue::find(const std::string& key) const {
+    for (const auto& member : object_) {
+        if (member.first == key) {
+            return &member.second;
+        }
+    }
+    return nullptr;
+}
+
+const JsonValue& JsonValue::operator[](const std::string& key) const {
+    const JsonValue* member = find(key);
+    return member ? *member : null_value;
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const {
+    return index < array_.size() ? array_[index] : null_value;
+}
+
+size_t JsonValue::size() const {
+    if (type_ == Type::ARRAY) {
+        return array_.size();
+    }
+    if (type_ == Type::OBJECT) {
+        return object_.size();
+    }
+    return 0;
+}
+
+std::string JsonValue::dump() const {
+    switch (type_) {
+        case Type::NUL:
+            return "null";
+        case Type::BOOLEAN:
+            return bool_ ? "true" : "false";
+        case Type::NUMBER:
+            return text_;
+        case Type::STRING:
+            return "\"" + json_escape(text_) + "\"";
+        case Type::ARRAY: {
+            std::string result = "[";
+            for (size_t i = 0; i < array_.size(); ++i) {
+                if (i > 0) {
+                    result += ',';
+                }
+                result += array_[i].dump();
+            }
+            return result + "]";
+        }
+        case Type::OBJECT: {
+            std::string result = "{";
+            for (size_t i = 0; i < object_.size(); ++i) {
+                if (i > 0) {
+                    result += ',';
+                }
+                result += "\"" + json_escape(object_[i].first) + "\":" + object_[i].second.dump();
+            }
+            return result + "}";
+        }
+    }
+    return "null";
+}
+
+std::string json_escape(const std::string& value) {
+    static const char hex[] = "0123456789abcdef";
+    std::string result;
+    result.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    result += "\\u00";
+                    result += hex[(c >> 4) & 0xF];
+                    result += hex[c & 0xF];
+                } else {
+                    result += c;
+                }
+        }
+    }
+    return result;
+}
+
+} // namespace svm_pay
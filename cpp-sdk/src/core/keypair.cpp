@@ -0,0 +1,141 @@
+#include "svm-pay/core/keypair.hpp"
+#include "svm-pay/core/base58.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace svm_pay {
+
+namespace {
+
+struct MdContextDeleter {
+    void operator()(EVP_MD_CTX* context) const { EVP_MD_CTX_free(context); }
+};
+
+/**
+ * Borrows the thread's digest context, which is reset rather than
+ * reallocated between operations so it holds no key once released
+ */
+class ThreadContext {
+public:
+    ThreadContext() {
+        thread_local std::unique_ptr<EVP_MD_CTX, MdContextDeleter> context(EVP_MD_CTX_new());
+        if (!context) {
+            throw CryptographicException("Failed to allocate digest context");
+        }
+        context_ = context.get();
+    }
+
+    ~ThreadContext() { EVP_MD_CTX_reset(context_); }
+
+    EVP_MD_CTX* get() const { return context_; }
+
+private:
+    EVP_MD_CTX* context_;
+};
+
+} // namespace
+
+struct Keypair::Key {
+    EVP_PKEY* pkey = nullptr;
+    uint8_t seed[SEED_SIZE];
+
+    ~Key() {
+        EVP_PKEY_free(pkey);
+        OPENSSL_cleanse(seed, sizeof(seed));
+    }
+};
+
+Keypair Keypair::generate() {
+    uint8_t seed[SEED_SIZE];
+    if (RAND_bytes(seed, sizeof(seed)) != 1) {
+        throw CryptographicException("Failed to generate secure random bytes");
+    }
+    Keypair keypair = from_seed(seed);
+    OPENSSL_cleanse(seed, sizeof(seed));
+    return keypair;
+}
+
+Keypair Keypair::from_seed(const uint8_t* seed) {
+    auto key = std::make_shared<Key>();
+    std::memcpy(key->seed, seed, SEED_SIZE);
+    key->pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, nullptr, seed, SEED_SIZE);
+    if (!key->pkey) {
+        throw CryptographicException("Failed to create Ed25519 key");
+    }
+    PublicKey public_key;
+    size_t size = PublicKey::SIZE;
+    if (EVP_PKEY_get_raw_public_key(key->pkey, public_key.data(), &size) != 1 || size != PublicKey::SIZE) {
+        throw CryptographicException("Failed to derive Ed25519 public key");
+    }
+    return Keypair(std::move(key), public_key);
+}
+
+Keypair Keypair::from_secret_key(const uint8_t* secret_key, size_t size) {
+    if (size != SECRET_KEY_SIZE) {
+        throw CryptographicException("Secret key must be " + std::to_string(SECRET_KEY_SIZE) + " bytes");
+    }
+    Keypair keypair = from_seed(secret_key);
+    if (std::memcmp(keypair.public_key().data(), secret_key + SEED_SIZE, PublicKey::SIZE) != 0) {
+        throw CryptographicException("Secret key does not match its public key");
+    }
+    return keypair;
+}
+
+Keypair Keypair::from_base58(const std::string& secret_key) {
+    uint8_t bytes[SECRET_KEY_SIZE];
+    if (!decode_base58(secret_key, bytes, sizeof(bytes))) {
+        throw CryptographicException("Secret key is not 64 bytes of base58");
+    }
+    try {
+        Keypair keypair = from_secret_key(bytes, sizeof(bytes));
+        OPENSSL_cleanse(bytes, sizeof(bytes));
+        return keypair;
+    } catch (...) {
+        OPENSSL_cleanse(bytes, sizeof(bytes));
+        throw;
+    }
+}
+
+std::array<uint8_t, Keypair::SECRET_KEY_SIZE> Keypair::secret_key() const {
+    std::array<uint8_t, SECRET_KEY_SIZE> bytes;
+    std::memcpy(bytes.data(), key_->seed, SEED_SIZE);
+    std::memcpy(bytes.data() + SEED_SIZE, public_key_.data(), PublicKey::SIZE);
+    return bytes;
+}
+
+Signature Keypair::sign(const uint8_t* message, size_t size) const {
+    ThreadContext context;
+    Signature signature;
+    size_t signature_size = signature.size();
+    if (EVP_DigestSignInit(context.get(), nullptr, nullptr, nullptr, key_->pkey) != 1 ||
+        EVP_DigestSign(context.get(), signature.data(), &signature_size, message, size) != 1) {
+        throw CryptographicException("Ed25519 signing failed");
+    }
+    return signature;
+}
+
+evp_pkey_st* Keypair::evp_key() const {
+    return key_->pkey;
+}
+
+bool verify_signature(const PublicKey& key, const uint8_t* message, size_t size, const Signature& signature) {
+    EVP_PKEY* pkey = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr, key.data(), PublicKey::SIZE);
+    if (!pkey) {
+        return false;
+    }
+    bool valid;
+    {
+        ThreadContext context;
+        valid = EVP_DigestVerifyInit(context.get(), nullptr, nullptr, nullptr, pkey) == 1 &&
+                EVP_DigestVerify(context.get(), signature.data(), signature.size(), message, size) == 1;
+    }
+    EVP_PKEY_free(pkey);
+    return valid;
+}
+
+} // namespace svm_pay
@@ -0,0 +1,245 @@
+#include "svm-pay/core/payout_packer.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/pda.hpp"
+#include <string>
+#include <unordered_map>
+
+namespace svm_pay {
+
+namespace {
+
+using MintMap = std::unordered_map<PublicKey, const MintInfo*, PublicKeyHash>;
+
+/**
+ * A request with its addresses and amount parsed
+ *
+ * For a token transfer, source and recipient start out as the wallets and
+ * are replaced by their associated token accounts once derived.
+ */
+struct Transfer {
+    PublicKey owner;
+    PublicKey source;
+    PublicKey recipient;
+    const MintInfo* mint = nullptr;
+    uint64_t amount = 0;
+    std::vector<PublicKey> references;
+    const std::string* memo = nullptr;
+    uint64_t units = 0;
+};
+
+PublicKey parse_address(const std::string& text, const char* role, size_t index) {
+    PublicKey key;
+    if (!PublicKey::try_from_base58(text, key)) {
+        throw AddressValidationException("Request " + std::to_string(index) + " has an invalid " + role + ": " + text);
+    }
+    return key;
+}
+
+Transfer resolve(const TransferRequest& request, size_t index, const PublicKey& fee_payer, const MintMap& mints,
+                 const PayoutPackerConfig& config) {
+    Transfer transfer;
+    transfer.owner = request.account ? parse_address(*request.account, "account", index) : fee_payer;
+    transfer.source = transfer.owner;
+    transfer.recipient = parse_address(request.recipient, "recipient", index);
+    for (const auto& reference : request.references) {
+        transfer.references.push_back(parse_address(reference, "reference", index));
+    }
+    if (request.spl_token) {
+        auto found = mints.find(parse_address(*request.spl_token, "token", index));
+        if (found == mints.end()) {
+            throw TransactionException("Request " + std::to_string(index) + " is for unknown mint " +
+                                       *request.spl_token);
+        }
+        transfer.mint = found->second;
+    }
+    try {
+        transfer.amount = parse_token_amount(request.amount, transfer.mint ? transfer.mint->decimals : LAMPORTS_DECIMALS);
+    } catch (const TransactionException&) {
+        throw TransactionException("Request " + std::to_string(index) + " has an invalid amount: " + request.amount);
+    }
+    transfer.units = transfer.mint ? config.token_transfer_units : config.system_transfer_units;
+    if (request.memo) {
+        transfer.memo = &*request.memo;
+        transfer.units += config.memo_units;
+    }
+    return transfer;
+}
+
+// Swap the wallets of token transfers for their associated token accounts,
+// one batch per mint so the derivations are hashed side by side
+void derive_token_accounts(std::vector<Transfer>& transfers) {
+    std::unordered_map<const MintInfo*, std::vector<Transfer*>> by_mint;
+    for (auto& transfer : transfers) {
+        if (transfer.mint) {
+            by_mint[transfer.mint].push_back(&transfer);
+        }
+    }
+    std::vector<PublicKey> wallets;
+    std::vector<PublicKey> accounts;
+    for (const auto& [mint, group] : by_mint) {
+        wallets.clear();
+        for (const Transfer* transfer : group) {
+            wallets.push_back(transfer->source);
+            wallets.push_back(transfer->recipient);
+        }
+        accounts.resize(wallets.size());
+        AssociatedTokenAddressCache::shared().get_many(wallets.data(), wallets.size(), mint->mint, accounts.data(),
+                                                       mint->program);
+        for (size_t i = 0; i < group.size(); ++i) {
+            group[i]->source = accounts[2 * i];
+            group[i]->recipient = accounts[2 * i + 1];
+        }
+    }
+}
+
+void add_transfer(TransactionBuilder& builder, const Transfer& transfer) {
+    if (transfer.memo) {
+        builder.add_memo(*transfer.memo);
+    }
+    if (transfer.mint) {
+        builder.add_transfer_checked(transfer.source, transfer.mint->mint, transfer.recipient, transfer.owner,
+                                     transfer.amount, transfer.mint->decimals, transfer.mint->program);
+    } else {
+        builder.add_system_transfer(transfer.source, transfer.recipient, transfer.amount);
+    }
+    builder.add_references(transfer.references);
+}
+
+class Packer {
+public:
+    Packer(const PublicKey& fee_payer, const Blockhash& blockhash, const PayoutPackerConfig& config)
+        : config_(config) {
+        builder_.set_version(config.lookup_tables.empty() ? MessageVersion::LEGACY : MessageVersion::V0)
+            .set_fee_payer(fee_payer)
+            .set_recent_blockhash(blockhash);
+        for (const auto& table : config.lookup_tables) {
+            builder_.add_lookup_table(table);
+        }
+        base_units_ = (config.set_compute_unit_limit ? config.compute_budget_units : 0) +
+                      (config.compute_unit_price ? config.compute_budget_units : 0);
+        start();
+    }
+
+    void add(size_t index, const Transfer& transfer) {
+        if (try_add(transfer)) {
+            requests_.push_back(index);
+            return;
+        }
+        if (requests_.empty()) {
+            throw TransactionException("Request " + std::to_string(index) + " does not fit in a transaction on its own");
+        }
+        finish();
+        add(index, transfer);
+    }
+
+    std::vector<PackedTransaction> take() {
+        if (!requests_.empty()) {
+            finish();
+        }
+        return std::move(packed_);
+    }
+
+private:
+    void start() {
+        builder_.clear_instructions();
+        // The limit's value does not change the size, so it is filled in by finish()
+        add_compute_budget(builder_, 0);
+        units_ = base_units_;
+        transfers_.clear();
+        requests_.clear();
+    }
+
+    void add_compute_budget(TransactionBuilder& builder, uint32_t units) const {
+        if (config_.set_compute_unit_limit) {
+            builder.add_instruction(compute_unit_limit(units));
+        }
+        if (config_.compute_unit_price) {
+            builder.add_instruction(compute_unit_price(*config_.compute_unit_price));
+        }
+    }
+
+    bool try_add(const Transfer& transfer) {
+        if (config_.max_transfers != 0 && requests_.size() >= config_.max_transfers) {
+            return false;
+        }
+        if (units_ + transfer.units > config_.max_compute_units) {
+            return false;
+        }
+        size_t count = builder_.instruction_count();
+        add_transfer(builder_, transfer);
+        if (!fits()) {
+            builder_.truncate_instructions(count);
+            return false;
+        }
+        units_ += transfer.units;
+        transfers_.push_back(&transfer);
+        return true;
+    }
+
+    bool fits() const {
+        try {
+            return builder_.serialized_size() <= TransactionBuilder::MAX_TRANSACTION_SIZE &&
+                   builder_.num_accounts() <= config_.max_accounts;
+        } catch (const TransactionException&) {
+            return false;  // More accounts than a message can index
+        }
+    }
+
+    void finish() {
+        PackedTransaction packed;
+        packed.transaction = builder_;
+        packed.transaction.clear_instructions();
+        packed.compute_units = static_cast<uint32_t>(units_);
+        add_compute_budget(packed.transaction, packed.compute_units);
+        for (const Transfer* transfer : transfers_) {
+            add_transfer(packed.transaction, *transfer);
+        }
+        packed.size = packed.transaction.serialized_size();
+
+        // A v0 message costs two bytes more when no lookup was worth it
+        if (!config_.lookup_tables.empty()) {
+            packed.transaction.set_version(MessageVersion::LEGACY);
+            size_t legacy_size = packed.transaction.serialized_size();
+            if (legacy_size <= packed.size) {
+                packed.size = legacy_size;
+            } else {
+                packed.transaction.set_version(MessageVersion::V0);
+            }
+        }
+        packed.requests = std::move(requests_);
+        packed_.push_back(std::move(packed));
+        start();
+    }
+
+    const PayoutPackerConfig& config_;
+    TransactionBuilder builder_;
+    uint64_t base_units_ = 0;
+    uint64_t units_ = 0;
+    std::vector<const Transfer*> transfers_;
+    std::vector<size_t> requests_;
+    std::vector<PackedTransaction> packed_;
+};
+
+} // namespace
+
+std::vector<PackedTransaction> pack_transfers(const std::vector<TransferRequest>& requests, const PublicKey& fee_payer,
+                                              const Blockhash& blockhash, const PayoutPackerConfig& config) {
+    MintMap mints;
+    for (const auto& mint : config.mints) {
+        mints.emplace(mint.mint, &mint);
+    }
+    std::vector<Transfer> transfers;
+    transfers.reserve(requests.size());
+    for (size_t i = 0; i < requests.size(); ++i) {
+        transfers.push_back(resolve(requests[i], i, fee_payer, mints, config));
+    }
+    derive_token_accounts(transfers);
+
+    Packer packer(fee_payer, blockhash, config);
+    for (size_t i = 0; i < transfers.size(); ++i) {
+        packer.add(i, transfers[i]);
+    }
+    return packer.take();
+}
+
+} // namespace svm_pay
@@ -0,0 +1,529 @@
+#include "svm-pay/core/pda.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/sha256.hpp"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace svm_pay {
+
+namespace {
+
+// Field arithmetic modulo p = 2^255 - 19 in five 51-bit limbs, enough to
+// tell whether a y coordinate belongs to a point of edwards25519
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 Wide;
+
+inline Wide mul_wide(uint64_t a, uint64_t b) {
+    return static_cast<Wide>(a) * b;
+}
+
+inline Wide widen(uint64_t value) {
+    return value;
+}
+
+inline uint64_t low_bits(Wide value) {
+    return static_cast<uint64_t>(value);
+}
+
+inline uint64_t shift51(Wide value) {
+    return static_cast<uint64_t>(value >> 51);
+}
+#else
+struct Wide {
+    uint64_t lo;
+    uint64_t hi;
+
+    Wide& operator+=(const Wide& other) {
+        lo += other.lo;
+        hi += other.hi + (lo < other.lo);
+        return *this;
+    }
+};
+
+inline Wide mul_wide(uint64_t a, uint64_t b) {
+    uint64_t a_lo = a & 0xFFFFFFFF, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xFFFFFFFF, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo;
+    uint64_t hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi;
+    uint64_t hi_hi = a_hi * b_hi;
+    uint64_t middle = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    return Wide{(middle << 32) | (lo_lo & 0xFFFFFFFF), hi_hi + (hi_lo >> 32) + (middle >> 32)};
+}
+
+inline Wide widen(uint64_t value) {
+    return Wide{value, 0};
+}
+
+inline uint64_t low_bits(Wide value) {
+    return value.lo;
+}
+
+inline uint64_t shift51(Wide value) {
+    return (value.lo >> 51) | (value.hi << 13);
+}
+#endif
+
+constexpr uint64_t LIMB_MASK = (uint64_t(1) << 51) - 1;
+
+struct Fe {
+    uint64_t v[5];
+};
+
+// d = -121665 / 121666, the curve constant
+constexpr Fe CURVE_D = {{929955233495203, 466365720129213, 1662059464998953, 2033849074728123, 1442794654840575}};
+constexpr Fe ONE = {{1, 0, 0, 0, 0}};
+
+uint64_t load64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (size_t i = 8; i > 0; --i) {
+        value = (value << 8) | in[i - 1];
+    }
+    return value;
+}
+
+// The top bit is the sign of x and is ignored; y need not be below p
+Fe fe_from_bytes(const uint8_t* in) {
+    return {{load64(in) & LIMB_MASK, (load64(in + 6) >> 3) & LIMB_MASK, (load64(in + 12) >> 6) & LIMB_MASK,
+             (load64(in + 19) >> 1) & LIMB_MASK, (load64(in + 24) >> 12) & LIMB_MASK}};
+}
+
+Fe fe_add(const Fe& a, const Fe& b) {
+    Fe r;
+    for (size_t i = 0; i < 5; ++i) {
+        r.v[i] = a.v[i] + b.v[i];
+    }
+    return r;
+}
+
+// Adds 2p first so no limb goes negative; b must come out of fe_mul
+Fe fe_sub(const Fe& a, const Fe& b) {
+    Fe r;
+    r.v[0] = a.v[0] + 0xFFFFFFFFFFFDA - b.v[0];
+    for (size_t i = 1; i < 5; ++i) {
+        r.v[i] = a.v[i] + 0xFFFFFFFFFFFFE - b.v[i];
+    }
+    return r;
+}
+
+Fe fe_reduce(Wide r0, Wide r1, Wide r2, Wide r3, Wide r4) {
+    Fe r;
+    r1 += widen(shift51(r0));
+    r.v[0] = low_bits(r0) & LIMB_MASK;
+    r2 += widen(shift51(r1));
+    r.v[1] = low_bits(r1) & LIMB_MASK;
+    r3 += widen(shift51(r2));
+    r.v[2] = low_bits(r2) & LIMB_MASK;
+    r4 += widen(shift51(r3));
+    r.v[3] = low_bits(r3) & LIMB_MASK;
+    r.v[0] += shift51(r4) * 19;
+    r.v[4] = low_bits(r4) & LIMB_MASK;
+    r.v[1] += r.v[0] >> 51;
+    r.v[0] &= LIMB_MASK;
+    return r;
+}
+
+Fe fe_mul(const Fe& a, const Fe& b) {
+    const uint64_t* x = a.v;
+    const uint64_t* y = b.v;
+    uint64_t y1_19 = y[1] * 19, y2_19 = y[2] * 19, y3_19 = y[3] * 19, y4_19 = y[4] * 19;
+
+    Wide r0 = mul_wide(x[0], y[0]);
+    r0 += mul_wide(x[1], y4_19);
+    r0 += mul_wide(x[2], y3_19);
+    r0 += mul_wide(x[3], y2_19);
+    r0 += mul_wide(x[4], y1_19);
+    Wide r1 = mul_wide(x[0], y[1]);
+    r1 += mul_wide(x[1], y[0]);
+    r1 += mul_wide(x[2], y4_19);
+    r1 += mul_wide(x[3], y3_19);
+    r1 += mul_wide(x[4], y2_19);
+    Wide r2 = mul_wide(x[0], y[2]);
+    r2 += mul_wide(x[1], y[1]);
+    r2 += mul_wide(x[2], y[0]);
+    r2 += mul_wide(x[3], y4_19);
+    r2 += mul_wide(x[4], y3_19);
+    Wide r3 = mul_wide(x[0], y[3]);
+    r3 += mul_wide(x[1], y[2]);
+    r3 += mul_wide(x[2], y[1]);
+    r3 += mul_wide(x[3], y[0]);
+    r3 += mul_wide(x[4], y4_19);
+    Wide r4 = mul_wide(x[0], y[4]);
+    r4 += mul_wide(x[1], y[3]);
+    r4 += mul_wide(x[2], y[2]);
+    r4 += mul_wide(x[3], y[1]);
+    r4 += mul_wide(x[4], y[0]);
+
+    return fe_reduce(r0, r1, r2, r3, r4);
+}
+
+// Squaring shares the doubled cross products: 15 multiplies instead of 25
+Fe fe_square(const Fe& a) {
+    const uint64_t* x = a.v;
+    uint64_t x0_2 = x[0] * 2, x1_2 = x[1] * 2, x2_2 = x[2] * 2, x3_2 = x[3] * 2;
+    uint64_t x3_19 = x[3] * 19, x4_19 = x[4] * 19;
+
+    Wide r0 = mul_wide(x[0], x[0]);
+    r0 += mul_wide(x1_2, x4_19);
+    r0 += mul_wide(x2_2, x3_19);
+    Wide r1 = mul_wide(x0_2, x[1]);
+    r1 += mul_wide(x2_2, x4_19);
+    r1 += mul_wide(x[3], x3_19);
+    Wide r2 = mul_wide(x0_2, x[2]);
+    r2 += mul_wide(x[1], x[1]);
+    r2 += mul_wide(x3_2, x4_19);
+    Wide r3 = mul_wide(x0_2, x[3]);
+    r3 += mul_wide(x1_2, x[2]);
+    r3 += mul_wide(x[4], x4_19);
+    Wide r4 = mul_wide(x0_2, x[4]);
+    r4 += mul_wide(x1_2, x[3]);
+    r4 += mul_wide(x[2], x[2]);
+    return fe_reduce(r0, r1, r2, r3, r4);
+}
+
+Fe fe_square_times(Fe a, size_t times) {
+    for (size_t i = 0; i < times; ++i) {
+        a = fe_square(a);
+    }
+    return a;
+}
+
+// z^(2^252 - 3), the usual addition chain
+Fe fe_pow22523(const Fe& z) {
+    Fe z2 = fe_square(z);
+    Fe z9 = fe_mul(fe_square_times(z2, 2), z);
+    Fe z11 = fe_mul(z9, z2);
+    Fe z_5_0 = fe_mul(fe_square(z11), z9);
+    Fe z_10_0 = fe_mul(fe_square_times(z_5_0, 5), z_5_0);
+    Fe z_20_0 = fe_mul(fe_square_times(z_10_0, 10), z_10_0);
+    Fe z_40_0 = fe_mul(fe_square_times(z_20_0, 20), z_20_0);
+    Fe z_50_0 = fe_mul(fe_square_times(z_40_0, 10), z_10_0);
+    Fe z_100_0 = fe_mul(fe_square_times(z_50_0, 50), z_50_0);
+    Fe z_200_0 = fe_mul(fe_square_times(z_100_0, 100), z_100_0);
+    Fe z_250_0 = fe_mul(fe_square_times(z_200_0, 50), z_50_0);
+    return fe_mul(fe_square_times(z_250_0, 2), z);
+}
+
+// Fully reduce below p
+Fe fe_canonical(Fe a) {
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < 4; ++i) {
+            a.v[i + 1] += a.v[i] >> 51;
+            a.v[i] &= LIMB_MASK;
+        }
+        a.v[0] += (a.v[4] >> 51) * 19;
+        a.v[4] &= LIMB_MASK;
+    }
+    // Now below 2^255; subtract p once if at or above it
+    uint64_t q = (a.v[0] + 19) >> 51;
+    for (size_t i = 1; i < 5; ++i) {
+        q = (a.v[i] + q) >> 51;
+    }
+    a.v[0] += 19 * q;
+    for (size_t i = 0; i < 4; ++i) {
+        a.v[i + 1] += a.v[i] >> 51;
+        a.v[i] &= LIMB_MASK;
+    }
+    a.v[4] &= LIMB_MASK;
+    return a;
+}
+
+const char PDA_MARKER[] = "ProgramDerivedAddress";
+constexpr size_t PDA_MARKER_SIZE = sizeof(PDA_MARKER) - 1;
+
+// Longest hash input: every seed at full length, then the program and marker
+constexpr size_t MAX_PDA_INPUT = MAX_SEEDS * MAX_SEED_LENGTH + PublicKey::SIZE + PDA_MARKER_SIZE;
+
+void check_seeds(const SeedView* seeds, size_t count, size_t max_count) {
+    if (count > max_count) {
+        throw std::invalid_argument("A program address takes at most " + std::to_string(MAX_SEEDS) + " seeds");
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (seeds[i].size > MAX_SEED_LENGTH) {
+            throw std::invalid_argument("Program address seed " + std::to_string(i) + " is longer than " +
+                                        std::to_string(MAX_SEED_LENGTH) + " bytes");
+        }
+    }
+}
+
+// Lays out the seeds, a byte for the bump if asked, then the program and
+// the marker; returns where the bump goes
+size_t pda_input(const SeedView* seeds, size_t count, bool with_bump, const PublicKey& program_id, uint8_t* out,
+                 size_t& size) {
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (seeds[i].size > 0) {
+            std::memcpy(out + offset, seeds[i].data, seeds[i].size);
+            offset += seeds[i].size;
+        }
+    }
+    size_t bump_offset = offset;
+    offset += with_bump ? 1 : 0;
+    std::memcpy(out + offset, program_id.data(), PublicKey::SIZE);
+    offset += PublicKey::SIZE;
+    std::memcpy(out + offset, PDA_MARKER, PDA_MARKER_SIZE);
+    size = offset + PDA_MARKER_SIZE;
+    return bump_offset;
+}
+
+// Most bump candidates hashed together; the widest sha256_many lane count
+constexpr size_t MAX_BUMP_BATCH = 8;
+
+void throw_no_bump() {
+    throw CryptographicException("No bump seed puts the program address off the curve");
+}
+
+} // namespace
+
+bool is_on_curve(const PublicKey& key) {
+    // -x^2 + y^2 = 1 + d x^2 y^2, so x^2 = (y^2 - 1) / (d y^2 + 1); the point
+    // exists when that is a square, i.e. when its Legendre symbol
+    // (uv)^((p - 1) / 2) is 0 or 1. v is never 0 since -1/d is not a square.
+    Fe y = fe_from_bytes(key.data());
+    Fe y2 = fe_square(y);
+    Fe u = fe_sub(y2, ONE);
+    Fe v = fe_add(fe_mul(CURVE_D, y2), ONE);
+    Fe t = fe_mul(u, v);
+    Fe r = fe_square_times(fe_pow22523(t), 2);  // t^(2^254 - 12)
+    Fe legendre = fe_canonical(fe_mul(r, fe_square(t)));
+    return legendre.v[0] <= 1 && (legendre.v[1] | legendre.v[2] | legendre.v[3] | legendre.v[4]) == 0;
+}
+
+bool create_program_address(const SeedView* seeds, size_t count, const PublicKey& program_id, PublicKey& out) {
+    check_seeds(seeds, count, MAX_SEEDS);
+    uint8_t input[MAX_PDA_INPUT];
+    size_t size;
+    pda_input(seeds, count, false, program_id, input, size);
+    PublicKey address;
+    sha256(input, size, address.data());
+    if (is_on_curve(address)) {
+        return false;
+    }
+    out = address;
+    return true;
+}
+
+ProgramAddress find_program_address(const SeedView* seeds, size_t count, const PublicKey& program_id) {
+    // The bump is a seed of its own
+    check_seeds(seeds, count, MAX_SEEDS - 1);
+    uint8_t input[MAX_PDA_INPUT];
+    size_t size;
+    size_t bump_offset = pda_input(seeds, count, true, program_id, input, size);
+
+    // Hash as many bumps at once as the hash has lanes, then take the
+    // highest one off the curve; about half of all hashes land off it
+    size_t lanes = std::min(sha256_lanes(), MAX_BUMP_BATCH);
+    uint8_t candidates[MAX_BUMP_BATCH][MAX_PDA_INPUT];
+    const uint8_t* messages[MAX_BUMP_BATCH];
+    size_t sizes[MAX_BUMP_BATCH];
+    for (size_t i = 0; i < lanes; ++i) {
+        std::memcpy(candidates[i], input, size);
+        messages[i] = candidates[i];
+        sizes[i] = size;
+    }
+    uint8_t digests[MAX_BUMP_BATCH * SHA256_SIZE];
+    ProgramAddress result;
+    for (int top = 255; top >= 0; top -= static_cast<int>(lanes)) {
+        size_t batch = std::min(lanes, static_cast<size_t>(top) + 1);
+        for (size_t i = 0; i < batch; ++i) {
+            candidates[i][bump_offset] = static_cast<uint8_t>(top - static_cast<int>(i));
+        }
+        sha256_many(messages, sizes, batch, digests);
+        for (size_t i = 0; i < batch; ++i) {
+            std::memcpy(result.address.data(), digests + i * SHA256_SIZE, PublicKey::SIZE);
+            if (!is_on_curve(result.address)) {
+                result.bump = static_cast<uint8_t>(top - static_cast<int>(i));
+                return result;
+            }
+        }
+    }
+    throw_no_bump();
+    return result;
+}
+
+ProgramAddress find_program_address(std::initializer_list<SeedView> seeds, const PublicKey& program_id) {
+    return find_program_address(seeds.begin(), seeds.size(), program_id);
+}
+
+ProgramAddress derive_associated_token_address(const PublicKey& owner, const PublicKey& mint,
+                                               const PublicKey& token_program) {
+    return find_program_address({owner, token_program, mint}, associated_token_program_id());
+}
+
+void derive_associated_token_addresses(const PublicKey* owners, size_t count, const PublicKey& mint,
+                                       ProgramAddress* out, const PublicKey& token_program) {
+    // One lane per derivation: every lane hashes its own next bump, and a
+    // lane whose derivation is done takes up the next owner
+    constexpr size_t INPUT_SIZE = 3 * PublicKey::SIZE + 1 + PublicKey::SIZE + PDA_MARKER_SIZE;
+    constexpr size_t BUMP_OFFSET = 3 * PublicKey::SIZE;
+    struct Lane {
+        uint8_t input[INPUT_SIZE];
+        size_t owner;
+    };
+
+    size_t lanes = std::min(sha256_lanes(), MAX_BUMP_BATCH);
+    Lane active[MAX_BUMP_BATCH];
+    const uint8_t* messages[MAX_BUMP_BATCH];
+    size_t sizes[MAX_BUMP_BATCH];
+    uint8_t digests[MAX_BUMP_BATCH * SHA256_SIZE];
+    size_t next_owner = 0;
+    size_t running = 0;
+
+    auto start = [&](Lane& lane) {
+        SeedView seeds[] = {owners[next_owner], token_program, mint};
+        size_t size;
+        pda_input(seeds, 3, true, associated_token_program_id(), lane.input, size);
+        lane.input[BUMP_OFFSET] = 255;
+        lane.owner = next_owner++;
+    };
+    while (running < lanes && next_owner < count) {
+        start(active[running++]);
+    }
+
+    while (running > 0) {
+        for (size_t i = 0; i < running; ++i) {
+            messages[i] = active[i].input;
+            sizes[i] = INPUT_SIZE;
+        }
+        sha256_many(messages, sizes, running, digests);
+
+        // Walk backwards so a finished lane can be refilled or swapped out
+        for (size_t i = running; i-- > 0;) {
+            Lane& lane = active[i];
+            ProgramAddress& result = out[lane.owner];
+            std::memcpy(result.address.data(), digests + i * SHA256_SIZE, PublicKey::SIZE);
+            if (is_on_curve(result.address)) {
+                if (lane.input[BUMP_OFFSET] == 0) {
+                    throw_no_bump();
+                }
+                --lane.input[BUMP_OFFSET];
+                continue;
+            }
+            result.bump = lane.input[BUMP_OFFSET];
+            if (next_owner < count) {
+                start(lane);
+            } else {
+                lane = active[--running];
+            }
+        }
+    }
+}
+
+size_t AssociatedTokenAddressCache::KeyHash::operator()(const Key& key) const {
+    // Owners vary the most; mixing in the mint and program keeps a wallet's
+    // accounts for different tokens apart
+    PublicKeyHash hash;
+    return hash(key.owner) ^ (hash(key.mint) * 0x9E3779B97F4A7C15ull) ^ (hash(key.program) * 0xC2B2AE3D27D4EB4Full);
+}
+
+AssociatedTokenAddressCache::AssociatedTokenAddressCache(const AssociatedTokenAddressCacheConfig& config) {
+    size_t shards = 1;
+    while (shards < config.shards) {
+        shards <<= 1;
+    }
+    shards_ = std::make_unique<Shard[]>(shards);
+    shard_mask_ = shards - 1;
+    shard_capacity_ = std::max<size_t>(1, (config.capacity + shards - 1) / shards);
+}
+
+AssociatedTokenAddressCache::Shard& AssociatedTokenAddressCache::shard_for(const Key& key) {
+    // High bits of a multiplicative hash pick the shard; the shard's map
+    // buckets by the low bits of the plain one
+    uint64_t spread = static_cast<uint64_t>(KeyHash{}(key)) * 0x9E3779B97F4A7C15ull;
+    return shards_[static_cast<size_t>(spread >> 32) & shard_mask_];
+}
+
+bool AssociatedTokenAddressCache::lookup(Shard& shard, const Key& key, PublicKey& out) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it == shard.index.end()) {
+        return false;
+    }
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    out = it->second->second;
+    return true;
+}
+
+void AssociatedTokenAddressCache::insert(Shard& shard, const Key& key, const PublicKey& address) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.index.count(key) == 0) {
+        shard.entries.emplace_front(key, address);
+        shard.index.emplace(key, shard.entries.begin());
+        if (shard.entries.size() > shard_capacity_) {
+            shard.index.erase(shard.entries.back().first);
+            shard.entries.pop_back();
+        }
+    }
+}
+
+PublicKey AssociatedTokenAddressCache::get(const PublicKey& owner, const PublicKey& mint,
+                                           const PublicKey& token_program) {
+    Key key{owner, mint, token_program};
+    Shard& shard = shard_for(key);
+    PublicKey address;
+    if (lookup(shard, key, address)) {
+        return address;
+    }
+
+    // Derived unlocked; a racing miss for the same key does the same work
+    address = derive_associated_token_address(owner, mint, token_program).address;
+    insert(shard, key, address);
+    return address;
+}
+
+void AssociatedTokenAddressCache::get_many(const PublicKey* owners, size_t count, const PublicKey& mint,
+                                           PublicKey* out, const PublicKey& token_program) {
+    std::vector<PublicKey> missing;
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < count; ++i) {
+        Key key{owners[i], mint, token_program};
+        if (!lookup(shard_for(key), key, out[i])) {
+            missing.push_back(owners[i]);
+            positions.push_back(i);
+        }
+    }
+    if (missing.empty()) {
+        return;
+    }
+
+    std::vector<ProgramAddress> derived(missing.size());
+    derive_associated_token_addresses(missing.data(), missing.size(), mint, derived.data(), token_program);
+    for (size_t i = 0; i < missing.size(); ++i) {
+        Key key{missing[i], mint, token_program};
+        insert(shard_for(key), key, derived[i].address);
+        out[positions[i]] = derived[i].address;
+    }
+}
+
+void AssociatedTokenAddressCache::clear() {
+    for (size_t i = 0; i <= shard_mask_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        shards_[i].index.clear();
+        shards_[i].entries.clear();
+    }
+}
+
+size_t AssociatedTokenAddressCache::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i <= shard_mask_; ++i) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        total += shards_[i].entries.size();
+    }
+    return total;
+}
+
+AssociatedTokenAddressCache& AssociatedTokenAddressCache::shared() {
+    static AssociatedTokenAddressCache cache;
+    return cache;
+}
+
+PublicKey associated_token_address(const PublicKey& owner, const PublicKey& mint, const PublicKey& token_program) {
+    return AssociatedTokenAddressCache::shared().get(owner, mint, token_program);
+}
+
+} // namespace svm_pay
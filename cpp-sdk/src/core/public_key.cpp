@@ -0,0 +1,23 @@
+#include "svm-pay/core/public_key.hpp"
+#include "svm-pay/core/base58.hpp"
+#include "svm-pay/core/exceptions.hpp"
+
+namespace svm_pay {
+
+PublicKey PublicKey::from_base58(const std::string& address) {
+    PublicKey key;
+    if (!try_from_base58(address, key)) {
+        throw AddressValidationException("Invalid public key: " + address);
+    }
+    return key;
+}
+
+bool PublicKey::try_from_base58(const std::string& address, PublicKey& out) {
+    return decode_base58(address, out.data(), SIZE);
+}
+
+std::string PublicKey::to_base58() const {
+    return encode_base58(bytes_.data(), SIZE);
+}
+
+} // namespace svm_pay
@@ -0,0 +1,99 @@
+#include "svm-pay/core/quantile_sketch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace svm_pay {
+
+QuantileSketch::QuantileSketch(double relative_accuracy) : relative_accuracy_(relative_accuracy) {
+    if (!(relative_accuracy > 0.0 && relative_accuracy < 1.0)) {
+        throw std::invalid_argument("Relative accuracy must be between 0 and 1");
+    }
+    gamma_ = (1.0 + relative_accuracy) / (1.0 - relative_accuracy);
+    log_gamma_ = std::log(gamma_);
+}
+
+size_t QuantileSketch::bucket_of(uint64_t value) const {
+    // Value 1 lands in bucket 0
+    return static_cast<size_t>(std::ceil(std::log(static_cast<double>(value)) / log_gamma_));
+}
+
+uint64_t QuantileSketch::bucket_value(size_t bucket) const {
+    // The point of (gamma^(k-1), gamma^k] with equal relative distance to both bounds
+    double value = 2.0 * std::pow(gamma_, static_cast<double>(bucket)) / (gamma_ + 1.0);
+    return static_cast<uint64_t>(std::min(value, 1.8e19) + 0.5);
+}
+
+void QuantileSketch::add(uint64_t value, uint64_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (value == 0) {
+        zeros_ += count;
+    } else {
+        size_t bucket = bucket_of(value);
+        if (bucket >= buckets_.size()) {
+            buckets_.resize(bucket + 1, 0);
+        }
+        buckets_[bucket] += count;
+    }
+    min_ = count_ == 0 ? value : std::min(min_, value);
+    max_ = std::max(max_, value);
+    count_ += count;
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.relative_accuracy_ != relative_accuracy_) {
+        throw std::invalid_argument("Cannot merge sketches of different accuracy");
+    }
+    if (other.count_ == 0) {
+        return;
+    }
+    if (other.buckets_.size() > buckets_.size()) {
+        buckets_.resize(other.buckets_.size(), 0);
+    }
+    for (size_t i = 0; i < other.buckets_.size(); ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    zeros_ += other.zeros_;
+    min_ = count_ == 0 ? other.min_ : std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    count_ += other.count_;
+}
+
+uint64_t QuantileSketch::quantile(double q) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    q = std::min(std::max(q, 0.0), 1.0);
+    // Zero-based rank of the sample the quantile falls on
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count_ - 1));
+    // The extremes are tracked exactly
+    if (rank == 0) {
+        return min_;
+    }
+    if (rank == count_ - 1) {
+        return max_;
+    }
+    if (rank < zeros_) {
+        return 0;
+    }
+    uint64_t seen = zeros_;
+    for (size_t i = 0; i < buckets_.size(); ++i) {
+        seen += buckets_[i];
+        if (rank < seen) {
+            return std::min(std::max(bucket_value(i), min_), max_);
+        }
+    }
+    return max_;
+}
+
+void QuantileSketch::clear() {
+    std::fill(buckets_.begin(), buckets_.end(), 0);
+    zeros_ = 0;
+    count_ = 0;
+    min_ = 0;
+    max_ = 0;
+}
+
+} // namespace svm_pay
@@ -1,4 +1,5 @@
 #include "svm-pay/core/reference.hpp"
+#include "svm-pay/core/base58.hpp"
 #include "svm-pay/core/exceptions.hpp"
 #include <openssl/rand.h>
 #include <openssl/evp.h>
@@ -10,100 +11,6 @@
 
 namespace svm_pay {
 
-// Base58 alphabet
-static const char* BASE58_ALPHABET = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
-
-/**
- * Encode binary data to base58
- * 
- * @param data The binary data to encode
- * @param size The size of the data
- * @return The base58-encoded string
- */
-std::string encode_base58(const unsigned char* data, size_t size) {
-    std::vector<unsigned char> digits(size * 2);
-    
-    // Count leading zeros
-    size_t leading_zeros = 0;
-    while (leading_zeros < size && data[leading_zeros] == 0) {
-        leading_zeros++;
-    }
-    
-    // Convert to base58
-    std::string result;
-    for (size_t i = leading_zeros; i < size; i++) {
-        int carry = data[i];
-        for (size_t j = 0; j < digits.size(); j++) {
-            carry += 256 * digits[j];
-            digits[j] = carry % 58;
-            carry /= 58;
-        }
-    }
-    
-    // Add leading zeros
-    result.append(leading_zeros, '1');
-    
-    // Convert digits to base58 characters
-    for (int i = digits.size() - 1; i >= 0; i--) {
-        if (digits[i] > 0 || !result.empty()) {
-            result += BASE58_ALPHABET[digits[i]];
-        }
-    }
-    
-    return result;
-}
-
-/**
- * Decode base58 to binary data
- * 
- * @param encoded The base58-encoded string
- * @return The decoded binary data
- */
-std::vector<unsigned char> decode_base58(const std::string& encoded) {
-    std::vector<unsigned char> result(encoded.size() * 733 / 1000 + 1); // log(58) / log(256), rounded up
-    
-    // Count leading '1's
-    size_t leading_ones = 0;
-    while (leading_ones < encoded.size() && encoded[leading_ones] == '1') {
-        leading_ones++;
-    }
-    
-    // Convert from base58
-    for (size_t i = leading_ones; i < encoded.size(); i++) {
-        int carry = -1;  // Initialize to invalid value
-        
-        // Find the character in the alphabet
-        for (int j = 0; j < 58; j++) {
-            if (BASE58_ALPHABET[j] == encoded[i]) {
-                carry = j;
-                break;
-            }
-        }
-        
-        // Check if character was found
-        if (carry == -1) {
-            throw ReferenceException("Invalid base58 character: " + std::string(1, encoded[i]));
-        }
-        
-        for (size_t j = 0; j < result.size(); j++) {
-            carry += 58 * result[j];
-            result[j] = carry % 256;
-            carry /= 256;
-        }
-    }
-    
-    // Add leading zeros
-    result.insert(result.begin(), leading_ones, 0);
-    
-    // Remove excess zeros
-    while (result.size() > 1 && result.back() == 0) {
-        result.pop_back();
-    }
-    
-    std::reverse(result.begin(), result.end());
-    return result;
-}
-
 std::string generate_reference(size_t length) {
     if (length == 0) {
         throw std::invalid_argument("Reference length must be greater than 0");
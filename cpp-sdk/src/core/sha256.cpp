@@ -0,0 +1,445 @@
+#include "svm-pay/core/sha256.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SVM_PAY_SHA256_X86 1
+#include <immintrin.h>
+#define SVM_PAY_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace svm_pay {
+
+namespace {
+
+alignas(32) const uint32_t ROUND_CONSTANTS[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+const uint32_t INITIAL_STATE[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                   0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+constexpr size_t BLOCK_SIZE = 64;
+
+inline uint32_t load_be32(const uint8_t* in) {
+    return (static_cast<uint32_t>(in[0]) << 24) | (static_cast<uint32_t>(in[1]) << 16) |
+           (static_cast<uint32_t>(in[2]) << 8) | static_cast<uint32_t>(in[3]);
+}
+
+inline void store_be32(uint32_t value, uint8_t* out) {
+    out[0] = static_cast<uint8_t>(value >> 24);
+    out[1] = static_cast<uint8_t>(value >> 16);
+    out[2] = static_cast<uint8_t>(value >> 8);
+    out[3] = static_cast<uint8_t>(value);
+}
+
+inline uint32_t rotr(uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+void store_digest(const uint32_t state[8], uint8_t* out) {
+    for (size_t i = 0; i < 8; ++i) {
+        store_be32(state[i], out + 4 * i);
+    }
+}
+
+/**
+ * Lay out the last one or two blocks of a message: its trailing partial
+ * block, the 0x80 marker and the bit length; returns the block count
+ */
+size_t pad_tail(const uint8_t* data, size_t size, uint8_t tail[2 * BLOCK_SIZE]) {
+    size_t remaining = size % BLOCK_SIZE;
+    std::memset(tail, 0, 2 * BLOCK_SIZE);
+    if (remaining > 0) {
+        std::memcpy(tail, data + size - remaining, remaining);
+    }
+    tail[remaining] = 0x80;
+    size_t blocks = remaining < BLOCK_SIZE - 8 ? 1 : 2;
+    uint64_t bits = static_cast<uint64_t>(size) * 8;
+    uint8_t* length = tail + blocks * BLOCK_SIZE - 8;
+    store_be32(static_cast<uint32_t>(bits >> 32), length);
+    store_be32(static_cast<uint32_t>(bits), length + 4);
+    return blocks;
+}
+
+void compress_scalar(uint32_t state[8], const uint8_t* data, size_t blocks) {
+    uint32_t w[64];
+    for (; blocks > 0; --blocks, data += BLOCK_SIZE) {
+        for (size_t t = 0; t < 16; ++t) {
+            w[t] = load_be32(data + 4 * t);
+        }
+        for (size_t t = 16; t < 64; ++t) {
+            uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (size_t t = 0; t < 64; ++t) {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + ROUND_CONSTANTS[t] + w[t];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef SVM_PAY_SHA256_X86
+
+// Messages hashed side by side with the SHA extensions. A message's rounds
+// form one long dependency chain, so interleaving a few keeps the SHA unit
+// busy while each waits on its previous result
+constexpr size_t SHA_NI_LANES = 2;
+
+// Follows the reference sequence in Intel's "Intel SHA Extensions" paper:
+// the state lives as ABEF and CDGH, each instruction runs two rounds
+SVM_PAY_TARGET("sha,sse4.1")
+inline void load_state_sha_ni(const uint32_t state[8], __m128i& abef, __m128i& cdgh) {
+    __m128i cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+    __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+    abef = _mm_alignr_epi8(cdab, efgh, 8);
+    cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+}
+
+SVM_PAY_TARGET("sha,sse4.1")
+inline void store_state_sha_ni(__m128i abef, __m128i cdgh, uint32_t state[8]) {
+    __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+/**
+ * Compress one block of each of Lanes messages, round by round in step
+ */
+template <size_t Lanes>
+SVM_PAY_TARGET("sha,sse4.1")
+inline void rounds_sha_ni(__m128i abef[Lanes], __m128i cdgh[Lanes], const uint8_t* const blocks[Lanes]) {
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    __m128i abef_saved[Lanes];
+    __m128i cdgh_saved[Lanes];
+    __m128i w[Lanes][4];
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+        abef_saved[lane] = abef[lane];
+        cdgh_saved[lane] = cdgh[lane];
+    }
+    for (size_t group = 0; group < 16; ++group) {
+        __m128i constants = _mm_load_si128(reinterpret_cast<const __m128i*>(ROUND_CONSTANTS + 4 * group));
+        for (size_t lane = 0; lane < Lanes; ++lane) {
+            __m128i& words = w[lane][group % 4];
+            if (group < 4) {
+                words = _mm_shuffle_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks[lane] + 16 * group)), byte_swap);
+            } else {
+                const __m128i& previous = w[lane][(group + 3) % 4];
+                words = _mm_sha256msg1_epu32(words, w[lane][(group + 1) % 4]);
+                words = _mm_add_epi32(words, _mm_alignr_epi8(previous, w[lane][(group + 2) % 4], 4));
+                words = _mm_sha256msg2_epu32(words, previous);
+            }
+            __m128i message = _mm_add_epi32(words, constants);
+            cdgh[lane] = _mm_sha256rnds2_epu32(cdgh[lane], abef[lane], message);
+            abef[lane] = _mm_sha256rnds2_epu32(abef[lane], cdgh[lane], _mm_shuffle_epi32(message, 0x0E));
+        }
+    }
+    for (size_t lane = 0; lane < Lanes; ++lane) {
+        abef[lane] = _mm_add_epi32(abef[lane], abef_saved[lane]);
+        cdgh[lane] = _mm_add_epi32(cdgh[lane], cdgh_saved[lane]);
+    }
+}
+
+SVM_PAY_TARGET("sha,sse4.1")
+void compress_sha_ni(uint32_t state[8], const uint8_t* data, size_t blocks) {
+    __m128i abef;
+    __m128i cdgh;
+    load_state_sha_ni(state, abef, cdgh);
+    for (; blocks > 0; --blocks, data += BLOCK_SIZE) {
+        rounds_sha_ni<1>(&abef, &cdgh, &data);
+    }
+    store_state_sha_ni(abef, cdgh, state);
+}
+
+/**
+ * Hash SHA_NI_LANES messages interleaved; once the shortest is done the
+ * rest finish one at a time
+ */
+SVM_PAY_TARGET("sha,sse4.1")
+void hash_lanes_sha_ni(const uint8_t* const* messages, const size_t* sizes, uint8_t* out) {
+    uint8_t tails[SHA_NI_LANES][2 * BLOCK_SIZE];
+    size_t full_blocks[SHA_NI_LANES];
+    size_t total_blocks[SHA_NI_LANES];
+    size_t fewest_blocks = SIZE_MAX;
+    __m128i abef[SHA_NI_LANES];
+    __m128i cdgh[SHA_NI_LANES];
+    for (size_t lane = 0; lane < SHA_NI_LANES; ++lane) {
+        full_blocks[lane] = sizes[lane] / BLOCK_SIZE;
+        total_blocks[lane] = full_blocks[lane] + pad_tail(messages[lane], sizes[lane], tails[lane]);
+        fewest_blocks = std::min(fewest_blocks, total_blocks[lane]);
+        load_state_sha_ni(INITIAL_STATE, abef[lane], cdgh[lane]);
+    }
+    auto block_of = [&](size_t lane, size_t block) -> const uint8_t* {
+        return block < full_blocks[lane] ? messages[lane] + block * BLOCK_SIZE
+                                         : tails[lane] + (block - full_blocks[lane]) * BLOCK_SIZE;
+    };
+
+    for (size_t block = 0; block < fewest_blocks; ++block) {
+        const uint8_t* blocks[SHA_NI_LANES];
+        for (size_t lane = 0; lane < SHA_NI_LANES; ++lane) {
+            blocks[lane] = block_of(lane, block);
+        }
+        rounds_sha_ni<SHA_NI_LANES>(abef, cdgh, blocks);
+    }
+    for (size_t lane = 0; lane < SHA_NI_LANES; ++lane) {
+        for (size_t block = fewest_blocks; block < total_blocks[lane]; ++block) {
+            const uint8_t* data = block_of(lane, block);
+            rounds_sha_ni<1>(&abef[lane], &cdgh[lane], &data);
+        }
+        uint32_t state[8];
+        store_state_sha_ni(abef[lane], cdgh[lane], state);
+        store_digest(state, out + lane * SHA256_SIZE);
+    }
+}
+
+// Eight messages, one per 32-bit lane: every vector holds the same state or
+// schedule word of all eight
+
+SVM_PAY_TARGET("avx2")
+inline __m256i rotr8x(__m256i value, int bits) {
+    return _mm256_or_si256(_mm256_srli_epi32(value, bits), _mm256_slli_epi32(value, 32 - bits));
+}
+
+SVM_PAY_TARGET("avx2")
+inline __m256i load_word8x(const uint8_t* const blocks[8], size_t offset, __m256i byte_swap) {
+    uint32_t words[8];
+    for (size_t lane = 0; lane < 8; ++lane) {
+        std::memcpy(&words[lane], blocks[lane] + offset, 4);
+    }
+    return _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words)), byte_swap);
+}
+
+/**
+ * Compress one block per lane; lanes outside active keep their state
+ */
+SVM_PAY_TARGET("avx2")
+void compress_avx2(__m256i state[8], const uint8_t* const blocks[8], __m256i active) {
+    const __m256i byte_swap = _mm256_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL,
+                                                0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    __m256i w[16];
+    __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+    __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (size_t t = 0; t < 64; ++t) {
+        __m256i word;
+        if (t < 16) {
+            word = load_word8x(blocks, 4 * t, byte_swap);
+        } else {
+            __m256i w15 = w[(t - 15) % 16];
+            __m256i w2 = w[(t - 2) % 16];
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(w15, 7), rotr8x(w15, 18)), _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(w2, 17), rotr8x(w2, 19)), _mm256_srli_epi32(w2, 10));
+            word = _mm256_add_epi32(_mm256_add_epi32(w[t % 16], s0), _mm256_add_epi32(w[(t - 7) % 16], s1));
+        }
+        w[t % 16] = word;
+
+        __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(e, 6), rotr8x(e, 11)), rotr8x(e, 25));
+        __m256i choose = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, sigma1),
+                                      _mm256_add_epi32(choose, _mm256_add_epi32(word, _mm256_set1_epi32(
+                                                                   static_cast<int>(ROUND_CONSTANTS[t])))));
+        __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(a, 2), rotr8x(a, 13)), rotr8x(a, 22));
+        __m256i majority = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, _mm256_add_epi32(sigma0, majority));
+    }
+
+    __m256i rounds[8] = {a, b, c, d, e, f, g, h};
+    for (size_t i = 0; i < 8; ++i) {
+        state[i] = _mm256_blendv_epi8(state[i], _mm256_add_epi32(state[i], rounds[i]), active);
+    }
+}
+
+/**
+ * Hash up to eight messages side by side
+ */
+SVM_PAY_TARGET("avx2")
+void hash8_avx2(const uint8_t* const* messages, const size_t* sizes, size_t count, uint8_t* out) {
+    alignas(64) static const uint8_t idle[BLOCK_SIZE] = {};
+    // Each lane reads whole blocks straight from its message, then its tail
+    uint8_t tails[8][2 * BLOCK_SIZE];
+    size_t full_blocks[8] = {};
+    size_t total_blocks[8] = {};
+    size_t most_blocks = 0;
+    for (size_t lane = 0; lane < count; ++lane) {
+        full_blocks[lane] = sizes[lane] / BLOCK_SIZE;
+        total_blocks[lane] = full_blocks[lane] + pad_tail(messages[lane], sizes[lane], tails[lane]);
+        most_blocks = std::max(most_blocks, total_blocks[lane]);
+    }
+
+    __m256i state[8];
+    for (size_t i = 0; i < 8; ++i) {
+        state[i] = _mm256_set1_epi32(static_cast<int>(INITIAL_STATE[i]));
+    }
+    for (size_t block = 0; block < most_blocks; ++block) {
+        const uint8_t* blocks[8];
+        alignas(32) int32_t active[8];
+        for (size_t lane = 0; lane < 8; ++lane) {
+            active[lane] = lane < count && block < total_blocks[lane] ? -1 : 0;
+            if (!active[lane]) {
+                blocks[lane] = idle;
+            } else if (block < full_blocks[lane]) {
+                blocks[lane] = messages[lane] + block * BLOCK_SIZE;
+            } else {
+                blocks[lane] = tails[lane] + (block - full_blocks[lane]) * BLOCK_SIZE;
+            }
+        }
+        compress_avx2(state, blocks, _mm256_load_si256(reinterpret_cast<const __m256i*>(active)));
+    }
+
+    alignas(32) uint32_t words[8][8];
+    for (size_t i = 0; i < 8; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(words[i]), state[i]);
+    }
+    for (size_t lane = 0; lane < count; ++lane) {
+        for (size_t i = 0; i < 8; ++i) {
+            store_be32(words[i][lane], out + lane * SHA256_SIZE + 4 * i);
+        }
+    }
+}
+
+bool cpu_supports(Sha256Implementation implementation) {
+    switch (implementation) {
+        case Sha256Implementation::SHA_NI:
+            return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+        case Sha256Implementation::AVX2:
+            return __builtin_cpu_supports("avx2");
+        default:
+            return true;
+    }
+}
+
+#else
+
+bool cpu_supports(Sha256Implementation implementation) {
+    return implementation == Sha256Implementation::SCALAR;
+}
+
+#endif
+
+Sha256Implementation detect_implementation() {
+    for (auto implementation : {Sha256Implementation::SHA_NI, Sha256Implementation::AVX2}) {
+        if (cpu_supports(implementation)) {
+            return implementation;
+        }
+    }
+    return Sha256Implementation::SCALAR;
+}
+
+std::atomic<Sha256Implementation>& active_implementation() {
+    static std::atomic<Sha256Implementation> implementation(detect_implementation());
+    return implementation;
+}
+
+void hash_one(Sha256Implementation implementation, const uint8_t* data, size_t size, uint8_t* out) {
+    uint32_t state[8];
+    std::memcpy(state, INITIAL_STATE, sizeof(state));
+    uint8_t tail[2 * BLOCK_SIZE];
+    size_t tail_blocks = pad_tail(data, size, tail);
+#ifdef SVM_PAY_SHA256_X86
+    if (implementation == Sha256Implementation::SHA_NI) {
+        compress_sha_ni(state, data, size / BLOCK_SIZE);
+        compress_sha_ni(state, tail, tail_blocks);
+        store_digest(state, out);
+        return;
+    }
+#else
+    (void)implementation;
+#endif
+    compress_scalar(state, data, size / BLOCK_SIZE);
+    compress_scalar(state, tail, tail_blocks);
+    store_digest(state, out);
+}
+
+} // namespace
+
+Sha256Implementation sha256_implementation() {
+    return active_implementation().load(std::memory_order_relaxed);
+}
+
+bool set_sha256_implementation(Sha256Implementation implementation) {
+    if (!cpu_supports(implementation)) {
+        return false;
+    }
+    active_implementation().store(implementation, std::memory_order_relaxed);
+    return true;
+}
+
+size_t sha256_lanes() {
+    switch (sha256_implementation()) {
+        case Sha256Implementation::AVX2:
+            return 8;
+#ifdef SVM_PAY_SHA256_X86
+        case Sha256Implementation::SHA_NI:
+            return SHA_NI_LANES;
+#endif
+        default:
+            return 1;
+    }
+}
+
+void sha256(const uint8_t* data, size_t size, uint8_t* out) {
+    hash_one(sha256_implementation(), data, size, out);
+}
+
+void sha256_many(const uint8_t* const* messages, const size_t* sizes, size_t count, uint8_t* out) {
+    Sha256Implementation implementation = sha256_implementation();
+#ifdef SVM_PAY_SHA256_X86
+    if (implementation == Sha256Implementation::AVX2) {
+        for (size_t i = 0; i < count; i += 8) {
+            hash8_avx2(messages + i, sizes + i, std::min<size_t>(8, count - i), out + i * SHA256_SIZE);
+        }
+        return;
+    }
+    if (implementation == Sha256Implementation::SHA_NI) {
+        size_t grouped = count - count % SHA_NI_LANES;
+        for (size_t i = 0; i < grouped; i += SHA_NI_LANES) {
+            hash_lanes_sha_ni(messages + i, sizes + i, out + i * SHA256_SIZE);
+        }
+        for (size_t i = grouped; i < count; ++i) {
+            hash_one(implementation, messages[i], sizes[i], out + i * SHA256_SIZE);
+        }
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        hash_one(implementation, messages[i], sizes[i], out + i * SHA256_SIZE);
+    }
+}
+
+} // namespace svm_pay
@@ -0,0 +1,745 @@
+#include "svm-pay/core/transaction.hpp"
+#include "svm-pay/core/base58.hpp"
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace svm_pay {
+
+namespace {
+
+// Prefix byte of versioned messages; the low bits carry the version
+constexpr uint8_t VERSION_PREFIX = 0x80;
+
+constexpr size_t SIGNATURE_SIZE = 64;
+
+// System program instruction discriminants
+constexpr uint32_t SYSTEM_CREATE_ACCOUNT = 0;
+constexpr uint32_t SYSTEM_TRANSFER = 2;
+constexpr uint32_t SYSTEM_ADVANCE_NONCE = 4;
+constexpr uint32_t SYSTEM_INITIALIZE_NONCE = 6;
+
+const uint8_t ADVANCE_NONCE_DATA[4] = {SYSTEM_ADVANCE_NONCE, 0, 0, 0};
+
+// Compute Budget program instruction tags
+constexpr uint8_t COMPUTE_UNIT_LIMIT = 2;
+constexpr uint8_t COMPUTE_UNIT_PRICE = 3;
+
+// SPL Token instruction tag for TransferChecked
+constexpr uint8_t TOKEN_TRANSFER_CHECKED = 12;
+
+void put_u32_le(uint8_t* out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+void put_u64_le(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+} // namespace
+
+const PublicKey& system_program_id() {
+    static const PublicKey key = PublicKey::from_base58("11111111111111111111111111111111");
+    return key;
+}
+
+const PublicKey& token_program_id() {
+    static const PublicKey key = PublicKey::from_base58("TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA");
+    return key;
+}
+
+const PublicKey& token_2022_program_id() {
+    static const PublicKey key = PublicKey::from_base58("TokenzQdBNbLqP5VEhdkAS6EPFLC1PHnBqCXEpPxuEb");
+    return key;
+}
+
+const PublicKey& associated_token_program_id() {
+    static const PublicKey key = PublicKey::from_base58("ATokenGPvbdGVxr1b2hvZbsiqW5xWH25efTNsLJA8knL");
+    return key;
+}
+
+const PublicKey& memo_program_id() {
+    static const PublicKey key = PublicKey::from_base58("MemoSq4gqABAXKb96qnH8TysNcWxMyWCqXgDLGmfcHr");
+    return key;
+}
+
+const PublicKey& compute_budget_program_id() {
+    static const PublicKey key = PublicKey::from_base58("ComputeBudget111111111111111111111111111111");
+    return key;
+}
+
+const PublicKey& sysvar_recent_blockhashes_id() {
+    static const PublicKey key = PublicKey::from_base58("SysvarRecentB1ockHashes11111111111111111111");
+    return key;
+}
+
+const PublicKey& sysvar_rent_id() {
+    static const PublicKey key = PublicKey::from_base58("SysvarRent111111111111111111111111111111111");
+    return key;
+}
+
+Instruction system_transfer(const PublicKey& from, const PublicKey& to, uint64_t lamports) {
+    Instruction instruction;
+    instruction.program_id = system_program_id();
+    instruction.accounts = {{from, true, true}, {to, false, true}};
+    instruction.data.resize(12);
+    put_u32_le(instruction.data.data(), SYSTEM_TRANSFER);
+    put_u64_le(instruction.data.data() + 4, lamports);
+    return instruction;
+}
+
+Instruction system_create_account(const PublicKey& from, const PublicKey& new_account, uint64_t lamports,
+                                  uint64_t space, const PublicKey& owner) {
+    Instruction instruction;
+    instruction.program_id = system_program_id();
+    instruction.accounts = {{from, true, true}, {new_account, true, true}};
+    instruction.data.resize(52);
+    put_u32_le(instruction.data.data(), SYSTEM_CREATE_ACCOUNT);
+    put_u64_le(instruction.data.data() + 4, lamports);
+    put_u64_le(instruction.data.data() + 12, space);
+    std::copy(owner.data(), owner.data() + PublicKey::SIZE, instruction.data.data() + 20);
+    return instruction;
+}
+
+Instruction nonce_initialize(const PublicKey& nonce_account, const PublicKey& authority) {
+    Instruction instruction;
+    instruction.program_id = system_program_id();
+    instruction.accounts = {{nonce_account, false, true},
+                            {sysvar_recent_blockhashes_id(), false, false},
+                            {sysvar_rent_id(), false, false}};
+    instruction.data.resize(36);
+    put_u32_le(instruction.data.data(), SYSTEM_INITIALIZE_NONCE);
+    std::copy(authority.data(), authority.data() + PublicKey::SIZE, instruction.data.data() + 4);
+    return instruction;
+}
+
+Instruction nonce_advance(const PublicKey& nonce_account, const PublicKey& authority) {
+    Instruction instruction;
+    instruction.program_id = system_program_id();
+    instruction.accounts = {{nonce_account, false, true},
+                            {sysvar_recent_blockhashes_id(), false, false},
+                            {authority, true, false}};
+    instruction.data.assign(ADVANCE_NONCE_DATA, ADVANCE_NONCE_DATA + sizeof(ADVANCE_NONCE_DATA));
+    return instruction;
+}
+
+Instruction compute_unit_limit(uint32_t units) {
+    Instruction instruction;
+    instruction.program_id = compute_budget_program_id();
+    instruction.data.resize(5);
+    instruction.data[0] = COMPUTE_UNIT_LIMIT;
+    put_u32_le(instruction.data.data() + 1, units);
+    return instruction;
+}
+
+Instruction compute_unit_price(uint64_t micro_lamports) {
+    Instruction instruction;
+    instruction.program_id = compute_budget_program_id();
+    instruction.data.resize(9);
+    instruction.data[0] = COMPUTE_UNIT_PRICE;
+    put_u64_le(instruction.data.data() + 1, micro_lamports);
+    return instruction;
+}
+
+Instruction spl_transfer_checked(const PublicKey& source, const PublicKey& mint, const PublicKey& destination,
+                                 const PublicKey& owner, uint64_t amount, uint8_t decimals,
+                                 const PublicKey& token_program) {
+    Instruction instruction;
+    instruction.program_id = token_program;
+    instruction.accounts = {{source, false, true}, {mint, false, false}, {destination, false, true}, {owner, true, false}};
+    instruction.data.resize(10);
+    instruction.data[0] = TOKEN_TRANSFER_CHECKED;
+    put_u64_le(instruction.data.data() + 1, amount);
+    instruction.data[9] = decimals;
+    return instruction;
+}
+
+Instruction memo_instruction(const std::string& memo, const std::vector<PublicKey>& signers) {
+    Instruction instruction;
+    instruction.program_id = memo_program_id();
+    for (const auto& signer : signers) {
+        instruction.accounts.push_back({signer, true, false});
+    }
+    instruction.data.assign(memo.begin(), memo.end());
+    return instruction;
+}
+
+size_t encode_compact_u16(uint16_t value, uint8_t* out) {
+    size_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = static_cast<uint8_t>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out[size++] = static_cast<uint8_t>(value);
+    return size;
+}
+
+size_t decode_compact_u16(const uint8_t* data, size_t size, uint16_t& value) {
+    uint32_t result = 0;
+    for (size_t i = 0; i < 3 && i < size; ++i) {
+        result |= static_cast<uint32_t>(data[i] & 0x7f) << (7 * i);
+        if ((data[i] & 0x80) == 0) {
+            // Reject overlong encodings and values beyond 16 bits
+            if ((i > 0 && data[i] == 0) || result > std::numeric_limits<uint16_t>::max()) {
+                return 0;
+            }
+            value = static_cast<uint16_t>(result);
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+bool verify_transaction(const uint8_t* data, size_t size) {
+    uint16_t num_signatures;
+    size_t offset = decode_compact_u16(data, size, num_signatures);
+    if (offset == 0 || num_signatures == 0 || size - offset < SIGNATURE_SIZE * num_signatures) {
+        return false;
+    }
+    const uint8_t* signatures = data + offset;
+    const uint8_t* message = signatures + SIGNATURE_SIZE * num_signatures;
+    size_t message_size = size - offset - SIGNATURE_SIZE * num_signatures;
+
+    size_t position = message_size > 0 && (message[0] & VERSION_PREFIX) ? 1 : 0;
+    if (message_size < position + 3 || message[position] != num_signatures) {
+        return false;
+    }
+    position += 3;
+    uint16_t num_keys;
+    size_t consumed = decode_compact_u16(message + position, message_size - position, num_keys);
+    position += consumed;
+    if (consumed == 0 || num_keys < num_signatures || message_size - position < PublicKey::SIZE * num_keys) {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < num_signatures; ++i) {
+        PublicKey key;
+        std::copy(message + position + PublicKey::SIZE * i, message + position + PublicKey::SIZE * (i + 1), key.data());
+        Signature signature;
+        std::copy(signatures + SIGNATURE_SIZE * i, signatures + SIGNATURE_SIZE * (i + 1), signature.data());
+        if (!verify_signature(key, message, message_size, signature)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string transaction_signature(const uint8_t* data, size_t size) {
+    uint16_t num_signatures;
+    size_t offset = decode_compact_u16(data, size, num_signatures);
+    if (offset == 0 || num_signatures == 0 || size - offset < SIGNATURE_SIZE) {
+        throw TransactionException("Transaction has no signatures");
+    }
+    const uint8_t* signature = data + offset;
+    if (std::all_of(signature, signature + SIGNATURE_SIZE, [](uint8_t byte) { return byte == 0; })) {
+        throw TransactionException("Transaction is not signed");
+    }
+    return encode_base58(signature, SIGNATURE_SIZE);
+}
+
+uint64_t parse_token_amount(const std::string& amount, uint8_t decimals) {
+    auto dot = amount.find('.');
+    std::string whole = amount.substr(0, dot);
+    std::string fraction = dot == std::string::npos ? "" : amount.substr(dot + 1);
+    if (whole.empty() && fraction.empty()) {
+        throw TransactionException("Invalid amount: " + amount);
+    }
+    if (fraction.size() > decimals) {
+        throw TransactionException("Amount " + amount + " has more than " + std::to_string(decimals) + " decimals");
+    }
+
+    uint64_t value = 0;
+    auto shift_in = [&](uint64_t digit) {
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+            throw TransactionException("Amount out of range: " + amount);
+        }
+        value = value * 10 + digit;
+    };
+    for (const std::string* part : {&whole, &fraction}) {
+        for (char c : *part) {
+            if (c < '0' || c > '9') {
+                throw TransactionException("Invalid amount: " + amount);
+            }
+            shift_in(static_cast<uint64_t>(c - '0'));
+        }
+    }
+    for (size_t i = fraction.size(); i < decimals; ++i) {
+        shift_in(0);
+    }
+    return value;
+}
+
+/**
+ * Accounts of a transaction in wire order, plus the v0 lookups
+ */
+struct TransactionBuilder::Compiled {
+    // Keys point into the builder's own storage, so compiling copies no keys
+    struct Key {
+        const PublicKey* key;
+        bool signer;
+        bool writable;
+        bool invoked;
+    };
+
+    struct Lookup {
+        const AddressLookupTable* table;
+        std::vector<uint8_t> writable;
+        std::vector<uint8_t> readonly;
+    };
+
+    Key keys[MAX_ACCOUNTS];
+    size_t num_keys = 0;  // Static keys
+    uint8_t header[3] = {0, 0, 0};
+
+    // Loaded addresses follow the static keys in the index space: all
+    // writable ones, then all read-only ones
+    const PublicKey* loaded[MAX_ACCOUNTS];
+    size_t num_loaded = 0;
+    std::vector<Lookup> lookups;
+
+    uint8_t index_of(const PublicKey& key) const {
+        for (size_t i = 0; i < num_keys; ++i) {
+            if (*keys[i].key == key) {
+                return static_cast<uint8_t>(i);
+            }
+        }
+        for (size_t i = 0; i < num_loaded; ++i) {
+            if (*loaded[i] == key) {
+                return static_cast<uint8_t>(num_keys + i);
+            }
+        }
+        throw TransactionException("Account missing from compiled message");
+    }
+};
+
+/**
+ * Bounds-checked output cursor; with no buffer it only counts bytes
+ */
+class TransactionBuilder::Writer {
+public:
+    Writer(uint8_t* out, size_t capacity) : out_(out), capacity_(capacity) {}
+
+    void put(uint8_t byte) {
+        reserve(1);
+        if (out_) {
+            out_[size_] = byte;
+        }
+        ++size_;
+    }
+
+    void put(const uint8_t* data, size_t size) {
+        reserve(size);
+        if (out_ && size > 0) {
+            std::copy(data, data + size, out_ + size_);
+        }
+        size_ += size;
+    }
+
+    void zeros(size_t size) {
+        reserve(size);
+        if (out_) {
+            std::fill(out_ + size_, out_ + size_ + size, 0);
+        }
+        size_ += size;
+    }
+
+    void compact(size_t value) {
+        if (value > std::numeric_limits<uint16_t>::max()) {
+            throw TransactionException("Length " + std::to_string(value) + " exceeds compact-u16 range");
+        }
+        uint8_t encoded[3];
+        put(encoded, encode_compact_u16(static_cast<uint16_t>(value), encoded));
+    }
+
+    size_t size() const { return size_; }
+
+private:
+    void reserve(size_t size) {
+        if (out_ && size_ + size > capacity_) {
+            throw TransactionException("Output buffer too small");
+        }
+    }
+
+    uint8_t* out_;
+    size_t capacity_;
+    size_t size_ = 0;
+};
+
+TransactionBuilder& TransactionBuilder::set_version(MessageVersion version) {
+    version_ = version;
+    return *this;
+}
+
+TransactionBuilder& TransactionBuilder::set_fee_payer(const PublicKey& fee_payer) {
+    fee_payer_ = fee_payer;
+    has_fee_payer_ = true;
+    return *this;
+}
+
+TransactionBuilder& TransactionBuilder::set_recent_blockhash(const Blockhash& blockhash) {
+    blockhash_ = blockhash;
+    has_blockhash_ = true;
+    return *this;
+}
+
+TransactionBuilder& TransactionBuilder::set_durable_nonce(const PublicKey& nonce_account, const PublicKey& authority,
+                                                          const Blockhash& nonce) {
+    nonce_accounts_[0] = {nonce_account, false, true};
+    nonce_accounts_[1] = {sysvar_recent_blockhashes_id(), false, false};
+    nonce_accounts_[2] = {authority, true, false};
+    has_nonce_ = true;
+    return set_recent_blockhash(nonce);
+}
+
+TransactionBuilder& TransactionBuilder::clear_durable_nonce() {
+    has_nonce_ = false;
+    return *this;
+}
+
+TransactionBuilder& TransactionBuilder::add_lookup_table(std::shared_ptr<const AddressLookupTable> table) {
+    if (!table) {
+        throw TransactionException("Lookup table must not be null");
+    }
+    lookup_tables_.push_back(std::move(table));
+    return *this;
+}
+
+TransactionBuilder& TransactionBuilder::add_instruction(const Instruction& instruction) {
+    return add_instruction(instruction.program_id, instruction.accounts.data(), instruction.accounts.size(),
+                           instruction.data.data(), instruction.data.size());
+}
+
+TransactionBuilder& TransactionBuilder::add_instruction(const PublicKey& program_id, const AccountMeta* accounts,
+                                                        size_t account_count, const uint8_t* data,
+                                                        size_t data_size) {
+    InstructionRecord record;
+    record.program_id = program_id;
+    record.account_offset = static_cast<uint32_t>(accounts_.size());
+    record.account_count = static_cast<uint32_t>(account_count);
+    record.data_offset = static_cast<uint32_t>(data_.size());
+    record.data_size = static_cast<uint32_t>(data_size);
+    accounts_.insert(accounts_.end(), accounts, accounts + account_count);
+    data_.insert(data_.end(), data, data + data_size);
+    instructions_.push_back(record);
+    return *this;
+}
+
+TransactionBuilder& TransactionBuilder::add_system_transfer(const PublicKey& from, const PublicKey& to,
+                                                            uint64_t lamports) {
+    const AccountMeta accounts[] = {{from, true, true}, {to, false, true}};
+    uint8_t data[12];
+    put_u32_le(data, SYSTEM_TRANSFER);
+    put_u64_le(data + 4, lamports);
+    return add_instruction(system_program_id(), accounts, 2, data, sizeof(data));
+}
+
+TransactionBuilder& TransactionBuilder::add_transfer_checked(const PublicKey& source, const PublicKey& mint,
+                                                             const PublicKey& destination, const PublicKey& owner,
+                                                             uint64_t amount, uint8_t decimals,
+                                                             const PublicKey& token_program) {
+    const AccountMeta accounts[] = {{source, false, true}, {mint, false, false}, {destination, false, true}, {owner, true, false}};
+    uint8_t data[10];
+    data[0] = TOKEN_TRANSFER_CHECKED;
+    put_u64_le(data + 1, amount);
+    data[9] = decimals;
+    return add_instruction(token_program, accounts, 4, data, sizeof(data));
+}
+
+TransactionBuilder& TransactionBuilder::add_memo(const std::string& memo) {
+    return add_instruction(memo_program_id(), nullptr, 0, reinterpret_cast<const uint8_t*>(memo.data()), memo.size());
+}
+
+TransactionBuilder& TransactionBuilder::add_references(const std::vector<PublicKey>& references) {
+    if (instructions_.empty()) {
+        throw TransactionException("References need an instruction to attach to");
+    }
+    // The last instruction's accounts are always at the tail of the flat list
+    for (const auto& reference : references) {
+        accounts_.push_back({reference, false, false});
+    }
+    instructions_.back().account_count += static_cast<uint32_t>(references.size());
+    return *this;
+}
+
+void TransactionBuilder::clear_instructions() {
+    instructions_.clear();
+    accounts_.clear();
+    data_.clear();
+}
+
+void TransactionBuilder::truncate_instructions(size_t count) {
+    if (count >= instructions_.size()) {
+        return;
+    }
+    // Instructions own consecutive ranges of the flat buffers
+    const InstructionRecord& first_dropped = instructions_[count];
+    accounts_.resize(first_dropped.account_offset);
+    data_.resize(first_dropped.data_offset);
+    instructions_.resize(count);
+}
+
+void TransactionBuilder::compile(Compiled& compiled) const {
+    if (!has_fee_payer_) {
+        throw TransactionException("Fee payer not set");
+    }
+    if (!has_blockhash_) {
+        throw TransactionException("Recent blockhash not set");
+    }
+    if (instructions_.empty() && !has_nonce_) {
+        throw TransactionException("Transaction has no instructions");
+    }
+
+    // Deduplicate, merging privileges; transactions are small, so a linear
+    // scan beats hashing
+    auto& keys = compiled.keys;
+    size_t count = 0;
+    auto add = [&](const PublicKey& key, bool signer, bool writable, bool invoked) {
+        for (size_t i = 0; i < count; ++i) {
+            if (*keys[i].key == key) {
+                keys[i].signer |= signer;
+                keys[i].writable |= writable;
+                keys[i].invoked |= invoked;
+                return;
+            }
+        }
+        if (count == MAX_ACCOUNTS) {
+            throw TransactionException("Transaction references more than " + std::to_string(MAX_ACCOUNTS) + " accounts");
+        }
+        keys[count++] = {&key, signer, writable, invoked};
+    };
+    add(fee_payer_, true, true, false);
+    if (has_nonce_) {
+        add(system_program_id(), false, false, true);
+        for (const auto& meta : nonce_accounts_) {
+            add(meta.key, meta.is_signer, meta.is_writable, false);
+        }
+    }
+    for (const auto& instruction : instructions_) {
+        add(instruction.program_id, false, false, true);
+        for (uint32_t i = 0; i < instruction.account_count; ++i) {
+            const auto& meta = accounts_[instruction.account_offset + i];
+            add(meta.key, meta.is_signer, meta.is_writable, false);
+        }
+    }
+
+    // Fee payer first, then by privilege group, then by key bytes
+    auto group = [](const Compiled::Key& key) {
+        return (key.signer ? 0 : 2) + (key.writable ? 0 : 1);
+    };
+    std::sort(keys + 1, keys + count, [&](const Compiled::Key& a, const Compiled::Key& b) {
+        int ga = group(a);
+        int gb = group(b);
+        return ga != gb ? ga < gb : *a.key < *b.key;
+    });
+
+    // v0: non-signer accounts that are not invoked as programs can be loaded
+    // from a lookup table by one-byte index instead of their 32-byte key
+    compiled.num_loaded = 0;
+    compiled.lookups.clear();
+    if (version_ == MessageVersion::V0 && !lookup_tables_.empty()) {
+        std::vector<bool> taken(count, false);
+        const PublicKey* readonly_loaded[MAX_ACCOUNTS];
+        size_t num_readonly_loaded = 0;
+        for (const auto& table : lookup_tables_) {
+            Compiled::Lookup lookup{table.get(), {}, {}};
+            size_t table_size = std::min(table->addresses.size(), MAX_ACCOUNTS);
+            for (size_t i = 1; i < count; ++i) {
+                if (taken[i] || keys[i].signer || keys[i].invoked) {
+                    continue;
+                }
+                for (size_t j = 0; j < table_size; ++j) {
+                    if (table->addresses[j] == *keys[i].key) {
+                        taken[i] = true;
+                        if (keys[i].writable) {
+                            lookup.writable.push_back(static_cast<uint8_t>(j));
+                            compiled.loaded[compiled.num_loaded++] = keys[i].key;
+                        } else {
+                            lookup.readonly.push_back(static_cast<uint8_t>(j));
+                            readonly_loaded[num_readonly_loaded++] = keys[i].key;
+                        }
+                        break;
+                    }
+                }
+            }
+            if (!lookup.writable.empty() || !lookup.readonly.empty()) {
+                compiled.lookups.push_back(std::move(lookup));
+            }
+        }
+        std::copy(readonly_loaded, readonly_loaded + num_readonly_loaded, compiled.loaded + compiled.num_loaded);
+        compiled.num_loaded += num_readonly_loaded;
+
+        // Order is preserved while the loaded keys are squeezed out
+        size_t kept = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (!taken[i]) {
+                keys[kept++] = keys[i];
+            }
+        }
+        count = kept;
+    }
+    compiled.num_keys = count;
+
+    uint8_t signers = 0;
+    uint8_t readonly_signed = 0;
+    uint8_t readonly_unsigned = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (keys[i].signer) {
+            ++signers;
+            readonly_signed += keys[i].writable ? 0 : 1;
+        } else {
+            readonly_unsigned += keys[i].writable ? 0 : 1;
+        }
+    }
+    compiled.header[0] = signers;
+    compiled.header[1] = readonly_signed;
+    compiled.header[2] = readonly_unsigned;
+}
+
+void TransactionBuilder::write_message(const Compiled& compiled, Writer& writer) const {
+    if (version_ == MessageVersion::V0) {
+        writer.put(VERSION_PREFIX);
+    }
+    writer.put(compiled.header, 3);
+    writer.compact(compiled.num_keys);
+    for (size_t i = 0; i < compiled.num_keys; ++i) {
+        writer.put(compiled.keys[i].key->data(), PublicKey::SIZE);
+    }
+    writer.put(blockhash_.data(), PublicKey::SIZE);
+
+    auto write_instruction = [&](const PublicKey& program_id, const AccountMeta* accounts, size_t account_count,
+                                 const uint8_t* data, size_t data_size) {
+        writer.put(compiled.index_of(program_id));
+        writer.compact(account_count);
+        for (size_t i = 0; i < account_count; ++i) {
+            writer.put(compiled.index_of(accounts[i].key));
+        }
+        writer.compact(data_size);
+        writer.put(data, data_size);
+    };
+    writer.compact(instructions_.size() + (has_nonce_ ? 1 : 0));
+    // The runtime only recognizes a nonce transaction by its first instruction
+    if (has_nonce_) {
+        write_instruction(system_program_id(), nonce_accounts_, 3, ADVANCE_NONCE_DATA, sizeof(ADVANCE_NONCE_DATA));
+    }
+    for (const auto& instruction : instructions_) {
+        write_instruction(instruction.program_id, accounts_.data() + instruction.account_offset,
+                          instruction.account_count, data_.data() + instruction.data_offset, instruction.data_size);
+    }
+
+    if (version_ == MessageVersion::V0) {
+        writer.compact(compiled.lookups.size());
+        for (const auto& lookup : compiled.lookups) {
+            writer.put(lookup.table->key.data(), PublicKey::SIZE);
+            writer.compact(lookup.writable.size());
+            writer.put(lookup.writable.data(), lookup.writable.size());
+            writer.compact(lookup.readonly.size());
+            writer.put(lookup.readonly.data(), lookup.readonly.size());
+        }
+    }
+}
+
+size_t TransactionBuilder::num_required_signatures() const {
+    Compiled compiled;
+    compile(compiled);
+    return compiled.header[0];
+}
+
+std::vector<PublicKey> TransactionBuilder::account_keys() const {
+    Compiled compiled;
+    compile(compiled);
+    std::vector<PublicKey> keys;
+    keys.reserve(compiled.num_keys);
+    for (size_t i = 0; i < compiled.num_keys; ++i) {
+        keys.push_back(*compiled.keys[i].key);
+    }
+    return keys;
+}
+
+size_t TransactionBuilder::num_accounts() const {
+    Compiled compiled;
+    compile(compiled);
+    return compiled.num_keys + compiled.num_loaded;
+}
+
+size_t TransactionBuilder::serialized_size() const {
+    Compiled compiled;
+    compile(compiled);
+    Writer counter(nullptr, 0);
+    counter.compact(compiled.header[0]);
+    counter.zeros(SIGNATURE_SIZE * compiled.header[0]);
+    write_message(compiled, counter);
+    return counter.size();
+}
+
+size_t TransactionBuilder::serialize_message(uint8_t* out, size_t capacity) const {
+    Compiled compiled;
+    compile(compiled);
+    Writer writer(out, capacity);
+    write_message(compiled, writer);
+    return writer.size();
+}
+
+size_t TransactionBuilder::serialize(uint8_t* out, size_t capacity) const {
+    Compiled compiled;
+    compile(compiled);
+
+    Writer counter(nullptr, 0);
+    counter.compact(compiled.header[0]);
+    counter.zeros(SIGNATURE_SIZE * compiled.header[0]);
+    write_message(compiled, counter);
+    if (counter.size() > MAX_TRANSACTION_SIZE) {
+        throw TransactionException("Transaction is " + std::to_string(counter.size()) + " bytes, limit is " +
+                                   std::to_string(MAX_TRANSACTION_SIZE));
+    }
+
+    Writer writer(out, capacity);
+    writer.compact(compiled.header[0]);
+    writer.zeros(SIGNATURE_SIZE * compiled.header[0]);
+    write_message(compiled, writer);
+    return writer.size();
+}
+
+size_t TransactionBuilder::serialize_signed(const std::vector<Keypair>& signers, uint8_t* out,
+                                           size_t capacity) const {
+    Compiled compiled;
+    compile(compiled);
+    const Keypair* ordered[MAX_ACCOUNTS];
+    for (size_t i = 0; i < compiled.header[0]; ++i) {
+        auto it = std::find_if(signers.begin(), signers.end(), [&](const Keypair& signer) {
+            return signer.public_key() == *compiled.keys[i].key;
+        });
+        if (it == signers.end()) {
+            throw TransactionException("Missing signer " + compiled.keys[i].key->to_base58());
+        }
+        ordered[i] = &*it;
+    }
+
+    size_t size = serialize(out, capacity);
+    uint8_t prefix[3];
+    size_t signatures_offset = encode_compact_u16(compiled.header[0], prefix);
+    size_t message_offset = signatures_offset + SIGNATURE_SIZE * compiled.header[0];
+    for (size_t i = 0; i < compiled.header[0]; ++i) {
+        Signature signature = ordered[i]->sign(out + message_offset, size - message_offset);
+        std::copy(signature.begin(), signature.end(), out + signatures_offset + SIGNATURE_SIZE * i);
+    }
+    return size;
+}
+
+std::vector<uint8_t> TransactionBuilder::serialize() const {
+    uint8_t buffer[MAX_TRANSACTION_SIZE];
+    size_t size = serialize(buffer, sizeof(buffer));
+    return std::vector<uint8_t>(buffer, buffer + size);
+}
+
+std::string TransactionBuilder::serialize_base64() const {
+    uint8_t buffer[MAX_TRANSACTION_SIZE];
+    size_t size = serialize(buffer, sizeof(buffer));
+    return base64_encode(buffer, size);
+}
+
+} // namespace svm_pay
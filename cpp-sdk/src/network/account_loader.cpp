@@ -0,0 +1,225 @@
+#include "svm-pay/network/account_loader.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+
+namespace svm_pay {
+
+namespace {
+
+using AccountCompletion = Completion<std::optional<AccountInfo>>;
+
+/**
+ * Keys of one getMultipleAccounts call and who is waiting for each
+ */
+struct Batch {
+    std::vector<PublicKey> keys;
+    std::unordered_map<PublicKey, std::vector<AccountCompletion>, PublicKeyHash> waiters;
+};
+
+} // namespace
+
+/**
+ * Shared with window timers and calls in flight
+ */
+struct AccountLoader::State : std::enable_shared_from_this<AccountLoader::State> {
+    State(SvmNetworkAdapter& adapter, const AccountLoaderConfig& config) : adapter(adapter), config(config) {}
+
+    Batch take_locked();
+    void send(Batch batch);
+
+    SvmNetworkAdapter& adapter;
+    AccountLoaderConfig config;
+
+    std::mutex mutex;
+    std::condition_variable idle;
+    size_t outstanding = 0;   // Calls in flight
+    uint64_t generation = 0;  // Bumped whenever the open batch is taken, so its timer does nothing
+    Batch open;
+
+    std::atomic<uint64_t> loads{0};
+    std::atomic<uint64_t> keys{0};
+    std::atomic<uint64_t> batches{0};
+};
+
+Batch AccountLoader::State::take_locked() {
+    ++generation;
+    Batch batch = std::move(open);
+    open = Batch{};
+    return batch;
+}
+
+void AccountLoader::State::send(Batch batch) {
+    if (batch.keys.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++outstanding;
+    }
+    keys.fetch_add(batch.keys.size(), std::memory_order_relaxed);
+    batches.fetch_add(1, std::memory_order_relaxed);
+
+    CallOptions options;
+    options.timeout = config.request_timeout;
+    auto self = shared_from_this();
+    auto pending = std::make_shared<Batch>(std::move(batch));
+    adapter.get_multiple_accounts_async(
+        pending->keys, options,
+        [self, pending](std::vector<std::optional<AccountInfo>> accounts, std::exception_ptr error) {
+            for (size_t i = 0; i < pending->keys.size(); ++i) {
+                auto& waiters = pending->waiters[pending->keys[i]];
+                for (size_t j = 0; j < waiters.size(); ++j) {
+                    // The last waiter for a key takes the account; the others get copies
+                    std::optional<AccountInfo> account;
+                    if (!error) {
+                        account = j + 1 == waiters.size() ? std::move(accounts[i]) : accounts[i];
+                    }
+                    waiters[j](std::move(account), error);
+                }
+            }
+            std::lock_guard<std::mutex> lock(self->mutex);
+            --self->outstanding;
+            self->idle.notify_all();
+        });
+}
+
+AccountLoader::AccountLoader(SvmNetworkAdapter& adapter, const AccountLoaderConfig& config)
+    : state_(std::make_shared<State>(adapter, config)) {
+    state_->config.max_batch =
+        std::min(std::max<size_t>(1, state_->config.max_batch), SvmNetworkAdapter::MAX_MULTIPLE_ACCOUNTS);
+}
+
+AccountLoader::~AccountLoader() {
+    flush();
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->idle.wait(lock, [this]() { return state_->outstanding == 0; });
+}
+
+void AccountLoader::load_async(const PublicKey& key, Completion<std::optional<AccountInfo>> on_done) {
+    state_->loads.fetch_add(1, std::memory_order_relaxed);
+    Batch full;
+    bool opened = false;
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        auto& waiters = state_->open.waiters[key];
+        if (waiters.empty()) {
+            state_->open.keys.push_back(key);
+        }
+        waiters.push_back(std::move(on_done));
+        opened = state_->open.keys.size() == 1 && waiters.size() == 1;
+        generation = state_->generation;
+        if (state_->open.keys.size() >= state_->config.max_batch) {
+            full = state_->take_locked();
+        }
+    }
+    if (!full.keys.empty()) {
+        state_->send(std::move(full));
+        return;
+    }
+    if (!opened) {
+        return;
+    }
+    auto state = state_;
+    state_->adapter.transport().schedule(
+        std::chrono::steady_clock::now() + state_->config.window, [state, generation](bool) {
+            Batch batch;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                // Filled up or flushed and already sent otherwise
+                if (state->generation == generation) {
+                    batch = state->take_locked();
+                }
+            }
+            // Sent even when the transport is shutting down, so waiters get its error
+            state->send(std::move(batch));
+        });
+}
+
+std::future<std::optional<AccountInfo>> AccountLoader::load(const PublicKey& key) {
+    auto promise = std::make_shared<std::promise<std::optional<AccountInfo>>>();
+    std::future<std::optional<AccountInfo>> result = promise->get_future();
+    load_async(key, [promise](std::optional<AccountInfo> account, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(account));
+        }
+    });
+    return result;
+}
+
+void AccountLoader::load_many_async(const std::vector<PublicKey>& keys,
+                                    Completion<std::vector<std::optional<AccountInfo>>> on_done) {
+    struct Gather {
+        std::mutex mutex;
+        std::vector<std::optional<AccountInfo>> accounts;
+        std::exception_ptr error;
+        size_t remaining = 0;
+        Completion<std::vector<std::optional<AccountInfo>>> on_done;
+    };
+    if (keys.empty()) {
+        on_done({}, nullptr);
+        return;
+    }
+    auto gather = std::make_shared<Gather>();
+    gather->accounts.resize(keys.size());
+    gather->remaining = keys.size();
+    gather->on_done = std::move(on_done);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        load_async(keys[i], [gather, i](std::optional<AccountInfo> account, std::exception_ptr error) {
+            {
+                std::lock_guard<std::mutex> lock(gather->mutex);
+                if (error && !gather->error) {
+                    gather->error = error;
+                }
+                gather->accounts[i] = std::move(account);
+                if (--gather->remaining > 0) {
+                    return;
+                }
+            }
+            gather->on_done(gather->error ? std::vector<std::optional<AccountInfo>>() : std::move(gather->accounts),
+                            gather->error);
+        });
+    }
+}
+
+std::future<std::vector<std::optional<AccountInfo>>> AccountLoader::load_many(const std::vector<PublicKey>& keys) {
+    auto promise = std::make_shared<std::promise<std::vector<std::optional<AccountInfo>>>>();
+    std::future<std::vector<std::optional<AccountInfo>>> result = promise->get_future();
+    load_many_async(keys, [promise](std::vector<std::optional<AccountInfo>> accounts, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(accounts));
+        }
+    });
+    return result;
+}
+
+void AccountLoader::flush() {
+    Batch batch;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        batch = state_->take_locked();
+    }
+    state_->send(std::move(batch));
+}
+
+uint64_t AccountLoader::load_count() const {
+    return state_->loads.load(std::memory_order_relaxed);
+}
+
+uint64_t AccountLoader::key_count() const {
+    return state_->keys.load(std::memory_order_relaxed);
+}
+
+uint64_t AccountLoader::batch_count() const {
+    return state_->batches.load(std::memory_order_relaxed);
+}
+
+} // namespace svm_pay
@@ -1,29 +1,143 @@
 #include "svm-pay/network/adapter.hpp"
+#include <array>
+#include <atomic>
 #include <mutex>
 
 namespace svm_pay {
 
-// Static member definitions
-std::unordered_map<SVMNetwork, std::unique_ptr<NetworkAdapter>> NetworkAdapterFactory::adapters_;
-std::mutex NetworkAdapterFactory::adapters_mutex_;
+namespace {
 
-void NetworkAdapterFactory::register_adapter(SVMNetwork network, std::unique_ptr<NetworkAdapter> adapter) {
-    std::lock_guard<std::mutex> lock(adapters_mutex_);
-    adapters_[network] = std::move(adapter);
+/**
+ * Completion that settles a promise, for futures derived from async calls
+ */
+template <typename T>
+Completion<T> settle(std::shared_ptr<std::promise<T>> promise) {
+    return [promise](T value, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(value));
+        }
+    };
 }
 
-NetworkAdapter* NetworkAdapterFactory::get_adapter(SVMNetwork network) {
-    std::lock_guard<std::mutex> lock(adapters_mutex_);
-    auto it = adapters_.find(network);
-    if (it != adapters_.end()) {
-        return it->second.get();
+/**
+ * Immutable view of the registered adapters, indexed by network
+ *
+ * Holds no ownership: a reader locks the entry, so an adapter replaced by
+ * a later registration goes as soon as its last holder lets go even while
+ * an old snapshot still names it.
+ */
+struct AdapterRegistry {
+    std::array<std::weak_ptr<NetworkAdapter>, SVM_NETWORK_COUNT> adapters;
+};
+
+// Constant-initialized, so lookups are safe even during static
+// initialization and after the owners below are destroyed at exit
+std::atomic<const AdapterRegistry*> current_registry{nullptr};
+
+/**
+ * Writer-side state, guarded by its mutex
+ */
+struct RegistryWriter {
+    std::mutex mutex;
+    std::array<std::shared_ptr<NetworkAdapter>, SVM_NETWORK_COUNT> owned;
+};
+
+RegistryWriter& registry_writer() {
+    static RegistryWriter writer;
+    return writer;
+}
+
+/**
+ * Publish a snapshot with one entry changed; the caller holds the writer lock
+ *
+ * A superseded snapshot is never freed, since a reader may still be
+ * indexing it; it only holds weak references, and registrations are rare.
+ */
+void publish_locked(RegistryWriter& writer, SVMNetwork network, std::shared_ptr<NetworkAdapter> adapter) {
+    auto* next = new AdapterRegistry();
+    if (const AdapterRegistry* current = current_registry.load(std::memory_order_relaxed)) {
+        *next = *current;
+    }
+    next->adapters[static_cast<size_t>(network)] = adapter;
+    current_registry.store(next, std::memory_order_release);
+    // The replaced adapter, unless someone holds it, goes with this reference
+    writer.owned[static_cast<size_t>(network)] = std::move(adapter);
+}
+
+} // namespace
+
+void NetworkAdapter::set_executor(std::shared_ptr<Executor> executor) {
+    std::atomic_store(&executor_, std::move(executor));
+}
+
+std::shared_ptr<Executor> NetworkAdapter::get_executor() const {
+    std::shared_ptr<Executor> executor = std::atomic_load(&executor_);
+    return executor ? executor : default_executor();
+}
+
+std::shared_ptr<Executor> NetworkAdapter::get_executor(const CallOptions& options) const {
+    return options.executor ? options.executor : get_executor();
+}
+
+std::future<std::string> NetworkAdapter::submit_transaction(const std::string& transaction, const std::string& signature,
+                                                           const CallOptions& options) {
+    auto done = std::make_shared<std::promise<std::string>>();
+    auto result = done->get_future();
+    submit_transaction_async(transaction, signature, options, settle(done));
+    return result;
+}
+
+std::future<PaymentStatus> NetworkAdapter::check_transaction_status(const std::string& signature,
+                                                                   const CallOptions& options) {
+    auto done = std::make_shared<std::promise<PaymentStatus>>();
+    auto result = done->get_future();
+    check_transaction_status_async(signature, options, settle(done));
+    return result;
+}
+
+void NetworkAdapterFactory::register_adapter(SVMNetwork network, std::shared_ptr<NetworkAdapter> adapter) {
+    RegistryWriter& writer = registry_writer();
+    std::lock_guard<std::mutex> lock(writer.mutex);
+    publish_locked(writer, network, std::move(adapter));
+}
+
+std::shared_ptr<NetworkAdapter> NetworkAdapterFactory::get_adapter(SVMNetwork network) {
+    const AdapterRegistry* registry = current_registry.load(std::memory_order_acquire);
+    while (registry) {
+        auto adapter = registry->adapters[static_cast<size_t>(network)].lock();
+        if (adapter) {
+            return adapter;
+        }
+        // Expired only if it was replaced since the load; the next snapshot has its successor
+        const AdapterRegistry* latest = current_registry.load(std::memory_order_acquire);
+        if (latest == registry) {
+            return nullptr;
+        }
+        registry = latest;
     }
     return nullptr;
 }
 
+std::shared_ptr<NetworkAdapter> NetworkAdapterFactory::get_or_register_adapter(
+    SVMNetwork network, const std::function<std::shared_ptr<NetworkAdapter>()>& create) {
+    if (auto adapter = get_adapter(network)) {
+        return adapter;
+    }
+    RegistryWriter& writer = registry_writer();
+    std::lock_guard<std::mutex> lock(writer.mutex);
+    // Another thread may have registered one while we waited for the lock
+    if (auto& adapter = writer.owned[static_cast<size_t>(network)]) {
+        return adapter;
+    }
+    std::shared_ptr<NetworkAdapter> adapter = create();
+    publish_locked(writer, network, adapter);
+    return adapter;
+}
+
 bool NetworkAdapterFactory::has_adapter(SVMNetwork network) {
-    std::lock_guard<std::mutex> lock(adapters_mutex_);
-    return adapters_.find(network) != adapters_.end();
+    return get_adapter(network) != nullptr;
 }
 
-} // namespace svm_pay
\ No newline at end of file
+} // namespace svm_pay
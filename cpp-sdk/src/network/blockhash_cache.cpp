@@ -0,0 +1,167 @@
+#include "svm-pay/network/blockhash_cache.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace svm_pay {
+
+BlockhashCache::BlockhashCache(SvmNetworkAdapter& adapter, const BlockhashCacheConfig& config)
+    : BlockhashCache(adapter.transport(), [&adapter](Completion<LatestBlockhash> on_done) {
+          adapter.get_latest_blockhash_async(CallOptions{}, std::move(on_done));
+      }, config) {}
+
+BlockhashCache::BlockhashCache(Fetcher fetcher, const BlockhashCacheConfig& config)
+    : BlockhashCache(*RpcTransport::shared(), std::move(fetcher), config) {}
+
+BlockhashCache::BlockhashCache(RpcTransport& transport, Fetcher fetcher, const BlockhashCacheConfig& config)
+    : fetcher_(std::move(fetcher)), config_(config) {
+    config_.slot_time = std::max(config_.slot_time, std::chrono::milliseconds(1));
+    config_.refresh_slots = std::max<uint64_t>(1, config_.refresh_slots);
+    // A fresh blockhash must count as usable
+    config_.stale_margin_blocks = std::min(config_.stale_margin_blocks, VALID_BLOCKHASH_AGE);
+    for (auto& word : words_) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    refresher_.emplace(transport, [this](PeriodicTask::Done done) { run(std::move(done)); });
+}
+
+BlockhashCache::~BlockhashCache() {
+    refresher_->stop();
+}
+
+std::optional<CachedBlockhash> BlockhashCache::current() const {
+    uint64_t words[WORDS];
+    uint64_t before;
+    while (true) {
+        before = sequence_.load(std::memory_order_acquire);
+        if (before == 0) {
+            return std::nullopt;
+        }
+        if (before & 1) {
+            continue;
+        }
+        for (size_t i = 0; i < WORDS; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == before) {
+            break;
+        }
+    }
+
+    CachedBlockhash cached;
+    std::memcpy(cached.blockhash.data(), words, PublicKey::SIZE);
+    cached.last_valid_block_height = words[WORDS - 3];
+    cached.slot = words[WORDS - 2];
+    cached.fetched_at = Clock::time_point(Clock::duration(static_cast<Clock::rep>(words[WORDS - 1])));
+    return cached;
+}
+
+void BlockhashCache::publish(const LatestBlockhash& latest, Clock::time_point fetched_at) {
+    uint64_t words[WORDS];
+    Blockhash blockhash = Blockhash::from_base58(latest.blockhash);
+    std::memcpy(words, blockhash.data(), PublicKey::SIZE);
+    words[WORDS - 3] = latest.last_valid_block_height;
+    words[WORDS - 2] = latest.slot;
+    words[WORDS - 1] = static_cast<uint64_t>(fetched_at.time_since_epoch().count());
+
+    // Refreshes never overlap, so there is one writer
+    uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; ++i) {
+        words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+CachedBlockhash BlockhashCache::get(std::chrono::milliseconds timeout) {
+    // A stale blockhash may expire before a transaction built on it lands
+    auto usable = [this](const std::optional<CachedBlockhash>& cached) { return cached && !is_stale(*cached); };
+    auto cached = current();
+    if (usable(cached)) {
+        return *cached;
+    }
+
+    auto deadline = Clock::now() + timeout;
+    refresher_->run_now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cached = current();
+        if (usable(cached)) {
+            return *cached;
+        }
+        if (cv_.wait_until(lock, deadline) == std::cv_status::timeout) {
+            cached = current();
+            if (usable(cached)) {
+                return *cached;
+            }
+            throw TimeoutException("no usable blockhash available");
+        }
+    }
+}
+
+uint64_t BlockhashCache::slots_elapsed(const CachedBlockhash& blockhash) const {
+    auto elapsed = Clock::now() - blockhash.fetched_at;
+    uint64_t by_time = elapsed > Clock::duration::zero() ? static_cast<uint64_t>(elapsed / config_.slot_time) : 0;
+    uint64_t observed = observed_slot_.load(std::memory_order_relaxed);
+    uint64_t by_slot = observed > blockhash.slot ? observed - blockhash.slot : 0;
+    return std::max(by_time, by_slot);
+}
+
+uint64_t BlockhashCache::remaining_blocks(const CachedBlockhash& blockhash) const {
+    uint64_t elapsed = slots_elapsed(blockhash);
+    return elapsed < VALID_BLOCKHASH_AGE ? VALID_BLOCKHASH_AGE - elapsed : 0;
+}
+
+bool BlockhashCache::is_stale(const CachedBlockhash& blockhash) const {
+    return remaining_blocks(blockhash) < config_.stale_margin_blocks;
+}
+
+void BlockhashCache::notify_slot(uint64_t slot) {
+    uint64_t observed = observed_slot_.load(std::memory_order_relaxed);
+    while (slot > observed && !observed_slot_.compare_exchange_weak(observed, slot, std::memory_order_relaxed)) {
+    }
+    auto cached = current();
+    if (cached && slot >= cached->slot + config_.refresh_slots) {
+        refresh();
+    }
+}
+
+void BlockhashCache::refresh() {
+    refresher_->run_now();
+}
+
+void BlockhashCache::run(PeriodicTask::Done done) {
+    auto finish = [this, done = std::move(done)](LatestBlockhash latest, std::exception_ptr error) {
+        std::chrono::milliseconds wait = config_.retry_delay;
+        if (!error) {
+            try {
+                publish(latest, Clock::now());
+                refreshes_.fetch_add(1, std::memory_order_relaxed);
+                wait = config_.slot_time * static_cast<int64_t>(config_.refresh_slots);
+            } catch (const std::exception&) {
+                // A malformed blockhash counts as a failed refresh
+            }
+        }
+        // Otherwise keep serving the previous blockhash and retry shortly
+
+        auto cached = current();
+        if (cached && config_.on_stale && is_stale(*cached)) {
+            config_.on_stale(*cached, remaining_blocks(*cached));
+        }
+        {
+            // Taken so a get() between its check and its wait cannot miss the signal
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        cv_.notify_all();
+        done(wait);
+    };
+    try {
+        fetcher_(finish);
+    } catch (...) {
+        finish(LatestBlockhash{}, std::current_exception());
+    }
+}
+
+} // namespace svm_pay
@@ -0,0 +1,79 @@
+#include "svm-pay/network/call_options.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace svm_pay {
+
+namespace {
+
+std::atomic<int64_t> default_call_timeout_ms{30000};
+std::atomic<int64_t> default_connect_timeout_ms{5000};
+
+} // namespace
+
+bool CancellationToken::is_cancelled() const {
+    return state_ && state_->cancelled.load(std::memory_order_acquire);
+}
+
+void CancellationToken::throw_if_cancelled() const {
+    if (is_cancelled()) {
+        throw OperationCancelledException("operation was cancelled");
+    }
+}
+
+bool CancellationToken::wait_for(std::chrono::steady_clock::duration timeout) const {
+    if (!state_) {
+        std::this_thread::sleep_for(timeout);
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    return state_->cv.wait_for(lock, timeout, [this]() {
+        return state_->cancelled.load(std::memory_order_acquire);
+    });
+}
+
+CancellationSource::CancellationSource() : state_(std::make_shared<CancellationToken::State>()) {}
+
+CancellationToken CancellationSource::token() const {
+    return CancellationToken(state_);
+}
+
+void CancellationSource::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->cancelled.store(true, std::memory_order_release);
+    }
+    state_->cv.notify_all();
+}
+
+bool CancellationSource::is_cancelled() const {
+    return state_->cancelled.load(std::memory_order_acquire);
+}
+
+CallOptions::Clock::time_point CallOptions::resolve_deadline() const {
+    auto now = Clock::now();
+    auto result = now + timeout.value_or(get_default_call_timeout());
+    if (deadline) {
+        result = std::min(result, *deadline);
+    }
+    return result;
+}
+
+void set_default_call_timeout(std::chrono::milliseconds timeout) {
+    default_call_timeout_ms.store(timeout.count(), std::memory_order_relaxed);
+}
+
+std::chrono::milliseconds get_default_call_timeout() {
+    return std::chrono::milliseconds(default_call_timeout_ms.load(std::memory_order_relaxed));
+}
+
+void set_default_connect_timeout(std::chrono::milliseconds timeout) {
+    default_connect_timeout_ms.store(timeout.count(), std::memory_order_relaxed);
+}
+
+std::chrono::milliseconds get_default_connect_timeout() {
+    return std::chrono::milliseconds(default_connect_timeout_ms.load(std::memory_order_relaxed));
+}
+
+} // namespace svm_pay
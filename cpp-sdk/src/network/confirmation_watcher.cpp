@@ -0,0 +1,319 @@
+#include "svm-pay/network/confirmation_watcher.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <algorithm>
+
+namespace svm_pay {
+
+namespace {
+
+// Wheel slots; signatures due further out than one revolution wait extra rounds
+constexpr size_t WHEEL_SIZE = 1024;
+
+// Confirmations after which a block is finalized
+constexpr uint64_t FINALIZATION_DEPTH = 32;
+
+bool reached_commitment(const SignatureStatus& status, const std::string& target) {
+    if (target == "finalized") {
+        return status.confirmation_status == "finalized";
+    }
+    if (target == "confirmed") {
+        return status.confirmation_status == "confirmed" || status.confirmation_status == "finalized";
+    }
+    return true;
+}
+
+ConfirmationWatcherConfig on_executor_of(const SvmNetworkAdapter& adapter, ConfirmationWatcherConfig config) {
+    if (!config.executor) {
+        config.executor = adapter.get_executor();
+    }
+    return config;
+}
+
+} // namespace
+
+ConfirmationWatcher::ConfirmationWatcher(SvmNetworkAdapter& adapter, const ConfirmationWatcherConfig& config)
+    : ConfirmationWatcher(
+          // Waits on the transport only, never on executor work queued behind it
+          [&adapter](const std::vector<std::string>& signatures) {
+              auto done = std::make_shared<std::promise<std::vector<std::optional<SignatureStatus>>>>();
+              auto result = done->get_future();
+              adapter.get_signature_statuses_async(
+                  signatures, CallOptions{},
+                  [done](std::vector<std::optional<SignatureStatus>> statuses, std::exception_ptr error) {
+                      if (error) {
+                          done->set_exception(error);
+                      } else {
+                          done->set_value(std::move(statuses));
+                      }
+                  });
+              return result.get();
+          },
+          on_executor_of(adapter, config)) {}
+
+ConfirmationWatcher::ConfirmationWatcher(StatusFetcher fetcher, const ConfirmationWatcherConfig& config)
+    : fetcher_(std::move(fetcher)), config_(config), epoch_(Clock::now()), wheel_(WHEEL_SIZE) {
+    config_.tick = std::max(config_.tick, std::chrono::milliseconds(1));
+    config_.batch_size = std::max<size_t>(1, std::min(config_.batch_size, SvmNetworkAdapter::MAX_SIGNATURE_STATUS_BATCH));
+    config_.max_concurrent_batches = std::max<size_t>(1, config_.max_concurrent_batches);
+    thread_ = std::thread([this]() { run(); });
+}
+
+ConfirmationWatcher::~ConfirmationWatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+}
+
+void ConfirmationWatcher::watch(const std::string& signature, Callback callback) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto memo = memo_.find(signature);
+    if (memo != memo_.end()) {
+        PaymentStatus status = memo->second;
+        lock.unlock();
+        callback(signature, status);
+        return;
+    }
+
+    auto pending = pending_.find(signature);
+    if (pending != pending_.end()) {
+        Entry& entry = entries_[pending->second];
+        if (entry.callbacks.size() >= config_.max_callbacks_per_signature) {
+            throw BackpressureException("too many watchers for signature " + signature);
+        }
+        entry.callbacks.push_back(std::move(callback));
+        return;
+    }
+
+    uint32_t index;
+    if (!free_entries_.empty()) {
+        index = free_entries_.back();
+        free_entries_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+    }
+    Entry& entry = entries_[index];
+    auto now = Clock::now();
+    entry.signature = signature;
+    entry.watched_at = now;
+    entry.first_seen.reset();
+    entry.in_use = true;
+    entry.callbacks.push_back(std::move(callback));
+    pending_.emplace(signature, index);
+
+    // Nothing can land sooner than one slot after submission
+    schedule_locked(index, now + config_.slot_time);
+}
+
+std::future<PaymentStatus> ConfirmationWatcher::wait(const std::string& signature) {
+    auto promise = std::make_shared<std::promise<PaymentStatus>>();
+    auto future = promise->get_future();
+    watch(signature, [promise](const std::string&, PaymentStatus status) {
+        promise->set_value(status);
+    });
+    return future;
+}
+
+std::optional<PaymentStatus> ConfirmationWatcher::cached_status(const std::string& signature) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = memo_.find(signature);
+    if (it == memo_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+size_t ConfirmationWatcher::pending_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+std::chrono::milliseconds ConfirmationWatcher::poll_interval(std::chrono::milliseconds age,
+                                                             const ConfirmationWatcherConfig& config) {
+    return std::min(config.max_interval, std::max(config.slot_time, age / 4));
+}
+
+uint64_t ConfirmationWatcher::current_tick(Clock::time_point now) const {
+    return static_cast<uint64_t>((now - epoch_) / config_.tick);
+}
+
+void ConfirmationWatcher::schedule_locked(uint32_t index, Clock::time_point due) {
+    Entry& entry = entries_[index];
+    // Round up so a signature is never polled early
+    auto offset = due - epoch_;
+    uint64_t tick = static_cast<uint64_t>((offset + config_.tick - Clock::duration(1)) / config_.tick);
+    entry.due_tick = std::max(tick, processed_tick_ + 1);
+    wheel_[entry.due_tick % WHEEL_SIZE].push_back({index, entry.generation});
+}
+
+std::vector<uint32_t> ConfirmationWatcher::collect_due_locked(uint64_t tick) {
+    std::vector<uint32_t> due;
+    auto& slot = wheel_[tick % WHEEL_SIZE];
+    size_t kept = 0;
+    for (const auto& ref : slot) {
+        const Entry& entry = entries_[ref.index];
+        if (!entry.in_use || entry.generation != ref.generation) {
+            continue;
+        }
+        if (entry.due_tick <= tick) {
+            due.push_back(ref.index);
+        } else {
+            slot[kept++] = ref;
+        }
+    }
+    slot.resize(kept);
+    return due;
+}
+
+void ConfirmationWatcher::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        uint64_t target = current_tick(Clock::now());
+        // After a long stall one revolution visits every slot
+        if (target > processed_tick_ + WHEEL_SIZE) {
+            processed_tick_ = target - WHEEL_SIZE;
+        }
+        std::vector<uint32_t> due;
+        while (processed_tick_ < target) {
+            ++processed_tick_;
+            auto ready = collect_due_locked(processed_tick_);
+            due.insert(due.end(), ready.begin(), ready.end());
+        }
+
+        if (!due.empty()) {
+            lock.unlock();
+            poll(due);
+            lock.lock();
+            continue;
+        }
+        cv_.wait_until(lock, epoch_ + config_.tick * (processed_tick_ + 1), [this]() { return stopping_; });
+    }
+}
+
+void ConfirmationWatcher::poll(const std::vector<uint32_t>& due) {
+    std::vector<std::vector<uint32_t>> batches;
+    std::vector<std::vector<std::string>> signatures;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t start = 0; start < due.size(); start += config_.batch_size) {
+            size_t end = std::min(due.size(), start + config_.batch_size);
+            batches.emplace_back(due.begin() + static_cast<std::ptrdiff_t>(start),
+                                 due.begin() + static_cast<std::ptrdiff_t>(end));
+            signatures.emplace_back();
+            for (uint32_t index : batches.back()) {
+                signatures.back().push_back(entries_[index].signature);
+            }
+        }
+    }
+
+    // A failed batch is simply retried later; it says nothing about the signatures
+    std::vector<std::optional<std::vector<std::optional<SignatureStatus>>>> results(batches.size());
+    auto executor = config_.executor ? config_.executor : default_executor();
+    for (size_t wave = 0; wave < batches.size(); wave += config_.max_concurrent_batches) {
+        size_t end = std::min(batches.size(), wave + config_.max_concurrent_batches);
+        parallel_for(*executor, end - wave, [&](size_t offset) {
+            size_t i = wave + offset;
+            try {
+                auto statuses = fetcher_(signatures[i]);
+                if (statuses.size() == batches[i].size()) {
+                    results[i] = std::move(statuses);
+                }
+            } catch (const std::exception&) {
+            }
+        });
+    }
+
+    std::vector<Notification> notifications;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = Clock::now();
+        for (size_t i = 0; i < batches.size(); ++i) {
+            for (size_t j = 0; j < batches[i].size(); ++j) {
+                uint32_t index = batches[i][j];
+                if (results[i]) {
+                    apply_locked(index, (*results[i])[j], now, notifications);
+                } else {
+                    auto age = std::chrono::duration_cast<std::chrono::milliseconds>(now - entries_[index].watched_at);
+                    schedule_locked(index, now + poll_interval(age, config_));
+                }
+            }
+        }
+    }
+
+    for (const auto& notification : notifications) {
+        for (const auto& callback : notification.callbacks) {
+            callback(notification.signature, notification.status);
+        }
+    }
+}
+
+void ConfirmationWatcher::apply_locked(uint32_t index, const std::optional<SignatureStatus>& status,
+                                       Clock::time_point now, std::vector<Notification>& notifications) {
+    Entry& entry = entries_[index];
+    auto age = std::chrono::duration_cast<std::chrono::milliseconds>(now - entry.watched_at);
+    auto interval = poll_interval(age, config_);
+
+    if (status) {
+        if (status->err) {
+            finish_locked(index, PaymentStatus::FAILED, notifications);
+            return;
+        }
+        if (reached_commitment(*status, config_.target_commitment)) {
+            finish_locked(index, PaymentStatus::CONFIRMED, notifications);
+            return;
+        }
+        if (!entry.first_seen) {
+            entry.first_seen = now;
+        }
+        // Landed but short of the target: stuck for too long means it was dropped
+        if (now - *entry.first_seen >= config_.expiry) {
+            finish_locked(index, PaymentStatus::EXPIRED, notifications);
+            return;
+        }
+        // Waiting for finalization: the remaining depth predicts when to look again
+        if (config_.target_commitment == "finalized" && status->confirmations) {
+            uint64_t remaining = FINALIZATION_DEPTH - std::min(FINALIZATION_DEPTH, *status->confirmations);
+            interval = std::min(config_.max_interval,
+                                std::max(config_.slot_time, config_.slot_time * static_cast<int64_t>(remaining)));
+        } else {
+            interval = config_.slot_time;
+        }
+    } else if (age >= config_.expiry) {
+        finish_locked(index, PaymentStatus::EXPIRED, notifications);
+        return;
+    }
+    schedule_locked(index, now + interval);
+}
+
+void ConfirmationWatcher::finish_locked(uint32_t index, PaymentStatus status,
+                                        std::vector<Notification>& notifications) {
+    Entry& entry = entries_[index];
+    remember_locked(entry.signature, status);
+    notifications.push_back({entry.signature, status, std::move(entry.callbacks)});
+
+    pending_.erase(entry.signature);
+    entry.in_use = false;
+    ++entry.generation;
+    entry.callbacks.clear();
+    entry.signature.clear();
+    free_entries_.push_back(index);
+}
+
+void ConfirmationWatcher::remember_locked(const std::string& signature, PaymentStatus status) {
+    if (config_.memo_capacity == 0) {
+        return;
+    }
+    if (memo_.emplace(signature, status).second) {
+        memo_order_.push_back(signature);
+    }
+    while (memo_.size() > config_.memo_capacity) {
+        memo_.erase(memo_order_.front());
+        memo_order_.pop_front();
+    }
+}
+
+} // namespace svm_pay
@@ -0,0 +1,215 @@
+#include "svm-pay/network/endpoint_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace svm_pay {
+
+namespace {
+
+// Update an atomic EWMA without locks; a zero average is seeded with the
+// first sample when seed_empty is set
+void update_ewma(std::atomic<double>& target, double sample, double alpha, bool seed_empty) {
+    double current = target.load(std::memory_order_relaxed);
+    double next;
+    do {
+        next = (seed_empty && current == 0.0) ? sample : current + alpha * (sample - current);
+    } while (!target.compare_exchange_weak(current, next, std::memory_order_relaxed));
+}
+
+std::minstd_rand& thread_rng() {
+    thread_local std::minstd_rand rng(std::random_device{}());
+    return rng;
+}
+
+} // namespace
+
+Endpoint::Endpoint(std::string url, double ewma_alpha, const RateLimitConfig& rate_limit,
+                   const CircuitBreakerConfig& circuit_breaker)
+    : url_(std::move(url)), ewma_alpha_(ewma_alpha), limiter_(rate_limit), breaker_(circuit_breaker) {}
+
+size_t Endpoint::bucket_for(uint64_t micros) {
+    if (micros < 1) {
+        return 0;
+    }
+    // Position of the highest set bit, plus the next two bits as sub-bucket
+    int exponent = 0;
+    for (uint64_t v = micros; v > 1; v >>= 1) {
+        ++exponent;
+    }
+    uint64_t sub = exponent >= 2 ? (micros >> (exponent - 2)) & 0x3 : (micros << (2 - exponent)) & 0x3;
+    size_t bucket = static_cast<size_t>(exponent) * 4 + static_cast<size_t>(sub);
+    return std::min(bucket, kBucketCount - 1);
+}
+
+uint64_t Endpoint::bucket_upper_bound(size_t bucket) {
+    size_t exponent = bucket / 4;
+    uint64_t sub = bucket % 4;
+    uint64_t base = 1ULL << exponent;
+    return base + ((base * (sub + 1)) >> 2);
+}
+
+void Endpoint::record_success(std::chrono::microseconds latency) {
+    record_latency(latency, false);
+}
+
+void Endpoint::record_failure(std::chrono::microseconds latency) {
+    record_latency(latency, true);
+}
+
+void Endpoint::on_request_abandoned() {
+    uint32_t in_flight = in_flight_.load(std::memory_order_relaxed);
+    while (in_flight > 0 &&
+           !in_flight_.compare_exchange_weak(in_flight, in_flight - 1, std::memory_order_relaxed)) {
+    }
+}
+
+void Endpoint::record_latency(std::chrono::microseconds latency, bool failed) {
+    on_request_abandoned();
+
+    update_ewma(error_rate_, failed ? 1.0 : 0.0, ewma_alpha_, false);
+
+    // Failed requests still tell us how long the endpoint made us wait
+    uint64_t micros = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+    update_ewma(latency_ewma_us_, static_cast<double>(std::max<uint64_t>(micros, 1)), ewma_alpha_, true);
+
+    buckets_[bucket_for(micros)].fetch_add(1, std::memory_order_relaxed);
+    if (sample_count_.fetch_add(1, std::memory_order_relaxed) + 1 >= kDecayThreshold) {
+        // Halve all buckets so the histogram tracks recent behaviour
+        uint64_t total = 0;
+        for (auto& bucket : buckets_) {
+            uint32_t halved = bucket.load(std::memory_order_relaxed) / 2;
+            bucket.store(halved, std::memory_order_relaxed);
+            total += halved;
+        }
+        sample_count_.store(total, std::memory_order_relaxed);
+    }
+}
+
+std::chrono::microseconds Endpoint::latency_quantile(double quantile) const {
+    std::array<uint32_t, kBucketCount> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return std::chrono::microseconds(0);
+    }
+
+    quantile = std::clamp(quantile, 0.0, 1.0);
+    uint64_t rank = static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= rank && counts[i] > 0) {
+            return std::chrono::microseconds(bucket_upper_bound(i));
+        }
+    }
+    return std::chrono::microseconds(bucket_upper_bound(kBucketCount - 1));
+}
+
+double Endpoint::cost() const {
+    // Unmeasured endpoints get a neutral latency so they are explored
+    double latency = latency_ewma_us();
+    if (latency == 0.0) {
+        latency = 1.0;
+    }
+    double success = std::max(1.0 - error_rate(), 0.01);
+    double cost = latency * (1.0 + in_flight()) / success;
+    if (limiter_.paused()) {
+        cost *= 100.0;
+    }
+    return cost;
+}
+
+EndpointPool::EndpointPool(const EndpointPoolConfig& config) {
+    configure(config);
+}
+
+void EndpointPool::configure(const EndpointPoolConfig& config) {
+    if (config.urls.empty()) {
+        throw std::invalid_argument("Endpoint pool requires at least one URL");
+    }
+
+    auto previous = snapshot();
+    auto next = std::make_shared<EndpointSet>();
+    next->config = config;
+    next->config.ewma_alpha = std::clamp(config.ewma_alpha, 0.001, 1.0);
+
+    for (const auto& url : config.urls) {
+        std::shared_ptr<Endpoint> endpoint;
+        if (previous) {
+            auto it = std::find_if(previous->endpoints.begin(), previous->endpoints.end(),
+                                   [&](const auto& e) { return e->url() == url; });
+            if (it != previous->endpoints.end()) {
+                endpoint = *it;
+                endpoint->limiter().configure(config.rate_limit);
+                endpoint->breaker().configure(config.circuit_breaker);
+            }
+        }
+        if (!endpoint) {
+            endpoint = std::make_shared<Endpoint>(url, next->config.ewma_alpha, config.rate_limit,
+                                                  config.circuit_breaker);
+        }
+        next->endpoints.push_back(std::move(endpoint));
+    }
+
+    std::atomic_store_explicit(&snapshot_, std::shared_ptr<const EndpointSet>(std::move(next)),
+                               std::memory_order_release);
+}
+
+std::shared_ptr<const EndpointSet> EndpointPool::snapshot() const {
+    return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+}
+
+std::shared_ptr<Endpoint> EndpointPool::pick(const EndpointSet& set, const Endpoint* exclude) {
+    const auto& endpoints = set.endpoints;
+    size_t count = endpoints.size();
+    if (count == 1) {
+        return endpoints.front();
+    }
+
+    auto& rng = thread_rng();
+    size_t first = rng() % count;
+    size_t second = rng() % (count - 1);
+    if (second >= first) {
+        ++second;
+    }
+
+    const auto& a = endpoints[first];
+    const auto& b = endpoints[second];
+    const std::shared_ptr<Endpoint>* chosen;
+    if (a.get() == exclude) {
+        chosen = &b;
+    } else if (b.get() == exclude) {
+        chosen = &a;
+    } else {
+        chosen = a->cost() <= b->cost() ? &a : &b;
+    }
+
+    if ((*chosen)->breaker().is_open()) {
+        // Both candidates may be down while others are healthy
+        for (const auto& endpoint : endpoints) {
+            if (endpoint.get() != exclude && !endpoint->breaker().is_open()) {
+                return endpoint;
+            }
+        }
+    }
+    return *chosen;
+}
+
+std::chrono::microseconds EndpointPool::hedge_delay(const EndpointSet& set, const Endpoint& endpoint) {
+    const auto& config = set.config;
+    auto min_delay = std::chrono::duration_cast<std::chrono::microseconds>(config.min_hedge_delay);
+    auto max_delay = std::chrono::duration_cast<std::chrono::microseconds>(config.max_hedge_delay);
+
+    // Too few samples for a meaningful quantile: be conservative
+    if (endpoint.sample_count() < 16) {
+        return max_delay;
+    }
+    return std::clamp(endpoint.latency_quantile(config.hedge_quantile), min_delay, max_delay);
+}
+
+} // namespace svm_pay
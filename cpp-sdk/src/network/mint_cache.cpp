@@ -0,0 +1,578 @@
+#include "svm-pay/network/mint_cache.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/transaction.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace svm_pay {
+
+namespace {
+
+constexpr size_t MINT_SIZE = 82;
+constexpr size_t MINT_DECIMALS_OFFSET = 44;
+constexpr size_t MINT_INITIALIZED_OFFSET = 45;
+// Token-2022 pads extended mints to a token account's size, then tags the type
+constexpr size_t ACCOUNT_TYPE_OFFSET = 165;
+constexpr uint8_t ACCOUNT_TYPE_MINT = 1;
+
+// File layout: a header, then one record per mint. Integers are
+// little-endian. A record whose loaded_at is 0 holds no mint: it was being
+// rewritten, for an evicted mint's successor, when the process died.
+//   header: magic[8] count:u32 capacity:u32
+//   record: mint[32] program[32] decimals:u8 reserved[7] loaded_at:u64
+constexpr char FILE_MAGIC[8] = {'S', 'V', 'M', 'M', 'I', 'N', 'T', '1'};
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t RECORD_SIZE = 80;
+
+void put_u32(uint8_t* out, uint32_t value) {
+    for (size_t i = 0; i < 4; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+void put_u64(uint8_t* out, uint64_t value) {
+    for (size_t i = 0; i < 8; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+uint64_t get_le(const uint8_t* in, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = size; i > 0; --i) {
+        value = (value << 8) | in[i - 1];
+    }
+    return value;
+}
+
+uint64_t unix_now() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// Replace a table slot's words under its sequence lock
+void write_slot(std::atomic<uint64_t>& sequence, std::atomic<uint64_t>* slot_words, const uint64_t* words,
+                size_t count) {
+    // Writers hold the mutex
+    uint64_t before = sequence.load(std::memory_order_relaxed);
+    sequence.store(before + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < count; ++i) {
+        slot_words[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence.store(before + 2, std::memory_order_release);
+}
+
+struct StoredMint {
+    MintInfo info;
+    uint64_t loaded_at;
+    size_t record;
+};
+
+} // namespace
+
+MintInfo decode_mint(const PublicKey& address, const AccountInfo& account) {
+    bool token = account.owner == token_program_id();
+    if (!token && account.owner != token_2022_program_id()) {
+        throw TransactionException("Account " + address.to_base58() + " is not owned by a token program");
+    }
+    const std::vector<uint8_t>& data = account.data;
+    bool is_mint = data.size() == MINT_SIZE ||
+                   (!token && data.size() > ACCOUNT_TYPE_OFFSET && data[ACCOUNT_TYPE_OFFSET] == ACCOUNT_TYPE_MINT);
+    if (!is_mint || data[MINT_INITIALIZED_OFFSET] != 1) {
+        throw TransactionException("Account " + address.to_base58() + " is not an initialized token mint");
+    }
+    MintInfo info;
+    info.mint = address;
+    info.program = account.owner;
+    info.decimals = data[MINT_DECIMALS_OFFSET];
+    return info;
+}
+
+/**
+ * Sequence-locked table slot: the mint, the program, then the decimals
+ * with the occupied flag
+ */
+struct MintCache::Slot {
+    static constexpr size_t WORDS = 9;
+    static constexpr uint64_t OCCUPIED = uint64_t(1) << 8;
+
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> words[WORDS];
+};
+
+/**
+ * The mapped cache file
+ */
+class MintCache::Storage {
+public:
+    /**
+     * Map the file, reading the mints it already holds
+     *
+     * Records stay where they are, so a process dying during startup
+     * loses nothing; only records past a smaller capacity are dropped.
+     *
+     * @param path The file
+     * @param capacity Records to make room for
+     * @param existing Receives the stored mints, in record order
+     */
+    Storage(const std::string& path, size_t capacity, std::vector<StoredMint>& existing)
+        : path_(path), size_(HEADER_SIZE + capacity * RECORD_SIZE) {
+        size_t count = read(capacity, existing);
+        map();
+        std::memcpy(data_, FILE_MAGIC, sizeof(FILE_MAGIC));
+        put_u32(data_ + 8, static_cast<uint32_t>(count));
+        put_u32(data_ + 12, static_cast<uint32_t>(capacity));
+    }
+
+    ~Storage() {
+        sync();
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+        CloseHandle(file_);
+#else
+        munmap(data_, size_);
+#endif
+    }
+
+    Storage(const Storage&) = delete;
+    Storage& operator=(const Storage&) = delete;
+
+    /**
+     * Get the number of records in use or freed
+     */
+    size_t count() const { return get_le(data_ + 8, 4); }
+
+    void write(size_t record, const MintInfo& info, uint64_t loaded_at) {
+        uint8_t* out = data_ + HEADER_SIZE + record * RECORD_SIZE;
+        // The record reads as empty until it is whole, and the count goes
+        // last, so a process dying mid-write leaves no torn record behind
+        put_u64(out + 72, 0);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        std::memcpy(out, info.mint.data(), PublicKey::SIZE);
+        std::memcpy(out + 32, info.program.data(), PublicKey::SIZE);
+        std::memset(out + 64, 0, 8);
+        out[64] = info.decimals;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        put_u64(out + 72, loaded_at);
+        if (record >= count()) {
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+            put_u32(data_ + 8, static_cast<uint32_t>(record + 1));
+        }
+    }
+
+    void sync() {
+#ifdef _WIN32
+        FlushViewOfFile(data_, size_);
+        FlushFileBuffers(file_);
+#else
+        msync(data_, size_, MS_SYNC);
+#endif
+    }
+
+private:
+    // Returns the record count to keep
+    size_t read(size_t capacity, std::vector<StoredMint>& existing) const {
+        std::ifstream in(path_, std::ios::binary);
+        if (!in) {
+            return 0;
+        }
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (bytes.empty()) {
+            return 0;
+        }
+        if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+            throw SVMPayException("Mint cache: " + path_ + " is not a mint cache file");
+        }
+        size_t count = std::min<size_t>(get_le(bytes.data() + 8, 4), (bytes.size() - HEADER_SIZE) / RECORD_SIZE);
+        count = std::min(count, capacity);
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t* record = bytes.data() + HEADER_SIZE + i * RECORD_SIZE;
+            StoredMint stored;
+            stored.loaded_at = get_le(record + 72, 8);
+            if (stored.loaded_at == 0) {
+                continue;
+            }
+            std::copy(record, record + 32, stored.info.mint.data());
+            std::copy(record + 32, record + 64, stored.info.program.data());
+            stored.info.decimals = record[64];
+            stored.record = i;
+            existing.push_back(stored);
+        }
+        return count;
+    }
+
+    void map() {
+#ifdef _WIN32
+        file_ = CreateFileA(path_.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw SVMPayException("Mint cache: cannot open " + path_);
+        }
+        // Sized up front, which also drops records past a smaller capacity
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(size_);
+        if (SetFilePointerEx(file_, end, nullptr, FILE_BEGIN) && SetEndOfFile(file_)) {
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+        }
+        data_ = mapping_ ? static_cast<uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, size_)) : nullptr;
+        if (!data_) {
+            if (mapping_) {
+                CloseHandle(mapping_);
+            }
+            CloseHandle(file_);
+            throw SVMPayException("Mint cache: cannot map " + path_);
+        }
+#else
+        int fd = open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            throw SVMPayException("Mint cache: cannot open " + path_ + ": " + std::strerror(errno));
+        }
+        void* data = MAP_FAILED;
+        if (ftruncate(fd, static_cast<off_t>(size_)) == 0) {
+            data = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        int error = errno;
+        close(fd);  // The mapping keeps the file open
+        if (data == MAP_FAILED) {
+            throw SVMPayException("Mint cache: cannot map " + path_ + ": " + std::strerror(error));
+        }
+        data_ = static_cast<uint8_t*>(data);
+#endif
+    }
+
+    std::string path_;
+    size_t size_;
+    uint8_t* data_ = nullptr;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+MintCache::MintCache(SvmNetworkAdapter& adapter, const MintCacheConfig& config)
+    : config_(config), loader_(adapter, config.loader) {
+    config_.capacity = std::max<size_t>(1, config_.capacity);
+    size_t slots = 2;
+    while (slots < 2 * config_.capacity) {
+        slots <<= 1;
+    }
+    slots_ = std::make_unique<Slot[]>(slots);
+    mask_ = slots - 1;
+    for (size_t i = 0; i < slots; ++i) {
+        for (auto& word : slots_[i].words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    if (!config_.path.empty()) {
+        std::vector<StoredMint> existing;
+        storage_ = std::make_unique<Storage>(config_.path, config_.capacity, existing);
+        for (const auto& stored : existing) {
+            // Should a mint appear twice, the later record wins and the earlier is freed below
+            entries_[stored.info.mint] = Entry{stored.record, stored.loaded_at, stores_++};
+            publish_locked(stored.info);
+        }
+        next_record_ = storage_->count();
+        std::vector<bool> used(next_record_, false);
+        for (const auto& entry : entries_) {
+            used[entry.second.record] = true;
+        }
+        for (size_t record = next_record_; record-- > 0;) {
+            if (!used[record]) {
+                free_records_.push_back(record);
+            }
+        }
+    }
+    refresher_.emplace(adapter.transport(), [this](PeriodicTask::Done done) { run(std::move(done)); });
+}
+
+MintCache::~MintCache() {
+    refresher_->stop();
+}
+
+std::optional<MintInfo> MintCache::find(const PublicKey& mint) const {
+    uint64_t key[4];
+    std::memcpy(key, mint.data(), sizeof(key));
+    size_t index = PublicKeyHash{}(mint) & mask_;
+    for (size_t probe = 0; probe <= mask_; ++probe, index = (index + 1) & mask_) {
+        const Slot& slot = slots_[index];
+        uint64_t words[Slot::WORDS];
+        while (true) {
+            uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+            for (size_t i = 0; i < Slot::WORDS; ++i) {
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                break;
+            }
+        }
+        if (!(words[8] & Slot::OCCUPIED)) {
+            return std::nullopt;
+        }
+        if (std::memcmp(words, key, sizeof(key)) == 0) {
+            MintInfo info;
+            info.mint = mint;
+            std::memcpy(info.program.data(), words + 4, PublicKey::SIZE);
+            info.decimals = static_cast<uint8_t>(words[8]);
+            return info;
+        }
+    }
+    return std::nullopt;
+}
+
+void MintCache::get_async(const PublicKey& mint, Completion<MintInfo> on_done) {
+    if (auto info = find(mint)) {
+        on_done(*info, nullptr);
+        return;
+    }
+    loader_.load_async(mint, [this, mint, on_done = std::move(on_done)](std::optional<AccountInfo> account,
+                                                                         std::exception_ptr error) {
+        if (error) {
+            on_done(MintInfo{}, error);
+            return;
+        }
+        MintInfo info;
+        try {
+            if (!account) {
+                throw TransactionException("Mint " + mint.to_base58() + " does not exist");
+            }
+            info = decode_mint(mint, *account);
+        } catch (const std::exception&) {
+            on_done(MintInfo{}, std::current_exception());
+            return;
+        }
+        store(info, unix_now());
+        on_done(info, nullptr);
+    });
+}
+
+std::future<MintInfo> MintCache::get(const PublicKey& mint) {
+    auto promise = std::make_shared<std::promise<MintInfo>>();
+    std::future<MintInfo> result = promise->get_future();
+    get_async(mint, [promise](MintInfo info, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(info);
+        }
+    });
+    return result;
+}
+
+void MintCache::put(const MintInfo& info) {
+    store(info, unix_now());
+}
+
+void MintCache::store(const MintInfo& info, uint64_t loaded_at, bool insert) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(info.mint);
+    size_t record;
+    if (it != entries_.end()) {
+        record = it->second.record;
+        it->second.loaded_at = loaded_at;
+        it->second.stored = stores_++;
+    } else {
+        if (!insert) {
+            return;
+        }
+        record = take_record_locked();
+        entries_.emplace(info.mint, Entry{record, loaded_at, stores_++});
+    }
+    if (storage_) {
+        storage_->write(record, info, loaded_at);
+    }
+    publish_locked(info);
+}
+
+size_t MintCache::take_record_locked() {
+    if (!free_records_.empty()) {
+        size_t record = free_records_.back();
+        free_records_.pop_back();
+        return record;
+    }
+    if (next_record_ < config_.capacity) {
+        return next_record_++;
+    }
+    // Full: the mint loaded longest ago gives up its record, the first stored on a tie
+    auto oldest = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (std::make_pair(it->second.loaded_at, it->second.stored) <
+            std::make_pair(oldest->second.loaded_at, oldest->second.stored)) {
+            oldest = it;
+        }
+    }
+    size_t record = oldest->second.record;
+    unpublish_locked(oldest->first);
+    entries_.erase(oldest);
+    ++evictions_;
+    return record;
+}
+
+void MintCache::publish_locked(const MintInfo& info) {
+    uint64_t words[Slot::WORDS];
+    std::memcpy(words, info.mint.data(), PublicKey::SIZE);
+    std::memcpy(words + 4, info.program.data(), PublicKey::SIZE);
+    words[8] = Slot::OCCUPIED | info.decimals;
+
+    // Probe for the mint's slot or the first free one; the table is never
+    // more than half full, so there is always one
+    size_t index = PublicKeyHash{}(info.mint) & mask_;
+    while (true) {
+        Slot& slot = slots_[index];
+        uint64_t meta = slot.words[8].load(std::memory_order_relaxed);
+        bool same = true;
+        for (size_t i = 0; i < 4; ++i) {
+            same = same && slot.words[i].load(std::memory_order_relaxed) == words[i];
+        }
+        if (!(meta & Slot::OCCUPIED) || same) {
+            write_slot(slot.sequence, slot.words, words, Slot::WORDS);
+            return;
+        }
+        index = (index + 1) & mask_;
+    }
+}
+
+void MintCache::unpublish_locked(const PublicKey& mint) {
+    uint64_t key[4];
+    std::memcpy(key, mint.data(), sizeof(key));
+    size_t hole = PublicKeyHash{}(mint) & mask_;
+    while (true) {
+        const Slot& slot = slots_[hole];
+        if (!(slot.words[8].load(std::memory_order_relaxed) & Slot::OCCUPIED)) {
+            return;
+        }
+        bool same = true;
+        for (size_t i = 0; i < 4; ++i) {
+            same = same && slot.words[i].load(std::memory_order_relaxed) == key[i];
+        }
+        if (same) {
+            break;
+        }
+        hole = (hole + 1) & mask_;
+    }
+
+    // Shift later mints of the probe run back into the hole rather than
+    // leave tombstones. A mint is copied before its old slot is cleared, so
+    // a concurrent find() can at worst miss it and load it as on any miss.
+    uint64_t words[Slot::WORDS];
+    for (size_t next = (hole + 1) & mask_;; next = (next + 1) & mask_) {
+        Slot& slot = slots_[next];
+        for (size_t i = 0; i < Slot::WORDS; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+        if (!(words[8] & Slot::OCCUPIED)) {
+            break;
+        }
+        PublicKey moved;
+        std::memcpy(moved.data(), words, PublicKey::SIZE);
+        size_t home = PublicKeyHash{}(moved) & mask_;
+        // Stays put if its home lies cyclically in (hole, next]
+        bool stays = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!stays) {
+            write_slot(slots_[hole].sequence, slots_[hole].words, words, Slot::WORDS);
+            hole = next;
+        }
+    }
+    std::fill(std::begin(words), std::end(words), 0);
+    write_slot(slots_[hole].sequence, slots_[hole].words, words, Slot::WORDS);
+}
+
+void MintCache::refresh() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        refresh_requested_ = true;
+    }
+    refresher_->run_now();
+}
+
+void MintCache::sync() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (storage_) {
+        storage_->sync();
+    }
+}
+
+size_t MintCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+uint64_t MintCache::eviction_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return evictions_;
+}
+
+void MintCache::run(PeriodicTask::Done done) {
+    uint64_t now = unix_now();
+    std::vector<std::pair<uint64_t, PublicKey>> due;
+    uint64_t next = UINT64_MAX;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool everything = std::exchange(refresh_requested_, false);
+        uint64_t max_age = static_cast<uint64_t>(config_.max_age.count());
+        for (const auto& [mint, entry] : entries_) {
+            if (everything || entry.loaded_at + max_age <= now) {
+                due.emplace_back(entry.loaded_at, mint);
+            } else {
+                next = std::min(next, entry.loaded_at + max_age);
+            }
+        }
+    }
+    if (due.empty()) {
+        done(next == UINT64_MAX ? config_.max_age : std::chrono::seconds(next - now));
+        return;
+    }
+
+    std::sort(due.begin(), due.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<PublicKey> keys;
+    keys.reserve(due.size());
+    for (const auto& entry : due) {
+        keys.push_back(entry.second);
+    }
+    loader_.load_many_async(keys, [this, keys, now, done = std::move(done)](
+                                      std::vector<std::optional<AccountInfo>> accounts, std::exception_ptr error) {
+        if (error) {
+            done(config_.retry_delay);
+            return;
+        }
+        for (size_t i = 0; i < keys.size(); ++i) {
+            // A mint that was closed or reassigned keeps its last known state
+            std::optional<MintInfo> info;
+            if (accounts[i]) {
+                try {
+                    info = decode_mint(keys[i], *accounts[i]);
+                } catch (const TransactionException&) {
+                }
+            }
+            if (!info) {
+                info = find(keys[i]);
+            }
+            // One evicted since it was picked stays out
+            if (info) {
+                store(*info, now, false);
+            }
+        }
+        // Look again at once for mints that came due meanwhile
+        done(std::chrono::milliseconds(0));
+    });
+}
+
+} // namespace svm_pay
@@ -0,0 +1,276 @@
+#include "svm-pay/network/nonce_pool.hpp"
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+namespace svm_pay {
+
+namespace {
+
+std::string sign_base64(const TransactionBuilder& builder, const std::vector<Keypair>& signers) {
+    uint8_t wire[TransactionBuilder::MAX_TRANSACTION_SIZE];
+    size_t size = builder.serialize_signed(signers, wire, sizeof(wire));
+    return base64_encode(wire, size);
+}
+
+} // namespace
+
+std::string create_nonce_account_transaction(const Keypair& payer, const Keypair& nonce_account,
+                                             const PublicKey& authority, uint64_t lamports,
+                                             const Blockhash& recent_blockhash) {
+    TransactionBuilder builder;
+    builder.set_fee_payer(payer.public_key())
+        .set_recent_blockhash(recent_blockhash)
+        .add_instruction(system_create_account(payer.public_key(), nonce_account.public_key(), lamports,
+                                               NONCE_ACCOUNT_SIZE, system_program_id()))
+        .add_instruction(nonce_initialize(nonce_account.public_key(), authority));
+    return sign_base64(builder, {payer, nonce_account});
+}
+
+std::string advance_nonce_transaction(const Keypair& authority, const NonceAccount& account) {
+    TransactionBuilder builder;
+    builder.set_fee_payer(authority.public_key())
+        .set_durable_nonce(account.address, authority.public_key(), account.nonce);
+    return sign_base64(builder, {authority});
+}
+
+/**
+ * Pool contents, shared with leases and with refreshes in flight
+ */
+struct NoncePool::State : std::enable_shared_from_this<NoncePool::State> {
+    enum class SlotState { READING, READY, LEASED, DROPPED };
+
+    struct Slot {
+        PublicKey address;
+        NonceAccount account;
+        SlotState state = SlotState::READING;
+        std::optional<Blockhash> consumed;  // Nonce a sent transaction used; the next read must differ
+        std::chrono::steady_clock::time_point consumed_at;
+        std::chrono::milliseconds delay{0};
+    };
+
+    State(SvmNetworkAdapter& adapter, const NoncePoolConfig& config) : adapter(adapter), config(config) {}
+
+    void read(size_t index);
+    void read_later(size_t index);
+    void release(size_t index, bool used);
+
+    SvmNetworkAdapter& adapter;
+    NoncePoolConfig config;
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    bool stopping = false;
+    size_t outstanding = 0;     // Slots with a read or refresh timer in flight
+    size_t dropped = 0;
+    std::vector<Slot> slots;
+    std::vector<size_t> ready;  // Indexes of READY slots
+};
+
+void NoncePool::State::read(size_t index) {
+    PublicKey address;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        address = slots[index].address;
+    }
+    CallOptions options;
+    options.timeout = config.request_timeout;
+    auto self = shared_from_this();
+    adapter.get_nonce_account_async(address, options, [self, index](NonceAccount account, std::exception_ptr error) {
+        // Network errors are retried; an account that is not a nonce account stays one
+        bool permanent = false;
+        if (error) {
+            try {
+                std::rethrow_exception(error);
+            } catch (const TransactionException&) {
+                permanent = true;
+            } catch (...) {
+            }
+        }
+        bool retry = false;
+        {
+            std::lock_guard<std::mutex> lock(self->mutex);
+            Slot& slot = self->slots[index];
+            // Until the sent transaction lands the old nonce is still on chain;
+            // past the timeout it was dropped, and the nonce is free again
+            bool unchanged = !error && slot.consumed && account.nonce == *slot.consumed &&
+                             std::chrono::steady_clock::now() - slot.consumed_at < self->config.used_nonce_timeout;
+            retry = !self->stopping && !permanent && (error || unchanged);
+            if (self->stopping) {
+                permanent = false;
+            }
+            if (permanent) {
+                // Still outstanding until on_dropped returns, so the pool outlives the call
+                slot.state = SlotState::DROPPED;
+                ++self->dropped;
+                self->changed.notify_all();
+            } else if (!retry) {
+                --self->outstanding;
+                if (!self->stopping) {
+                    slot.account = account;
+                    slot.consumed.reset();
+                    slot.delay = std::chrono::milliseconds(0);
+                    slot.state = SlotState::READY;
+                    self->ready.push_back(index);
+                }
+                self->changed.notify_all();
+            }
+        }
+        if (retry) {
+            // The read's outstanding count carries over to the timer
+            self->read_later(index);
+        } else if (permanent) {
+            if (self->config.on_dropped) {
+                self->config.on_dropped(self->slots[index].address, error);
+            }
+            std::lock_guard<std::mutex> lock(self->mutex);
+            --self->outstanding;
+            self->changed.notify_all();
+        }
+    });
+}
+
+void NoncePool::State::read_later(size_t index) {
+    std::chrono::milliseconds delay;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Slot& slot = slots[index];
+        slot.state = SlotState::READING;
+        slot.delay = slot.delay.count() == 0 ? config.refresh_interval
+                                             : std::min(slot.delay * 2, config.max_refresh_interval);
+        delay = slot.delay;
+    }
+    auto self = shared_from_this();
+    adapter.transport().schedule(std::chrono::steady_clock::now() + delay, [self, index](bool cancelled) {
+        {
+            std::lock_guard<std::mutex> lock(self->mutex);
+            if (cancelled || self->stopping) {
+                --self->outstanding;
+                self->changed.notify_all();
+                return;
+            }
+        }
+        // The timer's outstanding count carries over to the read
+        self->read(index);
+    });
+}
+
+void NoncePool::State::release(size_t index, bool used) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            return;
+        }
+        Slot& slot = slots[index];
+        if (!used) {
+            slot.state = SlotState::READY;
+            ready.push_back(index);
+            changed.notify_one();
+            return;
+        }
+        slot.consumed = slot.account.nonce;
+        slot.consumed_at = std::chrono::steady_clock::now();
+        slot.delay = std::chrono::milliseconds(0);
+        ++outstanding;
+    }
+    read_later(index);
+}
+
+NoncePool::NoncePool(SvmNetworkAdapter& adapter, const std::vector<PublicKey>& accounts, const NoncePoolConfig& config)
+    : state_(std::make_shared<State>(adapter, config)) {
+    state_->config.refresh_interval = std::max(state_->config.refresh_interval, std::chrono::milliseconds(1));
+    state_->slots.resize(accounts.size());
+    for (size_t i = 0; i < accounts.size(); ++i) {
+        state_->slots[i].address = accounts[i];
+    }
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->outstanding = accounts.size();
+    }
+    for (size_t i = 0; i < accounts.size(); ++i) {
+        state_->read(i);
+    }
+}
+
+NoncePool::~NoncePool() {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->stopping = true;
+    state_->changed.notify_all();
+    state_->changed.wait(lock, [this]() { return state_->outstanding == 0; });
+}
+
+NonceLease NoncePool::acquire(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    auto settled = [this]() { return !state_->ready.empty() || state_->dropped == state_->slots.size(); };
+    if (!state_->changed.wait_for(lock, timeout, settled)) {
+        throw TimeoutException("no nonce account free within " + std::to_string(timeout.count()) + " ms");
+    }
+    if (state_->ready.empty()) {
+        throw TransactionException("no account in the pool is a usable nonce account");
+    }
+    size_t index = state_->ready.back();
+    state_->ready.pop_back();
+    state_->slots[index].state = State::SlotState::LEASED;
+    return NonceLease(state_, index, state_->slots[index].account);
+}
+
+std::optional<NonceLease> NoncePool::try_acquire() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (state_->ready.empty()) {
+        return std::nullopt;
+    }
+    size_t index = state_->ready.back();
+    state_->ready.pop_back();
+    state_->slots[index].state = State::SlotState::LEASED;
+    return NonceLease(state_, index, state_->slots[index].account);
+}
+
+size_t NoncePool::available() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->ready.size();
+}
+
+size_t NoncePool::size() const {
+    return state_->slots.size();
+}
+
+size_t NoncePool::dropped() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->dropped;
+}
+
+NonceLease::NonceLease(std::shared_ptr<NoncePool::State> pool, size_t index, NonceAccount account)
+    : pool_(std::move(pool)), index_(index), account_(std::move(account)) {}
+
+NonceLease::NonceLease(NonceLease&& other) noexcept
+    : pool_(std::move(other.pool_)), index_(other.index_), account_(other.account_), used_(other.used_) {}
+
+NonceLease& NonceLease::operator=(NonceLease&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool_ = std::move(other.pool_);
+        index_ = other.index_;
+        account_ = other.account_;
+        used_ = other.used_;
+    }
+    return *this;
+}
+
+NonceLease::~NonceLease() {
+    release();
+}
+
+void NonceLease::apply(TransactionBuilder& builder) const {
+    builder.set_durable_nonce(account_.address, account_.authority, account_.nonce);
+}
+
+void NonceLease::release() {
+    if (pool_) {
+        pool_->release(index_, used_);
+        pool_.reset();
+    }
+}
+
+} // namespace svm_pay
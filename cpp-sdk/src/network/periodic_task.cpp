@@ -0,0 +1,88 @@
+#include "svm-pay/network/periodic_task.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+namespace svm_pay {
+
+/**
+ * Shared with timers that are set and the run in flight
+ */
+struct PeriodicTask::State : std::enable_shared_from_this<PeriodicTask::State> {
+    State(RpcTransport& transport, Step step) : transport(transport), step(std::move(step)) {}
+
+    void schedule_locked(std::chrono::milliseconds delay);
+    void start(uint64_t timer);
+    void finish(std::chrono::milliseconds next);
+
+    RpcTransport& transport;
+    Step step;
+
+    std::mutex mutex;
+    std::condition_variable idle;
+    bool running = false;
+    bool again = false;       // run_now() came in while running
+    bool stopping = false;
+    uint64_t generation = 0;  // Bumped per timer set, so only the latest one runs
+};
+
+void PeriodicTask::State::schedule_locked(std::chrono::milliseconds delay) {
+    uint64_t timer = ++generation;
+    auto self = shared_from_this();
+    transport.schedule(std::chrono::steady_clock::now() + delay, [self, timer](bool cancelled) {
+        if (!cancelled) {
+            self->start(timer);
+        }
+    });
+}
+
+void PeriodicTask::State::start(uint64_t timer) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping || running || timer != generation) {
+            return;
+        }
+        running = true;
+    }
+    auto self = shared_from_this();
+    step([self](std::chrono::milliseconds next) { self->finish(next); });
+}
+
+void PeriodicTask::State::finish(std::chrono::milliseconds next) {
+    std::lock_guard<std::mutex> lock(mutex);
+    running = false;
+    if (!stopping) {
+        schedule_locked(std::exchange(again, false) ? std::chrono::milliseconds(0) : next);
+    }
+    idle.notify_all();
+}
+
+PeriodicTask::PeriodicTask(RpcTransport& transport, Step step)
+    : state_(std::make_shared<State>(transport, std::move(step))) {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->schedule_locked(std::chrono::milliseconds(0));
+}
+
+PeriodicTask::~PeriodicTask() {
+    stop();
+}
+
+void PeriodicTask::run_now() {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (state_->stopping) {
+        return;
+    }
+    if (state_->running) {
+        state_->again = true;
+    } else {
+        state_->schedule_locked(std::chrono::milliseconds(0));
+    }
+}
+
+void PeriodicTask::stop() {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->stopping = true;
+    state_->idle.wait(lock, [this]() { return !state_->running; });
+}
+
+} // namespace svm_pay
@@ -0,0 +1,124 @@
+#include "svm-pay/network/priority_fee_estimator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace svm_pay {
+
+PriorityFeeEstimator::PriorityFeeEstimator(SvmNetworkAdapter& adapter, const PriorityFeeEstimatorConfig& config)
+    : PriorityFeeEstimator(adapter.transport(), [&adapter, accounts = config.accounts](
+          Completion<std::vector<PrioritizationFee>> on_done) {
+          adapter.get_recent_prioritization_fees_async(accounts, CallOptions{}, std::move(on_done));
+      }, config) {}
+
+PriorityFeeEstimator::PriorityFeeEstimator(Fetcher fetcher, const PriorityFeeEstimatorConfig& config)
+    : PriorityFeeEstimator(*RpcTransport::shared(), std::move(fetcher), config) {}
+
+PriorityFeeEstimator::PriorityFeeEstimator(RpcTransport& transport, Fetcher fetcher,
+                                           const PriorityFeeEstimatorConfig& config)
+    : fetcher_(std::move(fetcher)), config_(config), sketch_(config.relative_accuracy) {
+    config_.window_slots = std::max<uint64_t>(1, config_.window_slots);
+    for (auto& word : words_) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    refresher_.emplace(transport, [this](PeriodicTask::Done done) { run(std::move(done)); });
+}
+
+PriorityFeeEstimator::~PriorityFeeEstimator() {
+    refresher_->stop();
+}
+
+uint64_t PriorityFeeEstimator::fee_for_percentile(double percentile) const {
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    size_t below = static_cast<size_t>(percentile);
+    size_t above = std::min<size_t>(below + 1, 100);
+    uint64_t low;
+    uint64_t high;
+    while (true) {
+        uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before == 0) {
+            return config_.default_fee;
+        }
+        if (before & 1) {
+            continue;
+        }
+        low = words_[1 + below].load(std::memory_order_relaxed);
+        high = words_[1 + above].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == before) {
+            break;
+        }
+    }
+    double fraction = percentile - static_cast<double>(below);
+    return low + static_cast<uint64_t>(std::llround(fraction * static_cast<double>(high - low)));
+}
+
+void PriorityFeeEstimator::apply(TransactionBuilder& builder, double percentile) const {
+    builder.add_instruction(compute_unit_price(fee_for_percentile(percentile)));
+}
+
+uint64_t PriorityFeeEstimator::sample_count() const {
+    while (true) {
+        uint64_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        uint64_t count = words_[0].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) == before) {
+            return count;
+        }
+    }
+}
+
+void PriorityFeeEstimator::publish(const std::vector<PrioritizationFee>& fees) {
+    uint64_t newest = 0;
+    for (const auto& fee : fees) {
+        newest = std::max(newest, fee.slot);
+    }
+    sketch_.clear();
+    for (const auto& fee : fees) {
+        if (fee.slot + config_.window_slots > newest) {
+            sketch_.add(fee.fee);
+        }
+    }
+
+    uint64_t words[WORDS];
+    words[0] = sketch_.count();
+    for (size_t i = 0; i + 1 < WORDS; ++i) {
+        words[1 + i] = sketch_.quantile(static_cast<double>(i) / 100.0);
+    }
+
+    // Refreshes never overlap, so there is one writer
+    uint64_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; ++i) {
+        words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+void PriorityFeeEstimator::refresh() {
+    refresher_->run_now();
+}
+
+void PriorityFeeEstimator::run(PeriodicTask::Done done) {
+    auto finish = [this, done = std::move(done)](std::vector<PrioritizationFee> fees, std::exception_ptr error) {
+        // On failure keep answering from the previous samples and retry shortly;
+        // a node that has no samples yet says nothing about fees
+        std::chrono::milliseconds wait = config_.retry_delay;
+        if (!error && !fees.empty()) {
+            publish(fees);
+            refreshes_.fetch_add(1, std::memory_order_relaxed);
+            wait = config_.refresh_interval;
+        }
+        done(wait);
+    };
+    try {
+        fetcher_(finish);
+    } catch (...) {
+        finish({}, std::current_exception());
+    }
+}
+
+} // namespace svm_pay
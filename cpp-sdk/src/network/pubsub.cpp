@@ -0,0 +1,779 @@
+#include "svm-pay/network/pubsub.hpp"
+#include "svm-pay/network/call_options.hpp"
+#include "svm-pay/network/curl_initializer.hpp"
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <curl/curl.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <algorithm>
+#include <cctype>
+#include <thread>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+namespace svm_pay {
+
+namespace {
+
+enum class SubscriptionKind {
+    SIGNATURE,
+    ACCOUNT
+};
+
+const char* subscribe_method(SubscriptionKind kind) {
+    return kind == SubscriptionKind::SIGNATURE ? "signatureSubscribe" : "accountSubscribe";
+}
+
+const char* unsubscribe_method(SubscriptionKind kind) {
+    return kind == SubscriptionKind::SIGNATURE ? "signatureUnsubscribe" : "accountUnsubscribe";
+}
+
+std::string unsubscribe_message(SubscriptionKind kind, uint64_t server_id) {
+    return std::string("{\"jsonrpc\":\"2.0\",\"id\":0,\"method\":\"") + unsubscribe_method(kind) +
+           "\",\"params\":[" + std::to_string(server_id) + "]}";
+}
+
+/**
+ * Wait until a socket is readable or writable
+ *
+ * @return False on timeout or error
+ */
+bool wait_socket(curl_socket_t socket, bool for_write, std::chrono::steady_clock::duration timeout) {
+    // Rounded up, so a wait shorter than a millisecond does not spin;
+    // poll() also takes descriptors past FD_SETSIZE, which select() cannot
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+        timeout + std::chrono::microseconds(999)).count();
+    int wait_ms = static_cast<int>(std::min<int64_t>(std::max<int64_t>(millis, 0), INT32_MAX));
+#ifdef _WIN32
+    WSAPOLLFD fd{};
+    fd.fd = socket;
+    fd.events = for_write ? POLLWRNORM : POLLRDNORM;
+    int ready = WSAPoll(&fd, 1, wait_ms);
+#else
+    pollfd fd{};
+    fd.fd = socket;
+    fd.events = for_write ? POLLOUT : POLLIN;
+    int ready = poll(&fd, 1, wait_ms);
+#endif
+    return ready > 0;
+}
+
+std::string lowercase(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+/**
+ * RFC 6455 client over a libcurl connect-only transport
+ *
+ * libcurl supplies DNS, proxies, TCP and TLS; the upgrade handshake and
+ * framing are done here so that libcurl builds without WebSocket support
+ * work too. Not thread-safe.
+ */
+class WebSocket {
+public:
+    enum Opcode : uint8_t {
+        CONTINUATION = 0x0,
+        TEXT = 0x1,
+        BINARY = 0x2,
+        CLOSE = 0x8,
+        PING = 0x9,
+        PONG = 0xA
+    };
+
+    // Larger messages are treated as a protocol violation
+    static constexpr size_t MAX_MESSAGE_SIZE = 64 * 1024 * 1024;
+
+    WebSocket() = default;
+    WebSocket(const WebSocket&) = delete;
+    WebSocket& operator=(const WebSocket&) = delete;
+
+    ~WebSocket() {
+        if (curl_) {
+            curl_easy_cleanup(curl_);
+        }
+    }
+
+    /**
+     * Connect and perform the upgrade handshake
+     *
+     * @return False if the endpoint could not be reached or refused the upgrade
+     */
+    bool open(const std::string& url, std::chrono::milliseconds timeout) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        std::string scheme, host, port, path, query;
+        if (!split_url(url, scheme, host, port, path, query)) {
+            return false;
+        }
+        bool secure = scheme == "wss" || scheme == "https";
+        std::string authority = port.empty() ? host : host + ":" + port;
+
+        curl_ = curl_easy_init();
+        if (!curl_) {
+            return false;
+        }
+        std::string transport_url = (secure ? "https://" : "http://") + authority + "/";
+        curl_easy_setopt(curl_, CURLOPT_URL, transport_url.c_str());
+        curl_easy_setopt(curl_, CURLOPT_CONNECT_ONLY, 1L);
+        curl_easy_setopt(curl_, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(curl_, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(timeout.count()));
+        if (curl_easy_perform(curl_) != CURLE_OK) {
+            return false;
+        }
+
+        unsigned char nonce[16];
+        RAND_bytes(nonce, sizeof(nonce));
+        std::string key = base64_encode(nonce, sizeof(nonce));
+        std::string request = "GET " + path + (query.empty() ? "" : "?" + query) + " HTTP/1.1\r\n"
+                              "Host: " + authority + "\r\n"
+                              "Upgrade: websocket\r\n"
+                              "Connection: Upgrade\r\n"
+                              "Sec-WebSocket-Key: " + key + "\r\n"
+                              "Sec-WebSocket-Version: 13\r\n\r\n";
+        if (!send_raw(request.data(), request.size(), deadline)) {
+            return false;
+        }
+
+        size_t header_end;
+        while ((header_end = inbound_.find("\r\n\r\n")) == std::string::npos) {
+            if (inbound_.size() > 16 * 1024 || std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            wait_socket(socket(), false, deadline - std::chrono::steady_clock::now());
+            if (!receive()) {
+                return false;
+            }
+        }
+        std::string headers = inbound_.substr(0, header_end + 2);
+        std::string folded = lowercase(headers);
+        inbound_.erase(0, header_end + 4);
+
+        if (folded.compare(0, 12, "http/1.1 101") != 0) {
+            return false;
+        }
+        const std::string name = "\r\nsec-websocket-accept:";
+        size_t value_start = folded.find(name);
+        if (value_start == std::string::npos) {
+            return false;
+        }
+        value_start = headers.find_first_not_of(' ', value_start + name.size());
+        std::string accept = headers.substr(value_start, headers.find("\r\n", value_start) - value_start);
+
+        std::string magic = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int digest_size = 0;
+        EVP_Digest(magic.data(), magic.size(), digest, &digest_size, EVP_sha1(), nullptr);
+        return accept == base64_encode(digest, digest_size);
+    }
+
+    curl_socket_t socket() const {
+        curl_socket_t result = CURL_SOCKET_BAD;
+        if (curl_) {
+            curl_easy_getinfo(curl_, CURLINFO_ACTIVESOCKET, &result);
+        }
+        return result;
+    }
+
+    /**
+     * Send one unfragmented, masked frame
+     *
+     * @return False if the connection failed
+     */
+    bool send(uint8_t opcode, const std::string& payload) {
+        std::string frame;
+        frame.reserve(payload.size() + 14);
+        frame += static_cast<char>(0x80 | opcode);
+        if (payload.size() < 126) {
+            frame += static_cast<char>(0x80 | payload.size());
+        } else if (payload.size() <= 0xFFFF) {
+            frame += static_cast<char>(0x80 | 126);
+            frame += static_cast<char>((payload.size() >> 8) & 0xFF);
+            frame += static_cast<char>(payload.size() & 0xFF);
+        } else {
+            frame += static_cast<char>(0x80 | 127);
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                frame += static_cast<char>((static_cast<uint64_t>(payload.size()) >> shift) & 0xFF);
+            }
+        }
+        unsigned char mask[4];
+        RAND_bytes(mask, sizeof(mask));
+        frame.append(reinterpret_cast<char*>(mask), sizeof(mask));
+        for (size_t i = 0; i < payload.size(); ++i) {
+            frame += static_cast<char>(payload[i] ^ mask[i % 4]);
+        }
+        return send_raw(frame.data(), frame.size(), std::chrono::steady_clock::now() + std::chrono::seconds(5));
+    }
+
+    /**
+     * Read whatever has arrived and extract complete messages
+     *
+     * Pings are answered here; close frames end the connection.
+     *
+     * @param messages Receives complete text and binary messages
+     * @return False once the connection is closed or broken
+     */
+    bool poll(std::vector<std::string>& messages) {
+        if (!receive()) {
+            return false;
+        }
+        while (inbound_.size() >= 2) {
+            auto byte = [this](size_t i) { return static_cast<unsigned char>(inbound_[i]); };
+            bool fin = (byte(0) & 0x80) != 0;
+            uint8_t opcode = byte(0) & 0x0F;
+            bool masked = (byte(1) & 0x80) != 0;
+            uint64_t length = byte(1) & 0x7F;
+            size_t header = 2;
+            if (length >= 126) {
+                size_t extra = length == 126 ? 2 : 8;
+                if (inbound_.size() < header + extra) {
+                    break;
+                }
+                length = 0;
+                for (size_t i = 0; i < extra; ++i) {
+                    length = (length << 8) | byte(header + i);
+                }
+                header += extra;
+            }
+            if (length > MAX_MESSAGE_SIZE) {
+                return false;
+            }
+            size_t mask_offset = header;
+            header += masked ? 4 : 0;
+            if (inbound_.size() < header + length) {
+                break;
+            }
+
+            std::string payload = inbound_.substr(header, static_cast<size_t>(length));
+            if (masked) {
+                for (size_t i = 0; i < payload.size(); ++i) {
+                    payload[i] = static_cast<char>(payload[i] ^ inbound_[mask_offset + i % 4]);
+                }
+            }
+            inbound_.erase(0, header + static_cast<size_t>(length));
+
+            switch (opcode) {
+                case TEXT:
+                case BINARY:
+                case CONTINUATION:
+                    fragments_ += payload;
+                    if (fragments_.size() > MAX_MESSAGE_SIZE) {
+                        return false;
+                    }
+                    if (fin) {
+                        messages.push_back(std::move(fragments_));
+                        fragments_.clear();
+                    }
+                    break;
+                case PING:
+                    if (!send(PONG, payload)) {
+                        return false;
+                    }
+                    break;
+                case CLOSE:
+                    send(CLOSE, payload.substr(0, 2));
+                    return false;
+                default:
+                    break;
+            }
+        }
+        return true;
+    }
+
+private:
+    static bool split_url(const std::string& url, std::string& scheme, std::string& host, std::string& port,
+                          std::string& path, std::string& query) {
+        CURLU* parsed = curl_url();
+        if (!parsed) {
+            return false;
+        }
+        bool ok = curl_url_set(parsed, CURLUPART_URL, url.c_str(), CURLU_NON_SUPPORT_SCHEME) == CURLUE_OK;
+        auto get = [parsed](CURLUPart part, std::string& out) {
+            char* value = nullptr;
+            if (curl_url_get(parsed, part, &value, 0) == CURLUE_OK && value) {
+                out = value;
+                curl_free(value);
+            }
+        };
+        if (ok) {
+            get(CURLUPART_SCHEME, scheme);
+            get(CURLUPART_HOST, host);
+            get(CURLUPART_PORT, port);
+            get(CURLUPART_PATH, path);
+            get(CURLUPART_QUERY, query);
+        }
+        curl_url_cleanup(parsed);
+        if (path.empty()) {
+            path = "/";
+        }
+        return ok && !host.empty();
+    }
+
+    bool send_raw(const char* data, size_t size, std::chrono::steady_clock::time_point deadline) {
+        size_t offset = 0;
+        while (offset < size) {
+            size_t sent = 0;
+            CURLcode result = curl_easy_send(curl_, data + offset, size - offset, &sent);
+            offset += sent;
+            if (result == CURLE_AGAIN) {
+                auto now = std::chrono::steady_clock::now();
+                if (now >= deadline || !wait_socket(socket(), true, deadline - now)) {
+                    return false;
+                }
+            } else if (result != CURLE_OK) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool receive() {
+        char buffer[16 * 1024];
+        while (true) {
+            size_t received = 0;
+            CURLcode result = curl_easy_recv(curl_, buffer, sizeof(buffer), &received);
+            if (result == CURLE_AGAIN) {
+                return true;
+            }
+            if (result != CURLE_OK || received == 0) {
+                return false;
+            }
+            inbound_.append(buffer, received);
+        }
+    }
+
+    CURL* curl_ = nullptr;
+    std::string inbound_;    // Bytes not yet parsed into frames
+    std::string fragments_;  // Payload of a message still being reassembled
+};
+
+// Callback invocation deferred until locks are released
+using Dispatch = std::function<void()>;
+
+} // namespace
+
+struct PubSubClient::Subscription {
+    SubscriptionKind kind;
+    std::string key;  // Signature or account address
+    bool notify_received = false;
+    SignatureCallback on_signature;
+    AccountCallback on_account;
+
+    size_t connection = 0;
+    uint64_t sent_generation = 0;  // Connection generation the subscribe request went out on
+    std::optional<uint64_t> server_id;
+};
+
+struct PubSubClient::Connection {
+    struct PendingRequest {
+        SubscriptionId subscription;
+        SubscriptionKind kind;
+    };
+
+    size_t index = 0;
+    std::thread thread;
+
+    // Guards the socket; never held while acquiring mutex_
+    std::mutex io_mutex;
+    std::unique_ptr<WebSocket> socket;
+
+    // Bumped under both locks on every successful connect
+    std::atomic<uint64_t> generation{0};
+
+    // Guarded by mutex_
+    bool connected = false;
+    size_t subscription_count = 0;
+    std::unordered_map<uint64_t, PendingRequest> pending;      // Request id -> subscription
+    std::unordered_map<uint64_t, SubscriptionId> active;      // Server subscription id -> subscription
+};
+
+PubSubClient::PubSubClient(const PubSubConfig& config) : config_(config) {
+    curl_initializer_ = CurlInitializer::get_instance();
+    size_t count = std::max<size_t>(1, config_.connections);
+    for (size_t i = 0; i < count; ++i) {
+        auto connection = std::make_unique<Connection>();
+        connection->index = i;
+        connections_.push_back(std::move(connection));
+    }
+    for (auto& connection : connections_) {
+        Connection* raw = connection.get();
+        connection->thread = std::thread([this, raw]() { run(*raw); });
+    }
+}
+
+PubSubClient::~PubSubClient() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_.store(true);
+    }
+    stop_cv_.notify_all();
+    for (auto& connection : connections_) {
+        if (connection->thread.joinable()) {
+            connection->thread.join();
+        }
+    }
+}
+
+PubSubClient::SubscriptionId PubSubClient::subscribe_signature(const std::string& signature,
+                                                               SignatureCallback callback,
+                                                               bool notify_received) {
+    auto subscription = std::make_unique<Subscription>();
+    subscription->kind = SubscriptionKind::SIGNATURE;
+    subscription->key = signature;
+    subscription->notify_received = notify_received;
+    subscription->on_signature = std::move(callback);
+    return add_subscription(std::move(subscription));
+}
+
+std::future<PaymentStatus> PubSubClient::wait_for_signature(const std::string& signature) {
+    auto promise = std::make_shared<std::promise<PaymentStatus>>();
+    auto future = promise->get_future();
+    subscribe_signature(signature, [promise](const SignatureUpdate& update) {
+        promise->set_value(update.status);
+    });
+    return future;
+}
+
+PubSubClient::SubscriptionId PubSubClient::subscribe_account(const std::string& address,
+                                                             AccountCallback callback) {
+    auto subscription = std::make_unique<Subscription>();
+    subscription->kind = SubscriptionKind::ACCOUNT;
+    subscription->key = address;
+    subscription->on_account = std::move(callback);
+    return add_subscription(std::move(subscription));
+}
+
+PubSubClient::SubscriptionId PubSubClient::add_subscription(std::unique_ptr<Subscription> subscription) {
+    std::optional<std::string> message;
+    uint64_t generation = 0;
+    Connection* target = nullptr;
+    SubscriptionId id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = next_id_++;
+
+        // Least-loaded connection keeps sockets evenly filled
+        target = connections_.front().get();
+        for (auto& connection : connections_) {
+            if (connection->subscription_count < target->subscription_count) {
+                target = connection.get();
+            }
+        }
+        ++target->subscription_count;
+        subscription->connection = target->index;
+
+        generation = target->generation.load();
+        message = prepare_subscribe_locked(*target, id, *subscription);
+        subscriptions_.emplace(id, std::move(subscription));
+    }
+    // Not connected yet: the connection thread subscribes once it is up
+    if (message) {
+        send_text(*target, *message, generation);
+    }
+    return id;
+}
+
+std::optional<std::string> PubSubClient::prepare_subscribe_locked(Connection& connection, SubscriptionId id,
+                                                                  Subscription& subscription) {
+    uint64_t generation = connection.generation.load();
+    if (!connection.connected || subscription.sent_generation == generation) {
+        return std::nullopt;
+    }
+    uint64_t request_id = next_request_id_++;
+    connection.pending[request_id] = {id, subscription.kind};
+    subscription.sent_generation = generation;
+
+    std::string options = "{\"commitment\":\"" + json_escape(config_.commitment) + "\"";
+    if (subscription.kind == SubscriptionKind::SIGNATURE && subscription.notify_received) {
+        options += ",\"enableReceivedNotification\":true";
+    } else if (subscription.kind == SubscriptionKind::ACCOUNT) {
+        options += ",\"encoding\":\"base64\"";
+    }
+    options += "}";
+
+    return "{\"jsonrpc\":\"2.0\",\"id\":" + std::to_string(request_id) + ",\"method\":\"" +
+           subscribe_method(subscription.kind) + "\",\"params\":[\"" + json_escape(subscription.key) +
+           "\"," + options + "]}";
+}
+
+void PubSubClient::unsubscribe(SubscriptionId id) {
+    std::optional<std::string> message;
+    Connection* connection = nullptr;
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = subscriptions_.find(id);
+        if (it == subscriptions_.end()) {
+            return;
+        }
+        Subscription& subscription = *it->second;
+        connection = connections_[subscription.connection].get();
+        --connection->subscription_count;
+        if (subscription.server_id && connection->connected) {
+            connection->active.erase(*subscription.server_id);
+            message = unsubscribe_message(subscription.kind, *subscription.server_id);
+            generation = connection->generation.load();
+        }
+        // A subscribe still in flight is cancelled when its response arrives
+        subscriptions_.erase(it);
+    }
+    if (message) {
+        send_text(*connection, *message, generation);
+    }
+}
+
+size_t PubSubClient::subscription_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscriptions_.size();
+}
+
+size_t PubSubClient::connected_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    for (const auto& connection : connections_) {
+        count += connection->connected ? 1 : 0;
+    }
+    return count;
+}
+
+void PubSubClient::wait_for_stop(std::chrono::milliseconds duration) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stop_cv_.wait_for(lock, duration, [this]() { return stopping_.load(); });
+}
+
+void PubSubClient::run(Connection& connection) {
+    auto backoff = config_.reconnect_delay;
+    while (!stopping_.load()) {
+        if (!connect(connection)) {
+            wait_for_stop(backoff);
+            backoff = std::min(backoff * 2, config_.max_reconnect_delay);
+            continue;
+        }
+        backoff = config_.reconnect_delay;
+        resubscribe(connection);
+        read_loop(connection);
+        disconnect(connection);
+    }
+}
+
+bool PubSubClient::connect(Connection& connection) {
+    auto socket = std::make_unique<WebSocket>();
+    if (!socket->open(config_.url, get_default_connect_timeout())) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> io_lock(connection.io_mutex);
+    std::lock_guard<std::mutex> lock(mutex_);
+    connection.socket = std::move(socket);
+    connection.connected = true;
+    connection.generation.fetch_add(1);
+    return true;
+}
+
+void PubSubClient::disconnect(Connection& connection) {
+    {
+        std::lock_guard<std::mutex> io_lock(connection.io_mutex);
+        connection.socket.reset();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    connection.connected = false;
+    connection.pending.clear();
+    connection.active.clear();
+    for (auto& entry : subscriptions_) {
+        if (entry.second->connection == connection.index) {
+            entry.second->server_id.reset();
+        }
+    }
+}
+
+void PubSubClient::resubscribe(Connection& connection) {
+    std::vector<std::string> messages;
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation = connection.generation.load();
+        for (auto& entry : subscriptions_) {
+            if (entry.second->connection != connection.index) {
+                continue;
+            }
+            auto message = prepare_subscribe_locked(connection, entry.first, *entry.second);
+            if (message) {
+                messages.push_back(std::move(*message));
+            }
+        }
+    }
+    for (const auto& message : messages) {
+        if (!send_text(connection, message, generation)) {
+            return;
+        }
+    }
+}
+
+bool PubSubClient::send_text(Connection& connection, const std::string& text, uint64_t generation) {
+    std::lock_guard<std::mutex> io_lock(connection.io_mutex);
+    // A reconnect in between invalidates the request; the new generation resends it
+    if (!connection.socket || connection.generation.load() != generation) {
+        return false;
+    }
+    return connection.socket->send(WebSocket::TEXT, text);
+}
+
+void PubSubClient::read_loop(Connection& connection) {
+    auto last_ping = std::chrono::steady_clock::now();
+
+    while (!stopping_.load()) {
+        curl_socket_t socket;
+        {
+            std::lock_guard<std::mutex> io_lock(connection.io_mutex);
+            socket = connection.socket->socket();
+        }
+        if (socket == CURL_SOCKET_BAD) {
+            return;
+        }
+        // Short wait so shutdown and keepalive are noticed promptly
+        wait_socket(socket, false, std::chrono::milliseconds(100));
+
+        std::vector<std::string> messages;
+        bool open;
+        {
+            std::lock_guard<std::mutex> io_lock(connection.io_mutex);
+            open = connection.socket->poll(messages);
+            auto now = std::chrono::steady_clock::now();
+            if (open && now - last_ping >= config_.ping_interval) {
+                open = connection.socket->send(WebSocket::PING, "");
+                last_ping = now;
+            }
+        }
+
+        for (const auto& message : messages) {
+            handle_message(connection, message);
+        }
+        if (!open) {
+            return;
+        }
+    }
+}
+
+void PubSubClient::handle_message(Connection& connection, const std::string& text) {
+    JsonValue message;
+    try {
+        message = JsonValue::parse(text);
+    } catch (const JsonParseException&) {
+        return;
+    }
+
+    std::vector<Dispatch> dispatches;
+    std::optional<std::string> cleanup;
+    uint64_t generation = connection.generation.load();
+
+    const JsonValue* id = message.find("id");
+    if (id && id->is_number()) {
+        // Response to a subscribe request
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto pending = connection.pending.find(id->as_uint64());
+        if (pending == connection.pending.end()) {
+            return;
+        }
+        auto request = pending->second;
+        connection.pending.erase(pending);
+
+        const JsonValue& result = message["result"];
+        auto it = subscriptions_.find(request.subscription);
+        if (!result.is_number()) {
+            // Rejected by the node; signature watchers learn about it, account watchers are dropped
+            if (it == subscriptions_.end()) {
+                return;
+            }
+            if (it->second->kind == SubscriptionKind::SIGNATURE) {
+                SignatureUpdate update;
+                update.signature = it->second->key;
+                update.status = PaymentStatus::FAILED;
+                update.error = message["error"]["message"].is_string()
+                                   ? message["error"]["message"].as_string()
+                                   : std::string("subscription rejected");
+                auto callback = std::move(it->second->on_signature);
+                dispatches.push_back([callback, update]() { callback(update); });
+            }
+            --connection.subscription_count;
+            subscriptions_.erase(it);
+        } else if (it == subscriptions_.end()) {
+            // Unsubscribed while the request was in flight
+            cleanup = unsubscribe_message(request.kind, result.as_uint64());
+        } else {
+            it->second->server_id = result.as_uint64();
+            connection.active[result.as_uint64()] = request.subscription;
+        }
+    } else {
+        const JsonValue& method = message["method"];
+        const JsonValue& params = message["params"];
+        if (!method.is_string() || !params["subscription"].is_number()) {
+            return;
+        }
+        uint64_t server_id = params["subscription"].as_uint64();
+        const JsonValue& result = params["result"];
+        uint64_t slot = result["context"]["slot"].is_number() ? result["context"]["slot"].as_uint64() : 0;
+        const JsonValue& value = result["value"];
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto active = connection.active.find(server_id);
+        if (active == connection.active.end()) {
+            return;
+        }
+        auto it = subscriptions_.find(active->second);
+        if (it == subscriptions_.end()) {
+            return;
+        }
+        Subscription& subscription = *it->second;
+
+        if (method.as_string() == "signatureNotification" && subscription.kind == SubscriptionKind::SIGNATURE) {
+            SignatureUpdate update;
+            update.signature = subscription.key;
+            update.slot = slot;
+            if (value.is_string()) {
+                // "receivedSignature": seen by the node, not yet processed
+                update.status = PaymentStatus::PENDING;
+                auto callback = subscription.on_signature;
+                dispatches.push_back([callback, update]() { callback(update); });
+            } else {
+                const JsonValue& err = value["err"];
+                if (!err.is_null()) {
+                    update.status = PaymentStatus::FAILED;
+                    update.error = err.is_string() ? err.as_string() : err.dump();
+                } else if (config_.commitment == "processed") {
+                    update.status = PaymentStatus::PENDING;
+                } else {
+                    update.status = PaymentStatus::CONFIRMED;
+                }
+                // The node drops signature subscriptions after the final notification
+                auto callback = std::move(subscription.on_signature);
+                dispatches.push_back([callback, update]() { callback(update); });
+                connection.active.erase(active);
+                --connection.subscription_count;
+                subscriptions_.erase(it);
+            }
+        } else if (method.as_string() == "accountNotification" && subscription.kind == SubscriptionKind::ACCOUNT) {
+            AccountUpdate update;
+            update.address = subscription.key;
+            update.slot = slot;
+            update.lamports = value["lamports"].is_number() ? value["lamports"].as_uint64() : 0;
+            update.value = value;
+            auto callback = subscription.on_account;
+            dispatches.push_back([callback, update]() { callback(update); });
+        }
+    }
+
+    if (cleanup) {
+        send_text(connection, *cleanup, generation);
+    }
+    for (auto& dispatch : dispatches) {
+        dispatch();
+    }
+}
+
+} // namespace svm_pay
@@ -0,0 +1,395 @@
+#include "svm-pay/network/rate_limiter.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <algorithm>
+
+namespace svm_pay {
+
+namespace {
+
+// Effective token rate never drops below this share of the configured rate
+constexpr double kMinRateShare = 0.05;
+
+// Share of the configured rate recovered per successful request
+constexpr double kRateRecoveryShare = 0.01;
+
+// Drift of the latency baseline towards recent samples, so it can rise
+// again after a permanent change in network path
+constexpr double kBaselineDrift = 0.01;
+
+// Multiplicative decrease applied when latency exceeds the tolerance
+constexpr double kLatencyBackoff = 0.95;
+
+} // namespace
+
+TokenBucket::TokenBucket(double rate, double burst)
+    : rate_(std::max(rate, 0.0)),
+      effective_rate_(rate_),
+      capacity_(burst > 0.0 ? burst : std::max(rate_, 1.0)),
+      tokens_(capacity_),
+      last_refill_(Clock::now()) {}
+
+void TokenBucket::refill(Clock::time_point now) {
+    if (now <= last_refill_) {
+        return;
+    }
+    double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+    tokens_ = std::min(capacity_, tokens_ + elapsed * effective_rate_);
+    last_refill_ = now;
+}
+
+bool TokenBucket::try_acquire(Clock::time_point now) {
+    if (rate_ == 0.0) {
+        return true;
+    }
+    refill(now);
+    if (tokens_ >= 1.0) {
+        tokens_ -= 1.0;
+        return true;
+    }
+    return false;
+}
+
+TokenBucket::Clock::duration TokenBucket::time_until_available(Clock::time_point now) {
+    if (rate_ == 0.0) {
+        return Clock::duration::zero();
+    }
+    refill(now);
+    if (tokens_ >= 1.0) {
+        return Clock::duration::zero();
+    }
+    return std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>((1.0 - tokens_) / effective_rate_));
+}
+
+void TokenBucket::on_throttled() {
+    effective_rate_ = std::max(rate_ * kMinRateShare, effective_rate_ * 0.5);
+}
+
+void TokenBucket::on_success() {
+    effective_rate_ = std::min(rate_, effective_rate_ + rate_ * kRateRecoveryShare);
+}
+
+RateLimiter::Permit::Permit(Permit&& other) noexcept : limiter_(other.limiter_) {
+    other.limiter_ = nullptr;
+}
+
+RateLimiter::Permit& RateLimiter::Permit::operator=(Permit&& other) noexcept {
+    if (this != &other) {
+        release(Outcome::FAILED);
+        limiter_ = other.limiter_;
+        other.limiter_ = nullptr;
+    }
+    return *this;
+}
+
+RateLimiter::Permit::~Permit() {
+    release(Outcome::FAILED);
+}
+
+void RateLimiter::Permit::release(Outcome outcome, Clock::duration latency) {
+    if (limiter_) {
+        limiter_->release(outcome, latency);
+        limiter_ = nullptr;
+    }
+}
+
+RateLimiter::RateLimiter(const RateLimitConfig& config)
+    : config_(config),
+      bucket_(config.requests_per_second, config.burst),
+      limit_(config.initial_concurrency) {
+    configure(config);
+}
+
+void RateLimiter::configure(const RateLimitConfig& config) {
+    std::vector<Handoff> handoffs;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        bool rate_changed = config.requests_per_second != config_.requests_per_second ||
+                            config.burst != config_.burst;
+        config_ = config;
+        config_.min_concurrency = std::max<uint32_t>(config.min_concurrency, 1);
+        config_.max_concurrency = std::max(config.max_concurrency, config_.min_concurrency);
+        if (rate_changed) {
+            bucket_ = TokenBucket(config.requests_per_second, config.burst);
+        }
+        limit_ = std::clamp(limit_, static_cast<double>(config_.min_concurrency),
+                            static_cast<double>(config_.max_concurrency));
+        dispatch_locked(Clock::now(), handoffs);
+    }
+    hand_off(handoffs);
+}
+
+bool RateLimiter::try_admit_locked(Clock::time_point now, Clock::duration& retry_in) {
+    if (now < paused_until_) {
+        retry_in = paused_until_ - now;
+        return false;
+    }
+    if (in_flight_ >= static_cast<uint32_t>(limit_)) {
+        // Admitted by release(); the timeout only bounds the wait
+        retry_in = config_.max_queue_wait;
+        return false;
+    }
+    if (!bucket_.try_acquire(now)) {
+        retry_in = bucket_.time_until_available(now);
+        return false;
+    }
+    ++in_flight_;
+    return true;
+}
+
+void RateLimiter::resolve_locked(Waiter& waiter, std::exception_ptr error, std::vector<Handoff>& handoffs) {
+    if (waiter.on_grant) {
+        handoffs.push_back(Handoff{std::move(waiter.on_grant), error});
+    } else {
+        waiter.done = true;
+        waiter.error = error;
+        waiter.resolved.notify_one();
+    }
+}
+
+bool RateLimiter::must_queue_locked(RequestPriority priority, Clock::time_point now) const {
+    for (size_t i = 0; i < queues_.size(); ++i) {
+        const Queue& queue = queues_[i];
+        if (!queue.empty() && (i <= static_cast<size_t>(priority) ||
+                               now - queue.front()->queued_at >= config_.starvation_threshold)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+RateLimiter::Queue* RateLimiter::next_queue_locked(Clock::time_point now) {
+    // The oldest caller once it has waited too long, else the most urgent one
+    Queue* oldest = nullptr;
+    Queue* urgent = nullptr;
+    for (Queue& queue : queues_) {
+        if (queue.empty()) {
+            continue;
+        }
+        if (!urgent) {
+            urgent = &queue;
+        }
+        if (!oldest || queue.front()->queued_at < oldest->front()->queued_at) {
+            oldest = &queue;
+        }
+    }
+    if (oldest && now - oldest->front()->queued_at >= config_.starvation_threshold) {
+        return oldest;
+    }
+    return urgent;
+}
+
+void RateLimiter::push_locked(const std::shared_ptr<Waiter>& waiter, RequestPriority priority) {
+    queues_[static_cast<size_t>(priority)].push_back(waiter);
+    ++queued_;
+}
+
+RateLimiter::Clock::time_point RateLimiter::dispatch_locked(Clock::time_point now, std::vector<Handoff>& handoffs) {
+    // Nobody is admitted past the caller whose turn it is
+    Clock::duration retry_in{};
+    while (queued_ > 0 && try_admit_locked(now, retry_in)) {
+        Queue* queue = next_queue_locked(now);
+        resolve_locked(*queue->front(), nullptr, handoffs);
+        queue->pop_front();
+        --queued_;
+    }
+
+    auto next = Clock::time_point::max();
+    for (Queue& queue : queues_) {
+        for (auto it = queue.begin(); it != queue.end();) {
+            if (now >= (*it)->give_up) {
+                resolve_locked(**it, std::make_exception_ptr(BackpressureException("timed out waiting for a request slot")),
+                               handoffs);
+                it = queue.erase(it);
+                --queued_;
+            } else {
+                next = std::min(next, (*it)->give_up);
+                ++it;
+            }
+        }
+    }
+    return queued_ == 0 ? next : std::min(next, now + retry_in);
+}
+
+void RateLimiter::hand_off(std::vector<Handoff>& handoffs) {
+    for (auto& handoff : handoffs) {
+        handoff.on_grant(handoff.error ? Permit() : Permit(this), handoff.error);
+    }
+}
+
+bool RateLimiter::try_acquire(Permit& permit, RequestPriority priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = Clock::now();
+    Clock::duration retry_in{};
+    if (must_queue_locked(priority, now) || !try_admit_locked(now, retry_in)) {
+        return false;
+    }
+    permit = Permit(this);
+    return true;
+}
+
+RateLimiter::Permit RateLimiter::acquire(Clock::time_point deadline, RequestPriority priority) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto now = Clock::now();
+    Clock::duration retry_in{};
+
+    // Callers queued ahead go first, so only admit directly if none waits
+    if (!must_queue_locked(priority, now) && try_admit_locked(now, retry_in)) {
+        return Permit(this);
+    }
+    if (queued_ >= config_.max_queue) {
+        throw BackpressureException("request queue full (" + std::to_string(queued_) + " waiting)");
+    }
+
+    auto waiter = std::make_shared<Waiter>();
+    waiter->queued_at = now;
+    waiter->give_up = std::min(deadline, now + config_.max_queue_wait);
+    push_locked(waiter, priority);
+    std::vector<Handoff> handoffs;
+    while (!waiter->done) {
+        auto next = dispatch_locked(Clock::now(), handoffs);
+        if (!handoffs.empty()) {
+            lock.unlock();
+            hand_off(handoffs);
+            handoffs.clear();
+            lock.lock();
+        } else if (!waiter->done) {
+            waiter->resolved.wait_until(lock, next);
+        }
+    }
+    if (waiter->error) {
+        std::rethrow_exception(waiter->error);
+    }
+    return Permit(this);
+}
+
+RateLimiter::Ticket RateLimiter::enqueue(Clock::time_point deadline, Permit& permit, Grant on_grant,
+                                         RequestPriority priority) {
+    std::vector<Handoff> handoffs;
+    Ticket ticket;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = Clock::now();
+        Clock::duration retry_in{};
+        if (!must_queue_locked(priority, now) && try_admit_locked(now, retry_in)) {
+            permit = Permit(this);
+            return ticket;
+        }
+        if (queued_ >= config_.max_queue) {
+            throw BackpressureException("request queue full (" + std::to_string(queued_) + " waiting)");
+        }
+
+        auto waiter = std::make_shared<Waiter>();
+        waiter->id = next_ticket_++;
+        waiter->queued_at = now;
+        waiter->give_up = std::min(deadline, now + config_.max_queue_wait);
+        waiter->on_grant = std::move(on_grant);
+        push_locked(waiter, priority);
+        ticket.id = waiter->id;
+        ticket.poll_at = dispatch_locked(now, handoffs);
+    }
+    hand_off(handoffs);
+    return ticket;
+}
+
+RateLimiter::Clock::time_point RateLimiter::poll() {
+    std::vector<Handoff> handoffs;
+    Clock::time_point next;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        next = dispatch_locked(Clock::now(), handoffs);
+    }
+    hand_off(handoffs);
+    return next;
+}
+
+bool RateLimiter::cancel(uint64_t ticket) {
+    if (ticket == 0) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Queue& queue : queues_) {
+        for (auto it = queue.begin(); it != queue.end(); ++it) {
+            if ((*it)->id == ticket) {
+                queue.erase(it);
+                --queued_;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void RateLimiter::release(Outcome outcome, Clock::duration latency) {
+    std::vector<Handoff> handoffs;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (in_flight_ > 0) {
+            --in_flight_;
+        }
+
+        auto min_limit = static_cast<double>(config_.min_concurrency);
+        auto max_limit = static_cast<double>(config_.max_concurrency);
+
+        switch (outcome) {
+            case Outcome::SUCCESS: {
+                bucket_.on_success();
+                double latency_us = std::chrono::duration<double, std::micro>(latency).count();
+                if (baseline_latency_us_ == 0.0 || latency_us < baseline_latency_us_) {
+                    baseline_latency_us_ = latency_us;
+                } else {
+                    baseline_latency_us_ += kBaselineDrift * (latency_us - baseline_latency_us_);
+                }
+
+                if (latency_us > baseline_latency_us_ * config_.latency_tolerance) {
+                    // Rising latency means requests are queueing at the server
+                    limit_ = std::max(min_limit, limit_ * kLatencyBackoff);
+                } else if (in_flight_ + 1 >= static_cast<uint32_t>(limit_ / 2)) {
+                    // Only grow while the current limit is actually being used
+                    limit_ = std::min(max_limit, limit_ + 1.0 / limit_);
+                }
+                break;
+            }
+            case Outcome::THROTTLED:
+                bucket_.on_throttled();
+                limit_ = std::max(min_limit, limit_ * config_.throttle_backoff);
+                break;
+            case Outcome::FAILED:
+                break;
+        }
+        dispatch_locked(Clock::now(), handoffs);
+    }
+    hand_off(handoffs);
+}
+
+void RateLimiter::pause_for(Clock::duration duration) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    paused_until_ = std::max(paused_until_, Clock::now() + duration);
+}
+
+bool RateLimiter::paused() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return Clock::now() < paused_until_;
+}
+
+uint32_t RateLimiter::concurrency_limit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<uint32_t>(limit_);
+}
+
+uint32_t RateLimiter::in_flight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+size_t RateLimiter::queued() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queued_;
+}
+
+RateLimitConfig RateLimiter::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+} // namespace svm_pay
@@ -0,0 +1,183 @@
+#include "svm-pay/network/request_scheduler.hpp"
+#include <algorithm>
+
+namespace svm_pay {
+
+namespace {
+
+size_t wait_bucket(uint64_t wait_us) {
+    size_t bucket = 0;
+    while (wait_us > 0 && bucket < 31) {
+        wait_us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+} // namespace
+
+RequestPriority default_rpc_priority(const std::string& method) {
+    if (method == "sendTransaction") {
+        return RequestPriority::SUBMIT;
+    }
+    if (method == "getSignatureStatuses") {
+        return RequestPriority::CONFIRM;
+    }
+    if (method == "getSignaturesForAddress" || method == "getBlock" || method == "getBlocks" ||
+        method == "getBlocksWithLimit") {
+        return RequestPriority::BACKFILL;
+    }
+    return RequestPriority::READ;
+}
+
+RequestScheduler::RequestScheduler(const RequestSchedulerConfig& config) : config_(config) {
+    for (size_t i = 0; i < REQUEST_PRIORITY_COUNT; ++i) {
+        classes_[i].stride = 1.0 / std::max(config_.classes[i].weight, 1e-6);
+    }
+}
+
+uint64_t RequestScheduler::enqueue(RequestPriority priority, Clock::time_point now) {
+    Class& queue = classes_[static_cast<size_t>(priority)];
+    if (queue.queue.empty() && queue.in_flight == 0) {
+        // Back from idle: no credit for the time spent away
+        queue.pass = std::max(queue.pass, current_pass_);
+    }
+    uint64_t ticket = next_ticket_++;
+    queue.queue.push_back({ticket, now});
+    queue.queued.store(queue.queue.size(), std::memory_order_relaxed);
+    return ticket;
+}
+
+bool RequestScheduler::may_dispatch(size_t index) const {
+    const Class& queue = classes_[index];
+    if (queue.queue.empty()) {
+        return false;
+    }
+    size_t class_limit = config_.classes[index].max_in_flight;
+    if (class_limit > 0 && queue.in_flight >= class_limit) {
+        return false;
+    }
+    if (config_.max_in_flight == 0) {
+        return true;
+    }
+    size_t limit = config_.max_in_flight;
+    if (index == static_cast<size_t>(RequestPriority::SUBMIT)) {
+        limit += config_.submit_headroom;
+    }
+    return in_flight_ < limit;
+}
+
+std::optional<uint64_t> RequestScheduler::next(Clock::time_point now) {
+    std::optional<size_t> chosen;
+    bool starved = false;
+
+    // Starvation first: the eligible class whose head has waited longest past the threshold
+    Clock::time_point oldest = now - config_.starvation_threshold;
+    for (size_t i = 0; i < REQUEST_PRIORITY_COUNT; ++i) {
+        if (may_dispatch(i) && classes_[i].queue.front().enqueued_at <= oldest) {
+            oldest = classes_[i].queue.front().enqueued_at;
+            chosen = i;
+            starved = true;
+        }
+    }
+    // Otherwise the lowest pass; ties go to the more urgent class
+    if (!chosen) {
+        for (size_t i = 0; i < REQUEST_PRIORITY_COUNT; ++i) {
+            if (may_dispatch(i) && (!chosen || classes_[i].pass < classes_[*chosen].pass)) {
+                chosen = i;
+            }
+        }
+    }
+    if (!chosen) {
+        return std::nullopt;
+    }
+    return dispatch(*chosen, now, starved);
+}
+
+uint64_t RequestScheduler::dispatch(size_t index, Clock::time_point now, bool starved) {
+    Class& queue = classes_[index];
+    Waiting waiting = queue.queue.front();
+    queue.queue.pop_front();
+    current_pass_ = queue.pass;
+    queue.pass += queue.stride;
+    ++queue.in_flight;
+    ++in_flight_;
+
+    uint64_t wait_us = static_cast<uint64_t>(std::max<int64_t>(
+        0, std::chrono::duration_cast<std::chrono::microseconds>(now - waiting.enqueued_at).count()));
+    queue.dispatched.fetch_add(1, std::memory_order_relaxed);
+    queue.queued.store(queue.queue.size(), std::memory_order_relaxed);
+    queue.in_flight_count.store(queue.in_flight, std::memory_order_relaxed);
+    if (starved) {
+        queue.starved.fetch_add(1, std::memory_order_relaxed);
+    }
+    queue.total_wait_us.fetch_add(wait_us, std::memory_order_relaxed);
+    if (wait_us > queue.max_wait_us.load(std::memory_order_relaxed)) {
+        queue.max_wait_us.store(wait_us, std::memory_order_relaxed);
+    }
+    queue.wait_histogram[wait_bucket(wait_us)].fetch_add(1, std::memory_order_relaxed);
+    return waiting.ticket;
+}
+
+bool RequestScheduler::cancel(uint64_t ticket) {
+    for (auto& queue : classes_) {
+        auto it = std::find_if(queue.queue.begin(), queue.queue.end(),
+                               [ticket](const Waiting& waiting) { return waiting.ticket == ticket; });
+        if (it != queue.queue.end()) {
+            queue.queue.erase(it);
+            queue.queued.store(queue.queue.size(), std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void RequestScheduler::finish(RequestPriority priority) {
+    Class& queue = classes_[static_cast<size_t>(priority)];
+    if (queue.in_flight > 0) {
+        --queue.in_flight;
+        --in_flight_;
+    }
+    queue.in_flight_count.store(queue.in_flight, std::memory_order_relaxed);
+}
+
+bool RequestScheduler::has_queued() const {
+    return std::any_of(classes_.begin(), classes_.end(), [](const Class& queue) { return !queue.queue.empty(); });
+}
+
+PriorityClassMetrics RequestScheduler::metrics(RequestPriority priority) const {
+    const Class& queue = classes_[static_cast<size_t>(priority)];
+    PriorityClassMetrics metrics;
+    metrics.dispatched = queue.dispatched.load(std::memory_order_relaxed);
+    metrics.queued = queue.queued.load(std::memory_order_relaxed);
+    metrics.in_flight = queue.in_flight_count.load(std::memory_order_relaxed);
+    metrics.starved = queue.starved.load(std::memory_order_relaxed);
+    metrics.total_wait = std::chrono::microseconds(queue.total_wait_us.load(std::memory_order_relaxed));
+    metrics.max_wait = std::chrono::microseconds(queue.max_wait_us.load(std::memory_order_relaxed));
+
+    std::array<uint64_t, WAIT_BUCKETS> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < WAIT_BUCKETS; ++i) {
+        counts[i] = queue.wait_histogram[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    auto quantile = [&](double q) {
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < WAIT_BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen > rank) {
+                // Bucket i holds waits below 2^i microseconds
+                return std::chrono::microseconds(i == 0 ? 0 : (uint64_t{1} << i));
+            }
+        }
+        return metrics.max_wait;
+    };
+    if (total > 0) {
+        metrics.p50_wait = quantile(0.50);
+        metrics.p99_wait = quantile(0.99);
+    }
+    return metrics;
+}
+
+} // namespace svm_pay
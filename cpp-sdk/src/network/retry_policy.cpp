@@ -0,0 +1,117 @@
+#include "svm-pay/network/retry_policy.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <algorithm>
+#include <random>
+
+namespace svm_pay {
+
+std::chrono::milliseconds RetryPolicy::next_delay(std::chrono::milliseconds previous) const {
+    thread_local std::minstd_rand rng(std::random_device{}());
+
+    auto low = base_delay.count();
+    auto high = std::max(low, previous.count() * 3);
+    std::uniform_int_distribution<long long> distribution(low, high);
+    return std::min(max_delay, std::chrono::milliseconds(distribution(rng)));
+}
+
+bool is_idempotent_rpc_method(const std::string& method) {
+    return method != "sendTransaction" && method != "requestAirdrop";
+}
+
+bool is_retryable_failure(const std::exception_ptr& error, bool idempotent) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const BackpressureException&) {
+        // Load shedding is an explicit answer to the caller, not a glitch
+        return false;
+    } catch (const ConnectionException&) {
+        return true;
+    } catch (const RateLimitException&) {
+        return true;
+    } catch (const CircuitOpenException&) {
+        return true;
+    } catch (const NetworkException&) {
+        return idempotent;
+    } catch (...) {
+        return false;
+    }
+}
+
+CircuitBreaker::CircuitBreaker(const CircuitBreakerConfig& config) : config_(config) {}
+
+void CircuitBreaker::configure(const CircuitBreakerConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    if (config_.failure_threshold == 0) {
+        state_ = State::CLOSED;
+        consecutive_failures_ = 0;
+        probe_in_flight_ = false;
+    }
+}
+
+bool CircuitBreaker::allow_request() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (state_) {
+        case State::CLOSED:
+            return true;
+        case State::OPEN:
+            if (Clock::now() - opened_at_ < config_.open_duration) {
+                return false;
+            }
+            state_ = State::HALF_OPEN;
+            probe_in_flight_ = true;
+            return true;
+        case State::HALF_OPEN:
+            if (probe_in_flight_) {
+                return false;
+            }
+            probe_in_flight_ = true;
+            return true;
+    }
+    return true;
+}
+
+bool CircuitBreaker::is_open() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (state_) {
+        case State::CLOSED:
+            return false;
+        case State::OPEN:
+            return Clock::now() - opened_at_ < config_.open_duration;
+        case State::HALF_OPEN:
+            return probe_in_flight_;
+    }
+    return false;
+}
+
+void CircuitBreaker::record_success() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_ = State::CLOSED;
+    consecutive_failures_ = 0;
+    probe_in_flight_ = false;
+}
+
+void CircuitBreaker::record_failure() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (config_.failure_threshold == 0) {
+        return;
+    }
+    ++consecutive_failures_;
+    if (state_ == State::HALF_OPEN || consecutive_failures_ >= config_.failure_threshold) {
+        state_ = State::OPEN;
+        opened_at_ = Clock::now();
+        probe_in_flight_ = false;
+    }
+}
+
+void CircuitBreaker::release_probe() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    probe_in_flight_ = false;
+}
+
+CircuitBreaker::State CircuitBreaker::state() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return state_;
+}
+
+} // namespace svm_pay
@@ -0,0 +1,500 @@
+#include "svm-pay/network/rpc_transport.hpp"
+#include "svm-pay/network/curl_initializer.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <curl/curl.h>
+#include <algorithm>
+#include <cctype>
+#include <future>
+#include <unordered_map>
+
+namespace svm_pay {
+
+namespace {
+
+// Callback for curl to write response data
+size_t write_callback(void* contents, size_t size, size_t nmemb, std::string* body) {
+    size_t total = size * nmemb;
+    body->append(static_cast<char*>(contents), total);
+    return total;
+}
+
+// Callback for curl to capture the Retry-After header
+size_t header_callback(char* buffer, size_t size, size_t nitems, HttpResponse* response) {
+    size_t total = size * nitems;
+    std::string line(buffer, total);
+    const std::string name = "retry-after:";
+    if (line.size() > name.size()) {
+        std::string prefix = line.substr(0, name.size());
+        std::transform(prefix.begin(), prefix.end(), prefix.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (prefix == name) {
+            // Only the delay-seconds form is honoured; HTTP dates fall back to the default
+            try {
+                response->retry_after = std::chrono::seconds(std::stol(line.substr(name.size())));
+            } catch (const std::exception&) {
+            }
+        }
+    }
+    return total;
+}
+
+CURLM* as_multi(void* multi) {
+    return static_cast<CURLM*>(multi);
+}
+
+// Easy handles are configured on caller threads, so the share handle needs locking
+void lock_share(CURL*, curl_lock_data data, curl_lock_access, void* locks) {
+    (*static_cast<std::array<std::mutex, 8>*>(locks))[static_cast<size_t>(data)].lock();
+}
+
+void unlock_share(CURL*, curl_lock_data data, void* locks) {
+    (*static_cast<std::array<std::mutex, 8>*>(locks))[static_cast<size_t>(data)].unlock();
+}
+
+static_assert(CURL_LOCK_DATA_LAST <= 8, "share_locks_ needs one mutex per curl_lock_data");
+
+} // namespace
+
+/**
+ * A request handed to the I/O thread
+ *
+ * Blocking transfers live on the caller's stack until done; asynchronous
+ * ones own a copy of the request and are freed once their callback ran.
+ */
+struct RpcTransport::Transfer {
+    const HttpRequest* request = nullptr;
+    CURL* easy = nullptr;
+    curl_slist* headers = nullptr;
+    HttpResponse response;
+    CURLcode result = CURLE_OK;
+    std::promise<void> done;
+    uint64_t ticket = 0;  // Scheduler ticket while waiting for a slot
+    
+    // Set for perform_async
+    std::unique_ptr<HttpRequest> owned_request;
+    HttpCallback on_done;
+};
+
+std::shared_ptr<RpcTransport> RpcTransport::shared() {
+    static std::shared_ptr<RpcTransport> instance = std::make_shared<RpcTransport>();
+    return instance;
+}
+
+RpcTransport::RpcTransport(const RpcTransportConfig& config)
+    : config_(config), curl_initializer_(CurlInitializer::get_instance()), scheduler_(config.scheduler) {
+    multi_ = curl_multi_init();
+    if (!multi_) {
+        throw NetworkException("Failed to initialize curl multi handle");
+    }
+    curl_multi_setopt(as_multi(multi_), CURLMOPT_MAX_HOST_CONNECTIONS, config_.max_connections_per_host);
+    curl_multi_setopt(as_multi(multi_), CURLMOPT_MAX_TOTAL_CONNECTIONS, config_.max_total_connections);
+    curl_multi_setopt(as_multi(multi_), CURLMOPT_MAXCONNECTS, config_.max_idle_connections);
+    
+    // Connections are pooled by the multi handle; resolved names and TLS
+    // sessions are shared too, so a second connection to a host skips both
+    share_ = curl_share_init();
+    if (share_) {
+        CURLSH* share = static_cast<CURLSH*>(share_);
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lock_share);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlock_share);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, &share_locks_);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+}
+
+RpcTransport::~RpcTransport() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    if (io_thread_.joinable()) {
+        curl_multi_wakeup(as_multi(multi_));
+        io_thread_.join();
+    }
+    // Nothing can be queued without the I/O thread having been started, and it drains on exit
+    for (void* handle : idle_handles_) {
+        curl_easy_cleanup(static_cast<CURL*>(handle));
+    }
+    curl_multi_cleanup(as_multi(multi_));
+    if (share_) {
+        curl_share_cleanup(static_cast<CURLSH*>(share_));
+    }
+}
+
+void RpcTransport::warm_up() {
+    start();
+}
+
+void RpcTransport::start() {
+    std::call_once(start_once_, [this]() {
+        io_thread_ = std::thread([this]() { run(); });
+    });
+}
+
+void* RpcTransport::acquire_handle() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!idle_handles_.empty()) {
+            void* handle = idle_handles_.back();
+            idle_handles_.pop_back();
+            return handle;
+        }
+    }
+    CURL* easy = curl_easy_init();
+    if (!easy) {
+        throw NetworkException("Failed to initialize curl");
+    }
+    return easy;
+}
+
+void RpcTransport::release_handle(void* handle) {
+    curl_easy_reset(static_cast<CURL*>(handle));
+    std::lock_guard<std::mutex> lock(mutex_);
+    idle_handles_.push_back(handle);
+}
+
+void RpcTransport::prepare(Transfer& transfer) {
+    const HttpRequest& request = *transfer.request;
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        request.deadline - std::chrono::steady_clock::now());
+    if (remaining.count() <= 0) {
+        throw TimeoutException("deadline exceeded");
+    }
+    long timeout_ms = static_cast<long>(remaining.count());
+    long connect_ms = std::min<long>(static_cast<long>(request.connect_timeout.count()), timeout_ms);
+    start();
+
+    transfer.easy = static_cast<CURL*>(acquire_handle());
+    CURL* curl = transfer.easy;
+    curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer.response.body);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, header_callback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer.response);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, connect_ms);
+    // Prefer multiplexing over an existing HTTP/2 connection to opening another
+    curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, &transfer);
+    if (share_) {
+        curl_easy_setopt(curl, CURLOPT_SHARE, static_cast<CURLSH*>(share_));
+    }
+    if (request.body) {
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.body->c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(request.body->size()));
+        transfer.headers = curl_slist_append(nullptr, "Content-Type: application/json");
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer.headers);
+    }
+
+    Counters& counters = counters_[static_cast<size_t>(request.network)];
+    counters.requests.fetch_add(1, std::memory_order_relaxed);
+    counters.in_flight.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RpcTransport::submit(Transfer& transfer) {
+    bool rejected = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            transfer.result = CURLE_FAILED_INIT;
+            rejected = true;
+        } else {
+            queued_.push_back(&transfer);
+        }
+    }
+    if (rejected) {
+        signal(transfer);
+    } else {
+        curl_multi_wakeup(as_multi(multi_));
+    }
+}
+
+HttpResponse RpcTransport::perform(const HttpRequest& request) {
+    Transfer transfer;
+    transfer.request = &request;
+    prepare(transfer);
+    auto done = transfer.done.get_future();
+    submit(transfer);
+    done.wait();
+    return complete(transfer);
+}
+
+void RpcTransport::perform_async(const HttpRequest& request, HttpCallback on_done) {
+    auto transfer = std::make_unique<Transfer>();
+    transfer->owned_request = std::make_unique<HttpRequest>(request);
+    transfer->request = transfer->owned_request.get();
+    transfer->on_done = std::move(on_done);
+    try {
+        prepare(*transfer);
+    } catch (...) {
+        transfer->on_done(HttpResponse{}, std::current_exception());
+        return;
+    }
+    // Freed by signal() once the callback ran
+    submit(*transfer.release());
+}
+
+HttpResponse RpcTransport::complete(Transfer& transfer) {
+    const HttpRequest& request = *transfer.request;
+    CURL* curl = transfer.easy;
+    Counters& counters = counters_[static_cast<size_t>(request.network)];
+    counters.in_flight.fetch_sub(1, std::memory_order_relaxed);
+    curl_off_t sent = 0;
+    curl_off_t received = 0;
+    curl_off_t total_us = 0;
+    long connects = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &transfer.response.status);
+    curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &sent);
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &received);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total_us);
+    curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &connects);
+    counters.bytes_sent.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+    counters.bytes_received.fetch_add(static_cast<uint64_t>(received), std::memory_order_relaxed);
+    counters.total_time_us.fetch_add(static_cast<uint64_t>(total_us), std::memory_order_relaxed);
+    counters.connections_opened.fetch_add(static_cast<uint64_t>(connects), std::memory_order_relaxed);
+    curl_slist_free_all(transfer.headers);
+    transfer.headers = nullptr;
+    release_handle(curl);
+
+    CURLcode res = transfer.result;
+    if (res != CURLE_OK) {
+        counters.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (res == CURLE_ABORTED_BY_CALLBACK) {
+        throw OperationCancelledException("request to " + request.url + " aborted");
+    }
+    if (res == CURLE_OPERATION_TIMEDOUT) {
+        throw TimeoutException(std::string(curl_easy_strerror(res)));
+    }
+    if (res == CURLE_COULDNT_RESOLVE_HOST || res == CURLE_COULDNT_RESOLVE_PROXY ||
+        res == CURLE_COULDNT_CONNECT) {
+        // Nothing was sent, so even state-changing calls may be retried
+        throw ConnectionException(std::string(curl_easy_strerror(res)));
+    }
+    if (res == CURLE_FAILED_INIT) {
+        throw NetworkException("transport is shutting down");
+    }
+    if (res != CURLE_OK) {
+        throw NetworkException("curl_easy_perform() failed: " + std::string(curl_easy_strerror(res)));
+    }
+    return std::move(transfer.response);
+}
+
+void RpcTransport::signal(Transfer& transfer) {
+    if (!transfer.on_done) {
+        // The caller may free the transfer as soon as it is signalled
+        transfer.done.set_value();
+        return;
+    }
+    std::unique_ptr<Transfer> owned(&transfer);
+    HttpResponse response;
+    std::exception_ptr error;
+    try {
+        response = complete(transfer);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    transfer.on_done(std::move(response), error);
+}
+
+void RpcTransport::finish(Transfer& transfer, int result) {
+    curl_multi_remove_handle(as_multi(multi_), transfer.easy);
+    scheduler_.finish(transfer.request->priority);
+    transfer.result = static_cast<CURLcode>(result);
+    signal(transfer);
+}
+
+void RpcTransport::schedule(std::chrono::steady_clock::time_point when, std::function<void(bool cancelled)> task) {
+    start();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_) {
+            timers_.emplace(when, std::move(task));
+            task = nullptr;
+        }
+    }
+    if (task) {
+        task(true);
+        return;
+    }
+    curl_multi_wakeup(as_multi(multi_));
+}
+
+void RpcTransport::run() {
+    CURLM* multi = as_multi(multi_);
+    std::vector<Transfer*> arrived;
+    std::unordered_map<uint64_t, Transfer*> waiting;  // By scheduler ticket
+    std::vector<Transfer*> active;
+    std::vector<Transfer*> rejected;
+    std::vector<std::function<void(bool)>> due;
+    while (true) {
+        auto next_timer = std::chrono::steady_clock::time_point::max();
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                break;
+            }
+            arrived.swap(queued_);
+            while (!timers_.empty() && timers_.begin()->first <= now) {
+                due.push_back(std::move(timers_.begin()->second));
+                timers_.erase(timers_.begin());
+            }
+            if (!timers_.empty()) {
+                next_timer = timers_.begin()->first;
+            }
+        }
+        
+        for (Transfer* transfer : arrived) {
+            transfer->ticket = scheduler_.enqueue(transfer->request->priority, now);
+            waiting.emplace(transfer->ticket, transfer);
+        }
+        arrived.clear();
+        
+        // Drop waiting transfers whose callers gave up or ran out of time
+        for (auto it = waiting.begin(); it != waiting.end();) {
+            Transfer* transfer = it->second;
+            const auto& should_abort = transfer->request->should_abort;
+            if (should_abort && should_abort()) {
+                transfer->result = CURLE_ABORTED_BY_CALLBACK;
+            } else if (transfer->request->deadline <= now) {
+                transfer->result = CURLE_OPERATION_TIMEDOUT;
+            } else {
+                ++it;
+                continue;
+            }
+            scheduler_.cancel(it->first);
+            rejected.push_back(transfer);
+            it = waiting.erase(it);
+        }
+        
+        // Start transfers in scheduler order while there are free slots
+        while (auto ticket = scheduler_.next(now)) {
+            auto it = waiting.find(*ticket);
+            Transfer* transfer = it->second;
+            waiting.erase(it);
+            // Time spent queued comes out of the transfer's own budget
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(transfer->request->deadline - now);
+            curl_easy_setopt(transfer->easy, CURLOPT_TIMEOUT_MS, std::max<long>(static_cast<long>(remaining.count()), 1));
+            if (curl_multi_add_handle(multi, transfer->easy) == CURLM_OK) {
+                active.push_back(transfer);
+            } else {
+                scheduler_.finish(transfer->request->priority);
+                transfer->result = CURLE_FAILED_INIT;
+                rejected.push_back(transfer);
+            }
+        }
+        
+        // Callbacks may queue more work, so they run without the lock
+        for (Transfer* transfer : rejected) {
+            signal(*transfer);
+        }
+        rejected.clear();
+        for (auto& task : due) {
+            task(false);
+        }
+        due.clear();
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        int remaining = 0;
+        while (CURLMsg* message = curl_multi_info_read(multi, &remaining)) {
+            if (message->msg != CURLMSG_DONE) {
+                continue;
+            }
+            Transfer* transfer = nullptr;
+            curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+            CURLcode result = message->data.result;
+            active.erase(std::find(active.begin(), active.end(), transfer));
+            finish(*transfer, result);
+        }
+
+        // Abort transfers whose callers gave up
+        for (auto it = active.begin(); it != active.end();) {
+            const auto& should_abort = (*it)->request->should_abort;
+            if (should_abort && should_abort()) {
+                Transfer* transfer = *it;
+                it = active.erase(it);
+                finish(*transfer, CURLE_ABORTED_BY_CALLBACK);
+            } else {
+                ++it;
+            }
+        }
+
+        long timeout_ms = -1;
+        curl_multi_timeout(multi, &timeout_ms);
+        long poll_ms = static_cast<long>(config_.abort_poll_interval.count());
+        if (active.empty() && waiting.empty()) {
+            poll_ms = 1000;  // Idle; woken by curl_multi_wakeup when work arrives
+        }
+        if (timeout_ms >= 0) {
+            poll_ms = std::min(poll_ms, timeout_ms);
+        }
+        if (next_timer != std::chrono::steady_clock::time_point::max()) {
+            auto until_timer = std::chrono::duration_cast<std::chrono::milliseconds>(
+                next_timer - std::chrono::steady_clock::now());
+            poll_ms = std::min(poll_ms, std::max<long>(static_cast<long>(until_timer.count()) + 1, 0));
+        }
+        curl_multi_poll(multi, nullptr, 0, static_cast<int>(poll_ms), nullptr);
+    }
+
+    // Shutting down: fail everything still queued, waiting or running, and cancel
+    // timers; nothing new is accepted once stopping_ is set
+    std::vector<Transfer*> queued;
+    std::multimap<std::chrono::steady_clock::time_point, std::function<void(bool)>> timers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued.swap(queued_);
+        timers.swap(timers_);
+    }
+    for (const auto& entry : waiting) {
+        queued.push_back(entry.second);
+    }
+    for (Transfer* transfer : queued) {
+        transfer->result = CURLE_FAILED_INIT;
+        signal(*transfer);
+    }
+    for (Transfer* transfer : active) {
+        finish(*transfer, CURLE_FAILED_INIT);
+    }
+    for (auto& timer : timers) {
+        timer.second(true);
+    }
+}
+
+TransportMetrics RpcTransport::metrics(SVMNetwork network) const {
+    const Counters& counters = counters_[static_cast<size_t>(network)];
+    TransportMetrics metrics;
+    metrics.requests = counters.requests.load(std::memory_order_relaxed);
+    metrics.failures = counters.failures.load(std::memory_order_relaxed);
+    metrics.in_flight = counters.in_flight.load(std::memory_order_relaxed);
+    metrics.connections_opened = counters.connections_opened.load(std::memory_order_relaxed);
+    metrics.bytes_sent = counters.bytes_sent.load(std::memory_order_relaxed);
+    metrics.bytes_received = counters.bytes_received.load(std::memory_order_relaxed);
+    metrics.total_time = std::chrono::microseconds(counters.total_time_us.load(std::memory_order_relaxed));
+    return metrics;
+}
+
+PriorityClassMetrics RpcTransport::queue_metrics(RequestPriority priority) const {
+    return scheduler_.metrics(priority);
+}
+
+TransportMetrics RpcTransport::metrics() const {
+    TransportMetrics total;
+    for (size_t i = 0; i < SVM_NETWORK_COUNT; ++i) {
+        TransportMetrics network = metrics(static_cast<SVMNetwork>(i));
+        total.requests += network.requests;
+        total.failures += network.failures;
+        total.in_flight += network.in_flight;
+        total.connections_opened += network.connections_opened;
+        total.bytes_sent += network.bytes_sent;
+        total.bytes_received += network.bytes_received;
+        total.total_time += network.total_time;
+    }
+    return total;
+}
+
+} // namespace svm_pay
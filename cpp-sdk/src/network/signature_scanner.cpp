@@ -0,0 +1,411 @@
+#include "svm-pay/network/signature_scanner.hpp"
+#include "svm-pay/core/base58.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace svm_pay {
+
+namespace {
+
+constexpr size_t SIGNATURE_SIZE = 64;
+
+// File layout: a header, then one record per watched address. Signatures
+// are stored decoded; integers are little-endian.
+//   header: magic[8] count:u32 reserved[4]
+//   record: address[32] flags:u8 reserved[7] until[64] before[64] scan_newest[64]
+constexpr char FILE_MAGIC[8] = {'S', 'V', 'M', 'S', 'I', 'G', 'S', '1'};
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t RECORD_SIZE = 40 + 3 * SIGNATURE_SIZE;
+constexpr uint8_t HAS_UNTIL = 1;
+constexpr uint8_t SCANNING = 2;
+
+bool is_signature(const std::string& signature) {
+    uint8_t decoded[SIGNATURE_SIZE];
+    return decode_base58(signature, decoded, SIGNATURE_SIZE);
+}
+
+void put_signature(uint8_t* out, const std::string& signature) {
+    if (signature.empty() || !decode_base58(signature, out, SIGNATURE_SIZE)) {
+        std::memset(out, 0, SIGNATURE_SIZE);
+    }
+}
+
+std::string get_signature(const uint8_t* in) {
+    return encode_base58(in, SIGNATURE_SIZE);
+}
+
+void replace_file(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    bool replaced = MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    bool replaced = std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+    if (!replaced) {
+        throw SVMPayException("Signature scanner: cannot replace " + to + ": " + std::strerror(errno));
+    }
+}
+
+} // namespace
+
+/**
+ * One scan in flight, shared with its page requests
+ *
+ * Completions only queue their page. Whichever thread finds the queue
+ * unattended handles pages until it is empty, so pages are handled one at
+ * a time, in arrival order, and a request failing on the calling thread
+ * cannot recurse into the handler.
+ */
+struct SignatureScanner::Pass : std::enable_shared_from_this<SignatureScanner::Pass> {
+    struct Page {
+        size_t address;
+        std::vector<SignatureInfo> signatures;
+        std::exception_ptr error;
+    };
+
+    Pass(SignatureScanner& scanner, Completion<size_t> on_done) : scanner(scanner), on_done(std::move(on_done)) {}
+
+    void arrived(Page page);
+    void drain();
+    void request(size_t index);
+    void handle(Page& page);
+    void finish();
+
+    SignatureScanner& scanner;
+    Completion<size_t> on_done;
+
+    std::mutex mutex;
+    std::deque<Page> done;
+    bool draining = false;
+
+    // Touched only by the thread draining the queue
+    std::vector<std::pair<PublicKey, Cursor>> work;
+    size_t next = 0;
+    size_t in_flight = 0;
+    size_t reported = 0;
+    std::exception_ptr callback_error;
+};
+
+void SignatureScanner::Pass::arrived(Page page) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.push_back(std::move(page));
+        if (draining) {
+            return;
+        }
+        draining = true;
+    }
+    drain();
+}
+
+void SignatureScanner::Pass::drain() {
+    while (true) {
+        while (!callback_error && in_flight < scanner.config_.max_concurrent_pages && next < work.size()) {
+            request(next++);
+        }
+        if (in_flight == 0) {
+            finish();
+            return;
+        }
+        Page page;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (done.empty()) {
+                draining = false;
+                return;
+            }
+            page = std::move(done.front());
+            done.pop_front();
+        }
+        --in_flight;
+        if (!callback_error) {
+            handle(page);
+        }
+        // Otherwise draining the pages in flight
+    }
+}
+
+void SignatureScanner::Pass::request(size_t index) {
+    const Cursor& cursor = work[index].second;
+    SignatureQuery query;
+    query.before = cursor.before;
+    query.until = cursor.until;
+    query.limit = scanner.config_.page_size;
+    CallOptions options;
+    options.timeout = scanner.config_.request_timeout;
+    ++in_flight;
+    {
+        std::lock_guard<std::mutex> lock(scanner.mutex_);
+        ++scanner.pages_;
+    }
+    auto self = shared_from_this();
+    scanner.adapter_.get_signatures_for_address_async(
+        work[index].first, query, options, [self, index](std::vector<SignatureInfo> signatures, std::exception_ptr error) {
+            self->arrived(Page{index, std::move(signatures), error});
+        });
+}
+
+void SignatureScanner::Pass::handle(Page& page) {
+    const PublicKey& address = work[page.address].first;
+    Cursor& cursor = work[page.address].second;
+    const std::vector<SignatureInfo>& signatures = page.signatures;
+    if (!page.error && !signatures.empty() &&
+        (!is_signature(signatures.front().signature) || !is_signature(signatures.back().signature))) {
+        page.error = std::make_exception_ptr(JsonParseException("getSignaturesForAddress returned a malformed signature"));
+    }
+    if (page.error) {
+        std::lock_guard<std::mutex> lock(scanner.mutex_);
+        ++scanner.failures_;
+        return;
+    }
+
+    try {
+        for (const auto& signature : signatures) {
+            scanner.on_signature_(address, signature);
+        }
+    } catch (...) {
+        callback_error = std::current_exception();
+        return;
+    }
+    reported += signatures.size();
+
+    if (cursor.scan_newest.empty() && !signatures.empty()) {
+        cursor.scan_newest = signatures.front().signature;
+    }
+    bool exhausted = signatures.size() < scanner.config_.page_size;
+    if (exhausted) {
+        if (!cursor.scan_newest.empty()) {
+            cursor.until = cursor.scan_newest;
+        }
+        cursor.before.clear();
+        cursor.scan_newest.clear();
+    } else {
+        cursor.before = signatures.back().signature;
+    }
+    {
+        std::lock_guard<std::mutex> lock(scanner.mutex_);
+        auto it = scanner.cursors_.find(address);
+        if (it != scanner.cursors_.end()) {
+            it->second = cursor;
+            scanner.dirty_ = true;
+        }
+    }
+    if (!exhausted) {
+        request(page.address);
+    }
+}
+
+void SignatureScanner::Pass::finish() {
+    std::exception_ptr error = callback_error;
+    try {
+        scanner.sync();
+    } catch (...) {
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(scanner.mutex_);
+        scanner.scanning_ = false;
+    }
+    scanner.idle_.notify_all();
+    on_done(reported, error);
+}
+
+SignatureScanner::SignatureScanner(SvmNetworkAdapter& adapter, SignatureCallback on_signature,
+                                   const SignatureScannerConfig& config)
+    : adapter_(adapter), on_signature_(std::move(on_signature)), config_(config) {
+    config_.page_size = std::min(std::max<size_t>(1, config_.page_size), SvmNetworkAdapter::MAX_SIGNATURES_FOR_ADDRESS);
+    config_.max_concurrent_pages = std::max<size_t>(1, config_.max_concurrent_pages);
+    if (!config_.path.empty()) {
+        load();
+    }
+    if (config_.interval.count() > 0) {
+        scanner_.emplace(adapter_.transport(), [this](PeriodicTask::Done done) { run(std::move(done)); });
+    }
+}
+
+SignatureScanner::~SignatureScanner() {
+    if (scanner_) {
+        scanner_->stop();
+    }
+    try {
+        sync();
+    } catch (const std::exception&) {
+        // The cursors of the last scan are lost; its signatures come again
+    }
+}
+
+void SignatureScanner::watch(const PublicKey& address, const std::string& until) {
+    if (!until.empty() && !is_signature(until)) {
+        throw std::invalid_argument("Signature scanner: " + until + " is not a transaction signature");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cursors_.emplace(address, Cursor{until, std::string(), std::string()}).second) {
+        dirty_ = true;
+    }
+}
+
+void SignatureScanner::unwatch(const PublicKey& address) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (cursors_.erase(address) > 0) {
+        dirty_ = true;
+    }
+}
+
+bool SignatureScanner::is_watched(const PublicKey& address) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cursors_.count(address) > 0;
+}
+
+size_t SignatureScanner::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cursors_.size();
+}
+
+uint64_t SignatureScanner::page_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pages_;
+}
+
+uint64_t SignatureScanner::failure_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failures_;
+}
+
+size_t SignatureScanner::scan() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this]() { return !scanning_; });
+        scanning_ = true;
+    }
+    auto done = std::make_shared<std::promise<size_t>>();
+    std::future<size_t> result = done->get_future();
+    start_pass([done](size_t reported, std::exception_ptr error) {
+        if (error) {
+            done->set_exception(error);
+        } else {
+            done->set_value(reported);
+        }
+    });
+    return result.get();
+}
+
+void SignatureScanner::start_pass(Completion<size_t> on_done) {
+    auto pass = std::make_shared<Pass>(*this, std::move(on_done));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pass->work.assign(cursors_.begin(), cursors_.end());
+    }
+    {
+        std::lock_guard<std::mutex> lock(pass->mutex);
+        pass->draining = true;
+    }
+    pass->drain();
+}
+
+void SignatureScanner::run(PeriodicTask::Done done) {
+    bool busy;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        busy = std::exchange(scanning_, true);
+    }
+    // A scan() in progress covers this round
+    if (busy) {
+        done(config_.interval);
+        return;
+    }
+    // Failed pages are counted; the next scan retries them
+    start_pass([this, done = std::move(done)](size_t, std::exception_ptr) { done(config_.interval); });
+}
+
+void SignatureScanner::sync() {
+    if (config_.path.empty()) {
+        return;
+    }
+    std::vector<uint8_t> bytes;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!dirty_) {
+            return;
+        }
+        bytes.resize(HEADER_SIZE + cursors_.size() * RECORD_SIZE);
+        std::memcpy(bytes.data(), FILE_MAGIC, sizeof(FILE_MAGIC));
+        for (size_t i = 0; i < 4; ++i) {
+            bytes[8 + i] = static_cast<uint8_t>(cursors_.size() >> (8 * i));
+        }
+        uint8_t* out = bytes.data() + HEADER_SIZE;
+        for (const auto& [address, cursor] : cursors_) {
+            std::memcpy(out, address.data(), PublicKey::SIZE);
+            out[32] = static_cast<uint8_t>((cursor.until.empty() ? 0 : HAS_UNTIL) |
+                                           (cursor.scan_newest.empty() ? 0 : SCANNING));
+            put_signature(out + 40, cursor.until);
+            put_signature(out + 40 + SIGNATURE_SIZE, cursor.before);
+            put_signature(out + 40 + 2 * SIGNATURE_SIZE, cursor.scan_newest);
+            out += RECORD_SIZE;
+        }
+        dirty_ = false;
+    }
+
+    // Written aside and renamed over the old file, so a crash leaves one or the other
+    std::string temporary = config_.path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        file.flush();
+        if (!file) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            dirty_ = true;
+            throw SVMPayException("Signature scanner: cannot write " + temporary);
+        }
+    }
+    replace_file(temporary, config_.path);
+}
+
+void SignatureScanner::load() {
+    std::ifstream in(config_.path, std::ios::binary);
+    if (!in) {
+        return;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (bytes.empty()) {
+        return;
+    }
+    if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        throw SVMPayException("Signature scanner: " + config_.path + " is not a cursor file");
+    }
+    size_t count = 0;
+    for (size_t i = 4; i > 0; --i) {
+        count = (count << 8) | bytes[8 + i - 1];
+    }
+    count = std::min(count, (bytes.size() - HEADER_SIZE) / RECORD_SIZE);
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* record = bytes.data() + HEADER_SIZE + i * RECORD_SIZE;
+        PublicKey address;
+        std::copy(record, record + PublicKey::SIZE, address.data());
+        Cursor cursor;
+        if (record[32] & HAS_UNTIL) {
+            cursor.until = get_signature(record + 40);
+        }
+        if (record[32] & SCANNING) {
+            cursor.before = get_signature(record + 40 + SIGNATURE_SIZE);
+            cursor.scan_newest = get_signature(record + 40 + 2 * SIGNATURE_SIZE);
+        }
+        cursors_[address] = cursor;
+    }
+}
+
+} // namespace svm_pay
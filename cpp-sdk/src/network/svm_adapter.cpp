@@ -0,0 +1,1241 @@
+#include "svm-pay/network/svm_adapter.hpp"
+#include "svm-pay/network/blockhash_cache.hpp"
+#include "svm-pay/network/mint_cache.hpp"
+#include "svm-pay/network/priority_fee_estimator.hpp"
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/json.hpp"
+#include "svm-pay/core/pda.hpp"
+#include "svm-pay/core/transaction.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <sstream>
+#include <future>
+#include <mutex>
+#include <chrono>
+#include <optional>
+#include <algorithm>
+#include <cctype>
+
+namespace svm_pay {
+
+namespace {
+
+/**
+ * Deadline and cancellation state shared by every attempt of one call
+ */
+struct RequestContext {
+    std::chrono::steady_clock::time_point deadline;
+    CancellationToken cancellation;
+    
+    // Signalled when a hedged call already has its answer
+    CancellationToken settled;
+    
+    // Engine that carries the requests, and the network they count towards
+    std::shared_ptr<RpcTransport> transport;
+    SVMNetwork network = SVMNetwork::SOLANA;
+    
+    // Scheduling class of every request the call sends
+    RequestPriority priority = RequestPriority::READ;
+    
+    bool is_cancelled() const {
+        return cancellation.is_cancelled() || settled.is_cancelled();
+    }
+    
+    void throw_if_expired() const {
+        cancellation.throw_if_cancelled();
+        if (std::chrono::steady_clock::now() >= deadline) {
+            throw TimeoutException("deadline exceeded");
+        }
+    }
+};
+
+/**
+ * Describe an HTTP request bounded by the call's deadline
+ * 
+ * @param url The URL
+ * @param post_body JSON body to POST, or nullptr for GET
+ * @param context Deadline and cancellation for the call; must outlive the request
+ */
+HttpRequest make_http_request(const std::string& url, const std::string* post_body, const RequestContext& context) {
+    HttpRequest request;
+    request.url = url;
+    request.body = post_body;
+    request.network = context.network;
+    request.deadline = context.deadline;
+    request.connect_timeout = get_default_connect_timeout();
+    request.should_abort = [&context]() { return context.is_cancelled(); };
+    request.priority = context.priority;
+    return request;
+}
+
+/**
+ * Perform an HTTP request bounded by the call's deadline
+ * 
+ * @param url The URL
+ * @param post_body JSON body to POST, or nullptr for GET
+ * @param context Deadline and cancellation for the call
+ */
+HttpResponse http_request(const std::string& url, const std::string* post_body, const RequestContext& context) {
+    context.throw_if_expired();
+    
+    return context.transport->perform(make_http_request(url, post_body, context));
+}
+
+/**
+ * Check that an admitted request may go to the endpoint, and count it as started
+ */
+void begin_request(Endpoint& endpoint, const RequestContext& context) {
+    context.throw_if_expired();
+    
+    if (!endpoint.breaker().allow_request()) {
+        throw CircuitOpenException(endpoint.url());
+    }
+    
+    endpoint.on_request_start();
+}
+
+/**
+ * Record a request that got no HTTP response in the endpoint's statistics
+ */
+void record_transport_failure(Endpoint& endpoint, const std::exception_ptr& error,
+                              std::chrono::microseconds latency) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const OperationCancelledException&) {
+        // Our own decision, which says nothing about the endpoint
+        endpoint.on_request_abandoned();
+        endpoint.breaker().release_probe();
+    } catch (...) {
+        endpoint.record_failure(latency);
+        endpoint.breaker().record_failure();
+    }
+}
+
+/**
+ * Record an endpoint's HTTP response and extract its body
+ * 
+ * @throws RateLimitException on HTTP 429, after pausing the endpoint's limiter
+ * @throws NetworkException on any other HTTP error status
+ */
+std::string accept_response(Endpoint& endpoint, RateLimiter::Permit& permit, HttpResponse& response,
+                            std::chrono::microseconds latency) {
+    // Any HTTP answer below 500 proves the node is up
+    if (response.status >= 500) {
+        endpoint.breaker().record_failure();
+    } else {
+        endpoint.breaker().record_success();
+    }
+    
+    if (response.status == 429) {
+        permit.release(RateLimiter::Outcome::THROTTLED);
+        RateLimiter::Clock::duration pause = endpoint.limiter().config().default_retry_after;
+        if (response.retry_after) {
+            pause = *response.retry_after;
+        }
+        endpoint.limiter().pause_for(pause);
+        endpoint.record_failure(latency);
+        throw RateLimitException("HTTP 429 from " + endpoint.url());
+    }
+    if (response.status >= 400) {
+        endpoint.record_failure(latency);
+        throw NetworkException("HTTP " + std::to_string(response.status) + " from " + endpoint.url());
+    }
+    
+    permit.release(RateLimiter::Outcome::SUCCESS, latency);
+    endpoint.record_success(latency);
+    return std::move(response.body);
+}
+
+/**
+ * Send a request to one endpoint under its rate limiter and record the
+ * outcome in its statistics
+ */
+std::string post_to_endpoint(Endpoint& endpoint, const std::string& json_data, const RequestContext& context) {
+    // Admission may throw BackpressureException; that is not the endpoint's fault
+    RateLimiter::Permit permit = endpoint.limiter().acquire(context.deadline, context.priority);
+    begin_request(endpoint, context);
+    
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&]() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    };
+    
+    HttpResponse response;
+    try {
+        response = http_request(endpoint.url(), &json_data, context);
+    } catch (...) {
+        record_transport_failure(endpoint, std::current_exception(), elapsed());
+        throw;
+    }
+    return accept_response(endpoint, permit, response, elapsed());
+}
+
+/**
+ * Send a read to the best endpoint and, if it has not answered within the
+ * endpoint's hedge delay, a duplicate to a second endpoint. The first
+ * successful response wins; the call fails only when every attempt failed.
+ */
+std::string hedged_post(const std::shared_ptr<const EndpointSet>& endpoints, const std::string& json_data,
+                        const RequestContext& context, const Endpoint* exclude) {
+    struct HedgeState {
+        std::string json_data;
+        RequestContext context;  // The transfers' abort check refers to it
+        CancellationSource winner_found;
+        std::mutex mutex;
+        std::promise<std::string> promise;
+        int pending = 0;
+        bool settled = false;
+        
+        void finish(std::string response, std::exception_ptr error) {
+            std::lock_guard<std::mutex> lock(mutex);
+            --pending;
+            if (settled) {
+                return;
+            }
+            if (!error) {
+                settled = true;
+                promise.set_value(std::move(response));
+                winner_found.cancel();
+            } else if (pending == 0) {
+                settled = true;
+                promise.set_exception(error);
+            }
+        }
+    };
+    
+    auto state = std::make_shared<HedgeState>();
+    state->json_data = json_data;
+    state->context = context;
+    state->context.settled = state->winner_found.token();
+    // Not kept in the state, so the last reference never drops on the
+    // transport's own I/O thread; its destructor completes every transfer first
+    RpcTransport* transport = context.transport.get();
+    state->context.transport.reset();
+    auto result = state->promise.get_future();
+    
+    // Transfers complete on the I/O thread, so the loser never delays the
+    // caller; once one attempt answers, the other is aborted through the
+    // settled token and records nothing
+    auto launch = [&state, transport](const std::shared_ptr<Endpoint>& endpoint, RateLimiter::Permit permit) {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->settled) {
+                return;
+            }
+            ++state->pending;
+        }
+        try {
+            begin_request(*endpoint, state->context);
+        } catch (...) {
+            state->finish(std::string(), std::current_exception());
+            return;
+        }
+        
+        auto held = std::make_shared<RateLimiter::Permit>(std::move(permit));
+        auto start = std::chrono::steady_clock::now();
+        HttpRequest request = make_http_request(endpoint->url(), &state->json_data, state->context);
+        transport->perform_async(request, [state, endpoint, held, start](HttpResponse response, std::exception_ptr error) {
+            auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+            RateLimiter::Permit permit = std::move(*held);
+            std::string body;
+            if (error) {
+                record_transport_failure(*endpoint, error, latency);
+            } else {
+                try {
+                    body = accept_response(*endpoint, permit, response, latency);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            state->finish(std::move(body), error);
+        });
+    };
+    
+    // Admission may throw BackpressureException; that is not the endpoint's fault
+    auto primary = EndpointPool::pick(*endpoints, exclude);
+    launch(primary, primary->limiter().acquire(context.deadline, context.priority));
+    
+    if (result.wait_for(EndpointPool::hedge_delay(*endpoints, *primary)) == std::future_status::timeout) {
+        // The duplicate is optional, so it never queues behind a full limiter
+        auto backup = EndpointPool::pick(*endpoints, primary.get());
+        RateLimiter::Permit permit;
+        if (backup->limiter().try_acquire(permit, context.priority)) {
+            launch(backup, std::move(permit));
+        }
+    }
+    
+    return result.get();
+}
+
+/**
+ * Run an RPC request with retries across endpoints
+ * 
+ * Each retry avoids the endpoint that failed last. Retries stop when the
+ * failure is not retryable for this method, the attempt limit is reached,
+ * or the next delay would overrun the policy's total budget.
+ */
+std::string call_with_retries(const std::shared_ptr<const EndpointSet>& endpoints, const std::string& json_data,
+                              bool idempotent, const RequestContext& context) {
+    const auto& config = endpoints->config;
+    const RetryPolicy& policy = config.retry;
+    uint32_t max_attempts = std::max<uint32_t>(idempotent ? policy.max_attempts : policy.max_send_attempts, 1);
+    bool hedge = idempotent && config.hedging_enabled && endpoints->endpoints.size() > 1;
+    auto give_up = std::min(context.deadline, std::chrono::steady_clock::now() + policy.total_budget);
+    
+    std::chrono::milliseconds delay{0};
+    std::shared_ptr<Endpoint> last_failed;
+    for (uint32_t attempt = 1;; ++attempt) {
+        std::shared_ptr<Endpoint> endpoint;
+        try {
+            if (hedge) {
+                return hedged_post(endpoints, json_data, context, last_failed.get());
+            }
+            endpoint = EndpointPool::pick(*endpoints, last_failed.get());
+            return post_to_endpoint(*endpoint, json_data, context);
+        } catch (...) {
+            auto error = std::current_exception();
+            delay = policy.next_delay(delay);
+            if (attempt >= max_attempts || !is_retryable_failure(error, idempotent) ||
+                std::chrono::steady_clock::now() + delay >= give_up) {
+                throw;
+            }
+            last_failed = endpoint;
+        }
+        if (context.cancellation.wait_for(delay)) {
+            throw OperationCancelledException("operation was cancelled");
+        }
+    }
+}
+
+// How often a non-blocking call queued at an endpoint's limiter checks its
+// cancellation token; calls that cannot be cancelled do not check
+constexpr std::chrono::milliseconds CANCELLATION_CHECK_INTERVAL{50};
+
+/**
+ * An RPC call made without blocking a thread
+ * 
+ * Follows call_with_retries, but each step is a callback: transfers
+ * complete on the transport's I/O thread, admission queues at the
+ * endpoint's limiter with a callback, and retry delays are timers on the
+ * transport. Reads are not hedged.
+ */
+struct AsyncRpcCall {
+    std::shared_ptr<const EndpointSet> endpoints;
+    std::string json_data;
+    bool idempotent = false;
+    RequestContext context;
+    Completion<std::string> on_done;
+    
+    // Not owned, so the last reference never drops on the transport's own
+    // I/O thread; its destructor completes every pending call first
+    RpcTransport* transport = nullptr;
+    
+    uint32_t attempt = 0;
+    std::chrono::milliseconds delay{0};
+    std::chrono::steady_clock::time_point give_up;
+    std::shared_ptr<Endpoint> endpoint;
+    std::shared_ptr<Endpoint> last_failed;
+    RateLimiter::Permit permit;
+    std::chrono::steady_clock::time_point started;
+};
+
+void start_attempt(const std::shared_ptr<AsyncRpcCall>& call);
+
+void deliver(const std::shared_ptr<AsyncRpcCall>& call, std::string response, std::exception_ptr error) {
+    Completion<std::string> on_done = std::move(call->on_done);
+    on_done(std::move(response), error);
+}
+
+void attempt_failed(const std::shared_ptr<AsyncRpcCall>& call, std::exception_ptr error) {
+    const RetryPolicy& policy = call->endpoints->config.retry;
+    uint32_t max_attempts = std::max<uint32_t>(call->idempotent ? policy.max_attempts : policy.max_send_attempts, 1);
+    call->delay = policy.next_delay(call->delay);
+    if (call->attempt >= max_attempts || !is_retryable_failure(error, call->idempotent) ||
+        std::chrono::steady_clock::now() + call->delay >= call->give_up) {
+        deliver(call, std::string(), error);
+        return;
+    }
+    call->last_failed = call->endpoint;
+    call->transport->schedule(std::chrono::steady_clock::now() + call->delay, [call](bool cancelled) {
+        if (cancelled) {
+            deliver(call, std::string(), std::make_exception_ptr(NetworkException("transport is shutting down")));
+        } else if (call->context.cancellation.is_cancelled()) {
+            deliver(call, std::string(), std::make_exception_ptr(OperationCancelledException("operation was cancelled")));
+        } else {
+            start_attempt(call);
+        }
+    });
+}
+
+void start_transfer(const std::shared_ptr<AsyncRpcCall>& call) {
+    try {
+        begin_request(*call->endpoint, call->context);
+    } catch (...) {
+        call->permit = RateLimiter::Permit();
+        attempt_failed(call, std::current_exception());
+        return;
+    }
+    
+    call->started = std::chrono::steady_clock::now();
+    HttpRequest request = make_http_request(call->endpoint->url(), &call->json_data, call->context);
+    call->transport->perform_async(request, [call](HttpResponse response, std::exception_ptr error) {
+        auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - call->started);
+        RateLimiter::Permit permit = std::move(call->permit);
+        if (error) {
+            record_transport_failure(*call->endpoint, error, latency);
+            attempt_failed(call, error);
+            return;
+        }
+        std::string body;
+        try {
+            body = accept_response(*call->endpoint, permit, response, latency);
+        } catch (...) {
+            attempt_failed(call, std::current_exception());
+            return;
+        }
+        deliver(call, std::move(body), nullptr);
+    });
+}
+
+/**
+ * Keep a call queued at a limiter moving: poll the limiter when a clock
+ * wait ends, and leave the queue if the call is cancelled or the transport
+ * shuts down
+ */
+void watch_admission(const std::shared_ptr<AsyncRpcCall>& call, const std::shared_ptr<Endpoint>& endpoint,
+                     const std::shared_ptr<std::atomic<bool>>& queued, uint64_t ticket,
+                     std::chrono::steady_clock::time_point poll_at) {
+    if (call->context.cancellation.can_be_cancelled()) {
+        poll_at = std::min(poll_at, std::chrono::steady_clock::now() + CANCELLATION_CHECK_INTERVAL);
+    }
+    if (poll_at == std::chrono::steady_clock::time_point::max()) {
+        return;  // Out of the queue; the grant is on its way
+    }
+    call->transport->schedule(poll_at, [call, endpoint, queued, ticket](bool cancelled) {
+        if (!*queued) {
+            return;
+        }
+        if (cancelled || call->context.cancellation.is_cancelled()) {
+            if (endpoint->limiter().cancel(ticket)) {
+                deliver(call, std::string(), cancelled
+                    ? std::make_exception_ptr(NetworkException("transport is shutting down"))
+                    : std::make_exception_ptr(OperationCancelledException("operation was cancelled")));
+            }
+            return;
+        }
+        auto next = endpoint->limiter().poll();
+        if (*queued) {
+            watch_admission(call, endpoint, queued, ticket, next);
+        }
+    });
+}
+
+void send_attempt(const std::shared_ptr<AsyncRpcCall>& call) {
+    // Queued by priority with blocking callers; the grant may come from any
+    // thread that frees a slot and move the call on before this returns
+    auto endpoint = call->endpoint;
+    auto queued = std::make_shared<std::atomic<bool>>(true);
+    RateLimiter::Ticket ticket;
+    try {
+        ticket = endpoint->limiter().enqueue(
+            call->context.deadline, call->permit, [call, queued](RateLimiter::Permit permit, std::exception_ptr error) {
+                *queued = false;
+                if (error) {
+                    attempt_failed(call, error);
+                    return;
+                }
+                call->permit = std::move(permit);
+                start_transfer(call);
+            }, call->context.priority);
+    } catch (...) {
+        attempt_failed(call, std::current_exception());
+        return;
+    }
+    if (ticket.id == 0) {
+        start_transfer(call);
+    } else {
+        watch_admission(call, endpoint, queued, ticket.id, ticket.poll_at);
+    }
+}
+
+void start_attempt(const std::shared_ptr<AsyncRpcCall>& call) {
+    ++call->attempt;
+    call->endpoint = EndpointPool::pick(*call->endpoints, call->last_failed.get());
+    send_attempt(call);
+}
+
+std::string rpc_request_json(const std::string& method, const std::string& params) {
+    return R"({"jsonrpc":"2.0","id":1,"method":")" + method + R"(","params":)" + params + "}";
+}
+
+/**
+ * Fix a relative timeout to an absolute deadline at the time of the call,
+ * so nested calls share one budget
+ */
+CallOptions pin_deadline(const CallOptions& options) {
+    CallOptions pinned = options;
+    pinned.deadline = options.resolve_deadline();
+    return pinned;
+}
+
+// Closes the transaction string in sendTransaction params
+const char SEND_TRANSACTION_OPTIONS[] = "\",{\"encoding\":\"base64\"}]";
+constexpr size_t SEND_TRANSACTION_PARAMS_OVERHEAD = sizeof(SEND_TRANSACTION_OPTIONS) + 2;
+
+/**
+ * Extract the result of a JSON-RPC response
+ *
+ * @throws NetworkException if the node answered with a JSON-RPC error
+ * @throws JsonParseException if the body is not a JSON-RPC response
+ */
+JsonValue rpc_result(const std::string& response) {
+    JsonValue document = JsonValue::parse(response);
+    const JsonValue& error = document["error"];
+    if (!error.is_null()) {
+        const JsonValue& message = error["message"];
+        throw NetworkException("RPC error: " + (message.is_string() ? message.as_string() : error.dump()));
+    }
+    const JsonValue* result = document.find("result");
+    if (!result) {
+        throw JsonParseException("response has neither result nor error");
+    }
+    return *result;
+}
+
+std::optional<SignatureStatus> parse_signature_status(const JsonValue& value) {
+    if (value.is_null()) {
+        return std::nullopt;
+    }
+    SignatureStatus status;
+    status.slot = value["slot"].as_uint64();
+    if (value["confirmations"].is_number()) {
+        status.confirmations = value["confirmations"].as_uint64();
+    }
+    if (!value["err"].is_null()) {
+        status.err = value["err"].dump();
+    }
+    if (value["confirmationStatus"].is_string()) {
+        status.confirmation_status = value["confirmationStatus"].as_string();
+    }
+    return status;
+}
+
+/**
+ * Build sendTransaction params around a base64 transaction
+ *
+ * @throws TransactionException if the transaction is not strict base64 or exceeds the size limit
+ */
+std::string send_transaction_params(const std::string& transaction, const SendOptions& send = SendOptions{}) {
+    // Reject malformed payloads here rather than spend a round trip on them
+    constexpr size_t max_encoded = base64_encoded_size(TransactionBuilder::MAX_TRANSACTION_SIZE);
+    uint8_t wire[base64_decoded_max_size(max_encoded)];
+    size_t size = 0;
+    if (transaction.size() > max_encoded ||
+        !base64_decode(transaction.data(), transaction.size(), wire, size)) {
+        throw TransactionException("Transaction is not a base64 wire-format transaction");
+    }
+    if (size > TransactionBuilder::MAX_TRANSACTION_SIZE) {
+        throw TransactionException("Transaction exceeds " + std::to_string(TransactionBuilder::MAX_TRANSACTION_SIZE) + " bytes");
+    }
+    
+    std::string params;
+    params.reserve(transaction.size() + SEND_TRANSACTION_PARAMS_OVERHEAD);
+    params += "[\"";
+    params += transaction;
+    if (!send.skip_preflight && !send.max_retries) {
+        params += SEND_TRANSACTION_OPTIONS;
+        return params;
+    }
+    params += "\",{\"encoding\":\"base64\"";
+    if (send.skip_preflight) {
+        params += ",\"skipPreflight\":true";
+    }
+    if (send.max_retries) {
+        params += ",\"maxRetries\":" + std::to_string(*send.max_retries);
+    }
+    params += "}]";
+    return params;
+}
+
+PaymentStatus payment_status_of(const std::optional<SignatureStatus>& status) {
+    if (!status) {
+        return PaymentStatus::PENDING;
+    } else if (status->err) {
+        return PaymentStatus::FAILED;
+    } else if (status->confirmation_status == "confirmed" || status->confirmation_status == "finalized") {
+        return PaymentStatus::CONFIRMED;
+    } else {
+        return PaymentStatus::PENDING;
+    }
+}
+
+LatestBlockhash parse_latest_blockhash(const JsonValue& result) {
+    LatestBlockhash latest;
+    latest.blockhash = result["value"]["blockhash"].as_string();
+    latest.last_valid_block_height = result["value"]["lastValidBlockHeight"].as_uint64();
+    latest.slot = result["context"]["slot"].as_uint64();
+    return latest;
+}
+
+const char LATEST_BLOCKHASH_PARAMS[] = "[{\"commitment\":\"confirmed\"}]";
+const char BLOCK_HEIGHT_PARAMS[] = "[{\"commitment\":\"confirmed\"}]";
+
+std::string prioritization_fees_params(const std::vector<PublicKey>& accounts) {
+    if (accounts.empty()) {
+        return "[]";
+    }
+    std::string params = "[[";
+    for (size_t i = 0; i < accounts.size(); ++i) {
+        params += (i == 0 ? "\"" : ",\"") + accounts[i].to_base58() + "\"";
+    }
+    return params + "]]";
+}
+
+std::vector<PrioritizationFee> parse_prioritization_fees(const JsonValue& result) {
+    std::vector<PrioritizationFee> fees;
+    fees.reserve(result.as_array().size());
+    for (const auto& entry : result.as_array()) {
+        fees.push_back({entry["slot"].as_uint64(), entry["prioritizationFee"].as_uint64()});
+    }
+    return fees;
+}
+
+// Nonce account layout: version, state, authority, nonce, lamports per signature
+constexpr uint32_t NONCE_STATE_INITIALIZED = 1;
+
+std::string nonce_account_params(const PublicKey& address) {
+    return "[\"" + address.to_base58() + "\",{\"encoding\":\"base64\",\"commitment\":\"confirmed\"}]";
+}
+
+std::string multiple_accounts_params(const PublicKey* keys, size_t count) {
+    std::string params = "[[";
+    for (size_t i = 0; i < count; ++i) {
+        params += (i == 0 ? "\"" : ",\"") + keys[i].to_base58() + "\"";
+    }
+    return params + "],{\"encoding\":\"base64\",\"commitment\":\"confirmed\"}]";
+}
+
+std::optional<AccountInfo> parse_account_info(const JsonValue& value, uint64_t slot) {
+    if (value.is_null()) {
+        return std::nullopt;
+    }
+    AccountInfo account;
+    account.lamports = value["lamports"].as_uint64();
+    account.owner = PublicKey::from_base58(value["owner"].as_string());
+    account.data = base64_decode(value["data"].as_array().at(0).as_string());
+    account.executable = value["executable"].as_bool();
+    account.slot = slot;
+    return account;
+}
+
+std::vector<std::optional<AccountInfo>> parse_multiple_accounts(const JsonValue& result, size_t expected) {
+    uint64_t slot = result["context"]["slot"].as_uint64();
+    std::vector<std::optional<AccountInfo>> accounts;
+    accounts.reserve(expected);
+    for (const auto& entry : result["value"].as_array()) {
+        accounts.push_back(parse_account_info(entry, slot));
+    }
+    if (accounts.size() != expected) {
+        throw JsonParseException("getMultipleAccounts returned " + std::to_string(accounts.size()) +
+                                 " entries for " + std::to_string(expected) + " keys");
+    }
+    return accounts;
+}
+
+std::string signatures_for_address_params(const PublicKey& address, const SignatureQuery& query) {
+    if (query.limit == 0 || query.limit > SvmNetworkAdapter::MAX_SIGNATURES_FOR_ADDRESS) {
+        throw std::invalid_argument("getSignaturesForAddress takes a limit of 1 to " +
+                                    std::to_string(SvmNetworkAdapter::MAX_SIGNATURES_FOR_ADDRESS));
+    }
+    std::string params = "[\"" + address.to_base58() + "\",{\"commitment\":\"confirmed\",\"limit\":" +
+                         std::to_string(query.limit);
+    if (!query.before.empty()) {
+        params += ",\"before\":\"" + json_escape(query.before) + "\"";
+    }
+    if (!query.until.empty()) {
+        params += ",\"until\":\"" + json_escape(query.until) + "\"";
+    }
+    return params + "}]";
+}
+
+std::vector<SignatureInfo> parse_signatures_for_address(const JsonValue& result) {
+    std::vector<SignatureInfo> signatures;
+    signatures.reserve(result.as_array().size());
+    for (const auto& entry : result.as_array()) {
+        SignatureInfo info;
+        info.signature = entry["signature"].as_string();
+        info.slot = entry["slot"].as_uint64();
+        if (!entry["err"].is_null()) {
+            info.err = entry["err"].dump();
+        }
+        if (entry["memo"].is_string()) {
+            info.memo = entry["memo"].as_string();
+        }
+        if (entry["blockTime"].is_number()) {
+            info.block_time = entry["blockTime"].as_int64();
+        }
+        if (entry["confirmationStatus"].is_string()) {
+            info.confirmation_status = entry["confirmationStatus"].as_string();
+        }
+        signatures.push_back(std::move(info));
+    }
+    return signatures;
+}
+
+NonceAccount parse_nonce_account(const PublicKey& address, const JsonValue& result) {
+    auto account = parse_account_info(result["value"], result["context"]["slot"].as_uint64());
+    if (!account) {
+        throw TransactionException("Nonce account " + address.to_base58() + " does not exist");
+    }
+    return decode_nonce_account(address, *account);
+}
+
+/**
+ * Adapt a completion for a parsed result to one for the raw RPC response
+ */
+template <typename T, typename Parse>
+Completion<std::string> parse_into(Completion<T> on_done, Parse parse) {
+    return [on_done = std::move(on_done), parse](std::string response, std::exception_ptr error) {
+        T value{};
+        if (!error) {
+            try {
+                value = parse(rpc_result(response));
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        on_done(std::move(value), error);
+    };
+}
+
+} // namespace
+
+NonceAccount decode_nonce_account(const PublicKey& address, const AccountInfo& account) {
+    if (account.owner != system_program_id()) {
+        throw TransactionException("Account " + address.to_base58() + " is not owned by the System program");
+    }
+    const std::vector<uint8_t>& data = account.data;
+    auto u32_at = [&data](size_t offset) {
+        return static_cast<uint32_t>(data[offset]) | static_cast<uint32_t>(data[offset + 1]) << 8 |
+               static_cast<uint32_t>(data[offset + 2]) << 16 | static_cast<uint32_t>(data[offset + 3]) << 24;
+    };
+    if (data.size() != NONCE_ACCOUNT_SIZE || u32_at(4) != NONCE_STATE_INITIALIZED) {
+        throw TransactionException("Account " + address.to_base58() + " is not an initialized nonce account");
+    }
+    NonceAccount nonce;
+    nonce.address = address;
+    std::copy(data.begin() + 8, data.begin() + 40, nonce.authority.data());
+    std::copy(data.begin() + 40, data.begin() + 72, nonce.nonce.data());
+    for (int i = 7; i >= 0; --i) {
+        nonce.lamports_per_signature = (nonce.lamports_per_signature << 8) | data[72 + i];
+    }
+    return nonce;
+}
+
+SvmNetworkAdapter::SvmNetworkAdapter(SVMNetwork network, const EndpointPoolConfig& endpoints,
+                                     std::shared_ptr<RpcTransport> transport)
+    : NetworkAdapter(network), endpoint_pool_(endpoints), transport_(std::move(transport)) {
+    if (!transport_) {
+        throw std::invalid_argument("SvmNetworkAdapter requires a transport");
+    }
+}
+
+SvmNetworkAdapter::SvmNetworkAdapter(SVMNetwork network)
+    : SvmNetworkAdapter(network, [network]() {
+          EndpointPoolConfig config;
+          config.urls.push_back(default_rpc_url(network));
+          return config;
+      }()) {}
+
+std::string SvmNetworkAdapter::default_rpc_url(SVMNetwork network) {
+    switch (network) {
+        case SVMNetwork::SOLANA:
+            return "https://api.mainnet-beta.solana.com";
+        case SVMNetwork::SONIC:
+            return "https://api.sonic.game";
+        case SVMNetwork::ECLIPSE:
+            return "https://mainnet.eclipse.xyz";
+        case SVMNetwork::SOON:
+            return "https://rpc.soon.network";
+    }
+    throw std::invalid_argument("Unknown SVM network");
+}
+
+SvmNetworkAdapter::~SvmNetworkAdapter() = default;
+
+BlockhashCache& SvmNetworkAdapter::blockhash_cache() {
+    std::call_once(blockhash_cache_once_, [this]() {
+        blockhash_cache_ = std::make_unique<BlockhashCache>(*this);
+    });
+    return *blockhash_cache_;
+}
+
+PriorityFeeEstimator& SvmNetworkAdapter::priority_fee_estimator() {
+    std::call_once(priority_fee_estimator_once_, [this]() {
+        priority_fee_estimator_ = std::make_unique<PriorityFeeEstimator>(*this);
+    });
+    return *priority_fee_estimator_;
+}
+
+MintCache& SvmNetworkAdapter::mint_cache() {
+    std::call_once(mint_cache_once_, [this]() {
+        mint_cache_ = std::make_unique<MintCache>(*this);
+    });
+    return *mint_cache_;
+}
+
+void SvmNetworkAdapter::set_rpc_url(const std::string& rpc_url) {
+    EndpointPoolConfig config = endpoint_pool_.snapshot()->config;
+    config.urls = {rpc_url};
+    endpoint_pool_.configure(config);
+}
+
+std::string SvmNetworkAdapter::get_rpc_url() const {
+    return endpoint_pool_.snapshot()->endpoints.front()->url();
+}
+
+void SvmNetworkAdapter::set_endpoints(const EndpointPoolConfig& endpoints) {
+    endpoint_pool_.configure(endpoints);
+}
+
+const EndpointPool& SvmNetworkAdapter::get_endpoint_pool() const {
+    return endpoint_pool_;
+}
+
+bool SvmNetworkAdapter::validate_address(const std::string& address) const {
+    // SVM addresses are 32-44 characters long and base58 encoded
+    if (address.length() < 32 || address.length() > 44) {
+        return false;
+    }
+    
+    // Check if all characters are valid base58
+    const std::string base58_chars = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    return std::all_of(address.begin(), address.end(), [&](char c) {
+        return base58_chars.find(c) != std::string::npos;
+    });
+}
+
+std::string SvmNetworkAdapter::rpc_call(const std::string& method, const std::string& params,
+                                        const CallOptions& options) {
+    RequestContext context{options.resolve_deadline(), options.cancellation, {}, transport_, network_,
+                           options.priority.value_or(default_rpc_priority(method))};
+    return call_with_retries(endpoint_pool_.snapshot(), rpc_request_json(method, params),
+                             is_idempotent_rpc_method(method), context);
+}
+
+void SvmNetworkAdapter::rpc_call_async(const std::string& method, const std::string& params,
+                                       const CallOptions& options, Completion<std::string> on_done) {
+    auto call = std::make_shared<AsyncRpcCall>();
+    call->endpoints = endpoint_pool_.snapshot();
+    call->idempotent = is_idempotent_rpc_method(method);
+    call->json_data = rpc_request_json(method, params);
+    call->context = RequestContext{options.resolve_deadline(), options.cancellation, {}, nullptr, network_,
+                                   options.priority.value_or(default_rpc_priority(method))};
+    call->on_done = std::move(on_done);
+    call->transport = transport_.get();
+    call->give_up = std::min(call->context.deadline,
+                             std::chrono::steady_clock::now() + call->endpoints->config.retry.total_budget);
+    try {
+        call->context.throw_if_expired();
+    } catch (...) {
+        deliver(call, std::string(), std::current_exception());
+        return;
+    }
+    start_attempt(call);
+}
+
+void SvmNetworkAdapter::submit_transaction_async(const std::string& transaction, const std::string& /*signature*/,
+                                                 const CallOptions& options, Completion<std::string> on_done) {
+    send_transaction_async(transaction, SendOptions{}, options, std::move(on_done));
+}
+
+void SvmNetworkAdapter::send_transaction_async(const std::string& transaction, const SendOptions& send,
+                                               const CallOptions& options, Completion<std::string> on_done) {
+    std::string params;
+    try {
+        options.cancellation.throw_if_cancelled();
+        params = send_transaction_params(transaction, send);
+    } catch (...) {
+        on_done(std::string(), std::current_exception());
+        return;
+    }
+    rpc_call_async("sendTransaction", params, options,
+                   parse_into(std::move(on_done), [](const JsonValue& result) { return result.as_string(); }));
+}
+
+void SvmNetworkAdapter::check_transaction_status_async(const std::string& signature, const CallOptions& options,
+                                                       Completion<PaymentStatus> on_done) {
+    std::string params = "[[\"" + json_escape(signature) + "\"]]";
+    rpc_call_async("getSignatureStatuses", params, options,
+                   parse_into(std::move(on_done), [](const JsonValue& result) {
+                       const auto& entries = result["value"].as_array();
+                       if (entries.size() != 1) {
+                           throw JsonParseException("getSignatureStatuses returned " + std::to_string(entries.size()) +
+                                                    " entries for 1 signature");
+                       }
+                       return payment_status_of(parse_signature_status(entries.front()));
+                   }));
+}
+
+void SvmNetworkAdapter::get_latest_blockhash_async(const CallOptions& options, Completion<LatestBlockhash> on_done) {
+    rpc_call_async("getLatestBlockhash", LATEST_BLOCKHASH_PARAMS, options,
+                   parse_into(std::move(on_done), parse_latest_blockhash));
+}
+
+void SvmNetworkAdapter::get_nonce_account_async(const PublicKey& address, const CallOptions& options,
+                                                Completion<NonceAccount> on_done) {
+    rpc_call_async("getAccountInfo", nonce_account_params(address), options,
+                   parse_into(std::move(on_done), [address](const JsonValue& result) {
+                       return parse_nonce_account(address, result);
+                   }));
+}
+
+void SvmNetworkAdapter::get_recent_prioritization_fees_async(const std::vector<PublicKey>& accounts,
+                                                             const CallOptions& options,
+                                                             Completion<std::vector<PrioritizationFee>> on_done) {
+    rpc_call_async("getRecentPrioritizationFees", prioritization_fees_params(accounts), options,
+                   parse_into(std::move(on_done), parse_prioritization_fees));
+}
+
+void SvmNetworkAdapter::get_multiple_accounts_async(const std::vector<PublicKey>& keys, const CallOptions& options,
+                                                    Completion<std::vector<std::optional<AccountInfo>>> on_done) {
+    if (keys.size() > MAX_MULTIPLE_ACCOUNTS) {
+        throw std::invalid_argument("getMultipleAccounts takes at most " + std::to_string(MAX_MULTIPLE_ACCOUNTS) + " keys");
+    }
+    if (keys.empty()) {
+        on_done({}, nullptr);
+        return;
+    }
+    size_t expected = keys.size();
+    rpc_call_async("getMultipleAccounts", multiple_accounts_params(keys.data(), keys.size()), options,
+                   parse_into(std::move(on_done), [expected](const JsonValue& result) {
+                       return parse_multiple_accounts(result, expected);
+                   }));
+}
+
+void SvmNetworkAdapter::get_signatures_for_address_async(const PublicKey& address, const SignatureQuery& query,
+                                                         const CallOptions& options,
+                                                         Completion<std::vector<SignatureInfo>> on_done) {
+    rpc_call_async("getSignaturesForAddress", signatures_for_address_params(address, query), options,
+                   parse_into(std::move(on_done), parse_signatures_for_address));
+}
+
+void SvmNetworkAdapter::get_block_height_async(const CallOptions& options, Completion<uint64_t> on_done) {
+    rpc_call_async("getBlockHeight", BLOCK_HEIGHT_PARAMS, options,
+                   parse_into(std::move(on_done), [](const JsonValue& result) { return result.as_uint64(); }));
+}
+
+std::future<size_t> SvmNetworkAdapter::warm_up(const CallOptions& options) {
+    struct WarmUp {
+        std::shared_ptr<const EndpointSet> endpoints;
+        RequestContext context;
+        std::string health = R"({"jsonrpc":"2.0","id":1,"method":"getHealth"})";
+        std::atomic<size_t> answered{0};
+        std::atomic<size_t> remaining{0};
+        std::promise<size_t> done;
+    };
+    auto state = std::make_shared<WarmUp>();
+    state->endpoints = endpoint_pool_.snapshot();
+    state->context = RequestContext{options.resolve_deadline(), options.cancellation, {}, transport_, network_,
+                                    options.priority.value_or(RequestPriority::READ)};
+    state->remaining = state->endpoints->endpoints.size();
+    std::future<size_t> result = state->done.get_future();
+    transport_->warm_up();
+    
+    // One task per endpoint; the last one to finish reports the count
+    auto executor = get_executor(options);
+    for (const auto& endpoint : state->endpoints->endpoints) {
+        executor->execute([state, endpoint]() {
+            try {
+                // The connection stays pooled even when the node reports itself unhealthy
+                post_to_endpoint(*endpoint, state->health, state->context);
+                ++state->answered;
+            } catch (const std::exception&) {
+            }
+            if (--state->remaining == 0) {
+                state->done.set_value(state->answered.load());
+            }
+        });
+    }
+    return result;
+}
+
+std::future<std::string> SvmNetworkAdapter::create_transfer_transaction(const TransferRequest& request,
+                                                                          const CallOptions& options) {
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, request, pinned]() -> std::string {
+        pinned.cancellation.throw_if_cancelled();
+        
+        if (!validate_address(request.recipient)) {
+            throw AddressValidationException("Invalid recipient address: " + request.recipient);
+        }
+        
+        if (!request.account) {
+            throw TransactionException("Transfer request has no paying account");
+        }
+        PublicKey payer = PublicKey::from_base58(*request.account);
+        PublicKey recipient = PublicKey::from_base58(request.recipient);
+        std::vector<PublicKey> references;
+        for (const auto& reference : request.references) {
+            references.push_back(PublicKey::from_base58(reference));
+        }
+        
+        std::optional<MintInfo> mint;
+        if (request.spl_token) {
+            auto loading = mint_cache().get(PublicKey::from_base58(*request.spl_token));
+            if (loading.wait_until(*pinned.deadline) != std::future_status::ready) {
+                throw TimeoutException("Loading mint " + *request.spl_token + " timed out");
+            }
+            mint = loading.get();
+        }
+        
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            *pinned.deadline - std::chrono::steady_clock::now());
+        CachedBlockhash cached = blockhash_cache().get(std::max(remaining, std::chrono::milliseconds(0)));
+        
+        TransactionBuilder builder;
+        builder.set_fee_payer(payer).set_recent_blockhash(cached.blockhash);
+        if (request.memo) {
+            builder.add_memo(*request.memo);
+        }
+        if (mint) {
+            // Between the wallets' associated token accounts, as Solana Pay wallets do
+            uint64_t amount = parse_token_amount(request.amount, mint->decimals);
+            builder.add_transfer_checked(associated_token_address(payer, mint->mint, mint->program), mint->mint,
+                                         associated_token_address(recipient, mint->mint, mint->program), payer,
+                                         amount, mint->decimals, mint->program);
+        } else {
+            builder.add_system_transfer(payer, recipient, parse_token_amount(request.amount, LAMPORTS_DECIMALS));
+        }
+        builder.add_references(references);
+        return builder.serialize_base64();
+    });
+}
+
+std::future<std::string> SvmNetworkAdapter::fetch_transaction(const TransactionRequest& request,
+                                                                const CallOptions& options) {
+    RequestContext context{options.resolve_deadline(), options.cancellation, {}, transport_, network_,
+                           options.priority.value_or(RequestPriority::READ)};
+    return submit(*get_executor(options), [this, request, context]() -> std::string {
+        if (!validate_address(request.recipient)) {
+            throw AddressValidationException("Invalid recipient address: " + request.recipient);
+        }
+        
+        // Make HTTP request to fetch transaction from the link
+        HttpResponse response = http_request(request.link, nullptr, context);
+        if (response.status >= 400) {
+            throw NetworkException("Failed to fetch transaction: HTTP " + std::to_string(response.status));
+        }
+        
+        return std::move(response.body);
+    });
+}
+
+std::future<std::string> SvmNetworkAdapter::submit_transaction(const std::string& transaction, const std::string& /*signature*/,
+                                                                 const CallOptions& options) {
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, transaction, pinned]() -> std::string {
+        pinned.cancellation.throw_if_cancelled();
+        
+        std::string params = send_transaction_params(transaction);
+        return rpc_result(rpc_call("sendTransaction", params, pinned)).as_string();
+    });
+}
+
+std::future<std::string> SvmNetworkAdapter::submit_transaction(const uint8_t* transaction, size_t size,
+                                                                 const CallOptions& options) {
+    if (size > TransactionBuilder::MAX_TRANSACTION_SIZE) {
+        throw TransactionException("Transaction exceeds " + std::to_string(TransactionBuilder::MAX_TRANSACTION_SIZE) + " bytes");
+    }
+    // Encode straight into the request so the caller's buffer can be reused at once
+    std::string params;
+    params.reserve(base64_encoded_size(size) + SEND_TRANSACTION_PARAMS_OVERHEAD);
+    params += "[\"";
+    base64_encode_append(transaction, size, params);
+    params += SEND_TRANSACTION_OPTIONS;
+    
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, params = std::move(params), pinned]() -> std::string {
+        pinned.cancellation.throw_if_cancelled();
+        return rpc_result(rpc_call("sendTransaction", params, pinned)).as_string();
+    });
+}
+
+std::future<PaymentStatus> SvmNetworkAdapter::check_transaction_status(const std::string& signature,
+                                                                         const CallOptions& options) {
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, signature, pinned]() -> PaymentStatus {
+        auto statuses = fetch_signature_statuses({signature}, pinned);
+        return payment_status_of(statuses.front());
+    });
+}
+
+std::future<LatestBlockhash> SvmNetworkAdapter::get_latest_blockhash(const CallOptions& options) {
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, pinned]() {
+        return parse_latest_blockhash(rpc_result(rpc_call("getLatestBlockhash", LATEST_BLOCKHASH_PARAMS, pinned)));
+    });
+}
+
+std::future<NonceAccount> SvmNetworkAdapter::get_nonce_account(const PublicKey& address, const CallOptions& options) {
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, address, pinned]() {
+        return parse_nonce_account(address, rpc_result(rpc_call("getAccountInfo", nonce_account_params(address), pinned)));
+    });
+}
+
+std::future<std::vector<std::optional<AccountInfo>>> SvmNetworkAdapter::get_multiple_accounts(
+    const std::vector<PublicKey>& keys, const CallOptions& options) {
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, keys, pinned]() {
+        // Chunks go out concurrently, as in fetch_signature_statuses
+        std::vector<std::future<std::string>> responses;
+        for (size_t start = 0; start < keys.size(); start += MAX_MULTIPLE_ACCOUNTS) {
+            size_t count = std::min(keys.size() - start, MAX_MULTIPLE_ACCOUNTS);
+            auto response = std::make_shared<std::promise<std::string>>();
+            responses.push_back(response->get_future());
+            rpc_call_async("getMultipleAccounts", multiple_accounts_params(keys.data() + start, count), pinned,
+                           [response](std::string body, std::exception_ptr error) {
+                               if (error) {
+                                   response->set_exception(error);
+                               } else {
+                                   response->set_value(std::move(body));
+                               }
+                           });
+        }
+        
+        std::vector<std::optional<AccountInfo>> accounts;
+        accounts.reserve(keys.size());
+        for (size_t i = 0; i < responses.size(); ++i) {
+            size_t count = std::min(keys.size() - i * MAX_MULTIPLE_ACCOUNTS, MAX_MULTIPLE_ACCOUNTS);
+            for (auto& account : parse_multiple_accounts(rpc_result(responses[i].get()), count)) {
+                accounts.push_back(std::move(account));
+            }
+        }
+        return accounts;
+    });
+}
+
+std::future<std::vector<PrioritizationFee>> SvmNetworkAdapter::get_recent_prioritization_fees(
+    const std::vector<PublicKey>& accounts, const CallOptions& options) {
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, accounts, pinned]() {
+        return parse_prioritization_fees(
+            rpc_result(rpc_call("getRecentPrioritizationFees", prioritization_fees_params(accounts), pinned)));
+    });
+}
+
+std::future<std::vector<SignatureInfo>> SvmNetworkAdapter::get_signatures_for_address(
+    const PublicKey& address, const SignatureQuery& query, const CallOptions& options) {
+    std::string params = signatures_for_address_params(address, query);
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, params, pinned]() {
+        return parse_signatures_for_address(rpc_result(rpc_call("getSignaturesForAddress", params, pinned)));
+    });
+}
+
+std::future<uint64_t> SvmNetworkAdapter::get_minimum_balance_for_rent_exemption(uint64_t size,
+                                                                                const CallOptions& options) {
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, size, pinned]() {
+        return rpc_result(rpc_call("getMinimumBalanceForRentExemption", "[" + std::to_string(size) + "]", pinned))
+            .as_uint64();
+    });
+}
+
+std::future<std::vector<std::optional<SignatureStatus>>> SvmNetworkAdapter::get_signature_statuses(
+    const std::vector<std::string>& signatures, const CallOptions& options) {
+    CallOptions pinned = pin_deadline(options);
+    return submit(*get_executor(options), [this, signatures, pinned]() {
+        return fetch_signature_statuses(signatures, pinned);
+    });
+}
+
+void SvmNetworkAdapter::get_signature_statuses_async(const std::vector<std::string>& signatures,
+                                                     const CallOptions& options,
+                                                     Completion<std::vector<std::optional<SignatureStatus>>> on_done) {
+    // Batches go out concurrently; the last response in assembles the result
+    struct Lookup {
+        std::mutex mutex;
+        std::vector<std::string> responses;
+        size_t remaining = 0;
+        size_t expected = 0;
+        std::exception_ptr error;
+        Completion<std::vector<std::optional<SignatureStatus>>> on_done;
+    };
+    if (signatures.empty()) {
+        on_done({}, nullptr);
+        return;
+    }
+    auto lookup = std::make_shared<Lookup>();
+    size_t batches = (signatures.size() + MAX_SIGNATURE_STATUS_BATCH - 1) / MAX_SIGNATURE_STATUS_BATCH;
+    lookup->responses.resize(batches);
+    lookup->remaining = batches;
+    lookup->expected = signatures.size();
+    lookup->on_done = std::move(on_done);
+    
+    CallOptions pinned = pin_deadline(options);
+    for (size_t batch = 0; batch < batches; ++batch) {
+        size_t start = batch * MAX_SIGNATURE_STATUS_BATCH;
+        size_t end = std::min(signatures.size(), start + MAX_SIGNATURE_STATUS_BATCH);
+        std::string params = "[[";
+        for (size_t i = start; i < end; ++i) {
+            params += (i > start ? ",\"" : "\"") + json_escape(signatures[i]) + "\"";
+        }
+        params += "]]";
+        rpc_call_async("getSignatureStatuses", params, pinned, [lookup, batch](std::string body, std::exception_ptr error) {
+            {
+                std::lock_guard<std::mutex> lock(lookup->mutex);
+                if (error && !lookup->error) {
+                    lookup->error = error;
+                }
+                lookup->responses[batch] = std::move(body);
+                if (--lookup->remaining > 0) {
+                    return;
+                }
+            }
+            
+            std::vector<std::optional<SignatureStatus>> statuses;
+            error = lookup->error;
+            if (!error) {
+                try {
+                    statuses.reserve(lookup->expected);
+                    for (const auto& response : lookup->responses) {
+                        JsonValue value = rpc_result(response)["value"];
+                        for (const auto& entry : value.as_array()) {
+                            statuses.push_back(parse_signature_status(entry));
+                        }
+                    }
+                    if (statuses.size() != lookup->expected) {
+                        throw JsonParseException("getSignatureStatuses returned " + std::to_string(statuses.size()) +
+                                                 " entries for " + std::to_string(lookup->expected) + " signatures");
+                    }
+                } catch (...) {
+                    error = std::current_exception();
+                    statuses.clear();
+                }
+            }
+            lookup->on_done(std::move(statuses), error);
+        });
+    }
+}
+
+std::vector<std::optional<SignatureStatus>> SvmNetworkAdapter::fetch_signature_statuses(
+    const std::vector<std::string>& signatures, const CallOptions& options) {
+    // The only thread waiting is this one and it never waits on executor work
+    auto done = std::make_shared<std::promise<std::vector<std::optional<SignatureStatus>>>>();
+    auto result = done->get_future();
+    get_signature_statuses_async(signatures, options,
+                                 [done](std::vector<std::optional<SignatureStatus>> statuses, std::exception_ptr error) {
+        if (error) {
+            done->set_exception(error);
+        } else {
+            done->set_value(std::move(statuses));
+        }
+    });
+    return result.get();
+}
+
+} // namespace svm_pay
\ No newline at end of file
@@ -0,0 +1,262 @@
+#include "svm-pay/network/transaction_sender.hpp"
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/transaction.hpp"
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace svm_pay {
+
+/**
+ * One transaction being broadcast; only its own callbacks touch it, one at a time
+ */
+struct TransactionSender::Pipeline {
+    std::string signature;
+    std::string transaction;
+    uint64_t last_valid_block_height = 0;
+    CallOptions options;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    std::vector<Completion<PaymentStatus>> callbacks;  // Guarded by State::mutex
+    uint32_t round = 0;
+};
+
+/**
+ * Shared with every pipeline step, so callbacks on the I/O thread never
+ * reach into a destroyed sender
+ */
+struct TransactionSender::State : std::enable_shared_from_this<TransactionSender::State> {
+    using Clock = std::chrono::steady_clock;
+
+    State(SvmNetworkAdapter& adapter, const TransactionSenderConfig& config) : adapter(adapter), config(config) {}
+
+    void step(const std::shared_ptr<Pipeline>& pipeline);
+    void check_expiry(const std::shared_ptr<Pipeline>& pipeline);
+    void final_check(const std::shared_ptr<Pipeline>& pipeline);
+    void broadcast(const std::shared_ptr<Pipeline>& pipeline);
+    void schedule(const std::shared_ptr<Pipeline>& pipeline);
+    void finish(const std::shared_ptr<Pipeline>& pipeline, PaymentStatus status, std::exception_ptr error);
+    std::exception_ptr stop_reason(const Pipeline& pipeline);
+    CallOptions call_options(const Pipeline& pipeline) const;
+
+    SvmNetworkAdapter& adapter;
+    TransactionSenderConfig config;
+
+    mutable std::mutex mutex;
+    std::condition_variable idle;
+    bool stopping = false;
+    size_t sends_in_flight = 0;
+    std::unordered_map<std::string, std::shared_ptr<Pipeline>> pending;
+    std::unordered_map<std::string, PaymentStatus> memo;
+    std::deque<std::string> memo_order;
+
+    std::atomic<uint64_t> broadcasts{0};
+};
+
+namespace {
+
+bool is_terminal(PaymentStatus status) {
+    return status == PaymentStatus::CONFIRMED || status == PaymentStatus::FAILED;
+}
+
+} // namespace
+
+std::exception_ptr TransactionSender::State::stop_reason(const Pipeline& pipeline) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            return std::make_exception_ptr(OperationCancelledException("transaction sender stopped"));
+        }
+    }
+    if (pipeline.options.cancellation.is_cancelled()) {
+        return std::make_exception_ptr(OperationCancelledException("transaction broadcast cancelled"));
+    }
+    if (pipeline.deadline && Clock::now() >= *pipeline.deadline) {
+        return std::make_exception_ptr(TimeoutException("deadline exceeded before the transaction landed"));
+    }
+    return nullptr;
+}
+
+CallOptions TransactionSender::State::call_options(const Pipeline& pipeline) const {
+    CallOptions options;
+    options.timeout = config.request_timeout;
+    options.deadline = pipeline.deadline;
+    options.cancellation = pipeline.options.cancellation;
+    options.priority = pipeline.options.priority;
+    return options;
+}
+
+void TransactionSender::State::step(const std::shared_ptr<Pipeline>& pipeline) {
+    if (auto error = stop_reason(*pipeline)) {
+        finish(pipeline, PaymentStatus::PENDING, error);
+        return;
+    }
+    if (pipeline->round == 0) {
+        broadcast(pipeline);
+        schedule(pipeline);
+        return;
+    }
+    auto self = shared_from_this();
+    adapter.check_transaction_status_async(pipeline->signature, call_options(*pipeline),
+                                           [self, pipeline](PaymentStatus status, std::exception_ptr error) {
+                                               if (!error && is_terminal(status)) {
+                                                   self->finish(pipeline, status, nullptr);
+                                               } else {
+                                                   self->check_expiry(pipeline);
+                                               }
+                                           });
+}
+
+void TransactionSender::State::check_expiry(const std::shared_ptr<Pipeline>& pipeline) {
+    auto self = shared_from_this();
+    adapter.get_block_height_async(call_options(*pipeline), [self, pipeline](uint64_t height, std::exception_ptr error) {
+        if (!error && height > pipeline->last_valid_block_height) {
+            self->final_check(pipeline);
+            return;
+        }
+        // An unknown height is not proof of expiry, so keep going
+        self->broadcast(pipeline);
+        self->schedule(pipeline);
+    });
+}
+
+void TransactionSender::State::final_check(const std::shared_ptr<Pipeline>& pipeline) {
+    // It may have landed in the last valid block, after the previous check
+    auto self = shared_from_this();
+    adapter.check_transaction_status_async(pipeline->signature, call_options(*pipeline),
+                                           [self, pipeline](PaymentStatus status, std::exception_ptr error) {
+                                               if (error) {
+                                                   self->schedule(pipeline);
+                                               } else {
+                                                   self->finish(pipeline, is_terminal(status) ? status : PaymentStatus::EXPIRED,
+                                                                nullptr);
+                                               }
+                                           });
+}
+
+void TransactionSender::State::broadcast(const std::shared_ptr<Pipeline>& pipeline) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++sends_in_flight;
+    }
+    broadcasts.fetch_add(1, std::memory_order_relaxed);
+    auto self = shared_from_this();
+    // Send failures are not terminal; the status decides the outcome
+    adapter.send_transaction_async(pipeline->transaction, config.send, call_options(*pipeline),
+                                   [self](std::string, std::exception_ptr) {
+                                       std::lock_guard<std::mutex> lock(self->mutex);
+                                       --self->sends_in_flight;
+                                       self->idle.notify_all();
+                                   });
+}
+
+void TransactionSender::State::schedule(const std::shared_ptr<Pipeline>& pipeline) {
+    ++pipeline->round;
+    auto self = shared_from_this();
+    adapter.transport().schedule(Clock::now() + config.interval, [self, pipeline](bool cancelled) {
+        if (cancelled) {
+            self->finish(pipeline, PaymentStatus::PENDING,
+                         std::make_exception_ptr(NetworkException("transport is shutting down")));
+        } else {
+            self->step(pipeline);
+        }
+    });
+}
+
+void TransactionSender::State::finish(const std::shared_ptr<Pipeline>& pipeline, PaymentStatus status,
+                                      std::exception_ptr error) {
+    std::vector<Completion<PaymentStatus>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.erase(pipeline->signature);
+        callbacks.swap(pipeline->callbacks);
+        if (!error && config.memo_capacity > 0 && memo.emplace(pipeline->signature, status).second) {
+            memo_order.push_back(pipeline->signature);
+            if (memo_order.size() > config.memo_capacity) {
+                memo.erase(memo_order.front());
+                memo_order.pop_front();
+            }
+        }
+        idle.notify_all();
+    }
+    for (auto& callback : callbacks) {
+        callback(status, error);
+    }
+}
+
+TransactionSender::TransactionSender(SvmNetworkAdapter& adapter, const TransactionSenderConfig& config)
+    : state_(std::make_shared<State>(adapter, config)) {
+    state_->config.interval = std::max(state_->config.interval, std::chrono::milliseconds(1));
+}
+
+TransactionSender::~TransactionSender() {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->stopping = true;
+    state_->idle.wait(lock, [this]() { return state_->pending.empty() && state_->sends_in_flight == 0; });
+}
+
+void TransactionSender::send(const std::string& transaction, uint64_t last_valid_block_height,
+                             Completion<PaymentStatus> on_done, const CallOptions& options) {
+    std::vector<uint8_t> wire;
+    try {
+        wire = base64_decode(transaction);
+    } catch (const std::invalid_argument&) {
+        throw TransactionException("Transaction is not a base64 wire-format transaction");
+    }
+    std::string signature = transaction_signature(wire.data(), wire.size());
+
+    auto pipeline = std::make_shared<Pipeline>();
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        auto memo = state_->memo.find(signature);
+        if (memo != state_->memo.end()) {
+            PaymentStatus status = memo->second;
+            lock.unlock();
+            on_done(status, nullptr);
+            return;
+        }
+        auto existing = state_->pending.find(signature);
+        if (existing != state_->pending.end()) {
+            existing->second->callbacks.push_back(std::move(on_done));
+            return;
+        }
+        pipeline->signature = signature;
+        pipeline->transaction = transaction;
+        pipeline->last_valid_block_height = last_valid_block_height;
+        pipeline->options = options;
+        // Only an explicit limit applies; the default call timeout is per request
+        if (options.deadline || options.timeout) {
+            pipeline->deadline = options.resolve_deadline();
+        }
+        pipeline->callbacks.push_back(std::move(on_done));
+        state_->pending.emplace(signature, pipeline);
+    }
+    state_->step(pipeline);
+}
+
+std::future<PaymentStatus> TransactionSender::send(const std::string& transaction, uint64_t last_valid_block_height,
+                                                   const CallOptions& options) {
+    auto promise = std::make_shared<std::promise<PaymentStatus>>();
+    std::future<PaymentStatus> result = promise->get_future();
+    send(transaction, last_valid_block_height,
+         [promise](PaymentStatus status, std::exception_ptr error) {
+             if (error) {
+                 promise->set_exception(error);
+             } else {
+                 promise->set_value(status);
+             }
+         },
+         options);
+    return result;
+}
+
+size_t TransactionSender::pending_count() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->pending.size();
+}
+
+uint64_t TransactionSender::broadcast_count() const {
+    return state_->broadcasts.load(std::memory_order_relaxed);
+}
+
+} // namespace svm_pay
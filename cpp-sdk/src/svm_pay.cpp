@@ -1,31 +1,136 @@
 #include "svm-pay/svm_pay.hpp"
-#include "svm-pay/network/solana.hpp"
+#include "svm-pay/network/svm_adapter.hpp"
+#include <algorithm>
+#include <future>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 namespace svm_pay {
 
-void initialize_sdk(const std::unordered_map<std::string, std::string>& options) {
-    // Register default network adapters
+namespace {
+
+std::vector<std::string> split_list(const std::string& value) {
+    std::vector<std::string> items;
+    std::istringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        auto begin = item.find_first_not_of(" \t");
+        auto end = item.find_last_not_of(" \t");
+        if (begin != std::string::npos) {
+            items.push_back(item.substr(begin, end - begin + 1));
+        }
+    }
+    return items;
+}
+
+/**
+ * Apply the options, after installing the application's executor if there
+ * is one, so nothing is scheduled on or warmed up through a pool that is
+ * about to be replaced
+ */
+void configure_sdk(const std::unordered_map<std::string, std::string>& options, std::shared_ptr<Executor> executor) {
+    // The built-in pool can be sized and pinned, e.g. "executor_pin_threads" = "true" or "0,2,4";
+    // neither applies when the application supplies its own executor
+    auto threads_it = options.find("executor_threads");
+    auto pin_it = options.find("executor_pin_threads");
+    if (executor) {
+        set_default_executor(std::move(executor));
+    } else if (threads_it != options.end() || pin_it != options.end()) {
+        WorkStealingConfig pool;
+        if (threads_it != options.end()) {
+            pool.threads = std::stoul(threads_it->second);
+        }
+        if (pin_it != options.end() && pin_it->second != "false") {
+            pool.pin_threads = true;
+            if (pin_it->second != "true") {
+                for (const auto& cpu : split_list(pin_it->second)) {
+                    pool.cpus.push_back(std::stoi(cpu));
+                }
+            }
+        }
+        set_default_executor(std::make_shared<WorkStealingExecutor>(pool));
+    }
     
-    // Solana adapter with configurable RPC URL
-    std::string solana_rpc = "https://api.mainnet-beta.solana.com";
-    auto solana_rpc_it = options.find("solana_rpc_url");
-    if (solana_rpc_it != options.end()) {
-        solana_rpc = solana_rpc_it->second;
+    // SDK-wide limits for calls that do not set their own deadline
+    auto timeout_it = options.find("rpc_timeout_ms");
+    if (timeout_it != options.end()) {
+        set_default_call_timeout(std::chrono::milliseconds(std::stoll(timeout_it->second)));
+    }
+    auto connect_timeout_it = options.find("rpc_connect_timeout_ms");
+    if (connect_timeout_it != options.end()) {
+        set_default_connect_timeout(std::chrono::milliseconds(std::stoll(connect_timeout_it->second)));
     }
     
-    auto solana_adapter = std::make_unique<SolanaNetworkAdapter>(solana_rpc);
-    NetworkAdapterFactory::register_adapter(SVMNetwork::SOLANA, std::move(solana_adapter));
+    // Register default network adapters; they all share one transport
     
-    // TODO: Register other network adapters when implemented
-    // auto sonic_adapter = std::make_unique<SonicNetworkAdapter>();
-    // NetworkAdapterFactory::register_adapter(SVMNetwork::SONIC, std::move(sonic_adapter));
+    // Settings common to every network
+    EndpointPoolConfig shared_endpoints;
+    auto hedging_it = options.find("rpc_hedging");
+    if (hedging_it != options.end()) {
+        shared_endpoints.hedging_enabled = hedging_it->second == "true";
+    }
     
-    // auto eclipse_adapter = std::make_unique<EclipseNetworkAdapter>();
-    // NetworkAdapterFactory::register_adapter(SVMNetwork::ECLIPSE, std::move(eclipse_adapter));
+    // Per-endpoint client-side rate limits
+    auto rps_it = options.find("rpc_requests_per_second");
+    if (rps_it != options.end()) {
+        shared_endpoints.rate_limit.requests_per_second = std::stod(rps_it->second);
+    }
+    auto concurrency_it = options.find("rpc_max_concurrency");
+    if (concurrency_it != options.end()) {
+        shared_endpoints.rate_limit.max_concurrency = static_cast<uint32_t>(std::stoul(concurrency_it->second));
+    }
     
-    // auto soon_adapter = std::make_unique<SoonNetworkAdapter>();
-    // NetworkAdapterFactory::register_adapter(SVMNetwork::SOON, std::move(soon_adapter));
+    // Retries for idempotent reads
+    auto attempts_it = options.find("rpc_max_attempts");
+    if (attempts_it != options.end()) {
+        shared_endpoints.retry.max_attempts = static_cast<uint32_t>(std::stoul(attempts_it->second));
+    }
+    
+    // "warm_up" is "true" for every network or a list such as "solana,sonic"
+    std::vector<std::string> warm_networks;
+    auto warm_it = options.find("warm_up");
+    if (warm_it != options.end() && warm_it->second != "false") {
+        warm_networks = split_list(warm_it->second);
+    }
+    auto should_warm = [&](const std::string& name) {
+        return std::find(warm_networks.begin(), warm_networks.end(), name) != warm_networks.end() ||
+               std::find(warm_networks.begin(), warm_networks.end(), "true") != warm_networks.end();
+    };
+    CallOptions warm_options;
+    warm_options.timeout = std::chrono::milliseconds(5000);
+    auto warm_timeout_it = options.find("warm_up_timeout_ms");
+    if (warm_timeout_it != options.end()) {
+        warm_options.timeout = std::chrono::milliseconds(std::stoll(warm_timeout_it->second));
+    }
+    std::vector<std::future<size_t>> warming;
+    
+    // Each network takes "<network>_rpc_urls" or "<network>_rpc_url", e.g. "sonic_rpc_url"
+    for (auto network : {SVMNetwork::SOLANA, SVMNetwork::SONIC, SVMNetwork::ECLIPSE, SVMNetwork::SOON}) {
+        std::string prefix = network_to_string(network);
+        EndpointPoolConfig endpoints = shared_endpoints;
+        auto rpcs_it = options.find(prefix + "_rpc_urls");
+        if (rpcs_it != options.end()) {
+            endpoints.urls = split_list(rpcs_it->second);
+        }
+        auto rpc_it = options.find(prefix + "_rpc_url");
+        if (endpoints.urls.empty() && rpc_it != options.end()) {
+            endpoints.urls.push_back(rpc_it->second);
+        }
+        if (endpoints.urls.empty()) {
+            endpoints.urls.push_back(SvmNetworkAdapter::default_rpc_url(network));
+        }
+        auto adapter = std::make_shared<SvmNetworkAdapter>(network, endpoints);
+        if (should_warm(prefix)) {
+            warming.push_back(adapter->warm_up(warm_options));
+        }
+        NetworkAdapterFactory::register_adapter(network, adapter);
+    }
+    
+    // Networks warm up concurrently; a cold endpoint is not an error
+    for (auto& warm : warming) {
+        warm.get();
+    }
     
     // Debug output if enabled
     auto debug_it = options.find("debug");
@@ -37,9 +142,19 @@ void initialize_sdk(const std::unordered_map<std::string, std::string>& options)
     }
 }
 
+} // namespace
+
+void initialize_sdk(const std::unordered_map<std::string, std::string>& options) {
+    configure_sdk(options, nullptr);
+}
+
+void initialize_sdk(const std::unordered_map<std::string, std::string>& options, std::shared_ptr<Executor> executor) {
+    configure_sdk(options, std::move(executor));
+}
+
 void cleanup_sdk() {
-    // Currently, the NetworkAdapterFactory handles cleanup automatically
-    // when the static map is destroyed. Future versions might need explicit cleanup.
+    // Registered adapters are destroyed with the registry at exit, and
+    // replaced ones as soon as nothing holds them
 }
 
 } // namespace svm_pay
\ No newline at end of file
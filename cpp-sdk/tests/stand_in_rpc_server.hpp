@@ -0,0 +1,149 @@
+#pragma once
+
+#include "svm-pay/core/json.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace svm_pay_test {
+
+using svm_pay::JsonValue;
+using svm_pay::json_escape;
+
+/**
+ * Minimal HTTP JSON-RPC node for tests
+ *
+ * Every request is passed to the handler, which returns the JSON text of the
+ * "result" member; the server wraps it in a response with the request id.
+ * Handlers run on per-connection threads.
+ */
+class StandInRpcServer {
+public:
+    using Handler = std::function<std::string(const std::string& method, const JsonValue& params)>;
+
+    explicit StandInRpcServer(Handler handler) : handler_(std::move(handler)) {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listen_fd_, 64);
+        socklen_t len = sizeof(addr);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        accept_thread_ = std::thread([this]() { accept_loop(); });
+    }
+
+    ~StandInRpcServer() {
+        shutdown(listen_fd_, SHUT_RDWR);
+        close(listen_fd_);
+        accept_thread_.join();
+        std::list<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Wake workers idling on kept-alive connections
+            for (int fd : open_fds_) {
+                shutdown(fd, SHUT_RDWR);
+            }
+            workers.swap(workers_);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(port_); }
+
+    size_t request_count() const { return requests_; }
+
+    size_t connection_count() const { return connections_; }
+
+    // Serve many requests per connection instead of closing after each
+    void set_keep_alive(bool keep_alive) { keep_alive_ = keep_alive; }
+
+private:
+    void accept_loop() {
+        while (true) {
+            int fd = accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            ++connections_;
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_fds_.insert(fd);
+            workers_.emplace_back([this, fd]() {
+                serve(fd);
+                std::lock_guard<std::mutex> lock(mutex_);
+                open_fds_.erase(fd);
+                close(fd);
+            });
+        }
+    }
+
+    void serve(int fd) {
+        std::string data;
+        char buffer[4096];
+        do {
+            size_t header_end;
+            while ((header_end = data.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+                if (n <= 0) {
+                    return;
+                }
+                data.append(buffer, static_cast<size_t>(n));
+            }
+            size_t content_length = 0;
+            auto pos = data.find("Content-Length: ");
+            if (pos != std::string::npos && pos < header_end) {
+                content_length = std::stoul(data.substr(pos + 16));
+            }
+            while (data.size() < header_end + 4 + content_length) {
+                ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+                if (n <= 0) {
+                    return;
+                }
+                data.append(buffer, static_cast<size_t>(n));
+            }
+
+            ++requests_;
+            std::string body;
+            try {
+                auto request = JsonValue::parse(data.substr(header_end + 4, content_length));
+                std::string result = handler_(request["method"].as_string(), request["params"]);
+                body = "{\"jsonrpc\":\"2.0\",\"result\":" + result + ",\"id\":" + request["id"].dump() + "}";
+            } catch (const std::exception& e) {
+                body = "{\"jsonrpc\":\"2.0\",\"error\":{\"code\":-32602,\"message\":\"" +
+                       json_escape(e.what()) + "\"},\"id\":1}";
+            }
+            data.erase(0, header_end + 4 + content_length);
+            std::string response = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+                                   std::to_string(body.size()) +
+                                   (keep_alive_ ? "\r\n\r\n" : "\r\nConnection: close\r\n\r\n") + body;
+            send(fd, response.data(), response.size(), MSG_NOSIGNAL);
+        } while (keep_alive_);
+    }
+
+    Handler handler_;
+    int listen_fd_;
+    uint16_t port_;
+    std::thread accept_thread_;
+    std::mutex mutex_;
+    std::list<std::thread> workers_;
+    std::set<int> open_fds_;
+    std::atomic<size_t> requests_{0};
+    std::atomic<size_t> connections_{0};
+    std::atomic<bool> keep_alive_{false};
+};
+
+} // namespace svm_pay_test
@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/account_loader.hpp"
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+namespace {
+
+PublicKey filled_key(uint8_t byte) {
+    std::array<uint8_t, PublicKey::SIZE> bytes;
+    bytes.fill(byte);
+    return PublicKey(bytes);
+}
+
+// Keys filled with an odd byte exist, holding that byte as data and lamports
+std::string account_json(const PublicKey& key) {
+    uint8_t byte = key.bytes()[0];
+    if (byte % 2 == 0) {
+        return "null";
+    }
+    return R"({"data":[")" + base64_encode(&byte, 1) + R"(","base64"],"executable":false,"lamports":)" +
+           std::to_string(byte) + R"(,"owner":"11111111111111111111111111111111","rentEpoch":0,"space":1})";
+}
+
+/**
+ * Node answering getMultipleAccounts and recording each call's keys
+ */
+class AccountNode {
+public:
+    AccountNode()
+        : server_([this](const std::string& method, const JsonValue& params) -> std::string {
+              if (method != "getMultipleAccounts") {
+                  throw std::runtime_error("unexpected method " + method);
+              }
+              std::vector<std::string> keys;
+              std::string result = R"({"context":{"slot":77},"value":[)";
+              for (const auto& key : params.as_array().at(0).as_array()) {
+                  keys.push_back(key.as_string());
+                  result += (keys.size() == 1 ? "" : ",") + account_json(PublicKey::from_base58(key.as_string()));
+              }
+              std::lock_guard<std::mutex> lock(mutex_);
+              calls_.push_back(std::move(keys));
+              if (failing_) {
+                  throw std::runtime_error("node unavailable");
+              }
+              return result + "]}";
+          }) {
+        EndpointPoolConfig config;
+        config.urls.push_back(server_.url());
+        config.retry.max_attempts = 1;
+        adapter_ = std::make_unique<SvmNetworkAdapter>(SVMNetwork::SOLANA, config, std::make_shared<RpcTransport>());
+    }
+
+    SvmNetworkAdapter& adapter() { return *adapter_; }
+
+    std::vector<std::vector<std::string>> calls() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_;
+    }
+
+    void set_failing(bool failing) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failing_ = failing;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::vector<std::string>> calls_;
+    bool failing_ = false;
+    svm_pay_test::StandInRpcServer server_;
+    std::unique_ptr<SvmNetworkAdapter> adapter_;
+};
+
+} // namespace
+
+class AccountLoaderTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(AccountLoaderTest, MergesConcurrentLoadsIntoOneCall) {
+    AccountNode node;
+    AccountLoaderConfig config;
+    config.window = milliseconds(100);
+    AccountLoader loader(node.adapter(), config);
+
+    // Four threads ask for overlapping keys 1..10 within one window
+    std::vector<std::future<std::optional<AccountInfo>>> loads[4];
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (uint8_t byte = 1 + t; byte <= 10; byte += 2) {
+                loads[t].push_back(loader.load(filled_key(byte)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < 4; ++t) {
+        uint8_t byte = 1 + t;
+        for (auto& load : loads[t]) {
+            auto account = load.get();
+            if (byte % 2 == 0) {
+                EXPECT_FALSE(account.has_value());
+            } else {
+                ASSERT_TRUE(account.has_value());
+                EXPECT_EQ(account->lamports, byte);
+                EXPECT_EQ(account->data, std::vector<uint8_t>{byte});
+                EXPECT_EQ(account->owner, PublicKey());
+                EXPECT_EQ(account->slot, 77u);
+            }
+            byte += 2;
+        }
+    }
+
+    auto calls = node.calls();
+    ASSERT_EQ(calls.size(), 1u);
+    EXPECT_EQ(calls[0].size(), 10u);
+    EXPECT_EQ(loader.load_count(), 18u);
+    EXPECT_EQ(loader.key_count(), 10u);
+    EXPECT_EQ(loader.batch_count(), 1u);
+}
+
+TEST_F(AccountLoaderTest, SendsFullBatchesWithoutWaiting) {
+    AccountNode node;
+    AccountLoaderConfig config;
+    config.window = std::chrono::seconds(60);
+    AccountLoader loader(node.adapter(), config);
+
+    std::vector<PublicKey> keys;
+    for (int byte = 1; byte <= 250; ++byte) {
+        keys.push_back(filled_key(static_cast<uint8_t>(byte)));
+    }
+    auto many = loader.load_many(keys);
+
+    // Two full batches went out at once; the last 50 keys wait for the window
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (node.calls().size() < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    EXPECT_EQ(many.wait_for(milliseconds(50)), std::future_status::timeout);
+    loader.flush();
+
+    auto accounts = many.get();
+    ASSERT_EQ(accounts.size(), 250u);
+    for (size_t i = 0; i < accounts.size(); ++i) {
+        EXPECT_EQ(accounts[i].has_value(), i % 2 == 0) << i;
+    }
+    auto calls = node.calls();
+    ASSERT_EQ(calls.size(), 3u);
+    EXPECT_EQ(calls[0].size(), 100u);
+    EXPECT_EQ(calls[1].size(), 100u);
+    EXPECT_EQ(calls[2].size(), 50u);
+    EXPECT_EQ(calls[2].back(), filled_key(250).to_base58());
+}
+
+TEST_F(AccountLoaderTest, DeliversErrorsToEveryWaiter) {
+    AccountNode node;
+    node.set_failing(true);
+    AccountLoaderConfig config;
+    config.window = milliseconds(20);
+    AccountLoader loader(node.adapter(), config);
+
+    auto first = loader.load(filled_key(1));
+    auto second = loader.load(filled_key(1));
+    auto many = loader.load_many({filled_key(2), filled_key(3)});
+    EXPECT_THROW(first.get(), SVMPayException);
+    EXPECT_THROW(second.get(), SVMPayException);
+    EXPECT_THROW(many.get(), SVMPayException);
+    EXPECT_EQ(node.calls().size(), 1u);
+
+    node.set_failing(false);
+    EXPECT_TRUE(loader.load(filled_key(1)).get().has_value());
+}
+
+TEST_F(AccountLoaderTest, AdapterSplitsLongKeyLists) {
+    AccountNode node;
+    std::vector<PublicKey> keys;
+    for (int byte = 1; byte <= 250; ++byte) {
+        keys.push_back(filled_key(static_cast<uint8_t>(byte)));
+    }
+
+    auto accounts = node.adapter().get_multiple_accounts(keys).get();
+    ASSERT_EQ(accounts.size(), 250u);
+    EXPECT_EQ(accounts[248]->lamports, 249u);
+    EXPECT_FALSE(accounts[249].has_value());
+    EXPECT_EQ(node.calls().size(), 3u);
+    EXPECT_TRUE(node.adapter().get_multiple_accounts({}).get().empty());
+
+    EXPECT_THROW(node.adapter().get_multiple_accounts_async(keys, CallOptions{}, [](auto, std::exception_ptr) {}),
+                 std::invalid_argument);
+
+    // Nonce accounts decode from loaded data; this one is too short
+    EXPECT_THROW(decode_nonce_account(keys[0], *accounts[0]), TransactionException);
+}
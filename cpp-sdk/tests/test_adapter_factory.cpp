@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/adapter.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace svm_pay;
+
+namespace {
+
+/**
+ * Adapter that only records its own destruction
+ */
+class StubAdapter : public NetworkAdapter {
+public:
+    StubAdapter(SVMNetwork network, std::shared_ptr<std::atomic<int>> destroyed)
+        : NetworkAdapter(network), destroyed_(std::move(destroyed)) {}
+
+    ~StubAdapter() override {
+        if (destroyed_) {
+            ++*destroyed_;
+        }
+    }
+
+    std::future<std::string> create_transfer_transaction(const TransferRequest&, const CallOptions&) override {
+        return {};
+    }
+    std::future<std::string> fetch_transaction(const TransactionRequest&, const CallOptions&) override {
+        return {};
+    }
+    void submit_transaction_async(const std::string&, const std::string&, const CallOptions&,
+                                  Completion<std::string> on_done) override {
+        on_done(std::string(), std::make_exception_ptr(std::runtime_error("not supported")));
+    }
+    void check_transaction_status_async(const std::string&, const CallOptions&,
+                                        Completion<PaymentStatus> on_done) override {
+        status = std::move(on_done);
+    }
+
+    Completion<PaymentStatus> status;
+
+private:
+    std::shared_ptr<std::atomic<int>> destroyed_;
+};
+
+} // namespace
+
+class NetworkAdapterFactoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(NetworkAdapterFactoryTest, ReplacedAdaptersLiveWhileHeld) {
+    auto destroyed = std::make_shared<std::atomic<int>>(0);
+    NetworkAdapterFactory::register_adapter(SVMNetwork::SOON, std::make_unique<StubAdapter>(SVMNetwork::SOON, destroyed));
+    auto first = NetworkAdapterFactory::get_adapter(SVMNetwork::SOON);
+    ASSERT_NE(first, nullptr);
+    EXPECT_TRUE(NetworkAdapterFactory::has_adapter(SVMNetwork::SOON));
+
+    auto second = std::make_shared<StubAdapter>(SVMNetwork::SOON, destroyed);
+    NetworkAdapterFactory::register_adapter(SVMNetwork::SOON, second);
+    EXPECT_EQ(NetworkAdapterFactory::get_adapter(SVMNetwork::SOON), second);
+
+    // The replaced adapter is still usable by whoever holds it, and goes
+    // with the last holder
+    EXPECT_EQ(destroyed->load(), 0);
+    EXPECT_EQ(first->get_network(), SVMNetwork::SOON);
+    first.reset();
+    EXPECT_EQ(destroyed->load(), 1);
+
+    // An adapter nobody else holds goes as soon as it is replaced
+    second.reset();
+    NetworkAdapterFactory::register_adapter(SVMNetwork::SOON, std::make_unique<StubAdapter>(SVMNetwork::SOON, nullptr));
+    EXPECT_EQ(destroyed->load(), 2);
+}
+
+TEST_F(NetworkAdapterFactoryTest, LookupsRaceWithRegistration) {
+    std::atomic<bool> done{false};
+    std::atomic<size_t> lookups{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&]() {
+            do {
+                auto adapter = NetworkAdapterFactory::get_adapter(SVMNetwork::ECLIPSE);
+                if (adapter) {
+                    EXPECT_EQ(adapter->get_network(), SVMNetwork::ECLIPSE);
+                }
+                ++lookups;
+            } while (!done);
+        });
+    }
+    for (int i = 0; i < 500; ++i) {
+        NetworkAdapterFactory::register_adapter(SVMNetwork::ECLIPSE,
+                                                std::make_unique<StubAdapter>(SVMNetwork::ECLIPSE, nullptr));
+        std::this_thread::yield();
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_GT(lookups.load(), 0u);
+    EXPECT_TRUE(NetworkAdapterFactory::has_adapter(SVMNetwork::ECLIPSE));
+}
+
+TEST_F(NetworkAdapterFactoryTest, FuturesDeriveFromAsyncCalls) {
+    StubAdapter adapter(SVMNetwork::SOON, nullptr);
+    std::future<PaymentStatus> status = adapter.check_transaction_status("sig");
+    EXPECT_EQ(status.wait_for(std::chrono::milliseconds(20)), std::future_status::timeout);
+    ASSERT_TRUE(adapter.status);
+    adapter.status(PaymentStatus::CONFIRMED, nullptr);
+    EXPECT_EQ(status.get(), PaymentStatus::CONFIRMED);
+
+    // An error from the async call fails the future
+    EXPECT_THROW(adapter.submit_transaction("tx", "sig").get(), std::runtime_error);
+}
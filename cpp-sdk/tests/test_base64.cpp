@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/transaction.hpp"
+#include "svm-pay/network/solana.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace svm_pay;
+
+namespace {
+
+const Base64Implementation IMPLEMENTATIONS[] = {
+    Base64Implementation::SCALAR,
+    Base64Implementation::SSSE3,
+    Base64Implementation::AVX2
+};
+
+std::string encode(const std::string& data) {
+    return base64_encode(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+bool decodes(const std::string& encoded) {
+    std::vector<uint8_t> out(base64_decoded_max_size(encoded.size()) + 1);
+    size_t written = 0;
+    return base64_decode(encoded.data(), encoded.size(), out.data(), written);
+}
+
+} // namespace
+
+class Base64Test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        original_ = base64_implementation();
+    }
+
+    void TearDown() override {
+        set_base64_implementation(original_);
+    }
+
+private:
+    Base64Implementation original_ = Base64Implementation::SCALAR;
+};
+
+TEST_F(Base64Test, MatchesRfc4648Vectors) {
+    for (auto implementation : IMPLEMENTATIONS) {
+        if (!set_base64_implementation(implementation)) {
+            continue;
+        }
+        EXPECT_EQ(encode(""), "");
+        EXPECT_EQ(encode("f"), "Zg==");
+        EXPECT_EQ(encode("fo"), "Zm8=");
+        EXPECT_EQ(encode("foo"), "Zm9v");
+        EXPECT_EQ(encode("foob"), "Zm9vYg==");
+        EXPECT_EQ(encode("fooba"), "Zm9vYmE=");
+        EXPECT_EQ(encode("foobar"), "Zm9vYmFy");
+
+        auto decoded = base64_decode("Zm9vYmE=");
+        EXPECT_EQ(std::string(decoded.begin(), decoded.end()), "fooba");
+        EXPECT_TRUE(base64_decode("").empty());
+    }
+    EXPECT_TRUE(set_base64_implementation(Base64Implementation::SCALAR));
+}
+
+TEST_F(Base64Test, ImplementationsAgree) {
+    std::mt19937 rng(42);
+    for (size_t size = 0; size <= 300; ++size) {
+        std::vector<uint8_t> data(size);
+        for (auto& byte : data) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        set_base64_implementation(Base64Implementation::SCALAR);
+        std::string expected = base64_encode(data.data(), data.size());
+        ASSERT_EQ(expected.size(), base64_encoded_size(size));
+
+        for (auto implementation : IMPLEMENTATIONS) {
+            if (!set_base64_implementation(implementation)) {
+                continue;
+            }
+            std::string encoded = base64_encode(data.data(), data.size());
+            ASSERT_EQ(encoded, expected) << "size " << size << " implementation " << static_cast<int>(implementation);
+
+            // Decode into an exact-size buffer so overruns show up under sanitizers
+            std::vector<uint8_t> out(base64_decoded_max_size(encoded.size()));
+            size_t written = 0;
+            ASSERT_TRUE(base64_decode(encoded.data(), encoded.size(), out.data(), written));
+            out.resize(written);
+            ASSERT_EQ(out, data) << "size " << size << " implementation " << static_cast<int>(implementation);
+        }
+    }
+}
+
+TEST_F(Base64Test, RejectsMalformedInput) {
+    std::vector<uint8_t> data(200, 0xAB);
+    std::string valid = base64_encode(data.data(), data.size());
+
+    for (auto implementation : IMPLEMENTATIONS) {
+        if (!set_base64_implementation(implementation)) {
+            continue;
+        }
+        ASSERT_TRUE(decodes(valid));
+        // A bad character anywhere is caught, whichever block it lands in
+        for (size_t i = 0; i < valid.size(); ++i) {
+            for (char bad : {'-', '_', '=', ' ', '\n', '\0', '\x80'}) {
+                std::string corrupted = valid;
+                corrupted[i] = bad;
+                if (bad == '=' && i + 2 >= valid.size()) {
+                    continue;  // May form legitimate padding
+                }
+                EXPECT_FALSE(decodes(corrupted)) << "position " << i << " char " << static_cast<int>(bad);
+            }
+        }
+
+        EXPECT_FALSE(decodes("Zg="));        // Length not a multiple of 4
+        EXPECT_FALSE(decodes("Zg=a"));       // Data after padding
+        EXPECT_FALSE(decodes("Z==="));       // Too much padding
+        EXPECT_FALSE(decodes("Zh=="));       // Non-zero trailing bits
+        EXPECT_FALSE(decodes("Zm9="));       // Non-zero trailing bits
+        EXPECT_FALSE(decodes("Zg==Zg=="));   // Padding mid-string
+        EXPECT_TRUE(decodes("Zg=="));
+    }
+    EXPECT_THROW(base64_decode(std::string("Zm9v\n")), std::invalid_argument);
+}
+
+TEST_F(Base64Test, AdapterSubmitsBase64Transactions) {
+    std::vector<std::string> sent;
+    std::mutex mutex;
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue& params) {
+        EXPECT_EQ(method, "sendTransaction");
+        EXPECT_EQ(params[1]["encoding"].as_string(), "base64");
+        std::lock_guard<std::mutex> lock(mutex);
+        sent.push_back(params[0].as_string());
+        return std::string("\"5sig\"");
+    });
+    SolanaNetworkAdapter adapter(server.url());
+
+    std::vector<uint8_t> wire(300);
+    for (size_t i = 0; i < wire.size(); ++i) {
+        wire[i] = static_cast<uint8_t>(i * 7);
+    }
+    std::string encoded = base64_encode(wire.data(), wire.size());
+    EXPECT_EQ(adapter.submit_transaction(encoded, "").get(), "5sig");
+    EXPECT_EQ(adapter.submit_transaction(wire.data(), wire.size()).get(), "5sig");
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(sent[0], encoded);
+    EXPECT_EQ(sent[1], encoded);
+
+    // Malformed or oversized payloads never reach the node
+    EXPECT_THROW(adapter.submit_transaction("not base64!", "").get(), TransactionException);
+    std::vector<uint8_t> oversized(TransactionBuilder::MAX_TRANSACTION_SIZE + 1);
+    EXPECT_THROW(adapter.submit_transaction(base64_encode(oversized.data(), oversized.size()), "").get(),
+                 TransactionException);
+    EXPECT_THROW(adapter.submit_transaction(oversized.data(), oversized.size()), TransactionException);
+    EXPECT_EQ(server.request_count(), 2u);
+}
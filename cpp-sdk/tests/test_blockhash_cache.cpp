@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/blockhash_cache.hpp"
+#include "svm-pay/network/solana.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/transaction.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+namespace {
+
+Blockhash filled_hash(uint8_t byte) {
+    std::array<uint8_t, PublicKey::SIZE> bytes;
+    bytes.fill(byte);
+    return Blockhash(bytes);
+}
+
+/**
+ * Stand-in for getLatestBlockhash that advances one slot per call
+ */
+class FakeBlockhashSource {
+public:
+    BlockhashCache::Fetcher fetcher() {
+        return [this](Completion<LatestBlockhash> on_done) {
+            if (failing_) {
+                on_done(LatestBlockhash{}, std::make_exception_ptr(NetworkException("node unavailable")));
+                return;
+            }
+            uint64_t slot = ++slot_;
+            LatestBlockhash latest;
+            latest.blockhash = filled_hash(static_cast<uint8_t>(slot)).to_base58();
+            latest.slot = slot;
+            latest.last_valid_block_height = slot + BlockhashCache::VALID_BLOCKHASH_AGE;
+            on_done(latest, nullptr);
+        };
+    }
+
+    void set_failing(bool failing) { failing_ = failing; }
+    uint64_t calls() const { return slot_; }
+
+private:
+    std::atomic<bool> failing_{false};
+    std::atomic<uint64_t> slot_{1000};
+};
+
+} // namespace
+
+class BlockhashCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(BlockhashCacheTest, ReadsDoNotFetch) {
+    FakeBlockhashSource source;
+    BlockhashCacheConfig config;
+    config.slot_time = milliseconds(1000);
+    BlockhashCache cache(source.fetcher(), config);
+
+    CachedBlockhash first = cache.get(milliseconds(5000));
+    EXPECT_EQ(first.slot, 1001u);
+    EXPECT_EQ(first.blockhash, filled_hash(static_cast<uint8_t>(1001)));
+    EXPECT_EQ(first.last_valid_block_height, 1151u);
+    EXPECT_FALSE(cache.is_stale(first));
+    EXPECT_EQ(cache.remaining_blocks(first), BlockhashCache::VALID_BLOCKHASH_AGE);
+
+    for (int i = 0; i < 100000; ++i) {
+        auto cached = cache.current();
+        ASSERT_TRUE(cached.has_value());
+        ASSERT_EQ(cached->slot, 1001u);
+    }
+    EXPECT_EQ(source.calls(), 1001u);
+    EXPECT_EQ(cache.refresh_count(), 1u);
+}
+
+TEST_F(BlockhashCacheTest, RefreshesEveryFewSlots) {
+    FakeBlockhashSource source;
+    BlockhashCacheConfig config;
+    config.slot_time = milliseconds(5);
+    config.refresh_slots = 2;
+    BlockhashCache cache(source.fetcher(), config);
+
+    std::this_thread::sleep_for(milliseconds(200));
+    // Every 10 ms nominally; allow for a slow scheduler
+    EXPECT_GE(cache.refresh_count(), 5u);
+    EXPECT_LE(cache.refresh_count(), 25u);
+    EXPECT_GT(cache.current()->slot, 1001u);
+}
+
+TEST_F(BlockhashCacheTest, SlotNotificationsDriveRefresh) {
+    FakeBlockhashSource source;
+    BlockhashCacheConfig config;
+    config.slot_time = milliseconds(60000);
+    config.refresh_slots = 10;
+    BlockhashCache cache(source.fetcher(), config);
+    CachedBlockhash first = cache.get(milliseconds(5000));
+
+    cache.notify_slot(first.slot + 5);
+    std::this_thread::sleep_for(milliseconds(50));
+    EXPECT_EQ(cache.refresh_count(), 1u);
+    EXPECT_EQ(cache.remaining_blocks(first), BlockhashCache::VALID_BLOCKHASH_AGE - 5);
+
+    cache.notify_slot(first.slot + 10);
+    for (int i = 0; i < 500 && cache.refresh_count() < 2; ++i) {
+        std::this_thread::sleep_for(milliseconds(2));
+    }
+    EXPECT_EQ(cache.refresh_count(), 2u);
+
+    // Observed slots far past a blockhash expire it
+    cache.notify_slot(first.slot + 500);
+    EXPECT_EQ(cache.remaining_blocks(first), 0u);
+}
+
+TEST_F(BlockhashCacheTest, WarnsWhenStaleAndTimesOutWhenExpired) {
+    FakeBlockhashSource source;
+    std::atomic<int> warnings{0};
+    BlockhashCacheConfig config;
+    config.slot_time = milliseconds(2);
+    config.refresh_slots = 1000;
+    config.stale_margin_blocks = 140;
+    config.retry_delay = milliseconds(5);
+    config.on_stale = [&](const CachedBlockhash&, uint64_t remaining) {
+        EXPECT_LT(remaining, 140u);
+        ++warnings;
+    };
+    BlockhashCache cache(source.fetcher(), config);
+    cache.get(milliseconds(5000));
+
+    source.set_failing(true);
+    cache.refresh();
+    for (int i = 0; i < 500 && warnings.load() == 0; ++i) {
+        std::this_thread::sleep_for(milliseconds(2));
+    }
+    EXPECT_GT(warnings.load(), 0);
+
+    // Stale means unusable, even before it expires
+    EXPECT_THROW(cache.get(milliseconds(20)), TimeoutException);
+
+    source.set_failing(false);
+    EXPECT_GT(cache.remaining_blocks(cache.get(milliseconds(5000))), 0u);
+}
+
+TEST_F(BlockhashCacheTest, GetWaitsForRefreshOfStaleBlockhash) {
+    FakeBlockhashSource source;
+    BlockhashCacheConfig config;
+    config.slot_time = milliseconds(2);
+    config.refresh_slots = 10000;
+    config.stale_margin_blocks = 100;
+    BlockhashCache cache(source.fetcher(), config);
+    CachedBlockhash first = cache.get(milliseconds(5000));
+
+    // Past the margin but not yet expired
+    for (int i = 0; i < 500 && !cache.is_stale(first); ++i) {
+        std::this_thread::sleep_for(milliseconds(2));
+    }
+    ASSERT_TRUE(cache.is_stale(first));
+    ASSERT_GT(cache.remaining_blocks(first), 0u);
+    EXPECT_EQ(cache.current()->slot, first.slot);
+
+    CachedBlockhash next = cache.get(milliseconds(5000));
+    EXPECT_GT(next.slot, first.slot);
+    EXPECT_FALSE(cache.is_stale(next));
+    EXPECT_EQ(cache.refresh_count(), 2u);
+}
+
+TEST_F(BlockhashCacheTest, ReadersNeverSeeTornValues) {
+    FakeBlockhashSource source;
+    BlockhashCacheConfig config;
+    config.slot_time = milliseconds(1);
+    config.refresh_slots = 1;
+    BlockhashCache cache(source.fetcher(), config);
+    cache.get(milliseconds(5000));
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> torn{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                auto cached = cache.current();
+                if (cached->blockhash != filled_hash(static_cast<uint8_t>(cached->slot)) ||
+                    cached->last_valid_block_height != cached->slot + BlockhashCache::VALID_BLOCKHASH_AGE) {
+                    ++torn;
+                }
+            }
+        });
+    }
+    std::this_thread::sleep_for(milliseconds(200));
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(torn.load(), 0u);
+    EXPECT_GT(cache.refresh_count(), 10u);
+}
+
+TEST_F(BlockhashCacheTest, AdapterReusesPrefetchedBlockhash) {
+    Blockhash blockhash = filled_hash(3);
+    std::atomic<int> blockhash_calls{0};
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue&) {
+        EXPECT_EQ(method, "getLatestBlockhash");
+        ++blockhash_calls;
+        return R"({"context":{"slot":321},"value":{"blockhash":")" + blockhash.to_base58() +
+               R"(","lastValidBlockHeight":471}})";
+    });
+    SolanaNetworkAdapter adapter(server.url());
+
+    PublicKey payer = filled_hash(1);
+    TransferRequest request(SVMNetwork::SOLANA, filled_hash(2).to_base58(), "0.25");
+    request.account = payer.to_base58();
+    for (int i = 0; i < 20; ++i) {
+        adapter.create_transfer_transaction(request).get();
+    }
+    // The prefetcher may have refreshed once in the meantime, but not per transaction
+    EXPECT_LE(blockhash_calls.load(), 2);
+    EXPECT_EQ(adapter.blockhash_cache().current()->blockhash, blockhash);
+}
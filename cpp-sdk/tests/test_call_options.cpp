@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/call_options.hpp"
+#include "svm-pay/network/solana.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <thread>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+namespace {
+
+/**
+ * TCP listener that accepts connections into the backlog and never answers,
+ * standing in for a hung RPC node
+ */
+class SilentServer {
+public:
+    SilentServer() {
+        fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(fd_, 16);
+        socklen_t len = sizeof(addr);
+        getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+    }
+
+    ~SilentServer() { close(fd_); }
+
+    std::string url() const { return "http://127.0.0.1:" + std::to_string(port_); }
+
+private:
+    int fd_;
+    uint16_t port_;
+};
+
+EndpointPoolConfig no_retry_config(const std::string& url) {
+    EndpointPoolConfig config;
+    config.urls = {url};
+    config.retry.max_attempts = 1;
+    return config;
+}
+
+} // namespace
+
+class CallOptionsTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(CallOptionsTest, CancellationToken) {
+    CancellationToken never;
+    EXPECT_FALSE(never.can_be_cancelled());
+    EXPECT_FALSE(never.is_cancelled());
+    EXPECT_NO_THROW(never.throw_if_cancelled());
+
+    CancellationSource source;
+    CancellationToken token = source.token();
+    CancellationToken copy = token;
+    EXPECT_TRUE(token.can_be_cancelled());
+    EXPECT_FALSE(copy.is_cancelled());
+
+    source.cancel();
+    EXPECT_TRUE(source.is_cancelled());
+    EXPECT_TRUE(copy.is_cancelled());
+    EXPECT_THROW(token.throw_if_cancelled(), OperationCancelledException);
+}
+
+TEST_F(CallOptionsTest, WaitWakesOnCancel) {
+    CancellationSource source;
+    auto token = source.token();
+
+    std::thread canceller([&source]() {
+        std::this_thread::sleep_for(milliseconds(20));
+        source.cancel();
+    });
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(token.wait_for(std::chrono::seconds(10)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    canceller.join();
+
+    CancellationSource idle;
+    EXPECT_FALSE(idle.token().wait_for(milliseconds(1)));
+}
+
+TEST_F(CallOptionsTest, ResolveDeadline) {
+    auto now = CallOptions::Clock::now();
+
+    CallOptions relative;
+    relative.timeout = milliseconds(100);
+    auto deadline = relative.resolve_deadline();
+    EXPECT_GE(deadline, now + milliseconds(100));
+    EXPECT_LT(deadline, now + milliseconds(1000));
+
+    // The earlier of timeout and deadline wins
+    CallOptions both;
+    both.timeout = std::chrono::seconds(60);
+    both.deadline = now + milliseconds(10);
+    EXPECT_EQ(both.resolve_deadline(), now + milliseconds(10));
+}
+
+TEST_F(CallOptionsTest, DefaultTimeouts) {
+    auto call_timeout = get_default_call_timeout();
+    auto connect_timeout = get_default_connect_timeout();
+
+    set_default_call_timeout(milliseconds(1234));
+    set_default_connect_timeout(milliseconds(321));
+    EXPECT_EQ(get_default_call_timeout(), milliseconds(1234));
+    EXPECT_EQ(get_default_connect_timeout(), milliseconds(321));
+
+    CallOptions options;
+    auto deadline = options.resolve_deadline();
+    EXPECT_LE(deadline, CallOptions::Clock::now() + milliseconds(1234));
+
+    set_default_call_timeout(call_timeout);
+    set_default_connect_timeout(connect_timeout);
+}
+
+TEST_F(CallOptionsTest, HungNodeTimesOut) {
+    SilentServer server;
+    SolanaNetworkAdapter adapter(no_retry_config(server.url()));
+
+    CallOptions options;
+    options.timeout = milliseconds(150);
+    auto start = std::chrono::steady_clock::now();
+    auto status = adapter.check_transaction_status("signature", options);
+    EXPECT_THROW(status.get(), TimeoutException);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST_F(CallOptionsTest, CancellationAbortsTransfer) {
+    SilentServer server;
+    SolanaNetworkAdapter adapter(no_retry_config(server.url()));
+
+    CancellationSource cancel;
+    CallOptions options;
+    options.timeout = std::chrono::seconds(30);
+    options.cancellation = cancel.token();
+
+    auto start = std::chrono::steady_clock::now();
+    auto status = adapter.check_transaction_status("signature", options);
+    std::this_thread::sleep_for(milliseconds(50));
+    cancel.cancel();
+    EXPECT_THROW(status.get(), OperationCancelledException);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+TEST_F(CallOptionsTest, CancelledBeforeStart) {
+    SolanaNetworkAdapter adapter("http://127.0.0.1:1");
+    CancellationSource cancel;
+    cancel.cancel();
+
+    CallOptions options;
+    options.cancellation = cancel.token();
+    TransferRequest request(SVMNetwork::SOLANA, "7v91N7iZ9eyTktBwWC2ckrjdLhvmS4R1HqvYZzG5FGvn", "1");
+    EXPECT_THROW(adapter.create_transfer_transaction(request, options).get(), OperationCancelledException);
+    EXPECT_THROW(adapter.submit_transaction("tx", "sig", options).get(), OperationCancelledException);
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include "svm-pay/client.hpp"
+#include "svm-pay/network/svm_adapter.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <atomic>
+#include <memory>
 
 using namespace svm_pay;
 
@@ -127,7 +131,7 @@ TEST_F(ClientTest, ParseUrl) {
 
 TEST_F(ClientTest, HasSolanaAdapter) {
     // The client should have a Solana adapter registered by default
-    NetworkAdapter* adapter = client->get_adapter(SVMNetwork::SOLANA);
+    auto adapter = client->get_adapter(SVMNetwork::SOLANA);
     EXPECT_NE(adapter, nullptr);
     EXPECT_EQ(adapter->get_network(), SVMNetwork::SOLANA);
 }
@@ -146,6 +150,76 @@ TEST_F(ClientTest, MultipleReferences) {
     EXPECT_NE(url.find("reference=ref3"), std::string::npos);
 }
 
+TEST_F(ClientTest, ClientsShareRegisteredAdapters) {
+    // Constructing a client never replaces an adapter another client is using
+    auto before = client->get_adapter(SVMNetwork::SONIC);
+    ASSERT_NE(before, nullptr);
+    for (int i = 0; i < 100; ++i) {
+        Client other(SVMNetwork::SONIC);
+        EXPECT_EQ(other.get_adapter(SVMNetwork::SONIC), before);
+    }
+    EXPECT_EQ(NetworkAdapterFactory::get_adapter(SVMNetwork::SONIC), before);
+}
+
+TEST_F(ClientTest, ExecutorIsKept) {
+    EXPECT_EQ(client->get_executor(), nullptr);
+    auto executor = std::make_shared<WorkStealingExecutor>(WorkStealingConfig{2, false, {}});
+    Client pooled(SVMNetwork::SOLANA, executor);
+    EXPECT_EQ(pooled.get_executor(), executor);
+    EXPECT_EQ(pooled.get_default_network(), SVMNetwork::SOLANA);
+}
+
+TEST_F(ClientTest, CallsRunOnTheClientExecutor) {
+    class CountingExecutor : public Executor {
+    public:
+        CountingExecutor() : pool_(WorkStealingConfig{1, false, {}}) {}
+        void execute(std::function<void()> task) override {
+            ++tasks;
+            pool_.execute(std::move(task));
+        }
+        std::atomic<int> tasks{0};
+
+    private:
+        WorkStealingExecutor pool_;
+    };
+
+    svm_pay_test::StandInRpcServer server([](const std::string&, const JsonValue&) {
+        return std::string(R"({"context":{"slot":8},"value":[{"slot":8,"confirmations":null,"err":null,"confirmationStatus":"finalized"}]})");
+    });
+    // Registered before any client exists, as initialize_sdk does
+    EndpointPoolConfig endpoints;
+    endpoints.urls.push_back(server.url());
+    auto registered = std::make_shared<SvmNetworkAdapter>(SVMNetwork::ECLIPSE, endpoints, std::make_shared<RpcTransport>());
+    auto shared_executor = std::make_shared<CountingExecutor>();
+    registered->set_executor(shared_executor);
+    NetworkAdapterFactory::register_adapter(SVMNetwork::ECLIPSE, registered);
+
+    auto first_executor = std::make_shared<CountingExecutor>();
+    auto second_executor = std::make_shared<CountingExecutor>();
+    Client first(SVMNetwork::ECLIPSE, first_executor);
+    Client second(SVMNetwork::ECLIPSE, second_executor);
+    Client plain(SVMNetwork::ECLIPSE);
+
+    EXPECT_EQ(first.get_adapter(SVMNetwork::ECLIPSE)->check_transaction_status("sig").get(), PaymentStatus::CONFIRMED);
+    EXPECT_EQ(first_executor->tasks.load(), 1);
+    EXPECT_EQ(second.get_adapter(SVMNetwork::ECLIPSE)->check_transaction_status("sig").get(), PaymentStatus::CONFIRMED);
+    second.get_adapter(SVMNetwork::ECLIPSE)->check_transaction_status("sig").get();
+    EXPECT_EQ(second_executor->tasks.load(), 2);
+    EXPECT_EQ(shared_executor->tasks.load(), 0);
+
+    // A client without one uses the adapter's, and a call's own executor wins over the client's
+    EXPECT_EQ(plain.get_adapter(SVMNetwork::ECLIPSE), registered);
+    plain.get_adapter(SVMNetwork::ECLIPSE)->check_transaction_status("sig").get();
+    EXPECT_EQ(shared_executor->tasks.load(), 1);
+    CallOptions options;
+    options.executor = shared_executor;
+    first.get_adapter(SVMNetwork::ECLIPSE)->check_transaction_status("sig", options).get();
+    EXPECT_EQ(shared_executor->tasks.load(), 2);
+    EXPECT_EQ(first_executor->tasks.load(), 1);
+
+    NetworkAdapterFactory::register_adapter(SVMNetwork::ECLIPSE, std::make_shared<SvmNetworkAdapter>(SVMNetwork::ECLIPSE));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,277 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/confirmation_watcher.hpp"
+#include "svm-pay/network/solana.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <atomic>
+#include <map>
+#include <thread>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+namespace {
+
+/**
+ * In-memory stand-in for getSignatureStatuses
+ */
+class FakeStatusSource {
+public:
+    void set(const std::string& signature, const std::string& commitment,
+             std::optional<std::string> err = std::nullopt) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SignatureStatus status;
+        status.slot = 100;
+        status.confirmation_status = commitment;
+        status.err = std::move(err);
+        statuses_[signature] = status;
+    }
+
+    void set_failing(bool failing) { failing_ = failing; }
+
+    ConfirmationWatcher::StatusFetcher fetcher() {
+        return [this](const std::vector<std::string>& signatures) {
+            ++calls_;
+            max_batch_ = std::max(max_batch_.load(), signatures.size());
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& signature : signatures) {
+                ++lookups_[signature];
+            }
+            if (failing_) {
+                throw NetworkException("node unavailable");
+            }
+            std::vector<std::optional<SignatureStatus>> result;
+            for (const auto& signature : signatures) {
+                auto it = statuses_.find(signature);
+                result.push_back(it == statuses_.end() ? std::nullopt : std::optional<SignatureStatus>(it->second));
+            }
+            return result;
+        };
+    }
+
+    size_t calls() const { return calls_; }
+    size_t max_batch() const { return max_batch_; }
+    size_t lookups(const std::string& signature) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lookups_[signature];
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, SignatureStatus> statuses_;
+    std::map<std::string, size_t> lookups_;
+    std::atomic<bool> failing_{false};
+    std::atomic<size_t> calls_{0};
+    std::atomic<size_t> max_batch_{0};
+};
+
+ConfirmationWatcherConfig fast_config() {
+    ConfirmationWatcherConfig config;
+    config.tick = milliseconds(2);
+    config.slot_time = milliseconds(10);
+    config.max_interval = milliseconds(40);
+    config.expiry = milliseconds(5000);
+    return config;
+}
+
+} // namespace
+
+class ConfirmationWatcherTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(ConfirmationWatcherTest, PollIntervalGrowsWithAge) {
+    ConfirmationWatcherConfig config;
+    config.slot_time = milliseconds(400);
+    config.max_interval = milliseconds(5000);
+
+    EXPECT_EQ(ConfirmationWatcher::poll_interval(milliseconds(0), config), milliseconds(400));
+    EXPECT_EQ(ConfirmationWatcher::poll_interval(milliseconds(8000), config), milliseconds(2000));
+    EXPECT_EQ(ConfirmationWatcher::poll_interval(milliseconds(600000), config), milliseconds(5000));
+
+    milliseconds previous{0};
+    for (int age = 0; age < 60000; age += 500) {
+        auto interval = ConfirmationWatcher::poll_interval(milliseconds(age), config);
+        EXPECT_GE(interval, previous);
+        previous = interval;
+    }
+}
+
+TEST_F(ConfirmationWatcherTest, ConfirmsAndMemoizes) {
+    FakeStatusSource source;
+    ConfirmationWatcher watcher(source.fetcher(), fast_config());
+
+    auto status = watcher.wait("sig-1");
+    std::this_thread::sleep_for(milliseconds(30));
+    EXPECT_EQ(watcher.pending_count(), 1u);
+    source.set("sig-1", "processed");
+    std::this_thread::sleep_for(milliseconds(30));
+    source.set("sig-1", "confirmed");
+
+    ASSERT_EQ(status.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(status.get(), PaymentStatus::CONFIRMED);
+    EXPECT_EQ(watcher.pending_count(), 0u);
+    EXPECT_EQ(watcher.cached_status("sig-1"), PaymentStatus::CONFIRMED);
+
+    // Later watchers are answered from the memo without another lookup
+    size_t lookups = source.lookups("sig-1");
+    bool called = false;
+    watcher.watch("sig-1", [&](const std::string&, PaymentStatus s) {
+        called = s == PaymentStatus::CONFIRMED;
+    });
+    EXPECT_TRUE(called);
+    std::this_thread::sleep_for(milliseconds(30));
+    EXPECT_EQ(source.lookups("sig-1"), lookups);
+}
+
+TEST_F(ConfirmationWatcherTest, FailedTransaction) {
+    FakeStatusSource source;
+    source.set("sig-bad", "confirmed", std::string("{\"InstructionError\":[0,\"InvalidArgument\"]}"));
+    ConfirmationWatcher watcher(source.fetcher(), fast_config());
+
+    auto status = watcher.wait("sig-bad");
+    ASSERT_EQ(status.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(status.get(), PaymentStatus::FAILED);
+}
+
+TEST_F(ConfirmationWatcherTest, FinalizedTarget) {
+    FakeStatusSource source;
+    source.set("sig-f", "confirmed");
+    auto config = fast_config();
+    config.target_commitment = "finalized";
+    ConfirmationWatcher watcher(source.fetcher(), config);
+
+    auto status = watcher.wait("sig-f");
+    EXPECT_EQ(status.wait_for(milliseconds(60)), std::future_status::timeout);
+    source.set("sig-f", "finalized");
+    ASSERT_EQ(status.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(status.get(), PaymentStatus::CONFIRMED);
+}
+
+TEST_F(ConfirmationWatcherTest, UnknownSignatureExpires) {
+    FakeStatusSource source;
+    auto config = fast_config();
+    config.expiry = milliseconds(100);
+    ConfirmationWatcher watcher(source.fetcher(), config);
+
+    auto status = watcher.wait("sig-lost");
+    ASSERT_EQ(status.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(status.get(), PaymentStatus::EXPIRED);
+}
+
+TEST_F(ConfirmationWatcherTest, BatchesDueSignatures) {
+    FakeStatusSource source;
+    auto config = fast_config();
+    config.batch_size = 100;
+    ConfirmationWatcher watcher(source.fetcher(), config);
+
+    const size_t count = 2000;
+    std::atomic<size_t> confirmed{0};
+    for (size_t i = 0; i < count; ++i) {
+        std::string signature = "sig-" + std::to_string(i);
+        source.set(signature, "finalized");
+        watcher.watch(signature, [&](const std::string&, PaymentStatus status) {
+            if (status == PaymentStatus::CONFIRMED) {
+                ++confirmed;
+            }
+        });
+    }
+    for (int i = 0; i < 500 && confirmed.load() < count; ++i) {
+        std::this_thread::sleep_for(milliseconds(10));
+    }
+    EXPECT_EQ(confirmed.load(), count);
+    EXPECT_LE(source.max_batch(), 100u);
+    // Signatures watched within one tick share calls
+    EXPECT_LT(source.calls(), count / 4);
+}
+
+TEST_F(ConfirmationWatcherTest, AdaptiveCadenceBoundsPolls) {
+    FakeStatusSource source;
+    ConfirmationWatcher watcher(source.fetcher(), fast_config());
+
+    watcher.watch("sig-slow", [](const std::string&, PaymentStatus) {});
+    std::this_thread::sleep_for(milliseconds(500));
+    // Polling every slot would take ~50 lookups; the stretched cadence needs far fewer
+    size_t lookups = source.lookups("sig-slow");
+    EXPECT_GE(lookups, 5u);
+    EXPECT_LE(lookups, 25u);
+}
+
+TEST_F(ConfirmationWatcherTest, FetchFailuresAreRetried) {
+    FakeStatusSource source;
+    source.set("sig-r", "confirmed");
+    source.set_failing(true);
+    ConfirmationWatcher watcher(source.fetcher(), fast_config());
+
+    auto status = watcher.wait("sig-r");
+    EXPECT_EQ(status.wait_for(milliseconds(50)), std::future_status::timeout);
+    source.set_failing(false);
+    ASSERT_EQ(status.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(status.get(), PaymentStatus::CONFIRMED);
+}
+
+TEST_F(ConfirmationWatcherTest, BoundedCallbacksAndMemo) {
+    FakeStatusSource source;
+    auto config = fast_config();
+    config.max_callbacks_per_signature = 2;
+    config.memo_capacity = 3;
+    ConfirmationWatcher watcher(source.fetcher(), config);
+
+    watcher.watch("sig-x", [](const std::string&, PaymentStatus) {});
+    watcher.watch("sig-x", [](const std::string&, PaymentStatus) {});
+    EXPECT_THROW(watcher.watch("sig-x", [](const std::string&, PaymentStatus) {}), BackpressureException);
+
+    std::vector<std::future<PaymentStatus>> statuses;
+    for (int i = 0; i < 5; ++i) {
+        std::string signature = "memo-" + std::to_string(i);
+        source.set(signature, "confirmed");
+        statuses.push_back(watcher.wait(signature));
+        ASSERT_EQ(statuses.back().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    }
+    EXPECT_FALSE(watcher.cached_status("memo-0").has_value());
+    EXPECT_FALSE(watcher.cached_status("memo-1").has_value());
+    EXPECT_EQ(watcher.cached_status("memo-4"), PaymentStatus::CONFIRMED);
+}
+
+TEST_F(ConfirmationWatcherTest, AdapterParsesSignatureStatuses) {
+    svm_pay_test::StandInRpcServer server([](const std::string& method, const JsonValue& params) {
+        EXPECT_EQ(method, "getSignatureStatuses");
+        std::string value = "[";
+        for (size_t i = 0; i < params[0].size(); ++i) {
+            const std::string& signature = params[0][i].as_string();
+            value += i > 0 ? "," : "";
+            if (signature == "unknown") {
+                value += "null";
+            } else if (signature == "failed") {
+                value += R"({"slot":7,"confirmations":3,"err":{"InstructionError":[0,"InvalidArgument"]},"confirmationStatus":"confirmed"})";
+            } else {
+                value += R"({"slot":9,"confirmations":null,"err":null,"confirmationStatus":"finalized"})";
+            }
+        }
+        return R"({"context":{"slot":10},"value":)" + value + "]}";
+    });
+    SolanaNetworkAdapter adapter(server.url());
+
+    // More than one node-side batch is split and reassembled in order
+    std::vector<std::string> signatures(300, "final");
+    signatures[0] = "unknown";
+    signatures[299] = "failed";
+    auto statuses = adapter.get_signature_statuses(signatures).get();
+    ASSERT_EQ(statuses.size(), 300u);
+    EXPECT_FALSE(statuses[0].has_value());
+    EXPECT_EQ(statuses[1]->confirmation_status, "finalized");
+    EXPECT_FALSE(statuses[1]->confirmations.has_value());
+    EXPECT_EQ(statuses[299]->slot, 7u);
+    EXPECT_EQ(statuses[299]->confirmations, 3u);
+    EXPECT_EQ(statuses[299]->err.value_or(""), R"({"InstructionError":[0,"InvalidArgument"]})");
+    EXPECT_EQ(server.request_count(), 2u);
+
+    EXPECT_EQ(adapter.check_transaction_status("final").get(), PaymentStatus::CONFIRMED);
+    EXPECT_EQ(adapter.check_transaction_status("failed").get(), PaymentStatus::FAILED);
+    EXPECT_EQ(adapter.check_transaction_status("unknown").get(), PaymentStatus::PENDING);
+
+    ConfirmationWatcher watcher(adapter, fast_config());
+    EXPECT_EQ(watcher.wait("final").get(), PaymentStatus::CONFIRMED);
+}
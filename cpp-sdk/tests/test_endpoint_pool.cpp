@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/endpoint_pool.hpp"
+#include "svm-pay/network/solana.hpp"
+
+using namespace svm_pay;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+class EndpointPoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config.urls = {"https://fast.example.com", "https://slow.example.com"};
+    }
+    void TearDown() override {}
+
+    EndpointPoolConfig config;
+};
+
+TEST_F(EndpointPoolTest, RequiresAtLeastOneUrl) {
+    EXPECT_THROW(EndpointPool(EndpointPoolConfig{}), std::invalid_argument);
+}
+
+TEST_F(EndpointPoolTest, LatencyAndErrorAverages) {
+    Endpoint endpoint("https://rpc.example.com", 0.5);
+    EXPECT_EQ(endpoint.latency_ewma_us(), 0.0);
+
+    endpoint.on_request_start();
+    EXPECT_EQ(endpoint.in_flight(), 1u);
+    endpoint.record_success(microseconds(1000));
+    EXPECT_EQ(endpoint.in_flight(), 0u);
+    EXPECT_DOUBLE_EQ(endpoint.latency_ewma_us(), 1000.0);
+    EXPECT_DOUBLE_EQ(endpoint.error_rate(), 0.0);
+
+    endpoint.record_failure(microseconds(3000));
+    EXPECT_DOUBLE_EQ(endpoint.latency_ewma_us(), 2000.0);
+    EXPECT_DOUBLE_EQ(endpoint.error_rate(), 0.5);
+}
+
+TEST_F(EndpointPoolTest, LatencyQuantile) {
+    Endpoint endpoint("https://rpc.example.com");
+    EXPECT_EQ(endpoint.latency_quantile(0.95).count(), 0);
+
+    for (int i = 0; i < 95; ++i) {
+        endpoint.record_success(microseconds(1000));
+    }
+    for (int i = 0; i < 5; ++i) {
+        endpoint.record_success(microseconds(100000));
+    }
+
+    // Bucket bounds are within 25% of the recorded latency
+    auto p50 = endpoint.latency_quantile(0.5).count();
+    auto p99 = endpoint.latency_quantile(0.99).count();
+    EXPECT_GE(p50, 1000);
+    EXPECT_LE(p50, 1250);
+    EXPECT_GE(p99, 100000);
+    EXPECT_LE(p99, 125000);
+}
+
+TEST_F(EndpointPoolTest, PrefersFasterEndpoint) {
+    EndpointPool pool(config);
+    auto snapshot = pool.snapshot();
+    snapshot->endpoints[0]->record_success(microseconds(1000));
+    snapshot->endpoints[1]->record_success(microseconds(50000));
+
+    // With two endpoints both are always candidates, so the cheaper one wins
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(EndpointPool::pick(*snapshot)->url(), "https://fast.example.com");
+    }
+    EXPECT_EQ(EndpointPool::pick(*snapshot, snapshot->endpoints[0].get())->url(), "https://slow.example.com");
+}
+
+TEST_F(EndpointPoolTest, ErrorsRaiseCost) {
+    EndpointPool pool(config);
+    auto snapshot = pool.snapshot();
+    snapshot->endpoints[0]->record_success(microseconds(1000));
+    snapshot->endpoints[1]->record_success(microseconds(2000));
+    for (int i = 0; i < 10; ++i) {
+        snapshot->endpoints[0]->record_failure(microseconds(1000));
+    }
+
+    EXPECT_EQ(EndpointPool::pick(*snapshot)->url(), "https://slow.example.com");
+}
+
+TEST_F(EndpointPoolTest, ReconfigureKeepsStatistics) {
+    EndpointPool pool(config);
+    auto before = pool.snapshot();
+    before->endpoints[0]->record_success(microseconds(1234));
+
+    EndpointPoolConfig next = config;
+    next.urls = {"https://fast.example.com", "https://third.example.com"};
+    pool.configure(next);
+
+    auto after = pool.snapshot();
+    ASSERT_EQ(after->endpoints.size(), 2u);
+    EXPECT_EQ(after->endpoints[0], before->endpoints[0]);
+    EXPECT_DOUBLE_EQ(after->endpoints[0]->latency_ewma_us(), 1234.0);
+    EXPECT_EQ(after->endpoints[1]->url(), "https://third.example.com");
+
+    // The old snapshot stays intact for requests still using it
+    EXPECT_EQ(before->endpoints[1]->url(), "https://slow.example.com");
+}
+
+TEST_F(EndpointPoolTest, HedgeDelay) {
+    config.min_hedge_delay = milliseconds(5);
+    config.max_hedge_delay = milliseconds(500);
+    EndpointPool pool(config);
+    auto snapshot = pool.snapshot();
+    auto& endpoint = *snapshot->endpoints[0];
+
+    // Without enough samples the maximum delay is used
+    EXPECT_EQ(EndpointPool::hedge_delay(*snapshot, endpoint), microseconds(500000));
+
+    for (int i = 0; i < 100; ++i) {
+        endpoint.record_success(microseconds(20000));
+    }
+    auto delay = EndpointPool::hedge_delay(*snapshot, endpoint).count();
+    EXPECT_GE(delay, 20000);
+    EXPECT_LE(delay, 25000);
+
+    // Very fast endpoints are clamped to the minimum delay
+    auto& fast = *snapshot->endpoints[1];
+    for (int i = 0; i < 100; ++i) {
+        fast.record_success(microseconds(10));
+    }
+    EXPECT_EQ(EndpointPool::hedge_delay(*snapshot, fast), microseconds(5000));
+}
+
+TEST_F(EndpointPoolTest, AdapterRpcUrl) {
+    SolanaNetworkAdapter adapter(config);
+    EXPECT_EQ(adapter.get_rpc_url(), "https://fast.example.com");
+
+    adapter.set_rpc_url("https://api.devnet.solana.com");
+    EXPECT_EQ(adapter.get_rpc_url(), "https://api.devnet.solana.com");
+    EXPECT_EQ(adapter.get_endpoint_pool().snapshot()->endpoints.size(), 1u);
+}
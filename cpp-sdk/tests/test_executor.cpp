@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "svm-pay/core/executor.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace svm_pay;
+
+class ExecutorTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(ExecutorTest, RunsEveryTaskBeforeDestruction) {
+    std::atomic<int> ran{0};
+    {
+        WorkStealingConfig config;
+        config.threads = 3;
+        WorkStealingExecutor executor(config);
+        EXPECT_EQ(executor.thread_count(), 3u);
+        for (int i = 0; i < 10000; ++i) {
+            executor.execute([&ran]() { ++ran; });
+        }
+    }
+    EXPECT_EQ(ran.load(), 10000);
+
+    WorkStealingExecutor sized;
+    EXPECT_GE(sized.thread_count(), 4u);
+}
+
+TEST_F(ExecutorTest, IdleWorkersStealQueuedWork) {
+    WorkStealingConfig config;
+    config.threads = 4;
+    WorkStealingExecutor executor(config);
+    std::mutex mutex;
+    std::set<std::thread::id> workers;
+    std::atomic<int> remaining{64};
+
+    // Everything lands on the spawning worker's own deque; the others must steal it
+    executor.execute([&]() {
+        for (int i = 0; i < 64; ++i) {
+            executor.execute([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                std::lock_guard<std::mutex> lock(mutex);
+                workers.insert(std::this_thread::get_id());
+                --remaining;
+            });
+        }
+    });
+    while (remaining > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GT(workers.size(), 1u);
+}
+
+TEST_F(ExecutorTest, SubmitDeliversResultsAndExceptions) {
+    WorkStealingExecutor executor;
+    auto sum = submit(executor, []() { return 40 + 2; });
+    auto failure = submit(executor, []() -> int { throw std::runtime_error("boom"); });
+    EXPECT_EQ(sum.get(), 42);
+    EXPECT_THROW(failure.get(), std::runtime_error);
+
+    // A throwing task does not take its worker down
+    executor.execute([]() { throw std::runtime_error("dropped"); });
+    EXPECT_EQ(submit(executor, []() { return 7; }).get(), 7);
+}
+
+TEST_F(ExecutorTest, ParallelForRunsEveryIndexOnce) {
+    WorkStealingExecutor executor(WorkStealingConfig{1, false, {}});
+    std::vector<std::atomic<int>> runs(64);
+    parallel_for(executor, runs.size(), [&](size_t index) { ++runs[index]; });
+    for (const auto& count : runs) {
+        EXPECT_EQ(count.load(), 1);
+    }
+
+    // From the pool's only worker, the caller takes what is still queued
+    auto nested = submit(executor, [&executor]() {
+        std::atomic<int> total{0};
+        parallel_for(executor, 8, [&total](size_t) { ++total; });
+        return total.load();
+    });
+    EXPECT_EQ(nested.get(), 8);
+
+    // Every index runs before the first failure is rethrown
+    std::atomic<int> ran{0};
+    EXPECT_THROW(parallel_for(executor, 4, [&ran](size_t index) {
+        ++ran;
+        if (index == 0) {
+            throw std::runtime_error("boom");
+        }
+    }), std::runtime_error);
+    EXPECT_EQ(ran.load(), 4);
+}
+
+#ifdef __linux__
+TEST_F(ExecutorTest, PinsWorkersToConfiguredCpus) {
+    WorkStealingConfig config;
+    config.threads = 2;
+    config.pin_threads = true;
+    config.cpus = {0};
+    WorkStealingExecutor executor(config);
+    for (int i = 0; i < 4; ++i) {
+        auto affinity = submit(executor, []() {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+            return std::make_pair(CPU_COUNT(&set), CPU_ISSET(0, &set) != 0);
+        }).get();
+        EXPECT_EQ(affinity.first, 1);
+        EXPECT_TRUE(affinity.second);
+    }
+}
+#endif
+
+TEST_F(ExecutorTest, DefaultExecutorCanBeReplaced) {
+    std::shared_ptr<Executor> built_in = default_executor();
+    ASSERT_NE(built_in, nullptr);
+    EXPECT_EQ(default_executor(), built_in);
+
+    auto custom = std::make_shared<WorkStealingExecutor>();
+    set_default_executor(custom);
+    EXPECT_EQ(default_executor(), custom);
+
+    set_default_executor(nullptr);
+    EXPECT_NE(default_executor(), custom);
+    EXPECT_NE(default_executor(), nullptr);
+}
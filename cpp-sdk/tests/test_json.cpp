@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "svm-pay/core/json.hpp"
+#include "svm-pay/core/exceptions.hpp"
+
+using namespace svm_pay;
+
+class JsonTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(JsonTest, ParseRpcResponse) {
+    auto response = JsonValue::parse(
+        R"({"jsonrpc":"2.0","result":{"context":{"slot":341197053},"value":[{"slot":341197000,)"
+        R"("confirmations":null,"err":null,"confirmationStatus":"finalized"},null]},"id":7})");
+
+    EXPECT_EQ(response["id"].as_int64(), 7);
+    const JsonValue& value = response["result"]["value"];
+    ASSERT_TRUE(value.is_array());
+    EXPECT_EQ(value.size(), 2u);
+    EXPECT_EQ(value[0]["confirmationStatus"].as_string(), "finalized");
+    EXPECT_TRUE(value[0]["err"].is_null());
+    EXPECT_TRUE(value[1].is_null());
+    EXPECT_EQ(response["result"]["context"]["slot"].as_uint64(), 341197053u);
+
+    // Missing members and out-of-range indices read as null
+    EXPECT_TRUE(response["missing"]["deeper"].is_null());
+    EXPECT_TRUE(value[5].is_null());
+    EXPECT_EQ(response.find("missing"), nullptr);
+}
+
+TEST_F(JsonTest, LargeIntegersKeepPrecision) {
+    auto value = JsonValue::parse(R"({"lamports":18446744073709551615,"delta":-9007199254740993})");
+    EXPECT_EQ(value["lamports"].as_uint64(), 18446744073709551615ull);
+    EXPECT_EQ(value["delta"].as_int64(), -9007199254740993ll);
+    EXPECT_THROW(value["delta"].as_uint64(), JsonParseException);
+    EXPECT_DOUBLE_EQ(JsonValue::parse("1.5e3").as_double(), 1500.0);
+    EXPECT_THROW(JsonValue::parse("1.5").as_int64(), JsonParseException);
+}
+
+TEST_F(JsonTest, StringsAndEscapes) {
+    auto value = JsonValue::parse(R"(["a\"b\\c\n", "é😀", true, false])");
+    EXPECT_EQ(value[0].as_string(), "a\"b\\c\n");
+    EXPECT_EQ(value[1].as_string(), "\xC3\xA9\xF0\x9F\x98\x80");
+    EXPECT_TRUE(value[2].as_bool());
+    EXPECT_FALSE(value[3].as_bool());
+
+    EXPECT_EQ(json_escape("say \"hi\"\n\x01"), "say \\\"hi\\\"\\n\\u0001");
+}
+
+TEST_F(JsonTest, DumpRoundTrips) {
+    std::string text = R"({"InstructionError":[0,{"Custom":1}],"ok":true,"name":"a\"b"})";
+    EXPECT_EQ(JsonValue::parse(text).dump(), text);
+}
+
+TEST_F(JsonTest, RejectsMalformedInput) {
+    EXPECT_THROW(JsonValue::parse(""), JsonParseException);
+    EXPECT_THROW(JsonValue::parse("{\"a\":1"), JsonParseException);
+    EXPECT_THROW(JsonValue::parse("[1,]"), JsonParseException);
+    EXPECT_THROW(JsonValue::parse("{} extra"), JsonParseException);
+    EXPECT_THROW(JsonValue::parse("\"unterminated"), JsonParseException);
+    EXPECT_THROW(JsonValue::parse("01x"), JsonParseException);
+    EXPECT_THROW(JsonValue::parse(std::string(1000, '[')), JsonParseException);
+    EXPECT_THROW(JsonValue::parse("\"x\"").as_array(), JsonParseException);
+}
@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/mint_cache.hpp"
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/transaction.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+namespace {
+
+PublicKey filled_key(uint8_t byte) {
+    std::array<uint8_t, PublicKey::SIZE> bytes;
+    bytes.fill(byte);
+    return PublicKey(bytes);
+}
+
+AccountInfo mint_account(uint8_t decimals, const PublicKey& program = token_program_id(), size_t size = 82) {
+    AccountInfo account;
+    account.owner = program;
+    account.data.assign(size, 0);
+    account.data[44] = decimals;
+    account.data[45] = 1;  // Initialized
+    return account;
+}
+
+/**
+ * Node holding a set of mints and counting the keys it is asked for
+ */
+class MintNode {
+public:
+    MintNode()
+        : server_([this](const std::string& method, const JsonValue& params) -> std::string {
+              if (method != "getMultipleAccounts") {
+                  throw std::runtime_error("unexpected method " + method);
+              }
+              std::lock_guard<std::mutex> lock(mutex_);
+              ++calls_;
+              std::string result = R"({"context":{"slot":9},"value":[)";
+              bool first = true;
+              for (const auto& key : params.as_array().at(0).as_array()) {
+                  ++keys_;
+                  result += first ? "" : ",";
+                  first = false;
+                  auto it = accounts_.find(key.as_string());
+                  if (it == accounts_.end()) {
+                      result += "null";
+                      continue;
+                  }
+                  const AccountInfo& account = it->second;
+                  result += R"({"data":[")" + base64_encode(account.data.data(), account.data.size()) +
+                            R"(","base64"],"executable":false,"lamports":1461600,"owner":")" +
+                            account.owner.to_base58() + R"(","rentEpoch":0,"space":82})";
+              }
+              return result + "]}";
+          }) {
+        EndpointPoolConfig config;
+        config.urls.push_back(server_.url());
+        config.retry.max_attempts = 1;
+        adapter_ = std::make_unique<SvmNetworkAdapter>(SVMNetwork::SOLANA, config, std::make_shared<RpcTransport>());
+    }
+
+    SvmNetworkAdapter& adapter() { return *adapter_; }
+
+    void set(const PublicKey& key, const AccountInfo& account) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        accounts_[key.to_base58()] = account;
+    }
+
+    int calls() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_;
+    }
+
+    int keys() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return keys_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, AccountInfo> accounts_;
+    int calls_ = 0;
+    int keys_ = 0;
+    svm_pay_test::StandInRpcServer server_;
+    std::unique_ptr<SvmNetworkAdapter> adapter_;
+};
+
+std::string temp_path(const std::string& name) {
+    std::string path = ::testing::TempDir() + name;
+    std::remove(path.c_str());
+    return path;
+}
+
+std::string file_contents(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+} // namespace
+
+class MintCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(MintCacheTest, DecodesTokenAndToken2022Mints) {
+    MintInfo info = decode_mint(filled_key(1), mint_account(6));
+    EXPECT_EQ(info.mint, filled_key(1));
+    EXPECT_EQ(info.program, token_program_id());
+    EXPECT_EQ(info.decimals, 6);
+
+    AccountInfo extended = mint_account(9, token_2022_program_id(), 234);
+    extended.data[165] = 1;  // Mint account type
+    EXPECT_EQ(decode_mint(filled_key(1), extended).program, token_2022_program_id());
+    EXPECT_EQ(decode_mint(filled_key(1), extended).decimals, 9);
+
+    // A Token-2022 token account is not a mint
+    AccountInfo token_account = mint_account(9, token_2022_program_id(), 170);
+    token_account.data[165] = 2;
+    EXPECT_THROW(decode_mint(filled_key(1), token_account), TransactionException);
+
+    AccountInfo uninitialized = mint_account(6);
+    uninitialized.data[45] = 0;
+    EXPECT_THROW(decode_mint(filled_key(1), uninitialized), TransactionException);
+    EXPECT_THROW(decode_mint(filled_key(1), mint_account(6, system_program_id())), TransactionException);
+}
+
+TEST_F(MintCacheTest, LoadsMissesTogetherAndAnswersHitsFromMemory) {
+    MintNode node;
+    node.set(filled_key(1), mint_account(6));
+    node.set(filled_key(2), mint_account(9, token_2022_program_id()));
+    MintCacheConfig config;
+    config.loader.window = milliseconds(50);
+    MintCache cache(node.adapter(), config);
+
+    EXPECT_FALSE(cache.find(filled_key(1)).has_value());
+    auto first = cache.get(filled_key(1));
+    auto again = cache.get(filled_key(1));
+    auto second = cache.get(filled_key(2));
+    auto missing = cache.get(filled_key(3));
+    EXPECT_EQ(first.get().decimals, 6);
+    EXPECT_EQ(again.get().decimals, 6);
+    EXPECT_EQ(second.get().program, token_2022_program_id());
+    EXPECT_THROW(missing.get(), TransactionException);
+    EXPECT_EQ(node.calls(), 1);
+    EXPECT_EQ(node.keys(), 3);
+
+    auto hit = cache.find(filled_key(2));
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->decimals, 9);
+    EXPECT_EQ(hit->program, token_2022_program_id());
+    EXPECT_EQ(cache.get(filled_key(1)).get().decimals, 6);
+    EXPECT_EQ(node.calls(), 1);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.load_count(), 3u);
+}
+
+TEST_F(MintCacheTest, SurvivesRestartWithoutLoading) {
+    MintNode node;
+    MintCacheConfig config;
+    config.path = temp_path("svm_pay_mint_cache_restart.bin");
+    config.loader.window = milliseconds(10);
+    for (uint8_t byte = 1; byte <= 20; ++byte) {
+        node.set(filled_key(byte), mint_account(byte % 10));
+    }
+    {
+        MintCache cache(node.adapter(), config);
+        for (uint8_t byte = 1; byte <= 20; ++byte) {
+            cache.get(filled_key(byte)).get();
+        }
+    }
+    int calls = node.calls();
+    std::string before = file_contents(config.path);
+
+    MintCache restarted(node.adapter(), config);
+    // Startup reads the records where they are rather than rewriting them
+    EXPECT_EQ(file_contents(config.path), before);
+    EXPECT_EQ(restarted.size(), 20u);
+    for (uint8_t byte = 1; byte <= 20; ++byte) {
+        auto info = restarted.find(filled_key(byte));
+        ASSERT_TRUE(info.has_value());
+        EXPECT_EQ(info->decimals, byte % 10);
+        EXPECT_EQ(info->program, token_program_id());
+    }
+    std::this_thread::sleep_for(milliseconds(50));
+    EXPECT_EQ(node.calls(), calls);
+
+    // A smaller capacity keeps the first records, and a new mint evicts one
+    config.capacity = 5;
+    {
+        MintCache smaller(node.adapter(), config);
+        EXPECT_EQ(smaller.size(), 5u);
+        EXPECT_TRUE(smaller.find(filled_key(5)).has_value());
+        EXPECT_FALSE(smaller.find(filled_key(6)).has_value());
+        EXPECT_EQ(smaller.get(filled_key(6)).get().decimals, 6);
+        EXPECT_TRUE(smaller.find(filled_key(6)).has_value());
+        EXPECT_EQ(smaller.size(), 5u);
+        EXPECT_EQ(smaller.eviction_count(), 1u);
+    }
+
+    std::string foreign = temp_path("svm_pay_mint_cache_foreign.bin");
+    std::ofstream(foreign) << "not a cache";
+    config.path = foreign;
+    EXPECT_THROW(MintCache(node.adapter(), config), SVMPayException);
+}
+
+TEST_F(MintCacheTest, EvictsTheOldestMintWhenFull) {
+    MintNode node;
+    MintCacheConfig config;
+    config.path = temp_path("svm_pay_mint_cache_evict.bin");
+    config.capacity = 3;
+    {
+        MintCache cache(node.adapter(), config);
+        for (uint8_t byte = 1; byte <= 10; ++byte) {
+            cache.put(decode_mint(filled_key(byte), mint_account(byte)));
+        }
+        EXPECT_EQ(cache.size(), 3u);
+        EXPECT_EQ(cache.eviction_count(), 7u);
+        for (uint8_t byte = 1; byte <= 7; ++byte) {
+            EXPECT_FALSE(cache.find(filled_key(byte)).has_value());
+        }
+        for (uint8_t byte = 8; byte <= 10; ++byte) {
+            EXPECT_EQ(cache.find(filled_key(byte))->decimals, byte);
+        }
+    }
+
+    // The evicted mints' records were reused, so the file holds the survivors
+    MintCache restarted(node.adapter(), config);
+    EXPECT_EQ(restarted.size(), 3u);
+    for (uint8_t byte = 8; byte <= 10; ++byte) {
+        EXPECT_EQ(restarted.find(filled_key(byte))->decimals, byte);
+    }
+    EXPECT_EQ(node.calls(), 0);
+}
+
+TEST_F(MintCacheTest, EvictionKeepsCollidingMintsReachable) {
+    MintNode node;
+    MintCacheConfig config;
+    config.capacity = 16;
+    MintCache cache(node.adapter(), config);
+    // Enough churn through a small table that probe runs wrap and overlap
+    for (int byte = 0; byte < 200; ++byte) {
+        cache.put(decode_mint(filled_key(static_cast<uint8_t>(byte)), mint_account(static_cast<uint8_t>(byte % 10))));
+        EXPECT_EQ(cache.find(filled_key(static_cast<uint8_t>(byte)))->decimals, byte % 10);
+    }
+    EXPECT_EQ(cache.size(), 16u);
+    for (int byte = 184; byte < 200; ++byte) {
+        ASSERT_TRUE(cache.find(filled_key(static_cast<uint8_t>(byte))).has_value()) << byte;
+    }
+    for (int byte = 0; byte < 184; ++byte) {
+        EXPECT_FALSE(cache.find(filled_key(static_cast<uint8_t>(byte))).has_value()) << byte;
+    }
+}
+
+TEST_F(MintCacheTest, RefreshesInTheBackground) {
+    MintNode node;
+    node.set(filled_key(1), mint_account(6));
+    MintCache cache(node.adapter());
+    EXPECT_EQ(cache.get(filled_key(1)).get().decimals, 6);
+
+    cache.put(decode_mint(filled_key(2), mint_account(2)));
+    node.set(filled_key(1), mint_account(8));
+    cache.refresh();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (cache.find(filled_key(1))->decimals != 8 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    EXPECT_EQ(cache.find(filled_key(1))->decimals, 8);
+    // Mints the node no longer has keep their last known state
+    EXPECT_EQ(cache.find(filled_key(2))->decimals, 2);
+}
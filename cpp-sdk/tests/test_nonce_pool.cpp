@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/nonce_pool.hpp"
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace svm_pay;
+
+namespace {
+
+PublicKey filled_key(uint8_t byte) {
+    std::array<uint8_t, PublicKey::SIZE> bytes;
+    bytes.fill(byte);
+    return PublicKey(bytes);
+}
+
+// getAccountInfo result for an initialized nonce account
+std::string nonce_account_info(const PublicKey& authority, const Blockhash& nonce, uint64_t lamports_per_signature) {
+    std::vector<uint8_t> data(NONCE_ACCOUNT_SIZE, 0);
+    data[0] = 1;  // Current version
+    data[4] = 1;  // Initialized
+    std::copy(authority.bytes().begin(), authority.bytes().end(), data.begin() + 8);
+    std::copy(nonce.bytes().begin(), nonce.bytes().end(), data.begin() + 40);
+    for (size_t i = 0; i < 8; ++i) {
+        data[72 + i] = static_cast<uint8_t>(lamports_per_signature >> (8 * i));
+    }
+    return R"({"context":{"slot":5},"value":{"data":[")" + base64_encode(data.data(), data.size()) +
+           R"(","base64"],"executable":false,"lamports":1447680,"owner":"11111111111111111111111111111111","rentEpoch":0,"space":80}})";
+}
+
+std::unique_ptr<SvmNetworkAdapter> adapter_for(const svm_pay_test::StandInRpcServer& server) {
+    EndpointPoolConfig config;
+    config.urls.push_back(server.url());
+    config.retry.max_attempts = 1;
+    return std::make_unique<SvmNetworkAdapter>(SVMNetwork::SOLANA, config, std::make_shared<RpcTransport>());
+}
+
+NoncePoolConfig fast() {
+    NoncePoolConfig config;
+    config.refresh_interval = std::chrono::milliseconds(10);
+    config.max_refresh_interval = std::chrono::milliseconds(40);
+    return config;
+}
+
+} // namespace
+
+class NoncePoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(NoncePoolTest, ReadsNonceAccounts) {
+    PublicKey authority = filled_key(7);
+    Blockhash nonce = filled_key(8);
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue& params) -> std::string {
+        if (method == "getMinimumBalanceForRentExemption") {
+            return params.as_array().at(0).as_uint64() == NONCE_ACCOUNT_SIZE ? "1447680" : "0";
+        }
+        if (params.as_array().at(0).as_string() == filled_key(1).to_base58()) {
+            return nonce_account_info(authority, nonce, 5000);
+        }
+        if (params.as_array().at(0).as_string() == filled_key(2).to_base58()) {
+            return R"({"context":{"slot":5},"value":null})";
+        }
+        return R"({"context":{"slot":5},"value":{"data":["AAAA","base64"],"executable":false,"lamports":1,"owner":"11111111111111111111111111111111","rentEpoch":0,"space":3}})";
+    });
+    auto adapter = adapter_for(server);
+
+    NonceAccount account = adapter->get_nonce_account(filled_key(1)).get();
+    EXPECT_EQ(account.address, filled_key(1));
+    EXPECT_EQ(account.authority, authority);
+    EXPECT_EQ(account.nonce, nonce);
+    EXPECT_EQ(account.lamports_per_signature, 5000u);
+    EXPECT_THROW(adapter->get_nonce_account(filled_key(2)).get(), TransactionException);
+    EXPECT_THROW(adapter->get_nonce_account(filled_key(3)).get(), TransactionException);
+    EXPECT_EQ(adapter->get_minimum_balance_for_rent_exemption(NONCE_ACCOUNT_SIZE).get(), 1447680u);
+}
+
+TEST_F(NoncePoolTest, BuildsSignedNonceTransactions) {
+    Keypair payer = Keypair::generate();
+    Keypair nonce_account = Keypair::generate();
+    std::string create = create_nonce_account_transaction(payer, nonce_account, payer.public_key(), 1447680, filled_key(3));
+    std::vector<uint8_t> wire = base64_decode(create);
+    EXPECT_EQ(wire[0], 2);  // Payer and the new account both sign
+    EXPECT_TRUE(verify_transaction(wire.data(), wire.size()));
+
+    NonceAccount account;
+    account.address = nonce_account.public_key();
+    account.authority = payer.public_key();
+    account.nonce = filled_key(4);
+    wire = base64_decode(advance_nonce_transaction(payer, account));
+    EXPECT_EQ(wire[0], 1);
+    EXPECT_TRUE(verify_transaction(wire.data(), wire.size()));
+}
+
+TEST_F(NoncePoolTest, LeasesAndRefreshesUsedNonces) {
+    PublicKey authority = filled_key(7);
+    std::atomic<uint8_t> nonce_byte{10};
+    std::atomic<int> reads{0};
+    svm_pay_test::StandInRpcServer server([&](const std::string&, const JsonValue&) -> std::string {
+        ++reads;
+        return nonce_account_info(authority, filled_key(nonce_byte), 5000);
+    });
+    auto adapter = adapter_for(server);
+    NoncePool pool(*adapter, {filled_key(1), filled_key(2)}, fast());
+    EXPECT_EQ(pool.size(), 2u);
+
+    NonceLease first = pool.acquire(std::chrono::milliseconds(5000));
+    NonceLease second = pool.acquire(std::chrono::milliseconds(5000));
+    EXPECT_NE(first.account().address, second.account().address);
+    EXPECT_EQ(first.account().nonce, filled_key(10));
+    EXPECT_FALSE(pool.try_acquire().has_value());
+
+    TransactionBuilder builder;
+    builder.set_fee_payer(authority).add_system_transfer(authority, filled_key(5), 1);
+    first.apply(builder);
+    EXPECT_EQ(builder.account_keys().size(), 5u);
+
+    // An unused lease goes straight back
+    PublicKey unused = second.account().address;
+    second.release();
+    EXPECT_EQ(pool.available(), 1u);
+    auto again = pool.try_acquire();
+    ASSERT_TRUE(again.has_value());
+    EXPECT_EQ(again->account().address, unused);
+    again->release();
+
+    // A used one comes back only once the nonce has moved on
+    PublicKey used = first.account().address;
+    first.mark_used();
+    first.release();
+    EXPECT_EQ(pool.available(), 1u);
+    while (reads < 5) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(pool.available(), 1u);
+    nonce_byte = 11;
+    NonceLease a = pool.acquire(std::chrono::milliseconds(5000));
+    NonceLease b = pool.acquire(std::chrono::milliseconds(5000));
+    NonceLease& refreshed = a.account().address == used ? a : b;
+    EXPECT_EQ(refreshed.account().nonce, filled_key(11));
+}
+
+TEST_F(NoncePoolTest, AcquireTimesOut) {
+    svm_pay_test::StandInRpcServer server([&](const std::string&, const JsonValue&) -> std::string {
+        throw std::runtime_error("node is behind");
+    });
+    auto adapter = adapter_for(server);
+    NoncePool pool(*adapter, {filled_key(1)}, fast());
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_THROW(pool.acquire(std::chrono::milliseconds(50)), TimeoutException);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+    EXPECT_EQ(pool.available(), 0u);
+    EXPECT_EQ(pool.dropped(), 0u);
+}
+
+TEST_F(NoncePoolTest, DroppedTransactionsFreeTheirNonce) {
+    // The nonce never advances, as if the transaction built on it was dropped
+    svm_pay_test::StandInRpcServer server([&](const std::string&, const JsonValue&) -> std::string {
+        return nonce_account_info(filled_key(7), filled_key(10), 5000);
+    });
+    auto adapter = adapter_for(server);
+    NoncePoolConfig config = fast();
+    config.used_nonce_timeout = std::chrono::milliseconds(100);
+    NoncePool pool(*adapter, {filled_key(1)}, config);
+
+    NonceLease lease = pool.acquire(std::chrono::milliseconds(5000));
+    lease.mark_used();
+    lease.release();
+    auto released = std::chrono::steady_clock::now();
+    EXPECT_FALSE(pool.try_acquire().has_value());
+
+    NonceLease again = pool.acquire(std::chrono::milliseconds(5000));
+    EXPECT_GE(std::chrono::steady_clock::now() - released, std::chrono::milliseconds(100));
+    EXPECT_EQ(again.account().address, filled_key(1));
+    EXPECT_EQ(again.account().nonce, filled_key(10));
+}
+
+TEST_F(NoncePoolTest, AccountsThatAreNotNoncesAreDropped) {
+    svm_pay_test::StandInRpcServer server([&](const std::string&, const JsonValue& params) -> std::string {
+        if (params.as_array().at(0).as_string() == filled_key(1).to_base58()) {
+            return nonce_account_info(filled_key(7), filled_key(10), 5000);
+        }
+        return R"({"context":{"slot":5},"value":{"data":["AAAA","base64"],"executable":false,"lamports":1,"owner":"11111111111111111111111111111111","rentEpoch":0,"space":3}})";
+    });
+    auto adapter = adapter_for(server);
+    std::mutex mutex;
+    std::vector<PublicKey> reported;
+    NoncePoolConfig config = fast();
+    config.on_dropped = [&](const PublicKey& account, std::exception_ptr error) {
+        EXPECT_THROW(std::rethrow_exception(error), TransactionException);
+        std::lock_guard<std::mutex> lock(mutex);
+        reported.push_back(account);
+    };
+
+    NoncePool pool(*adapter, {filled_key(1), filled_key(2)}, config);
+    NonceLease lease = pool.acquire(std::chrono::milliseconds(5000));
+    EXPECT_EQ(lease.account().address, filled_key(1));
+    EXPECT_THROW(pool.acquire(std::chrono::milliseconds(50)), TimeoutException);
+    EXPECT_EQ(pool.dropped(), 1u);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(reported, std::vector<PublicKey>{filled_key(2)});
+    }
+
+    // With no usable account left, acquire fails at once instead of timing out
+    NoncePool broken(*adapter, {filled_key(2), filled_key(3)}, config);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_THROW(broken.acquire(std::chrono::milliseconds(5000)), TransactionException);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(2000));
+    EXPECT_EQ(broken.dropped(), 2u);
+}
@@ -0,0 +1,215 @@
+#include <gtest/gtest.h>
+#include "svm-pay/core/payout_packer.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/pda.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace svm_pay;
+
+namespace {
+
+PublicKey numbered_key(uint32_t number) {
+    std::array<uint8_t, PublicKey::SIZE> bytes;
+    bytes.fill(0x42);
+    for (int i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<uint8_t>(number >> (8 * i));
+    }
+    return PublicKey(bytes);
+}
+
+const PublicKey PAYER = numbered_key(0xffffffff);
+const Blockhash BLOCKHASH = numbered_key(0xfffffffe);
+
+std::vector<TransferRequest> payouts(size_t count) {
+    std::vector<TransferRequest> requests;
+    for (size_t i = 0; i < count; ++i) {
+        requests.emplace_back(SVMNetwork::SOLANA, numbered_key(static_cast<uint32_t>(i)).to_base58(), "0.001");
+    }
+    return requests;
+}
+
+// Every request lands in exactly one transaction, in order
+void expect_covers(const std::vector<PackedTransaction>& packed, size_t count) {
+    std::vector<size_t> seen;
+    for (const auto& transaction : packed) {
+        EXPECT_LE(transaction.size, TransactionBuilder::MAX_TRANSACTION_SIZE);
+        EXPECT_EQ(transaction.transaction.serialized_size(), transaction.size);
+        seen.insert(seen.end(), transaction.requests.begin(), transaction.requests.end());
+    }
+    ASSERT_EQ(seen.size(), count);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(seen[i], i);
+    }
+}
+
+} // namespace
+
+class PayoutPackerTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(PayoutPackerTest, FillsTransactionsToTheSizeLimit) {
+    auto requests = payouts(100);
+    auto packed = pack_transfers(requests, PAYER, BLOCKHASH);
+    expect_covers(packed, requests.size());
+    ASSERT_GT(packed.size(), 1u);
+
+    // Full transactions have no room for one more transfer (32-byte key + 17-byte instruction)
+    for (size_t i = 0; i + 1 < packed.size(); ++i) {
+        EXPECT_GT(packed[i].size + 49, TransactionBuilder::MAX_TRANSACTION_SIZE);
+        EXPECT_EQ(packed[i].compute_units, 150u + 150u * packed[i].requests.size());
+    }
+
+    // SetComputeUnitLimit comes first and carries the estimate
+    auto bytes = packed[0].transaction.serialize();
+    auto keys = packed[0].transaction.account_keys();
+    size_t instructions = 1 + 64 + 3 + 1 + 32 * keys.size() + 32;
+    EXPECT_EQ(bytes[instructions], 1 + packed[0].requests.size());
+    EXPECT_EQ(keys[bytes[instructions + 1]], compute_budget_program_id());
+    uint32_t units = packed[0].compute_units;
+    EXPECT_EQ(std::vector<uint8_t>(bytes.begin() + instructions + 2, bytes.begin() + instructions + 9),
+              (std::vector<uint8_t>{0, 5, 2, static_cast<uint8_t>(units), static_cast<uint8_t>(units >> 8),
+                                    static_cast<uint8_t>(units >> 16), static_cast<uint8_t>(units >> 24)}));
+}
+
+TEST_F(PayoutPackerTest, LookupTablesPackMoreUpToTheAccountLimit) {
+    auto requests = payouts(200);
+    auto table = std::make_shared<AddressLookupTable>();
+    table->key = numbered_key(0xfffffffd);
+    for (size_t i = 0; i < 200; ++i) {
+        table->addresses.push_back(numbered_key(static_cast<uint32_t>(i)));
+    }
+    PayoutPackerConfig config;
+    config.lookup_tables.push_back(table);
+
+    auto legacy = pack_transfers(requests, PAYER, BLOCKHASH);
+    auto packed = pack_transfers(requests, PAYER, BLOCKHASH, config);
+    expect_covers(packed, requests.size());
+    EXPECT_LT(packed.size(), legacy.size());
+    // A transfer to a loaded recipient takes 18 bytes instead of 49
+    EXPECT_EQ(packed[0].requests.size(), 55u);
+
+    // Payer, System and Compute Budget programs leave the rest of the accounts for recipients
+    config.max_accounts = 32;
+    packed = pack_transfers(requests, PAYER, BLOCKHASH, config);
+    expect_covers(packed, requests.size());
+    EXPECT_EQ(packed[0].requests.size(), 29u);
+
+    // Without a usable lookup a legacy message is smaller
+    table->addresses.clear();
+    auto unused = pack_transfers(payouts(5), PAYER, BLOCKHASH, config);
+    ASSERT_EQ(unused.size(), 1u);
+    EXPECT_EQ(unused[0].size, pack_transfers(payouts(5), PAYER, BLOCKHASH)[0].size);
+}
+
+TEST_F(PayoutPackerTest, RespectsComputeAndTransferCaps) {
+    auto requests = payouts(30);
+    for (auto& request : requests) {
+        request.memo = "invoice";
+    }
+    PayoutPackerConfig config;
+    config.compute_unit_price = 5000;
+    config.max_compute_units = 300 + 3 * (150 + 10000);
+    auto packed = pack_transfers(requests, PAYER, BLOCKHASH, config);
+    expect_covers(packed, requests.size());
+    EXPECT_EQ(packed.size(), 10u);
+    EXPECT_EQ(packed[0].compute_units, config.max_compute_units);
+
+    config = PayoutPackerConfig{};
+    config.max_transfers = 4;
+    config.set_compute_unit_limit = false;
+    packed = pack_transfers(payouts(10), PAYER, BLOCKHASH, config);
+    expect_covers(packed, 10);
+    EXPECT_EQ(packed.size(), 3u);
+    EXPECT_EQ(packed[2].requests.size(), 2u);
+    EXPECT_EQ(packed[0].transaction.account_keys().size(), 6u);  // No Compute Budget program
+}
+
+TEST_F(PayoutPackerTest, PaysFromEachRequestAccount) {
+    auto requests = payouts(3);
+    requests[1].account = numbered_key(1000).to_base58();
+    requests[2].references = {numbered_key(2000).to_base58()};
+    auto packed = pack_transfers(requests, PAYER, BLOCKHASH);
+    ASSERT_EQ(packed.size(), 1u);
+    EXPECT_EQ(packed[0].transaction.num_required_signatures(), 2u);
+    auto keys = packed[0].transaction.account_keys();
+    EXPECT_NE(std::find(keys.begin(), keys.end(), numbered_key(2000)), keys.end());
+}
+
+TEST_F(PayoutPackerTest, PacksTokenTransfersBetweenAssociatedAccounts) {
+    MintInfo usdc{numbered_key(3000), token_program_id(), 6};
+    MintInfo points{numbered_key(3001), token_2022_program_id(), 2};
+    PayoutPackerConfig config;
+    config.mints = {usdc, points};
+
+    auto requests = payouts(60);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (i % 3 == 1) {
+            requests[i].spl_token = usdc.mint.to_base58();
+        } else if (i % 3 == 2) {
+            requests[i].spl_token = points.mint.to_base58();
+            requests[i].amount = "1.5";
+        }
+    }
+    auto packed = pack_transfers(requests, PAYER, BLOCKHASH, config);
+    expect_covers(packed, requests.size());
+    // Token transfers carry the recipient's token account plus the mint and program, once per transaction
+    EXPECT_GT(packed.size(), pack_transfers(payouts(60), PAYER, BLOCKHASH).size());
+
+    const auto& first = packed[0];
+    size_t tokens = 0;
+    for (size_t index : first.requests) {
+        tokens += requests[index].spl_token ? 1 : 0;
+    }
+    EXPECT_EQ(first.compute_units, 150u + 150u * (first.requests.size() - tokens) + 6200u * tokens);
+    EXPECT_EQ(first.transaction.num_required_signatures(), 1u);
+
+    auto keys = first.transaction.account_keys();
+    auto has = [&](const PublicKey& key) { return std::find(keys.begin(), keys.end(), key) != keys.end(); };
+    EXPECT_TRUE(has(numbered_key(0)));
+    EXPECT_FALSE(has(numbered_key(1)));  // Paid to its token account, not the wallet
+    EXPECT_TRUE(has(associated_token_address(numbered_key(1), usdc.mint, usdc.program)));
+    EXPECT_TRUE(has(associated_token_address(numbered_key(2), points.mint, points.program)));
+    EXPECT_TRUE(has(associated_token_address(PAYER, usdc.mint, usdc.program)));
+    EXPECT_TRUE(has(associated_token_address(PAYER, points.mint, points.program)));
+    EXPECT_TRUE(has(usdc.mint));
+    EXPECT_TRUE(has(token_program_id()));
+    EXPECT_TRUE(has(token_2022_program_id()));
+
+    // The account limit counts token accounts, mints and programs
+    config.max_accounts = 16;
+    packed = pack_transfers(requests, PAYER, BLOCKHASH, config);
+    expect_covers(packed, requests.size());
+    for (const auto& transaction : packed) {
+        EXPECT_LE(transaction.transaction.num_accounts(), 16u);
+    }
+}
+
+TEST_F(PayoutPackerTest, RejectsBadRequests) {
+    auto requests = payouts(3);
+    requests[1].recipient = "not an address";
+    EXPECT_THROW(pack_transfers(requests, PAYER, BLOCKHASH), AddressValidationException);
+
+    requests = payouts(3);
+    requests[2].amount = "1.0000000001";
+    EXPECT_THROW(pack_transfers(requests, PAYER, BLOCKHASH), TransactionException);
+
+    requests = payouts(3);
+    requests[0].spl_token = "EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v";
+    EXPECT_THROW(pack_transfers(requests, PAYER, BLOCKHASH), TransactionException);  // Mint not supplied
+
+    PayoutPackerConfig config;
+    config.mints = {MintInfo{PublicKey::from_base58(*requests[0].spl_token), token_program_id(), 6}};
+    requests[0].amount = "0.0000001";
+    EXPECT_THROW(pack_transfers(requests, PAYER, BLOCKHASH, config), TransactionException);  // Past 6 decimals
+
+    requests = payouts(3);
+    requests[1].memo = std::string(1200, 'x');
+    EXPECT_THROW(pack_transfers(requests, PAYER, BLOCKHASH), TransactionException);
+
+    EXPECT_TRUE(pack_transfers({}, PAYER, BLOCKHASH).empty());
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "svm-pay/core/pda.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace svm_pay;
+
+namespace {
+
+PublicKey filled_key(uint8_t byte) {
+    std::array<uint8_t, PublicKey::SIZE> bytes;
+    bytes.fill(byte);
+    return PublicKey(bytes);
+}
+
+// Little-endian y coordinate with the sign bit clear
+PublicKey y_coordinate(uint64_t y) {
+    std::array<uint8_t, PublicKey::SIZE> bytes{};
+    for (size_t i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<uint8_t>(y >> (8 * i));
+    }
+    return PublicKey(bytes);
+}
+
+PublicKey usdc() {
+    return PublicKey::from_base58("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v");
+}
+
+} // namespace
+
+class PdaTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(PdaTest, ChecksCurvePoints) {
+    // Wallet addresses are points
+    EXPECT_TRUE(is_on_curve(PublicKey::from_base58("9WzDXwBbmkg8ZTbNMqUxvQRAyrZzDsGYdLVL9zYtAWWM")));
+    // y = 0 and y = 1 are points, y = 2 is not
+    EXPECT_TRUE(is_on_curve(PublicKey()));
+    EXPECT_TRUE(is_on_curve(y_coordinate(1)));
+    EXPECT_FALSE(is_on_curve(y_coordinate(2)));
+    EXPECT_TRUE(is_on_curve(y_coordinate(3)));
+
+    // The sign bit does not matter, and y is taken modulo p
+    std::array<uint8_t, PublicKey::SIZE> signed_two = y_coordinate(2).bytes();
+    signed_two[31] |= 0x80;
+    EXPECT_FALSE(is_on_curve(PublicKey(signed_two)));
+    std::array<uint8_t, PublicKey::SIZE> p_plus_one;
+    p_plus_one.fill(0xFF);
+    p_plus_one[0] = 0xEE;
+    p_plus_one[31] = 0x7F;
+    EXPECT_TRUE(is_on_curve(PublicKey(p_plus_one)));
+    p_plus_one[0] = 0xEF;
+    EXPECT_FALSE(is_on_curve(PublicKey(p_plus_one)));
+}
+
+TEST_F(PdaTest, FindsProgramAddresses) {
+    // The Metaplex metadata account of USDC
+    PublicKey metaplex = PublicKey::from_base58("metaqbxxUerdq28cj1RbAWkYQm3ybzjb6a8bt518x1s");
+    PublicKey mint = usdc();
+    std::string prefix = "metadata";
+    ProgramAddress metadata = find_program_address({prefix, metaplex, mint}, metaplex);
+    EXPECT_EQ(metadata.address.to_base58(), "5x38Kp4hvdomTCnCrAny4UtMUt5rQBdB6px2K1Ui45Wq");
+    EXPECT_EQ(metadata.bump, 255);
+
+    // Recreating it from the bump gives the same address
+    uint8_t bump = metadata.bump;
+    SeedView seeds[] = {prefix, metaplex, mint, SeedView(&bump, 1)};
+    PublicKey created;
+    ASSERT_TRUE(create_program_address(seeds, 4, metaplex, created));
+    EXPECT_EQ(created, metadata.address);
+
+    std::vector<uint8_t> too_long(33);
+    EXPECT_THROW(find_program_address({too_long}, metaplex), std::invalid_argument);
+    std::vector<SeedView> too_many(16, SeedView(mint));
+    EXPECT_THROW(find_program_address(too_many.data(), too_many.size(), metaplex), std::invalid_argument);
+    EXPECT_NO_THROW(create_program_address(too_many.data(), too_many.size(), metaplex, created));
+}
+
+TEST_F(PdaTest, DerivesAssociatedTokenAccounts) {
+    PublicKey wallet = PublicKey::from_base58("9WzDXwBbmkg8ZTbNMqUxvQRAyrZzDsGYdLVL9zYtAWWM");
+    ProgramAddress ata = derive_associated_token_address(wallet, usdc());
+    EXPECT_EQ(ata.address.to_base58(), "FGETo8T8wMcN2wCjav8VK6eh3dLk63evNDPxzLSJra8B");
+    EXPECT_EQ(ata.bump, 254);
+    EXPECT_EQ(derive_associated_token_address(wallet, usdc(), token_2022_program_id()).address.to_base58(),
+              "GdjpegrtGwU3pgtzPivYVViSA8rmGL248qBVKzsrU3DD");
+    EXPECT_EQ(derive_associated_token_address(PublicKey(), usdc()).address.to_base58(),
+              "HJt8Tjdsc9ms9i4WCZEzhzr4oyf3ANcdzXrNdLPFqm3M");
+
+    // This owner needs eight bumps
+    ata = derive_associated_token_address(filled_key(4), usdc());
+    EXPECT_EQ(ata.address.to_base58(), "DhscvS2mfxadjGkSvoGxKzgEi6ZnuLunmFEjcZ5sd5u1");
+    EXPECT_EQ(ata.bump, 248);
+}
+
+TEST_F(PdaTest, CachesDerivationsPerShard) {
+    AssociatedTokenAddressCacheConfig config;
+    config.shards = 4;
+    config.capacity = 64;
+    AssociatedTokenAddressCache cache(config);
+
+    PublicKey wallet = PublicKey::from_base58("9WzDXwBbmkg8ZTbNMqUxvQRAyrZzDsGYdLVL9zYtAWWM");
+    EXPECT_EQ(cache.get(wallet, usdc()).to_base58(), "FGETo8T8wMcN2wCjav8VK6eh3dLk63evNDPxzLSJra8B");
+    EXPECT_EQ(cache.get(wallet, usdc(), token_2022_program_id()).to_base58(),
+              "GdjpegrtGwU3pgtzPivYVViSA8rmGL248qBVKzsrU3DD");
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.get(wallet, usdc()).to_base58(), "FGETo8T8wMcN2wCjav8VK6eh3dLk63evNDPxzLSJra8B");
+    EXPECT_EQ(cache.size(), 2u);
+
+    // Concurrent builders see the same addresses; the cache stays within capacity
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int round = 0; round < 3; ++round) {
+                for (int byte = 1; byte <= 200; ++byte) {
+                    PublicKey owner = filled_key(static_cast<uint8_t>(byte));
+                    if (cache.get(owner, usdc()) != derive_associated_token_address(owner, usdc()).address) {
+                        ++mismatches;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches.load(), 0);
+    EXPECT_LE(cache.size(), 64u);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(associated_token_address(wallet, usdc()), derive_associated_token_address(wallet, usdc()).address);
+}
+
+TEST_F(PdaTest, DerivesManyAssociatedTokenAccounts) {
+    // Owners needing different bump counts finish in different rounds
+    std::vector<PublicKey> owners = {PublicKey::from_base58("9WzDXwBbmkg8ZTbNMqUxvQRAyrZzDsGYdLVL9zYtAWWM"),
+                                     filled_key(4), PublicKey()};
+    for (int byte = 5; byte <= 44; ++byte) {
+        owners.push_back(filled_key(static_cast<uint8_t>(byte)));
+    }
+
+    std::vector<ProgramAddress> derived(owners.size());
+    derive_associated_token_addresses(owners.data(), owners.size(), usdc(), derived.data());
+    EXPECT_EQ(derived[0].address.to_base58(), "FGETo8T8wMcN2wCjav8VK6eh3dLk63evNDPxzLSJra8B");
+    EXPECT_EQ(derived[1].bump, 248);
+    EXPECT_EQ(derived[2].address.to_base58(), "HJt8Tjdsc9ms9i4WCZEzhzr4oyf3ANcdzXrNdLPFqm3M");
+    for (size_t i = 0; i < owners.size(); ++i) {
+        ProgramAddress single = derive_associated_token_address(owners[i], usdc());
+        EXPECT_EQ(derived[i].address, single.address);
+        EXPECT_EQ(derived[i].bump, single.bump);
+    }
+    derive_associated_token_addresses(owners.data(), 0, usdc(), derived.data());
+
+    // The cache derives only what it is missing
+    AssociatedTokenAddressCache cache;
+    cache.get(owners[5], usdc());
+    std::vector<PublicKey> addresses(owners.size());
+    cache.get_many(owners.data(), owners.size(), usdc(), addresses.data());
+    for (size_t i = 0; i < owners.size(); ++i) {
+        EXPECT_EQ(addresses[i], derived[i].address);
+    }
+    EXPECT_EQ(cache.size(), owners.size());
+}
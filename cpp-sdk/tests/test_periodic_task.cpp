@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/periodic_task.hpp"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+namespace {
+
+void wait_for(const std::atomic<int>& value, int target) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (value.load() < target && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    ASSERT_GE(value.load(), target);
+}
+
+} // namespace
+
+class PeriodicTaskTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(PeriodicTaskTest, RunsAtTheDelayEachRunAsksFor) {
+    RpcTransport transport;
+    std::atomic<int> runs{0};
+    PeriodicTask task(transport, [&](PeriodicTask::Done done) {
+        // Quick runs at first, then one far out
+        done(++runs < 3 ? milliseconds(5) : milliseconds(60000));
+    });
+    wait_for(runs, 3);
+    std::this_thread::sleep_for(milliseconds(50));
+    EXPECT_EQ(runs.load(), 3);
+
+    task.run_now();
+    wait_for(runs, 4);
+}
+
+TEST_F(PeriodicTaskTest, RunsNeverOverlap) {
+    RpcTransport transport;
+    std::mutex mutex;
+    PeriodicTask::Done pending;
+    std::atomic<int> runs{0};
+    std::atomic<int> active{0};
+    std::atomic<int> overlaps{0};
+    PeriodicTask task(transport, [&](PeriodicTask::Done done) {
+        if (++active > 1) {
+            ++overlaps;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        pending = std::move(done);
+        ++runs;
+    });
+    wait_for(runs, 1);
+
+    // A run requested while one is in flight follows it at once
+    task.run_now();
+    task.run_now();
+    std::this_thread::sleep_for(milliseconds(20));
+    EXPECT_EQ(runs.load(), 1);
+    PeriodicTask::Done finish;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finish = std::move(pending);
+    }
+    --active;
+    finish(milliseconds(60000));
+    wait_for(runs, 2);
+    std::this_thread::sleep_for(milliseconds(20));
+    EXPECT_EQ(runs.load(), 2);
+    EXPECT_EQ(overlaps.load(), 0);
+
+    // stop() waits for the run in flight
+    std::atomic<bool> stopped{false};
+    std::thread stopper([&]() {
+        task.stop();
+        stopped = true;
+    });
+    std::this_thread::sleep_for(milliseconds(20));
+    EXPECT_FALSE(stopped.load());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finish = std::move(pending);
+    }
+    --active;
+    finish(milliseconds(0));
+    stopper.join();
+    EXPECT_TRUE(stopped.load());
+    std::this_thread::sleep_for(milliseconds(20));
+    EXPECT_EQ(runs.load(), 2);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/priority_fee_estimator.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+namespace {
+
+// One sample per slot, fee = 100 * (slot - first_slot)
+std::vector<PrioritizationFee> ramp(uint64_t first_slot, size_t count) {
+    std::vector<PrioritizationFee> fees;
+    for (size_t i = 0; i < count; ++i) {
+        fees.push_back({first_slot + i, 100 * i});
+    }
+    return fees;
+}
+
+// Fetcher answering at once with what sample() returns or throws
+template <typename Sample>
+PriorityFeeEstimator::Fetcher answering(Sample sample) {
+    return [sample](Completion<std::vector<PrioritizationFee>> on_done) {
+        std::vector<PrioritizationFee> fees;
+        try {
+            fees = sample();
+        } catch (...) {
+            on_done({}, std::current_exception());
+            return;
+        }
+        on_done(std::move(fees), nullptr);
+    };
+}
+
+void wait_for_refreshes(const PriorityFeeEstimator& estimator, uint64_t count) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (estimator.refresh_count() < count && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    ASSERT_GE(estimator.refresh_count(), count);
+}
+
+} // namespace
+
+class PriorityFeeEstimatorTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(PriorityFeeEstimatorTest, AnswersPercentilesFromMemory) {
+    std::atomic<int> calls{0};
+    PriorityFeeEstimatorConfig config;
+    config.refresh_interval = milliseconds(60000);
+    PriorityFeeEstimator estimator(answering([&]() {
+        ++calls;
+        return ramp(1000, 101);
+    }), config);
+    wait_for_refreshes(estimator, 1);
+
+    EXPECT_EQ(estimator.sample_count(), 101u);
+    EXPECT_EQ(estimator.fee_for_percentile(0), 0u);
+    EXPECT_EQ(estimator.fee_for_percentile(100), 10000u);
+    EXPECT_NEAR(static_cast<double>(estimator.fee_for_percentile(50)), 5000.0, 5000.0 * config.relative_accuracy);
+    EXPECT_NEAR(static_cast<double>(estimator.fee_for_percentile(75.5)), 7550.0, 7550.0 * config.relative_accuracy);
+    EXPECT_EQ(estimator.fee_for_percentile(250), 10000u);
+
+    // Reads never fetch
+    for (int i = 0; i < 10000; ++i) {
+        estimator.fee_for_percentile(i % 100);
+    }
+    EXPECT_EQ(calls.load(), 1);
+
+    TransactionBuilder builder;
+    builder.set_fee_payer(PublicKey()).set_recent_blockhash(PublicKey());
+    estimator.apply(builder, 100);
+    auto bytes = builder.serialize();
+    // Compute Budget SetComputeUnitPrice(10000) is the last instruction
+    EXPECT_EQ(std::vector<uint8_t>(bytes.end() - 9, bytes.end()), (std::vector<uint8_t>{3, 0x10, 0x27, 0, 0, 0, 0, 0, 0}));
+}
+
+TEST_F(PriorityFeeEstimatorTest, KeepsOnlyTheRecentWindow) {
+    PriorityFeeEstimatorConfig config;
+    config.window_slots = 10;
+    config.refresh_interval = milliseconds(60000);
+    PriorityFeeEstimator estimator(answering([]() { return ramp(1000, 150); }), config);
+    wait_for_refreshes(estimator, 1);
+
+    EXPECT_EQ(estimator.sample_count(), 10u);
+    EXPECT_GE(estimator.fee_for_percentile(0), 14000u * 99 / 100);
+}
+
+TEST_F(PriorityFeeEstimatorTest, ServesDefaultUntilFirstSamplesAndKeepsThemOnFailure) {
+    std::atomic<bool> failing{true};
+    std::atomic<uint64_t> base{0};
+    PriorityFeeEstimatorConfig config;
+    config.default_fee = 42;
+    config.refresh_interval = milliseconds(5);
+    config.retry_delay = milliseconds(5);
+    PriorityFeeEstimator estimator(answering([&]() {
+        if (failing) {
+            throw NetworkException("node unavailable");
+        }
+        return std::vector<PrioritizationFee>{{1, base.load()}};
+    }), config);
+
+    std::this_thread::sleep_for(milliseconds(30));
+    EXPECT_EQ(estimator.fee_for_percentile(50), 42u);
+    EXPECT_EQ(estimator.sample_count(), 0u);
+
+    base = 7000;
+    failing = false;
+    wait_for_refreshes(estimator, 1);
+    failing = true;
+    uint64_t fee = estimator.fee_for_percentile(50);
+    EXPECT_NEAR(static_cast<double>(fee), 7000.0, 70.0);
+    std::this_thread::sleep_for(milliseconds(30));
+    EXPECT_EQ(estimator.fee_for_percentile(50), fee);
+}
+
+TEST_F(PriorityFeeEstimatorTest, SamplesThroughTheAdapter) {
+    std::mutex mutex;
+    std::vector<std::string> params_seen;
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue& params) -> std::string {
+        if (method != "getRecentPrioritizationFees") {
+            return "null";
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        params_seen.push_back(params.dump());
+        return R"([{"slot":10,"prioritizationFee":0},{"slot":11,"prioritizationFee":2500},{"slot":12,"prioritizationFee":5000}])";
+    });
+    EndpointPoolConfig endpoints;
+    endpoints.urls.push_back(server.url());
+    SvmNetworkAdapter adapter(SVMNetwork::SOLANA, endpoints, std::make_shared<RpcTransport>());
+
+    auto fees = adapter.get_recent_prioritization_fees({}).get();
+    ASSERT_EQ(fees.size(), 3u);
+    EXPECT_EQ(fees[1].slot, 11u);
+    EXPECT_EQ(fees[1].fee, 2500u);
+
+    PriorityFeeEstimatorConfig config;
+    config.accounts = {PublicKey::from_base58("TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA")};
+    PriorityFeeEstimator scoped(adapter, config);
+    wait_for_refreshes(scoped, 1);
+    EXPECT_EQ(scoped.fee_for_percentile(100), 5000u);
+
+    PriorityFeeEstimator& shared = adapter.priority_fee_estimator();
+    EXPECT_EQ(&shared, &adapter.priority_fee_estimator());
+    wait_for_refreshes(shared, 1);
+    EXPECT_EQ(shared.sample_count(), 3u);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_GE(params_seen.size(), 3u);
+    EXPECT_EQ(params_seen[0], "[]");
+    EXPECT_EQ(params_seen[1], R"([["TokenkegQfeZyiNwAJbNbGKPFXCWuBvf9Ss623VQ5DA"]])");
+}
@@ -0,0 +1,435 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/pubsub.hpp"
+#include "svm-pay/core/json.hpp"
+#include <openssl/evp.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <thread>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+namespace {
+
+/**
+ * Minimal stand-in for a Solana PubSub node: performs the WebSocket
+ * handshake, acknowledges subscribe/unsubscribe requests and lets the test
+ * push notifications or drop every connection
+ */
+class StandInPubSubServer {
+public:
+    StandInPubSubServer() {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listen_fd_, 16);
+        socklen_t len = sizeof(addr);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        accept_thread_ = std::thread([this]() { accept_loop(); });
+    }
+
+    ~StandInPubSubServer() {
+        stopping_ = true;
+        shutdown(listen_fd_, SHUT_RDWR);
+        close(listen_fd_);
+        accept_thread_.join();
+        drop_connections();
+        for (auto& client : clients_) {
+            client->thread.join();
+        }
+    }
+
+    std::string url() const { return "ws://127.0.0.1:" + std::to_string(port_); }
+
+    template <typename Predicate>
+    bool wait_until(Predicate predicate, milliseconds timeout = milliseconds(5000)) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&]() { return predicate(*this); });
+    }
+
+    // The accessors below are meant for wait_until predicates, which hold the lock
+    size_t open_connections() const { return open_connections_; }
+    size_t peak_connections() const { return peak_connections_; }
+    size_t subscribe_requests() const { return subscribe_requests_; }
+    size_t unsubscribe_requests() const { return unsubscribe_requests_; }
+    size_t active_subscriptions() const { return subscriptions_.size(); }
+
+    void notify_signature(const std::string& signature, const std::string& value_json) {
+        notify("signatureSubscribe", signature, "signatureNotification",
+               "{\"context\":{\"slot\":4242},\"value\":" + value_json + "}");
+    }
+
+    void notify_account(const std::string& address, uint64_t lamports) {
+        notify("accountSubscribe", address, "accountNotification",
+               "{\"context\":{\"slot\":77},\"value\":{\"lamports\":" + std::to_string(lamports) +
+               ",\"owner\":\"11111111111111111111111111111111\",\"data\":[\"\",\"base64\"],"
+               "\"executable\":false,\"rentEpoch\":0}}");
+    }
+
+    void drop_connections() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& client : clients_) {
+            shutdown(client->fd, SHUT_RDWR);
+        }
+    }
+
+private:
+    struct Client {
+        int fd = -1;
+        std::mutex write_mutex;
+        std::thread thread;
+    };
+
+    struct ServerSubscription {
+        Client* client;
+        std::string method;
+        std::string key;
+        uint64_t id;
+    };
+
+    void accept_loop() {
+        while (!stopping_) {
+            int fd = accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            clients_.push_back(std::make_unique<Client>());
+            Client* client = clients_.back().get();
+            client->fd = fd;
+            client->thread = std::thread([this, client]() { serve(*client); });
+        }
+    }
+
+    static bool read_exact(int fd, void* buffer, size_t size) {
+        auto* out = static_cast<unsigned char*>(buffer);
+        while (size > 0) {
+            ssize_t n = recv(fd, out, size, 0);
+            if (n <= 0) {
+                return false;
+            }
+            out += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    static std::string accept_key(const std::string& key) {
+        std::string input = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int digest_len = 0;
+        EVP_Digest(input.data(), input.size(), digest, &digest_len, EVP_sha1(), nullptr);
+        unsigned char encoded[64];
+        int encoded_len = EVP_EncodeBlock(encoded, digest, static_cast<int>(digest_len));
+        return std::string(reinterpret_cast<char*>(encoded), static_cast<size_t>(encoded_len));
+    }
+
+    static void send_frame(Client& client, uint8_t opcode, const std::string& payload) {
+        std::string frame;
+        frame += static_cast<char>(0x80 | opcode);
+        if (payload.size() < 126) {
+            frame += static_cast<char>(payload.size());
+        } else if (payload.size() < 65536) {
+            frame += static_cast<char>(126);
+            frame += static_cast<char>((payload.size() >> 8) & 0xFF);
+            frame += static_cast<char>(payload.size() & 0xFF);
+        } else {
+            frame += static_cast<char>(127);
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                frame += static_cast<char>((static_cast<uint64_t>(payload.size()) >> shift) & 0xFF);
+            }
+        }
+        frame += payload;
+        std::lock_guard<std::mutex> lock(client.write_mutex);
+        send(client.fd, frame.data(), frame.size(), MSG_NOSIGNAL);
+    }
+
+    bool handshake(Client& client) {
+        std::string request;
+        char c;
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            if (recv(client.fd, &c, 1, 0) != 1) {
+                return false;
+            }
+            request += c;
+        }
+        auto key_pos = request.find("Sec-WebSocket-Key: ");
+        if (key_pos == std::string::npos) {
+            return false;
+        }
+        key_pos += 19;
+        std::string key = request.substr(key_pos, request.find("\r\n", key_pos) - key_pos);
+        std::string response =
+            "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+            "Sec-WebSocket-Accept: " + accept_key(key) + "\r\n\r\n";
+        send(client.fd, response.data(), response.size(), MSG_NOSIGNAL);
+        return true;
+    }
+
+    void serve(Client& client) {
+        if (handshake(client)) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++open_connections_;
+                peak_connections_ = std::max(peak_connections_, open_connections_);
+            }
+            cv_.notify_all();
+
+            while (true) {
+                unsigned char header[2];
+                if (!read_exact(client.fd, header, 2)) {
+                    break;
+                }
+                uint8_t opcode = header[0] & 0x0F;
+                uint64_t length = header[1] & 0x7F;
+                if (length == 126 || length == 127) {
+                    unsigned char extended[8];
+                    size_t bytes = length == 126 ? 2 : 8;
+                    if (!read_exact(client.fd, extended, bytes)) {
+                        break;
+                    }
+                    length = 0;
+                    for (size_t i = 0; i < bytes; ++i) {
+                        length = (length << 8) | extended[i];
+                    }
+                }
+                unsigned char mask[4] = {0, 0, 0, 0};
+                if ((header[1] & 0x80) && !read_exact(client.fd, mask, 4)) {
+                    break;
+                }
+                std::string payload(length, '\0');
+                if (length > 0 && !read_exact(client.fd, &payload[0], length)) {
+                    break;
+                }
+                for (size_t i = 0; i < payload.size(); ++i) {
+                    payload[i] = static_cast<char>(payload[i] ^ mask[i % 4]);
+                }
+
+                if (opcode == 0x8) {
+                    break;
+                } else if (opcode == 0x9) {
+                    send_frame(client, 0xA, payload);
+                } else if (opcode == 0x1) {
+                    handle_request(client, payload);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            --open_connections_;
+            for (auto it = subscriptions_.begin(); it != subscriptions_.end();) {
+                it = it->client == &client ? subscriptions_.erase(it) : std::next(it);
+            }
+        }
+        close(client.fd);
+        cv_.notify_all();
+    }
+
+    void handle_request(Client& client, const std::string& payload) {
+        auto request = JsonValue::parse(payload);
+        const std::string& method = request["method"].as_string();
+        std::string reply;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (method.size() > 9 && method.compare(method.size() - 9, 9, "Subscribe") == 0) {
+                uint64_t id = next_subscription_id_++;
+                subscriptions_.push_back({&client, method, request["params"][0].as_string(), id});
+                ++subscribe_requests_;
+                reply = std::to_string(id);
+            } else {
+                uint64_t id = request["params"][0].as_uint64();
+                for (auto it = subscriptions_.begin(); it != subscriptions_.end(); ++it) {
+                    if (it->id == id) {
+                        subscriptions_.erase(it);
+                        break;
+                    }
+                }
+                ++unsubscribe_requests_;
+                reply = "true";
+            }
+        }
+        send_frame(client, 0x1, "{\"jsonrpc\":\"2.0\",\"result\":" + reply + ",\"id\":" +
+                                     request["id"].dump() + "}");
+        cv_.notify_all();
+    }
+
+    void notify(const std::string& subscribe_method, const std::string& key,
+                const std::string& notification, const std::string& result) {
+        std::vector<std::pair<Client*, uint64_t>> targets;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto it = subscriptions_.begin(); it != subscriptions_.end();) {
+                if (it->method == subscribe_method && it->key == key) {
+                    targets.emplace_back(it->client, it->id);
+                    // Like a real node, signature subscriptions end after the final notification
+                    if (notification == "signatureNotification" && result.find("receivedSignature") == std::string::npos) {
+                        it = subscriptions_.erase(it);
+                        continue;
+                    }
+                }
+                ++it;
+            }
+        }
+        for (const auto& target : targets) {
+            send_frame(*target.first, 0x1,
+                       "{\"jsonrpc\":\"2.0\",\"method\":\"" + notification + "\",\"params\":{\"result\":" +
+                       result + ",\"subscription\":" + std::to_string(target.second) + "}}");
+        }
+    }
+
+    int listen_fd_;
+    uint16_t port_;
+    std::atomic<bool> stopping_{false};
+    std::thread accept_thread_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::list<std::unique_ptr<Client>> clients_;
+    std::list<ServerSubscription> subscriptions_;
+    uint64_t next_subscription_id_ = 100;
+    size_t open_connections_ = 0;
+    size_t peak_connections_ = 0;
+    size_t subscribe_requests_ = 0;
+    size_t unsubscribe_requests_ = 0;
+};
+
+PubSubConfig test_config(const StandInPubSubServer& server, size_t connections = 1) {
+    PubSubConfig config;
+    config.url = server.url();
+    config.connections = connections;
+    config.reconnect_delay = milliseconds(10);
+    config.max_reconnect_delay = milliseconds(50);
+    return config;
+}
+
+} // namespace
+
+class PubSubTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(PubSubTest, SignatureConfirmedThroughFuture) {
+    StandInPubSubServer server;
+    PubSubClient client(test_config(server));
+
+    auto status = client.wait_for_signature("sig-ok");
+    ASSERT_TRUE(server.wait_until([](auto& s) { return s.active_subscriptions() == 1; }));
+    server.notify_signature("sig-ok", "{\"err\":null}");
+
+    ASSERT_EQ(status.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(status.get(), PaymentStatus::CONFIRMED);
+    EXPECT_EQ(client.subscription_count(), 0u);
+}
+
+TEST_F(PubSubTest, ReceivedThenFailed) {
+    StandInPubSubServer server;
+    PubSubClient client(test_config(server));
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<SignatureUpdate> updates;
+    client.subscribe_signature("sig-bad", [&](const SignatureUpdate& update) {
+        std::lock_guard<std::mutex> lock(mutex);
+        updates.push_back(update);
+        cv.notify_all();
+    }, true);
+
+    ASSERT_TRUE(server.wait_until([](auto& s) { return s.active_subscriptions() == 1; }));
+    server.notify_signature("sig-bad", "\"receivedSignature\"");
+    server.notify_signature("sig-bad", "{\"err\":{\"InstructionError\":[0,{\"Custom\":1}]}}");
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&]() { return updates.size() == 2; }));
+    EXPECT_EQ(updates[0].status, PaymentStatus::PENDING);
+    EXPECT_EQ(updates[1].status, PaymentStatus::FAILED);
+    EXPECT_EQ(updates[1].slot, 4242u);
+    EXPECT_EQ(updates[1].error.value_or(""), "{\"InstructionError\":[0,{\"Custom\":1}]}");
+}
+
+TEST_F(PubSubTest, MultiplexesAcrossFewConnections) {
+    StandInPubSubServer server;
+    PubSubClient client(test_config(server, 2));
+
+    const size_t count = 500;
+    std::vector<std::future<PaymentStatus>> statuses;
+    for (size_t i = 0; i < count; ++i) {
+        statuses.push_back(client.wait_for_signature("sig-" + std::to_string(i)));
+    }
+    ASSERT_TRUE(server.wait_until([&](auto& s) { return s.active_subscriptions() == count; }));
+    EXPECT_EQ(server.wait_until([](auto& s) { return s.peak_connections() == 2; }), true);
+
+    for (size_t i = 0; i < count; ++i) {
+        server.notify_signature("sig-" + std::to_string(i), "{\"err\":null}");
+    }
+    for (auto& status : statuses) {
+        ASSERT_EQ(status.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+        EXPECT_EQ(status.get(), PaymentStatus::CONFIRMED);
+    }
+    EXPECT_EQ(client.subscription_count(), 0u);
+    EXPECT_EQ(client.connected_count(), 2u);
+}
+
+TEST_F(PubSubTest, ResubscribesAfterReconnect) {
+    StandInPubSubServer server;
+    PubSubClient client(test_config(server));
+
+    std::atomic<uint64_t> lamports{0};
+    client.subscribe_account("Acct111", [&](const AccountUpdate& update) {
+        lamports = update.lamports;
+    });
+    ASSERT_TRUE(server.wait_until([](auto& s) { return s.active_subscriptions() == 1; }));
+
+    server.drop_connections();
+    ASSERT_TRUE(server.wait_until([](auto& s) {
+        return s.subscribe_requests() == 2 && s.active_subscriptions() == 1;
+    }));
+
+    server.notify_account("Acct111", 5000);
+    for (int i = 0; i < 500 && lamports.load() == 0; ++i) {
+        std::this_thread::sleep_for(milliseconds(10));
+    }
+    EXPECT_EQ(lamports.load(), 5000u);
+    EXPECT_EQ(client.subscription_count(), 1u);
+}
+
+TEST_F(PubSubTest, UnsubscribeReleasesServerSubscription) {
+    StandInPubSubServer server;
+    PubSubClient client(test_config(server));
+
+    auto id = client.subscribe_account("Acct222", [](const AccountUpdate&) {});
+    ASSERT_TRUE(server.wait_until([](auto& s) { return s.active_subscriptions() == 1; }));
+
+    client.unsubscribe(id);
+    EXPECT_EQ(client.subscription_count(), 0u);
+    ASSERT_TRUE(server.wait_until([](auto& s) {
+        return s.unsubscribe_requests() == 1 && s.active_subscriptions() == 0;
+    }));
+
+    // Unknown ids are ignored
+    client.unsubscribe(id);
+}
+
+TEST_F(PubSubTest, SubscriptionsQueueUntilConnected) {
+    // Nothing listens on port 1; subscriptions wait for a connection instead of failing
+    PubSubConfig config;
+    config.url = "ws://127.0.0.1:1";
+    config.reconnect_delay = milliseconds(10);
+    PubSubClient client(config);
+
+    client.subscribe_signature("sig", [](const SignatureUpdate&) {});
+    std::this_thread::sleep_for(milliseconds(50));
+    EXPECT_EQ(client.subscription_count(), 1u);
+    EXPECT_EQ(client.connected_count(), 0u);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "svm-pay/core/quantile_sketch.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace svm_pay;
+
+class QuantileSketchTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(QuantileSketchTest, QuantilesStayWithinRelativeAccuracy) {
+    QuantileSketch sketch(0.01);
+    std::mt19937_64 random(7);
+    std::lognormal_distribution<double> fees(8.0, 2.5);
+    std::vector<uint64_t> values;
+    for (int i = 0; i < 20000; ++i) {
+        uint64_t value = i % 5 == 0 ? 0 : static_cast<uint64_t>(fees(random)) + 1;
+        values.push_back(value);
+        sketch.add(value);
+    }
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(sketch.count(), values.size());
+    EXPECT_EQ(sketch.min(), 0u);
+    EXPECT_EQ(sketch.max(), values.back());
+
+    for (double q : {0.0, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 1.0}) {
+        uint64_t exact = values[static_cast<size_t>(q * static_cast<double>(values.size() - 1))];
+        uint64_t estimate = sketch.quantile(q);
+        EXPECT_NEAR(static_cast<double>(estimate), static_cast<double>(exact), 0.011 * static_cast<double>(exact) + 1)
+            << "q=" << q;
+    }
+}
+
+TEST_F(QuantileSketchTest, MergesAndClears) {
+    QuantileSketch low;
+    QuantileSketch high;
+    for (uint64_t i = 1; i <= 100; ++i) {
+        low.add(i);
+        high.add(1000 + i, 2);
+    }
+    low.merge(high);
+    EXPECT_EQ(low.count(), 300u);
+    EXPECT_EQ(low.min(), 1u);
+    EXPECT_EQ(low.max(), 1100u);
+    EXPECT_LE(low.quantile(0.3), 100u);
+    EXPECT_GE(low.quantile(0.4), 990u);
+    EXPECT_EQ(low.quantile(1.0), 1100u);
+    EXPECT_EQ(low.quantile(2.0), 1100u);
+
+    low.clear();
+    EXPECT_EQ(low.count(), 0u);
+    EXPECT_EQ(low.quantile(0.5), 0u);
+    low.add(UINT64_MAX);
+    EXPECT_EQ(low.quantile(0.5), UINT64_MAX);
+
+    EXPECT_THROW(low.merge(QuantileSketch(0.05)), std::invalid_argument);
+    EXPECT_THROW(QuantileSketch(0.0), std::invalid_argument);
+}
@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/rate_limiter.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <atomic>
+#include <future>
+#include <list>
+#include <thread>
+#include <vector>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+class RateLimiterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config.initial_concurrency = 4;
+        config.min_concurrency = 1;
+        config.max_concurrency = 8;
+    }
+    void TearDown() override {}
+
+    RateLimitConfig config;
+};
+
+TEST_F(RateLimiterTest, TokenBucketPacing) {
+    TokenBucket bucket(10.0, 2.0);
+    auto now = TokenBucket::Clock::now();
+
+    EXPECT_TRUE(bucket.try_acquire(now));
+    EXPECT_TRUE(bucket.try_acquire(now));
+    EXPECT_FALSE(bucket.try_acquire(now));
+    EXPECT_GT(bucket.time_until_available(now).count(), 0);
+
+    // 10 tokens per second: one more token after 100ms
+    EXPECT_TRUE(bucket.try_acquire(now + milliseconds(101)));
+}
+
+TEST_F(RateLimiterTest, TokenBucketBacksOffAndRecovers) {
+    TokenBucket bucket(100.0);
+    bucket.on_throttled();
+    EXPECT_DOUBLE_EQ(bucket.effective_rate(), 50.0);
+
+    for (int i = 0; i < 100; ++i) {
+        bucket.on_success();
+    }
+    EXPECT_DOUBLE_EQ(bucket.effective_rate(), 100.0);
+}
+
+TEST_F(RateLimiterTest, UnlimitedBucket) {
+    TokenBucket bucket;
+    auto now = TokenBucket::Clock::now();
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(bucket.try_acquire(now));
+    }
+}
+
+TEST_F(RateLimiterTest, ConcurrencyLimit) {
+    RateLimiter limiter(config);
+    std::vector<RateLimiter::Permit> permits(4);
+    for (auto& permit : permits) {
+        EXPECT_TRUE(limiter.try_acquire(permit));
+    }
+    EXPECT_EQ(limiter.in_flight(), 4u);
+
+    RateLimiter::Permit extra;
+    EXPECT_FALSE(limiter.try_acquire(extra));
+
+    permits[0].release(RateLimiter::Outcome::FAILED);
+    EXPECT_TRUE(limiter.try_acquire(extra));
+}
+
+TEST_F(RateLimiterTest, ThrottlingShrinksLimit) {
+    RateLimiter limiter(config);
+    limiter.acquire().release(RateLimiter::Outcome::THROTTLED);
+    EXPECT_EQ(limiter.concurrency_limit(), 2u);
+    limiter.acquire().release(RateLimiter::Outcome::THROTTLED);
+    limiter.acquire().release(RateLimiter::Outcome::THROTTLED);
+    EXPECT_EQ(limiter.concurrency_limit(), 1u);
+}
+
+TEST_F(RateLimiterTest, SuccessGrowsLimitWhileSaturated) {
+    config.initial_concurrency = 2;
+    RateLimiter limiter(config);
+    for (int i = 0; i < 20; ++i) {
+        auto a = limiter.acquire();
+        auto b = limiter.acquire();
+        a.release(RateLimiter::Outcome::SUCCESS, milliseconds(10));
+        b.release(RateLimiter::Outcome::SUCCESS, milliseconds(10));
+    }
+    EXPECT_GT(limiter.concurrency_limit(), 2u);
+    EXPECT_LE(limiter.concurrency_limit(), 8u);
+}
+
+TEST_F(RateLimiterTest, RisingLatencyShrinksLimit) {
+    config.initial_concurrency = 8;
+    RateLimiter limiter(config);
+    limiter.acquire().release(RateLimiter::Outcome::SUCCESS, milliseconds(10));
+    for (int i = 0; i < 20; ++i) {
+        limiter.acquire().release(RateLimiter::Outcome::SUCCESS, milliseconds(100));
+    }
+    EXPECT_LT(limiter.concurrency_limit(), 8u);
+}
+
+TEST_F(RateLimiterTest, PauseBlocksAdmission) {
+    RateLimiter limiter(config);
+    limiter.pause_for(milliseconds(50));
+    EXPECT_TRUE(limiter.paused());
+
+    RateLimiter::Permit permit;
+    EXPECT_FALSE(limiter.try_acquire(permit));
+
+    auto start = std::chrono::steady_clock::now();
+    permit = limiter.acquire();
+    EXPECT_GE(std::chrono::steady_clock::now() - start, milliseconds(40));
+}
+
+TEST_F(RateLimiterTest, QueueTimeoutSheds) {
+    config.initial_concurrency = 1;
+    config.max_queue_wait = milliseconds(20);
+    RateLimiter limiter(config);
+    auto held = limiter.acquire();
+    EXPECT_THROW(limiter.acquire(), BackpressureException);
+    EXPECT_EQ(limiter.queued(), 0u);
+}
+
+TEST_F(RateLimiterTest, FullQueueSheds) {
+    config.initial_concurrency = 1;
+    config.max_queue = 0;
+    RateLimiter limiter(config);
+    auto held = limiter.acquire();
+    EXPECT_THROW(limiter.acquire(), BackpressureException);
+}
+
+TEST_F(RateLimiterTest, WaiterAdmittedOnRelease) {
+    config.initial_concurrency = 1;
+    RateLimiter limiter(config);
+    auto held = limiter.acquire();
+
+    std::thread releaser([&held]() {
+        std::this_thread::sleep_for(milliseconds(20));
+        held.release(RateLimiter::Outcome::SUCCESS, milliseconds(1));
+    });
+    auto permit = limiter.acquire();
+    releaser.join();
+    EXPECT_EQ(limiter.in_flight(), 1u);
+}
+
+TEST_F(RateLimiterTest, QueuedCallersShareTheLineWithBlockedOnes) {
+    config.initial_concurrency = 1;
+    config.max_concurrency = 1;
+    config.max_queue = 2;
+    RateLimiter limiter(config);
+    RateLimiter::Permit held;
+    EXPECT_EQ(limiter.enqueue(RateLimiter::Clock::time_point::max(), held, nullptr).id, 0u);
+    EXPECT_EQ(limiter.in_flight(), 1u);
+
+    // A blocked caller queues first, a non-blocking one behind it
+    std::atomic<int> order{0};
+    int blocked_turn = 0;
+    std::thread blocked([&]() {
+        auto permit = limiter.acquire();
+        blocked_turn = ++order;
+    });
+    while (limiter.queued() == 0) {
+        std::this_thread::yield();
+    }
+    std::promise<int> queued_turn;
+    RateLimiter::Permit unused;
+    auto ticket = limiter.enqueue(RateLimiter::Clock::time_point::max(), unused,
+                                  [&](RateLimiter::Permit, std::exception_ptr error) {
+                                      EXPECT_FALSE(error);
+                                      queued_turn.set_value(++order);
+                                  });
+    EXPECT_NE(ticket.id, 0u);
+    EXPECT_EQ(limiter.queued(), 2u);
+
+    // Nobody gets past the full queue, and try_acquire does not jump it
+    RateLimiter::Permit extra;
+    EXPECT_THROW(limiter.enqueue(RateLimiter::Clock::time_point::max(), extra, nullptr), BackpressureException);
+    EXPECT_FALSE(limiter.try_acquire(extra));
+
+    held.release(RateLimiter::Outcome::SUCCESS, milliseconds(1));
+    EXPECT_EQ(queued_turn.get_future().get(), 2);
+    blocked.join();
+    EXPECT_EQ(blocked_turn, 1);
+    EXPECT_EQ(limiter.in_flight(), 0u);
+}
+
+TEST_F(RateLimiterTest, QueuedCallersExpireAndCancel) {
+    config.initial_concurrency = 1;
+    config.max_queue_wait = milliseconds(20);
+    RateLimiter limiter(config);
+    auto held = limiter.acquire();
+
+    std::exception_ptr rejected;
+    RateLimiter::Permit unused;
+    auto ticket = limiter.enqueue(RateLimiter::Clock::time_point::max(), unused,
+                                  [&](RateLimiter::Permit, std::exception_ptr error) { rejected = error; });
+    EXPECT_LE(ticket.poll_at, RateLimiter::Clock::now() + milliseconds(20));
+    std::this_thread::sleep_until(ticket.poll_at);
+    EXPECT_EQ(limiter.poll(), RateLimiter::Clock::time_point::max());
+    EXPECT_THROW(std::rethrow_exception(rejected), BackpressureException);
+    EXPECT_FALSE(limiter.cancel(ticket.id));
+
+    // A cancelled caller is never granted
+    bool granted = false;
+    ticket = limiter.enqueue(RateLimiter::Clock::time_point::max(), unused,
+                             [&](RateLimiter::Permit, std::exception_ptr) { granted = true; });
+    EXPECT_TRUE(limiter.cancel(ticket.id));
+    EXPECT_EQ(limiter.queued(), 0u);
+    held.release(RateLimiter::Outcome::SUCCESS, milliseconds(1));
+    EXPECT_FALSE(granted);
+}
+
+TEST_F(RateLimiterTest, UrgentCallersGoFirstUntilOthersStarve) {
+    config.initial_concurrency = 1;
+    config.max_concurrency = 1;
+    config.starvation_threshold = milliseconds(50);
+    RateLimiter limiter(config);
+    auto held = limiter.acquire();
+
+    std::vector<RequestPriority> order;
+    std::list<RateLimiter::Permit> permits;  // Grants arrive while a permit in it is being released
+    auto queue = [&](RequestPriority priority) {
+        RateLimiter::Permit unused;
+        auto ticket = limiter.enqueue(RateLimiter::Clock::time_point::max(), unused,
+                                      [&, priority](RateLimiter::Permit permit, std::exception_ptr error) {
+                                          EXPECT_FALSE(error);
+                                          order.push_back(priority);
+                                          permits.push_back(std::move(permit));
+                                      }, priority);
+        EXPECT_NE(ticket.id, 0u);
+    };
+    queue(RequestPriority::BACKFILL);
+    queue(RequestPriority::READ);
+    queue(RequestPriority::SUBMIT);
+    queue(RequestPriority::READ);
+
+    // Nothing jumps a queued caller of the same or a more urgent class
+    RateLimiter::Permit extra;
+    EXPECT_FALSE(limiter.try_acquire(extra, RequestPriority::SUBMIT));
+
+    held.release(RateLimiter::Outcome::FAILED);
+    while (order.size() < 4) {
+        permits.back().release(RateLimiter::Outcome::FAILED);
+    }
+    EXPECT_EQ(order, (std::vector<RequestPriority>{RequestPriority::SUBMIT, RequestPriority::READ,
+                                                   RequestPriority::READ, RequestPriority::BACKFILL}));
+    permits.back().release(RateLimiter::Outcome::FAILED);
+
+    // A caller queued past the threshold goes before more urgent ones
+    held = limiter.acquire();
+    order.clear();
+    permits.clear();
+    queue(RequestPriority::BACKFILL);
+    std::this_thread::sleep_for(milliseconds(60));
+    queue(RequestPriority::SUBMIT);
+    held.release(RateLimiter::Outcome::FAILED);
+    ASSERT_EQ(order.size(), 1u);
+    EXPECT_EQ(order[0], RequestPriority::BACKFILL);
+    permits.back().release(RateLimiter::Outcome::FAILED);
+    EXPECT_EQ(order.back(), RequestPriority::SUBMIT);
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/request_scheduler.hpp"
+#include "svm-pay/network/rpc_transport.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <algorithm>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace svm_pay;
+
+namespace {
+
+using Clock = RequestScheduler::Clock;
+
+RequestSchedulerConfig uncapped() {
+    RequestSchedulerConfig config;
+    config.max_in_flight = 0;
+    for (auto& priority_class : config.classes) {
+        priority_class.max_in_flight = 0;
+    }
+    config.starvation_threshold = std::chrono::hours(1);
+    return config;
+}
+
+} // namespace
+
+class RequestSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(RequestSchedulerTest, MethodsMapToClasses) {
+    EXPECT_EQ(default_rpc_priority("sendTransaction"), RequestPriority::SUBMIT);
+    EXPECT_EQ(default_rpc_priority("getSignatureStatuses"), RequestPriority::CONFIRM);
+    EXPECT_EQ(default_rpc_priority("getBalance"), RequestPriority::READ);
+    EXPECT_EQ(default_rpc_priority("getSignaturesForAddress"), RequestPriority::BACKFILL);
+}
+
+TEST_F(RequestSchedulerTest, WeightsShareDispatches) {
+    RequestScheduler scheduler(uncapped());
+    Clock::time_point now = Clock::now();
+    for (int i = 0; i < 100; ++i) {
+        scheduler.enqueue(RequestPriority::SUBMIT, now);
+        scheduler.enqueue(RequestPriority::BACKFILL, now);
+    }
+
+    for (int i = 0; i < 90; ++i) {
+        ASSERT_TRUE(scheduler.next(now).has_value());
+    }
+    // Weights 8:1 give submissions 80 of the first 90 dispatches
+    EXPECT_EQ(scheduler.metrics(RequestPriority::SUBMIT).dispatched, 80u);
+    EXPECT_EQ(scheduler.metrics(RequestPriority::BACKFILL).dispatched, 10u);
+}
+
+TEST_F(RequestSchedulerTest, IdleClassesBankNoCredit) {
+    RequestScheduler scheduler(uncapped());
+    Clock::time_point now = Clock::now();
+    for (int i = 0; i < 100; ++i) {
+        scheduler.enqueue(RequestPriority::SUBMIT, now);
+        scheduler.next(now);
+    }
+
+    for (int i = 0; i < 20; ++i) {
+        scheduler.enqueue(RequestPriority::SUBMIT, now);
+        scheduler.enqueue(RequestPriority::BACKFILL, now);
+    }
+    for (int i = 0; i < 9; ++i) {
+        scheduler.next(now);
+    }
+    // Backfill starts level with submissions rather than 100 dispatches behind
+    EXPECT_LE(scheduler.metrics(RequestPriority::BACKFILL).dispatched, 2u);
+}
+
+TEST_F(RequestSchedulerTest, LimitsBoundWhatIsInFlight) {
+    RequestSchedulerConfig config = uncapped();
+    config.max_in_flight = 2;
+    config.submit_headroom = 1;
+    config.classes[static_cast<size_t>(RequestPriority::BACKFILL)].max_in_flight = 1;
+    RequestScheduler scheduler(config);
+    Clock::time_point now = Clock::now();
+
+    scheduler.enqueue(RequestPriority::BACKFILL, now);
+    scheduler.enqueue(RequestPriority::BACKFILL, now);
+    uint64_t read = scheduler.enqueue(RequestPriority::READ, now);
+    uint64_t backlog = scheduler.enqueue(RequestPriority::READ, now);
+    ASSERT_TRUE(scheduler.next(now).has_value());
+    ASSERT_TRUE(scheduler.next(now).has_value());
+    EXPECT_EQ(scheduler.metrics(RequestPriority::BACKFILL).in_flight, 1u);
+    EXPECT_FALSE(scheduler.next(now).has_value());
+
+    // Only submissions may use the headroom
+    uint64_t submit = scheduler.enqueue(RequestPriority::SUBMIT, now);
+    EXPECT_EQ(scheduler.next(now), submit);
+    EXPECT_FALSE(scheduler.next(now).has_value());
+
+    scheduler.finish(RequestPriority::SUBMIT);
+    scheduler.finish(RequestPriority::BACKFILL);
+    std::optional<uint64_t> freed = scheduler.next(now);
+    EXPECT_TRUE(freed == read || freed == backlog);
+    EXPECT_TRUE(scheduler.has_queued());
+}
+
+TEST_F(RequestSchedulerTest, StarvedRequestsGoFirst) {
+    RequestSchedulerConfig config = uncapped();
+    config.max_in_flight = 1;
+    config.starvation_threshold = std::chrono::milliseconds(250);
+    RequestScheduler scheduler(config);
+    Clock::time_point start = Clock::now();
+
+    scheduler.enqueue(RequestPriority::SUBMIT, start);
+    scheduler.next(start);
+    uint64_t backfill = scheduler.enqueue(RequestPriority::BACKFILL, start);
+    scheduler.enqueue(RequestPriority::SUBMIT, start + std::chrono::milliseconds(300));
+    scheduler.finish(RequestPriority::SUBMIT);
+
+    EXPECT_EQ(scheduler.next(start + std::chrono::milliseconds(300)), backfill);
+    EXPECT_EQ(scheduler.metrics(RequestPriority::BACKFILL).starved, 1u);
+}
+
+TEST_F(RequestSchedulerTest, MetricsRecordQueueWait) {
+    RequestScheduler scheduler(uncapped());
+    Clock::time_point start = Clock::now();
+    scheduler.enqueue(RequestPriority::CONFIRM, start);
+    uint64_t abandoned = scheduler.enqueue(RequestPriority::CONFIRM, start);
+    EXPECT_EQ(scheduler.metrics(RequestPriority::CONFIRM).queued, 2u);
+
+    EXPECT_TRUE(scheduler.cancel(abandoned));
+    EXPECT_FALSE(scheduler.cancel(abandoned));
+    scheduler.next(start + std::chrono::milliseconds(10));
+
+    PriorityClassMetrics metrics = scheduler.metrics(RequestPriority::CONFIRM);
+    EXPECT_EQ(metrics.dispatched, 1u);
+    EXPECT_EQ(metrics.queued, 0u);
+    EXPECT_EQ(metrics.in_flight, 1u);
+    EXPECT_EQ(metrics.max_wait, std::chrono::milliseconds(10));
+    EXPECT_GE(metrics.p99_wait, std::chrono::milliseconds(10));
+    EXPECT_LE(metrics.p99_wait, std::chrono::milliseconds(20));
+    EXPECT_FALSE(scheduler.has_queued());
+}
+
+TEST_F(RequestSchedulerTest, SubmissionsOvertakeQueuedBackfill) {
+    std::mutex mutex;
+    std::vector<std::string> served;
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::lock_guard<std::mutex> lock(mutex);
+        served.push_back(method);
+        return std::string("null");
+    });
+    RpcTransportConfig config;
+    config.scheduler.max_in_flight = 1;
+    config.scheduler.submit_headroom = 0;
+    RpcTransport transport(config);
+
+    const std::string backfill_body = R"({"jsonrpc":"2.0","id":1,"method":"getSignaturesForAddress","params":[]})";
+    const std::string submit_body = R"({"jsonrpc":"2.0","id":2,"method":"sendTransaction","params":[]})";
+    auto request_for = [&](const std::string& body, RequestPriority priority) {
+        HttpRequest request;
+        request.url = server.url();
+        request.body = &body;
+        request.deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        request.priority = priority;
+        return request;
+    };
+
+    std::vector<std::future<void>> done;
+    auto send = [&](const std::string& body, RequestPriority priority) {
+        auto promise = std::make_shared<std::promise<void>>();
+        done.push_back(promise->get_future());
+        transport.perform_async(request_for(body, priority), [promise](HttpResponse, std::exception_ptr error) {
+            if (error) {
+                promise->set_exception(error);
+            } else {
+                promise->set_value();
+            }
+        });
+    };
+    for (int i = 0; i < 10; ++i) {
+        send(backfill_body, RequestPriority::BACKFILL);
+    }
+    send(submit_body, RequestPriority::SUBMIT);
+    for (auto& result : done) {
+        result.get();
+    }
+
+    // At most the backfill request already on the wire went before it
+    auto position = std::find(served.begin(), served.end(), "sendTransaction") - served.begin();
+    EXPECT_LE(position, 1);
+    EXPECT_EQ(transport.queue_metrics(RequestPriority::BACKFILL).dispatched, 10u);
+    EXPECT_GT(transport.queue_metrics(RequestPriority::BACKFILL).max_wait, std::chrono::milliseconds(100));
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/retry_policy.hpp"
+#include "svm-pay/network/solana.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include <thread>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+namespace {
+
+template <typename E>
+std::exception_ptr make_error(const std::string& message = "test") {
+    return std::make_exception_ptr(E(message));
+}
+
+} // namespace
+
+class RetryPolicyTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(RetryPolicyTest, DecorrelatedJitterBounds) {
+    RetryPolicy policy;
+    policy.base_delay = milliseconds(10);
+    policy.max_delay = milliseconds(200);
+
+    milliseconds delay{0};
+    for (int i = 0; i < 100; ++i) {
+        delay = policy.next_delay(delay);
+        EXPECT_GE(delay.count(), 10);
+        EXPECT_LE(delay.count(), 200);
+    }
+
+    // Starting from the base delay the next one is at most three times larger
+    for (int i = 0; i < 100; ++i) {
+        auto next = policy.next_delay(milliseconds(10));
+        EXPECT_GE(next.count(), 10);
+        EXPECT_LE(next.count(), 30);
+    }
+}
+
+TEST_F(RetryPolicyTest, IdempotentMethods) {
+    EXPECT_TRUE(is_idempotent_rpc_method("getSignatureStatuses"));
+    EXPECT_TRUE(is_idempotent_rpc_method("getAccountInfo"));
+    EXPECT_FALSE(is_idempotent_rpc_method("sendTransaction"));
+}
+
+TEST_F(RetryPolicyTest, RetryableFailures) {
+    // Never delivered: safe for every method
+    EXPECT_TRUE(is_retryable_failure(make_error<ConnectionException>(), false));
+    EXPECT_TRUE(is_retryable_failure(make_error<RateLimitException>(), false));
+    EXPECT_TRUE(is_retryable_failure(make_error<CircuitOpenException>(), false));
+
+    // Ambiguous: only for reads
+    EXPECT_TRUE(is_retryable_failure(make_error<NetworkException>(), true));
+    EXPECT_FALSE(is_retryable_failure(make_error<NetworkException>(), false));
+
+    // Load shedding and non-network errors are final
+    EXPECT_FALSE(is_retryable_failure(make_error<BackpressureException>(), true));
+    EXPECT_FALSE(is_retryable_failure(make_error<std::runtime_error>(), true));
+}
+
+TEST_F(RetryPolicyTest, CircuitBreakerOpensAndProbes) {
+    CircuitBreakerConfig config;
+    config.failure_threshold = 3;
+    config.open_duration = milliseconds(30);
+    CircuitBreaker breaker(config);
+
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_TRUE(breaker.allow_request());
+        breaker.record_failure();
+    }
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::CLOSED);
+
+    breaker.record_failure();
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::OPEN);
+    EXPECT_TRUE(breaker.is_open());
+    EXPECT_FALSE(breaker.allow_request());
+
+    std::this_thread::sleep_for(milliseconds(40));
+    EXPECT_FALSE(breaker.is_open());
+
+    // One probe only
+    EXPECT_TRUE(breaker.allow_request());
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::HALF_OPEN);
+    EXPECT_FALSE(breaker.allow_request());
+
+    // Failed probe re-opens immediately
+    breaker.record_failure();
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::OPEN);
+
+    std::this_thread::sleep_for(milliseconds(40));
+    EXPECT_TRUE(breaker.allow_request());
+    breaker.record_success();
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::CLOSED);
+}
+
+TEST_F(RetryPolicyTest, ReleasedProbeStaysHalfOpen) {
+    CircuitBreakerConfig config;
+    config.failure_threshold = 1;
+    config.open_duration = milliseconds(10);
+    CircuitBreaker breaker(config);
+
+    breaker.record_failure();
+    std::this_thread::sleep_for(milliseconds(20));
+    EXPECT_TRUE(breaker.allow_request());
+
+    // A cancelled probe proves nothing; the next caller probes instead
+    breaker.release_probe();
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::HALF_OPEN);
+    EXPECT_TRUE(breaker.allow_request());
+    EXPECT_FALSE(breaker.allow_request());
+}
+
+TEST_F(RetryPolicyTest, SuccessResetsFailureRun) {
+    CircuitBreakerConfig config;
+    config.failure_threshold = 2;
+    CircuitBreaker breaker(config);
+
+    breaker.record_failure();
+    breaker.record_success();
+    breaker.record_failure();
+    EXPECT_EQ(breaker.state(), CircuitBreaker::State::CLOSED);
+}
+
+TEST_F(RetryPolicyTest, DisabledBreaker) {
+    CircuitBreakerConfig config;
+    config.failure_threshold = 0;
+    CircuitBreaker breaker(config);
+    for (int i = 0; i < 100; ++i) {
+        breaker.record_failure();
+    }
+    EXPECT_TRUE(breaker.allow_request());
+}
+
+TEST_F(RetryPolicyTest, AdapterRetriesAndOpensCircuit) {
+    // Nothing listens on port 1, so every attempt fails to connect
+    EndpointPoolConfig config;
+    config.urls = {"http://127.0.0.1:1"};
+    config.retry.max_attempts = 3;
+    config.retry.base_delay = milliseconds(1);
+    config.retry.max_delay = milliseconds(5);
+    config.circuit_breaker.failure_threshold = 3;
+    config.circuit_breaker.open_duration = milliseconds(60000);
+    SolanaNetworkAdapter adapter(config);
+
+    auto status = adapter.check_transaction_status("signature");
+    EXPECT_THROW(status.get(), ConnectionException);
+
+    auto& endpoint = *adapter.get_endpoint_pool().snapshot()->endpoints.front();
+    EXPECT_EQ(endpoint.breaker().state(), CircuitBreaker::State::OPEN);
+
+    // Further calls fail fast without touching the network
+    auto again = adapter.check_transaction_status("signature");
+    EXPECT_THROW(again.get(), CircuitOpenException);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "svm-pay/core/pda.hpp"
+#include "svm-pay/core/sha256.hpp"
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace svm_pay;
+
+namespace {
+
+const Sha256Implementation IMPLEMENTATIONS[] = {
+    Sha256Implementation::SCALAR,
+    Sha256Implementation::AVX2,
+    Sha256Implementation::SHA_NI
+};
+
+std::string hex(const uint8_t* digest) {
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string out;
+    for (size_t i = 0; i < SHA256_SIZE; ++i) {
+        out += DIGITS[digest[i] >> 4];
+        out += DIGITS[digest[i] & 0x0F];
+    }
+    return out;
+}
+
+std::string hash(const std::string& message) {
+    uint8_t digest[SHA256_SIZE];
+    sha256(reinterpret_cast<const uint8_t*>(message.data()), message.size(), digest);
+    return hex(digest);
+}
+
+std::vector<std::string> hash_many(const std::vector<std::string>& messages) {
+    std::vector<const uint8_t*> pointers;
+    std::vector<size_t> sizes;
+    for (const auto& message : messages) {
+        pointers.push_back(reinterpret_cast<const uint8_t*>(message.data()));
+        sizes.push_back(message.size());
+    }
+    std::vector<uint8_t> digests(messages.size() * SHA256_SIZE);
+    sha256_many(pointers.data(), sizes.data(), messages.size(), digests.data());
+    std::vector<std::string> out;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        out.push_back(hex(digests.data() + i * SHA256_SIZE));
+    }
+    return out;
+}
+
+} // namespace
+
+class Sha256Test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        original_ = sha256_implementation();
+    }
+
+    void TearDown() override {
+        set_sha256_implementation(original_);
+    }
+
+private:
+    Sha256Implementation original_ = Sha256Implementation::SCALAR;
+};
+
+TEST_F(Sha256Test, MatchesNistVectors) {
+    const std::string EMPTY = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+    const std::string ABC = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+    // 56 bytes: the length no longer fits the first block
+    const std::string TWO_BLOCKS = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    const std::string TWO_BLOCKS_DIGEST = "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1";
+    const std::string MILLION_A_DIGEST = "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0";
+
+    for (auto implementation : IMPLEMENTATIONS) {
+        if (!set_sha256_implementation(implementation)) {
+            continue;
+        }
+        EXPECT_EQ(hash(""), EMPTY);
+        EXPECT_EQ(hash("abc"), ABC);
+        EXPECT_EQ(hash(TWO_BLOCKS), TWO_BLOCKS_DIGEST);
+        EXPECT_EQ(hash(std::string(1000000, 'a')), MILLION_A_DIGEST);
+
+        std::vector<std::string> digests = hash_many({"abc", "", TWO_BLOCKS, std::string(1000000, 'a')});
+        EXPECT_EQ(digests, (std::vector<std::string>{ABC, EMPTY, TWO_BLOCKS_DIGEST, MILLION_A_DIGEST}));
+    }
+}
+
+TEST_F(Sha256Test, HashesMixedLengthBatches) {
+    // Lengths around every padding boundary, in batches that do not fill
+    // the lanes evenly
+    std::mt19937 random(7);
+    std::vector<std::string> messages;
+    for (size_t size = 0; size <= 300; ++size) {
+        std::string message(size, '\0');
+        for (auto& c : message) {
+            c = static_cast<char>(random());
+        }
+        messages.push_back(message);
+    }
+    std::shuffle(messages.begin(), messages.end(), random);
+
+    ASSERT_TRUE(set_sha256_implementation(Sha256Implementation::SCALAR));
+    EXPECT_EQ(sha256_lanes(), 1u);
+    std::vector<std::string> expected;
+    for (const auto& message : messages) {
+        expected.push_back(hash(message));
+    }
+
+    for (auto implementation : IMPLEMENTATIONS) {
+        if (!set_sha256_implementation(implementation)) {
+            continue;
+        }
+        if (implementation != Sha256Implementation::SCALAR) {
+            EXPECT_GT(sha256_lanes(), 1u);
+        }
+        EXPECT_EQ(hash_many(messages), expected);
+        for (size_t batch : {size_t(1), size_t(3), size_t(8), size_t(9)}) {
+            std::vector<std::string> part(messages.begin(), messages.begin() + batch);
+            EXPECT_EQ(hash_many(part), std::vector<std::string>(expected.begin(), expected.begin() + batch));
+        }
+        for (size_t i = 0; i < messages.size(); i += 37) {
+            EXPECT_EQ(hash(messages[i]), expected[i]);
+        }
+    }
+}
+
+TEST_F(Sha256Test, DerivesTheSameAddressesOnEveryImplementation) {
+    PublicKey mint = PublicKey::from_base58("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v");
+    PublicKey wallet = PublicKey::from_base58("9WzDXwBbmkg8ZTbNMqUxvQRAyrZzDsGYdLVL9zYtAWWM");
+    std::array<uint8_t, PublicKey::SIZE> fours;
+    fours.fill(4);
+
+    for (auto implementation : IMPLEMENTATIONS) {
+        if (!set_sha256_implementation(implementation)) {
+            continue;
+        }
+        ProgramAddress ata = derive_associated_token_address(wallet, mint);
+        EXPECT_EQ(ata.address.to_base58(), "FGETo8T8wMcN2wCjav8VK6eh3dLk63evNDPxzLSJra8B");
+        EXPECT_EQ(ata.bump, 254);
+        // Eight bumps: the whole first batch of eight lanes is on the curve
+        ata = derive_associated_token_address(PublicKey(fours), mint);
+        EXPECT_EQ(ata.address.to_base58(), "DhscvS2mfxadjGkSvoGxKzgEi6ZnuLunmFEjcZ5sd5u1");
+        EXPECT_EQ(ata.bump, 248);
+    }
+}
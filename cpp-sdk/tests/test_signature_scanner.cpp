@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/signature_scanner.hpp"
+#include "svm-pay/core/base58.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace svm_pay;
+using std::chrono::milliseconds;
+
+namespace {
+
+PublicKey filled_key(uint8_t byte) {
+    std::array<uint8_t, PublicKey::SIZE> bytes;
+    bytes.fill(byte);
+    return PublicKey(bytes);
+}
+
+std::string make_signature(uint32_t serial) {
+    uint8_t bytes[64] = {};
+    for (size_t i = 0; i < 4; ++i) {
+        bytes[i] = static_cast<uint8_t>(serial >> (8 * i));
+    }
+    bytes[63] = 0x5A;
+    return encode_base58(bytes, sizeof(bytes));
+}
+
+/**
+ * Node answering getSignaturesForAddress from per-address histories kept
+ * newest first
+ */
+class HistoryNode {
+public:
+    HistoryNode()
+        : server_([this](const std::string& method, const JsonValue& params) -> std::string {
+              if (method != "getSignaturesForAddress") {
+                  throw std::runtime_error("unexpected method " + method);
+              }
+              std::string address = params.as_array().at(0).as_string();
+              const JsonValue& options = params.as_array().at(1);
+              size_t limit = static_cast<size_t>(options["limit"].as_uint64());
+              std::string before = options["before"].is_string() ? options["before"].as_string() : "";
+              std::string until = options["until"].is_string() ? options["until"].as_string() : "";
+
+              std::lock_guard<std::mutex> lock(mutex_);
+              if (failing_) {
+                  throw std::runtime_error("node unavailable");
+              }
+              const std::vector<std::string>& history = histories_[address];
+              size_t start = 0;
+              if (!before.empty()) {
+                  while (start < history.size() && history[start] != before) {
+                      ++start;
+                  }
+                  ++start;
+              }
+              std::string result = "[";
+              size_t count = 0;
+              for (size_t i = start; i < history.size() && count < limit && history[i] != until; ++i, ++count) {
+                  result += (count == 0 ? "" : ",") + std::string(R"({"signature":")") + history[i] +
+                            R"(","slot":)" + std::to_string(1000 - i) +
+                            R"(,"err":null,"memo":null,"blockTime":1700000000,"confirmationStatus":"finalized"})";
+              }
+              return result + "]";
+          }) {
+        EndpointPoolConfig config;
+        config.urls.push_back(server_.url());
+        config.retry.max_attempts = 1;
+        adapter_ = std::make_unique<SvmNetworkAdapter>(SVMNetwork::SOLANA, config, std::make_shared<RpcTransport>());
+    }
+
+    SvmNetworkAdapter& adapter() { return *adapter_; }
+
+    // Adds count transactions touching the address; returns them newest first
+    std::vector<std::string> add(const PublicKey& address, size_t count) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string>& history = histories_[address.to_base58()];
+        std::vector<std::string> added;
+        for (size_t i = 0; i < count; ++i) {
+            added.insert(added.begin(), make_signature(next_serial_++));
+        }
+        history.insert(history.begin(), added.begin(), added.end());
+        return added;
+    }
+
+    void set_failing(bool failing) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failing_ = failing;
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, std::vector<std::string>> histories_;
+    uint32_t next_serial_ = 1;
+    bool failing_ = false;
+    svm_pay_test::StandInRpcServer server_;
+    std::unique_ptr<SvmNetworkAdapter> adapter_;
+};
+
+/**
+ * Collects what a scanner reports
+ */
+class Reports {
+public:
+    SignatureCallback callback() {
+        return [this](const PublicKey& address, const SignatureInfo& signature) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            signatures_[address.to_base58()].push_back(signature.signature);
+            ++count_;
+        };
+    }
+
+    std::vector<std::string> take(const PublicKey& address) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> taken;
+        taken.swap(signatures_[address.to_base58()]);
+        return taken;
+    }
+
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, std::vector<std::string>> signatures_;
+    size_t count_ = 0;
+};
+
+SignatureScannerConfig manual_config(const std::string& path = std::string()) {
+    SignatureScannerConfig config;
+    config.path = path;
+    config.page_size = 10;
+    config.interval = milliseconds(0);
+    return config;
+}
+
+std::string temporary_path(const std::string& name) {
+    return testing::TempDir() + name + "-" + std::to_string(getpid());
+}
+
+} // namespace
+
+class SignatureScannerTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(SignatureScannerTest, PagesHistoriesAndReportsOnlyNewSignatures) {
+    HistoryNode node;
+    PublicKey busy = filled_key(1);
+    PublicKey quiet = filled_key(2);
+    std::vector<std::string> busy_history = node.add(busy, 25);
+    std::vector<std::string> quiet_history = node.add(quiet, 3);
+
+    Reports reports;
+    SignatureScanner scanner(node.adapter(), reports.callback(), manual_config());
+    scanner.watch(busy);
+    scanner.watch(quiet);
+    scanner.watch(filled_key(3));  // No history at all
+    EXPECT_EQ(scanner.size(), 3u);
+
+    // Three pages for the long history, newest first; one each for the others
+    EXPECT_EQ(scanner.scan(), 28u);
+    EXPECT_EQ(reports.take(busy), busy_history);
+    EXPECT_EQ(reports.take(quiet), quiet_history);
+    EXPECT_EQ(scanner.page_count(), 5u);
+
+    // Nothing new: one page per address, stopping at the until cursor
+    EXPECT_EQ(scanner.scan(), 0u);
+    EXPECT_EQ(scanner.page_count(), 8u);
+
+    std::vector<std::string> fresh = node.add(busy, 12);
+    EXPECT_EQ(scanner.scan(), 12u);
+    EXPECT_EQ(reports.take(busy), fresh);
+    EXPECT_TRUE(reports.take(quiet).empty());
+
+    // Watching from a known signature skips everything up to it
+    PublicKey late = filled_key(4);
+    std::vector<std::string> late_history = node.add(late, 6);
+    scanner.watch(late, late_history[2]);
+    EXPECT_EQ(scanner.scan(), 2u);
+    EXPECT_EQ(reports.take(late), std::vector<std::string>(late_history.begin(), late_history.begin() + 2));
+    EXPECT_THROW(scanner.watch(filled_key(5), "not a signature"), std::invalid_argument);
+
+    // One page straight from the adapter
+    SignatureQuery query;
+    query.before = busy_history[1];
+    query.limit = 3;
+    std::vector<SignatureInfo> page = node.adapter().get_signatures_for_address(busy, query).get();
+    ASSERT_EQ(page.size(), 3u);
+    EXPECT_EQ(page[0].signature, busy_history[2]);
+    EXPECT_EQ(page[0].block_time, 1700000000);
+    EXPECT_EQ(page[0].confirmation_status, "finalized");
+    EXPECT_FALSE(page[0].err);
+    query.limit = 1001;
+    EXPECT_THROW(node.adapter().get_signatures_for_address(busy, query), std::invalid_argument);
+
+    scanner.unwatch(late);
+    EXPECT_FALSE(scanner.is_watched(late));
+    EXPECT_TRUE(scanner.is_watched(busy));
+}
+
+TEST_F(SignatureScannerTest, ResumesFromPersistedCursors) {
+    std::string path = temporary_path("signature-cursors");
+    std::remove(path.c_str());
+    HistoryNode node;
+    PublicKey reference = filled_key(7);
+    std::vector<std::string> history = node.add(reference, 25);
+
+    // The callback fails partway through the second page: the first page
+    // stays handled, the second is reported again after the restart
+    {
+        size_t seen = 0;
+        SignatureScanner scanner(node.adapter(), [&seen](const PublicKey&, const SignatureInfo&) {
+            if (++seen == 15) {
+                throw std::runtime_error("verifier unavailable");
+            }
+        }, manual_config(path));
+        scanner.watch(reference);
+        EXPECT_THROW(scanner.scan(), std::runtime_error);
+    }
+
+    Reports reports;
+    {
+        SignatureScanner scanner(node.adapter(), reports.callback(), manual_config(path));
+        EXPECT_TRUE(scanner.is_watched(reference));
+        EXPECT_EQ(scanner.scan(), 15u);
+        EXPECT_EQ(reports.take(reference), std::vector<std::string>(history.begin() + 10, history.end()));
+    }
+
+    // The finished scan's cursor survives too: only new signatures come back
+    std::vector<std::string> fresh = node.add(reference, 2);
+    {
+        SignatureScanner scanner(node.adapter(), reports.callback(), manual_config(path));
+        EXPECT_EQ(scanner.scan(), 2u);
+        EXPECT_EQ(reports.take(reference), fresh);
+    }
+    std::remove(path.c_str());
+
+    std::string foreign = temporary_path("not-cursors");
+    std::ofstream(foreign) << "definitely not a cursor file";
+    EXPECT_THROW(SignatureScanner(node.adapter(), reports.callback(), manual_config(foreign)), SVMPayException);
+    std::remove(foreign.c_str());
+}
+
+TEST_F(SignatureScannerTest, RetriesFailedPagesAndScansInTheBackground) {
+    HistoryNode node;
+    std::vector<PublicKey> references;
+    for (uint8_t byte = 10; byte < 30; ++byte) {
+        references.push_back(filled_key(byte));
+        node.add(references.back(), 4);
+    }
+
+    Reports reports;
+    {
+        SignatureScanner scanner(node.adapter(), reports.callback(), manual_config());
+        for (const auto& reference : references) {
+            scanner.watch(reference);
+        }
+        node.set_failing(true);
+        EXPECT_EQ(scanner.scan(), 0u);
+        EXPECT_EQ(scanner.failure_count(), references.size());
+
+        node.set_failing(false);
+        EXPECT_EQ(scanner.scan(), 4 * references.size());
+    }
+
+    SignatureScannerConfig config = manual_config();
+    config.interval = milliseconds(20);
+    config.max_concurrent_pages = 4;
+    SignatureScanner scanner(node.adapter(), reports.callback(), config);
+    for (const auto& reference : references) {
+        scanner.watch(reference);
+    }
+    size_t expected = reports.count() + 4 * references.size();
+    auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (reports.count() < expected && std::chrono::steady_clock::now() < give_up) {
+        std::this_thread::sleep_for(milliseconds(5));
+    }
+    EXPECT_EQ(reports.count(), expected);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include "svm-pay/core/batch_signer.hpp"
+#include "svm-pay/core/base58.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/keypair.hpp"
+#include "svm-pay/core/transaction.hpp"
+#include <string>
+#include <vector>
+
+using namespace svm_pay;
+
+namespace {
+
+std::vector<uint8_t> from_hex(const std::string& hex) {
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+        bytes.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+MessageView view(const std::string& message) {
+    return {reinterpret_cast<const uint8_t*>(message.data()), message.size()};
+}
+
+} // namespace
+
+class SigningTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(SigningTest, MatchesRfc8032Vector) {
+    auto seed = from_hex("9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60");
+    auto public_key = from_hex("d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a");
+    auto expected = from_hex("e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b");
+
+    Keypair keypair = Keypair::from_seed(seed.data());
+    EXPECT_EQ(std::vector<uint8_t>(keypair.public_key().bytes().begin(), keypair.public_key().bytes().end()), public_key);
+
+    Signature signature = keypair.sign(nullptr, 0);
+    EXPECT_EQ(std::vector<uint8_t>(signature.begin(), signature.end()), expected);
+    EXPECT_TRUE(verify_signature(keypair.public_key(), nullptr, 0, signature));
+    signature[0] ^= 1;
+    EXPECT_FALSE(verify_signature(keypair.public_key(), nullptr, 0, signature));
+}
+
+TEST_F(SigningTest, SecretKeyRoundTrip) {
+    Keypair keypair = Keypair::generate();
+    auto secret = keypair.secret_key();
+    Keypair loaded = Keypair::from_base58(encode_base58(secret.data(), secret.size()));
+    EXPECT_EQ(loaded.public_key(), keypair.public_key());
+
+    std::string message = "payout";
+    Signature signature = loaded.sign(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    EXPECT_TRUE(verify_signature(keypair.public_key(), reinterpret_cast<const uint8_t*>(message.data()), message.size(), signature));
+
+    // The public half must belong to the seed
+    secret[40] ^= 1;
+    EXPECT_THROW(Keypair::from_secret_key(secret.data(), secret.size()), CryptographicException);
+    EXPECT_THROW(Keypair::from_secret_key(secret.data(), 32), CryptographicException);
+    EXPECT_THROW(Keypair::from_base58("not-base58"), CryptographicException);
+}
+
+TEST_F(SigningTest, BatchSignAndVerify) {
+    Keypair signer = Keypair::generate();
+    Keypair other = Keypair::generate();
+    BatchSignerConfig config;
+    config.workers = 4;
+    config.min_items_per_worker = 8;
+    config.key_cache_capacity = 1;
+    BatchSigner batch(config);
+
+    std::vector<std::string> messages;
+    for (int i = 0; i < 200; ++i) {
+        messages.push_back("message-" + std::to_string(i));
+    }
+    std::vector<MessageView> views;
+    for (const auto& message : messages) {
+        views.push_back(view(message));
+    }
+
+    auto signatures = batch.sign(signer, views);
+    ASSERT_EQ(signatures.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(signatures[i], signer.sign(views[i].data, views[i].size));
+    }
+
+    std::vector<SignatureCheck> checks;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        // Alternate keys so the one-entry key cache keeps turning over
+        checks.push_back({i % 3 == 0 ? other.public_key() : signer.public_key(), views[i], signatures[i]});
+    }
+    auto results = batch.verify(checks);
+    for (size_t i = 0; i < checks.size(); ++i) {
+        EXPECT_EQ(results[i], i % 3 != 0) << i;
+    }
+
+    // Contexts are reused across batches
+    bool valid[200];
+    EXPECT_EQ(batch.verify(checks.data(), checks.size(), valid), 133u);
+    EXPECT_TRUE(batch.sign(signer, std::vector<MessageView>{}).empty());
+}
+
+TEST_F(SigningTest, SignsAndVerifiesTransactions) {
+    Keypair payer = Keypair::generate();
+    Keypair owner = Keypair::generate();
+    std::array<uint8_t, PublicKey::SIZE> bytes;
+    bytes.fill(7);
+    PublicKey account(bytes);
+
+    TransactionBuilder builder;
+    builder.set_fee_payer(payer.public_key()).set_recent_blockhash(account);
+    builder.add_transfer_checked(account, account, account, owner.public_key(), 1, 6);
+    builder.add_memo("signed");
+
+    uint8_t buffer[TransactionBuilder::MAX_TRANSACTION_SIZE];
+    EXPECT_THROW(builder.serialize_signed({payer}, buffer, sizeof(buffer)), TransactionException);
+    size_t size = builder.serialize_signed({owner, payer}, buffer, sizeof(buffer));
+    EXPECT_TRUE(verify_transaction(buffer, size));
+
+    // An unsigned transaction does not verify
+    size_t unsigned_size = builder.serialize(buffer + 0, sizeof(buffer));
+    EXPECT_FALSE(verify_transaction(buffer, unsigned_size));
+
+    builder.set_version(MessageVersion::V0);
+    size = builder.serialize_signed({owner, payer}, buffer, sizeof(buffer));
+    EXPECT_TRUE(verify_transaction(buffer, size));
+    buffer[size - 1] ^= 1;
+    EXPECT_FALSE(verify_transaction(buffer, size));
+    EXPECT_FALSE(verify_transaction(buffer, 10));
+
+    uint16_t value;
+    const uint8_t overlong[] = {0x80, 0x00};
+    EXPECT_EQ(decode_compact_u16(overlong, 2, value), 0u);
+    const uint8_t too_large[] = {0xff, 0xff, 0x04};
+    EXPECT_EQ(decode_compact_u16(too_large, 3, value), 0u);
+    const uint8_t valid[] = {0x80, 0x01};
+    EXPECT_EQ(decode_compact_u16(valid, 2, value), 2u);
+    EXPECT_EQ(value, 0x80);
+}
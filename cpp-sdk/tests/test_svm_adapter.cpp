@@ -0,0 +1,321 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/svm_adapter.hpp"
+#include "svm-pay/network/rpc_transport.hpp"
+#include "svm-pay/svm_pay.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace svm_pay;
+
+namespace {
+
+const char BLOCKHASH_RESULT[] =
+    R"({"context":{"slot":7},"value":{"blockhash":"11111111111111111111111111111111","lastValidBlockHeight":9}})";
+
+EndpointPoolConfig endpoints_for(const std::string& url) {
+    EndpointPoolConfig config;
+    config.urls.push_back(url);
+    return config;
+}
+
+} // namespace
+
+class SvmAdapterTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(SvmAdapterTest, NetworksShareOneTransport) {
+    svm_pay_test::StandInRpcServer server([](const std::string&, const JsonValue&) {
+        return std::string(BLOCKHASH_RESULT);
+    });
+    auto transport = std::make_shared<RpcTransport>();
+    SvmNetworkAdapter sonic(SVMNetwork::SONIC, endpoints_for(server.url()), transport);
+    SvmNetworkAdapter eclipse(SVMNetwork::ECLIPSE, endpoints_for(server.url()), transport);
+    EXPECT_EQ(sonic.get_network(), SVMNetwork::SONIC);
+    EXPECT_EQ(&sonic.transport(), &eclipse.transport());
+
+    EXPECT_EQ(sonic.get_latest_blockhash().get().slot, 7u);
+    EXPECT_EQ(sonic.get_latest_blockhash().get().slot, 7u);
+    EXPECT_EQ(eclipse.get_latest_blockhash().get().last_valid_block_height, 9u);
+
+    // Metrics are kept per network and summed over all of them
+    EXPECT_EQ(transport->metrics(SVMNetwork::SONIC).requests, 2u);
+    EXPECT_EQ(transport->metrics(SVMNetwork::ECLIPSE).requests, 1u);
+    EXPECT_EQ(transport->metrics(SVMNetwork::SOLANA).requests, 0u);
+    TransportMetrics total = transport->metrics();
+    EXPECT_EQ(total.requests, 3u);
+    EXPECT_EQ(total.failures, 0u);
+    EXPECT_EQ(total.in_flight, 0u);
+    EXPECT_GT(total.bytes_sent, 0u);
+    EXPECT_GT(total.bytes_received, 0u);
+
+    // Adapters use the process-wide transport unless given another
+    SvmNetworkAdapter soon(SVMNetwork::SOON);
+    SvmNetworkAdapter solana(SVMNetwork::SOLANA);
+    EXPECT_EQ(&soon.transport(), &solana.transport());
+    EXPECT_EQ(&soon.transport(), RpcTransport::shared().get());
+    EXPECT_EQ(soon.get_rpc_url(), SvmNetworkAdapter::default_rpc_url(SVMNetwork::SOON));
+}
+
+TEST_F(SvmAdapterTest, ConnectionsAreReusedAcrossNetworks) {
+    svm_pay_test::StandInRpcServer server([](const std::string&, const JsonValue&) {
+        return std::string(BLOCKHASH_RESULT);
+    });
+    server.set_keep_alive(true);
+    auto transport = std::make_shared<RpcTransport>();
+    SvmNetworkAdapter sonic(SVMNetwork::SONIC, endpoints_for(server.url()), transport);
+    SvmNetworkAdapter soon(SVMNetwork::SOON, endpoints_for(server.url()), transport);
+
+    for (int i = 0; i < 5; ++i) {
+        sonic.get_latest_blockhash().get();
+        soon.get_latest_blockhash().get();
+    }
+    EXPECT_EQ(server.request_count(), 10u);
+    EXPECT_EQ(server.connection_count(), 1u);
+    EXPECT_EQ(transport->metrics().connections_opened, 1u);
+}
+
+TEST_F(SvmAdapterTest, FailuresAreCounted) {
+    auto transport = std::make_shared<RpcTransport>();
+    EndpointPoolConfig config = endpoints_for("http://127.0.0.1:1");
+    config.retry.max_attempts = 1;
+    SvmNetworkAdapter adapter(SVMNetwork::ECLIPSE, config, transport);
+    EXPECT_THROW(adapter.get_latest_blockhash().get(), ConnectionException);
+    EXPECT_EQ(transport->metrics(SVMNetwork::ECLIPSE).failures, 1u);
+    EXPECT_EQ(transport->metrics(SVMNetwork::ECLIPSE).in_flight, 0u);
+}
+
+TEST_F(SvmAdapterTest, HedgeLoserRecordsNothing) {
+    // The first request, on whichever endpoint is primary, stalls; the hedge answers
+    std::atomic<int> requests{0};
+    auto handler = [&requests](const std::string&, const JsonValue&) {
+        if (requests.fetch_add(1) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        }
+        return std::string(BLOCKHASH_RESULT);
+    };
+    svm_pay_test::StandInRpcServer first(handler);
+    svm_pay_test::StandInRpcServer second(handler);
+    EndpointPoolConfig config = endpoints_for(first.url());
+    config.urls.push_back(second.url());
+    config.hedging_enabled = true;
+    config.min_hedge_delay = std::chrono::milliseconds(20);
+    config.max_hedge_delay = std::chrono::milliseconds(20);
+    config.retry.max_attempts = 1;
+    config.circuit_breaker.failure_threshold = 1;
+    SvmNetworkAdapter adapter(SVMNetwork::SOON, config, std::make_shared<RpcTransport>());
+
+    EXPECT_EQ(adapter.get_latest_blockhash().get().slot, 7u);
+    EXPECT_EQ(requests.load(), 2);
+
+    // The aborted primary neither counts as a failure nor trips its breaker
+    auto endpoints = adapter.get_endpoint_pool().snapshot()->endpoints;
+    for (int i = 0; i < 100 && (endpoints[0]->in_flight() > 0 || endpoints[1]->in_flight() > 0); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    for (const auto& endpoint : endpoints) {
+        EXPECT_EQ(endpoint->in_flight(), 0u);
+        EXPECT_EQ(endpoint->error_rate(), 0.0);
+        EXPECT_EQ(endpoint->breaker().state(), CircuitBreaker::State::CLOSED);
+    }
+}
+
+TEST_F(SvmAdapterTest, SubmissionsOvertakeQueuedReads) {
+    std::mutex mutex;
+    std::vector<std::string> served;
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::lock_guard<std::mutex> lock(mutex);
+        served.push_back(method);
+        return method == "sendTransaction" ? std::string("\"sig\"") : std::string(BLOCKHASH_RESULT);
+    });
+    EndpointPoolConfig config = endpoints_for(server.url());
+    config.rate_limit.initial_concurrency = 2;
+    config.rate_limit.max_concurrency = 2;
+    SvmNetworkAdapter adapter(SVMNetwork::SOON, config, std::make_shared<RpcTransport>());
+
+    // Reads saturate the endpoint's limiter, then a submission arrives
+    std::vector<std::future<void>> done;
+    auto track = [&done]() {
+        auto promise = std::make_shared<std::promise<void>>();
+        done.push_back(promise->get_future());
+        return promise;
+    };
+    for (int i = 0; i < 10; ++i) {
+        adapter.get_latest_blockhash_async(CallOptions{}, [promise = track()](LatestBlockhash, std::exception_ptr error) {
+            error ? promise->set_exception(error) : promise->set_value();
+        });
+    }
+    adapter.submit_transaction_async("AQID", "", CallOptions{}, [promise = track()](std::string, std::exception_ptr error) {
+        error ? promise->set_exception(error) : promise->set_value();
+    });
+    for (auto& result : done) {
+        result.get();
+    }
+
+    // At most the reads already admitted went before it
+    auto position = std::find(served.begin(), served.end(), "sendTransaction") - served.begin();
+    EXPECT_LE(position, 2);
+    EXPECT_EQ(served.size(), 11u);
+}
+
+TEST_F(SvmAdapterTest, InitializeRegistersEveryNetwork) {
+    initialize_sdk({{"sonic_rpc_url", "https://sonic.example.com"},
+                    {"eclipse_rpc_urls", "https://a.example.com, https://b.example.com"}});
+
+    for (auto network : {SVMNetwork::SOLANA, SVMNetwork::SONIC, SVMNetwork::ECLIPSE, SVMNetwork::SOON}) {
+        auto adapter = std::dynamic_pointer_cast<SvmNetworkAdapter>(NetworkAdapterFactory::get_adapter(network));
+        ASSERT_NE(adapter, nullptr);
+        EXPECT_EQ(adapter->get_network(), network);
+        EXPECT_EQ(&adapter->transport(), RpcTransport::shared().get());
+    }
+    auto sonic = std::dynamic_pointer_cast<SvmNetworkAdapter>(NetworkAdapterFactory::get_adapter(SVMNetwork::SONIC));
+    EXPECT_EQ(sonic->get_rpc_url(), "https://sonic.example.com");
+    auto eclipse = std::dynamic_pointer_cast<SvmNetworkAdapter>(NetworkAdapterFactory::get_adapter(SVMNetwork::ECLIPSE));
+    EXPECT_EQ(eclipse->get_endpoint_pool().snapshot()->endpoints.size(), 2u);
+    auto soon = std::dynamic_pointer_cast<SvmNetworkAdapter>(NetworkAdapterFactory::get_adapter(SVMNetwork::SOON));
+    EXPECT_EQ(soon->get_rpc_url(), "https://rpc.soon.network");
+}
+
+TEST_F(SvmAdapterTest, WarmUpOpensConnectionsAhead) {
+    std::atomic<int> health_checks{0};
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue&) {
+        if (method == "getHealth") {
+            ++health_checks;
+            return std::string(R"("ok")");
+        }
+        return std::string(BLOCKHASH_RESULT);
+    });
+    server.set_keep_alive(true);
+    auto transport = std::make_shared<RpcTransport>();
+    SvmNetworkAdapter adapter(SVMNetwork::SOON, endpoints_for(server.url()), transport);
+
+    EXPECT_EQ(adapter.warm_up().get(), 1u);
+    EXPECT_EQ(health_checks.load(), 1);
+    EXPECT_EQ(adapter.get_latest_blockhash().get().slot, 7u);
+    EXPECT_EQ(server.connection_count(), 1u);
+    EXPECT_EQ(transport->metrics().connections_opened, 1u);
+
+    // An unreachable endpoint stays cold without failing the warm-up
+    SvmNetworkAdapter cold(SVMNetwork::SOON, endpoints_for("http://127.0.0.1:1"), transport);
+    EXPECT_EQ(cold.warm_up().get(), 0u);
+}
+
+TEST_F(SvmAdapterTest, InitializeWarmsSelectedNetworks) {
+    std::atomic<int> health_checks{0};
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue&) {
+        if (method == "getHealth") {
+            ++health_checks;
+        }
+        return std::string(R"("ok")");
+    });
+    initialize_sdk({{"sonic_rpc_url", server.url()},
+                    {"eclipse_rpc_url", server.url()},
+                    {"warm_up", "sonic"}});
+    EXPECT_EQ(health_checks.load(), 1);
+}
+
+TEST_F(SvmAdapterTest, InitializeInstallsTheExecutorFirst) {
+    class CountingExecutor : public Executor {
+    public:
+        void execute(std::function<void()> task) override {
+            ++tasks;
+            task();
+        }
+        std::atomic<int> tasks{0};
+    };
+
+    svm_pay_test::StandInRpcServer server([](const std::string&, const JsonValue&) {
+        return std::string(R"("ok")");
+    });
+    auto executor = std::make_shared<CountingExecutor>();
+    // The pool options give way to the supplied executor, which the warm-up already runs on
+    initialize_sdk({{"sonic_rpc_url", server.url()},
+                    {"warm_up", "sonic"},
+                    {"executor_threads", "2"}},
+                   executor);
+    EXPECT_EQ(default_executor(), executor);
+    EXPECT_EQ(executor->tasks.load(), 1);
+    set_default_executor(nullptr);
+}
+
+TEST_F(SvmAdapterTest, AsyncCallsCompleteWithoutBlocking) {
+    svm_pay_test::StandInRpcServer server([](const std::string&, const JsonValue&) {
+        return std::string(BLOCKHASH_RESULT);
+    });
+    auto transport = std::make_shared<RpcTransport>();
+    EndpointPoolConfig config = endpoints_for("http://127.0.0.1:1");
+    config.urls.push_back(server.url());
+    config.retry.max_attempts = 3;
+    config.retry.base_delay = std::chrono::milliseconds(1);
+    SvmNetworkAdapter adapter(SVMNetwork::SOON, config, transport);
+
+    // Whichever endpoint is tried first, a refused connection moves the call to the other
+    std::promise<std::pair<LatestBlockhash, std::thread::id>> done;
+    adapter.get_latest_blockhash_async(CallOptions{}, [&](LatestBlockhash latest, std::exception_ptr error) {
+        if (error) {
+            done.set_exception(error);
+        } else {
+            done.set_value({latest, std::this_thread::get_id()});
+        }
+    });
+    auto result = done.get_future().get();
+    EXPECT_EQ(result.first.slot, 7u);
+    EXPECT_NE(result.second, std::this_thread::get_id());
+
+    // Validation failures complete before the call returns
+    bool rejected = false;
+    adapter.submit_transaction_async("not base64!", "", CallOptions{}, [&](std::string, std::exception_ptr error) {
+        EXPECT_THROW(std::rethrow_exception(error), TransactionException);
+        rejected = true;
+    });
+    EXPECT_TRUE(rejected);
+}
+
+TEST_F(SvmAdapterTest, WorkRunsOnTheAdapterExecutor) {
+    // Counts the tasks it runs on a single worker, so any call that waited
+    // on further executor work would deadlock here
+    class CountingExecutor : public Executor {
+    public:
+        CountingExecutor() : pool_(WorkStealingConfig{1, false, {}}) {}
+        void execute(std::function<void()> task) override {
+            ++tasks;
+            pool_.execute(std::move(task));
+        }
+        std::atomic<int> tasks{0};
+
+    private:
+        WorkStealingExecutor pool_;
+    };
+
+    svm_pay_test::StandInRpcServer server([](const std::string& method, const JsonValue&) {
+        if (method == "getSignatureStatuses") {
+            return std::string(R"({"context":{"slot":8},"value":[{"slot":8,"confirmations":null,"err":null,"confirmationStatus":"finalized"}]})");
+        }
+        return std::string(BLOCKHASH_RESULT);
+    });
+    auto executor = std::make_shared<CountingExecutor>();
+    SvmNetworkAdapter adapter(SVMNetwork::SONIC, endpoints_for(server.url()), std::make_shared<RpcTransport>());
+    adapter.set_executor(executor);
+    EXPECT_EQ(adapter.get_executor(), executor);
+
+    EXPECT_EQ(adapter.get_latest_blockhash().get().slot, 7u);
+    EXPECT_EQ(adapter.check_transaction_status("sig").get(), PaymentStatus::CONFIRMED);
+    TransferRequest request(SVMNetwork::SONIC, "11111111111111111111111111111113", "0.5");
+    request.account = "11111111111111111111111111111112";
+    EXPECT_FALSE(adapter.create_transfer_transaction(request).get().empty());
+    EXPECT_EQ(adapter.warm_up().get(), 1u);
+    EXPECT_GE(executor->tasks.load(), 4);
+
+    adapter.set_executor(nullptr);
+    EXPECT_EQ(adapter.get_executor(), default_executor());
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/task.hpp"
+#include "svm-pay/network/rpc_transport.hpp"
+#include "svm-pay/network/svm_adapter.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/transaction.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef SVM_PAY_HAS_COROUTINES
+
+using namespace svm_pay;
+
+namespace {
+
+const char BLOCKHASH_RESULT[] =
+    R"({"context":{"slot":7},"value":{"blockhash":"11111111111111111111111111111111","lastValidBlockHeight":9}})";
+const char SIGNATURE[] = "5VERv8NMvzbJMEkV8xnrLkEaWRtSz9CosKDYjCJjBRnbJLgp8uirBgmQpjKhoR4tjF3ZpRzrFmBV6UjKdiSZkQUW";
+
+EndpointPoolConfig endpoints_for(const std::string& url) {
+    EndpointPoolConfig config;
+    config.urls.push_back(url);
+    return config;
+}
+
+std::string node_answer(const std::string& method) {
+    if (method == "getLatestBlockhash") {
+        return BLOCKHASH_RESULT;
+    }
+    if (method == "sendTransaction") {
+        return std::string("\"") + SIGNATURE + "\"";
+    }
+    if (method == "getSignatureStatuses") {
+        return R"({"context":{"slot":8},"value":[{"slot":8,"confirmations":null,"err":null,"confirmationStatus":"confirmed"}]})";
+    }
+    return "null";
+}
+
+std::string sample_transaction(const std::string& blockhash) {
+    PublicKey payer = PublicKey::from_base58("11111111111111111111111111111112");
+    PublicKey recipient = PublicKey::from_base58("11111111111111111111111111111113");
+    TransactionBuilder builder;
+    builder.set_fee_payer(payer)
+        .set_recent_blockhash(PublicKey::from_base58(blockhash))
+        .add_system_transfer(payer, recipient, 1000);
+    return builder.serialize_base64();
+}
+
+task<PaymentStatus> pay(SvmNetworkAdapter& adapter) {
+    LatestBlockhash latest = co_await async_get_latest_blockhash(adapter);
+    std::string signature = co_await async_submit_transaction(adapter, sample_transaction(latest.blockhash));
+    co_return co_await async_check_transaction_status(adapter, signature);
+}
+
+} // namespace
+
+class TaskTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(TaskTest, FlowSuspendsBetweenCalls) {
+    std::mutex mutex;
+    std::vector<std::string> methods;
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        methods.push_back(method);
+        return node_answer(method);
+    });
+    SvmNetworkAdapter adapter(SVMNetwork::SOLANA, endpoints_for(server.url()), std::make_shared<RpcTransport>());
+
+    EXPECT_EQ(sync_wait(pay(adapter)), PaymentStatus::CONFIRMED);
+    EXPECT_EQ(methods, (std::vector<std::string>{"getLatestBlockhash", "sendTransaction", "getSignatureStatuses"}));
+}
+
+TEST_F(TaskTest, ThousandsOfFlowsShareTheIoThread) {
+    svm_pay_test::StandInRpcServer server([](const std::string& method, const JsonValue&) {
+        return node_answer(method);
+    });
+    server.set_keep_alive(true);
+    RpcTransportConfig config;
+    config.max_connections_per_host = 4;
+    SvmNetworkAdapter adapter(SVMNetwork::SONIC, endpoints_for(server.url()), std::make_shared<RpcTransport>(config));
+
+    std::mutex mutex;
+    std::set<std::thread::id> resumed_on;
+    auto flow = [&]() -> task<PaymentStatus> {
+        PaymentStatus status = co_await pay(adapter);
+        std::lock_guard<std::mutex> lock(mutex);
+        resumed_on.insert(std::this_thread::get_id());
+        co_return status;
+    };
+
+    std::vector<std::future<PaymentStatus>> flows;
+    for (int i = 0; i < 1000; ++i) {
+        flows.push_back(spawn(flow()));
+    }
+    for (auto& result : flows) {
+        EXPECT_EQ(result.get(), PaymentStatus::CONFIRMED);
+    }
+    EXPECT_EQ(server.request_count(), 3000u);
+    EXPECT_LE(server.connection_count(), 4u);
+    // Every flow finished on the transport's one I/O thread
+    EXPECT_EQ(resumed_on.size(), 1u);
+}
+
+TEST_F(TaskTest, ErrorsResumeAsExceptions) {
+    svm_pay_test::StandInRpcServer server([](const std::string&, const JsonValue&) -> std::string {
+        throw std::runtime_error("Blockhash not found");
+    });
+    EndpointPoolConfig config = endpoints_for(server.url());
+    config.retry.max_attempts = 1;
+    SvmNetworkAdapter adapter(SVMNetwork::ECLIPSE, config, std::make_shared<RpcTransport>());
+
+    EXPECT_THROW(sync_wait(async_get_latest_blockhash(adapter)), NetworkException);
+    // Rejected locally, so the awaiter resumes without ever suspending
+    EXPECT_THROW(sync_wait(async_submit_transaction(adapter, "not base64!")), TransactionException);
+
+    CancellationSource cancelled;
+    cancelled.cancel();
+    CallOptions options;
+    options.cancellation = cancelled.token();
+    EXPECT_THROW(sync_wait(async_submit_transaction(adapter, sample_transaction(std::string(32, '1')), "", options)),
+                 OperationCancelledException);
+}
+
+#endif
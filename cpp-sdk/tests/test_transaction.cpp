@@ -0,0 +1,322 @@
+#include <gtest/gtest.h>
+#include "svm-pay/core/transaction.hpp"
+#include "svm-pay/core/base58.hpp"
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/pda.hpp"
+#include "svm-pay/network/solana.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <algorithm>
+#include <chrono>
+
+using namespace svm_pay;
+
+namespace {
+
+PublicKey filled_key(uint8_t byte) {
+    std::array<uint8_t, PublicKey::SIZE> bytes;
+    bytes.fill(byte);
+    return PublicKey(bytes);
+}
+
+std::vector<uint8_t> slice(const std::vector<uint8_t>& data, size_t offset, size_t size) {
+    return std::vector<uint8_t>(data.begin() + static_cast<std::ptrdiff_t>(offset),
+                                data.begin() + static_cast<std::ptrdiff_t>(offset + size));
+}
+
+std::vector<uint8_t> key_bytes(const PublicKey& key) {
+    return std::vector<uint8_t>(key.bytes().begin(), key.bytes().end());
+}
+
+} // namespace
+
+class TransactionTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(TransactionTest, CompactU16) {
+    struct Case {
+        uint16_t value;
+        std::vector<uint8_t> encoded;
+    };
+    const Case cases[] = {
+        {0x0000, {0x00}},
+        {0x007f, {0x7f}},
+        {0x0080, {0x80, 0x01}},
+        {0x3fff, {0xff, 0x7f}},
+        {0x4000, {0x80, 0x80, 0x01}},
+        {0xffff, {0xff, 0xff, 0x03}},
+    };
+    for (const auto& c : cases) {
+        uint8_t out[3];
+        size_t size = encode_compact_u16(c.value, out);
+        EXPECT_EQ(std::vector<uint8_t>(out, out + size), c.encoded) << c.value;
+    }
+}
+
+TEST_F(TransactionTest, Base58RoundTripsLeadingZeros) {
+    std::vector<uint8_t> data = {0, 0, 0, 1, 2, 255};
+    std::string encoded = encode_base58(data.data(), data.size());
+    EXPECT_EQ(encoded.substr(0, 3), "111");
+    EXPECT_EQ(decode_base58(encoded), data);
+
+    EXPECT_EQ(system_program_id(), PublicKey());
+    EXPECT_EQ(system_program_id().to_base58(), "11111111111111111111111111111111");
+    EXPECT_EQ(PublicKey::from_base58(token_program_id().to_base58()), token_program_id());
+    EXPECT_THROW(PublicKey::from_base58("0OIl"), AddressValidationException);
+    PublicKey key;
+    EXPECT_FALSE(PublicKey::try_from_base58("1111", key));
+}
+
+TEST_F(TransactionTest, ParseTokenAmount) {
+    EXPECT_EQ(parse_token_amount("1.5", 9), 1500000000u);
+    EXPECT_EQ(parse_token_amount("0.000000001", 9), 1u);
+    EXPECT_EQ(parse_token_amount("42", 0), 42u);
+    EXPECT_EQ(parse_token_amount(".25", 2), 25u);
+    EXPECT_EQ(parse_token_amount("18446744073709551615", 0), 18446744073709551615ull);
+    EXPECT_THROW(parse_token_amount("1.0000000001", 9), TransactionException);
+    EXPECT_THROW(parse_token_amount("18446744073.709551616", 9), TransactionException);
+    EXPECT_THROW(parse_token_amount("-1", 9), TransactionException);
+    EXPECT_THROW(parse_token_amount("1e9", 9), TransactionException);
+    EXPECT_THROW(parse_token_amount(".", 9), TransactionException);
+}
+
+TEST_F(TransactionTest, LegacySystemTransferLayout) {
+    PublicKey payer = filled_key(1);
+    PublicKey recipient = filled_key(2);
+    Blockhash blockhash = filled_key(3);
+
+    TransactionBuilder builder;
+    builder.set_fee_payer(payer).set_recent_blockhash(blockhash).add_system_transfer(payer, recipient, 0x0102030405060708ull);
+
+    auto bytes = builder.serialize();
+    ASSERT_EQ(bytes.size(), 215u);
+    EXPECT_EQ(builder.serialized_size(), 215u);
+    EXPECT_EQ(bytes[0], 1);                                               // One signature
+    EXPECT_EQ(slice(bytes, 1, 64), std::vector<uint8_t>(64, 0));          // Left for the wallet
+    EXPECT_EQ(slice(bytes, 65, 3), (std::vector<uint8_t>{1, 0, 1}));      // Header
+    EXPECT_EQ(bytes[68], 3);                                              // Account count
+    EXPECT_EQ(slice(bytes, 69, 32), key_bytes(payer));
+    EXPECT_EQ(slice(bytes, 101, 32), key_bytes(recipient));
+    EXPECT_EQ(slice(bytes, 133, 32), key_bytes(system_program_id()));
+    EXPECT_EQ(slice(bytes, 165, 32), key_bytes(blockhash));
+    EXPECT_EQ(slice(bytes, 197, 18), (std::vector<uint8_t>{
+        1,                        // Instruction count
+        2,                        // Program index
+        2, 0, 1,                  // Accounts
+        12, 2, 0, 0, 0,           // Data: Transfer discriminant
+        8, 7, 6, 5, 4, 3, 2, 1})); // Lamports
+
+    // The factory function produces the same transaction
+    TransactionBuilder generic;
+    generic.set_fee_payer(payer).set_recent_blockhash(blockhash).add_instruction(system_transfer(payer, recipient, 0x0102030405060708ull));
+    EXPECT_EQ(generic.serialize(), bytes);
+    EXPECT_EQ(builder.serialize_base64(), base64_encode(bytes.data(), bytes.size()));
+
+    // The message is what follows the signatures
+    uint8_t message[TransactionBuilder::MAX_TRANSACTION_SIZE];
+    size_t size = builder.serialize_message(message, sizeof(message));
+    EXPECT_EQ(std::vector<uint8_t>(message, message + size), slice(bytes, 65, 150));
+}
+
+TEST_F(TransactionTest, DeduplicatesAndOrdersAccounts) {
+    PublicKey payer = filled_key(0x50);
+    PublicKey owner = filled_key(0x40);
+    PublicKey source = filled_key(0x30);
+    PublicKey destination = filled_key(0x20);
+    PublicKey mint = filled_key(0x10);
+    PublicKey reference = filled_key(0x05);
+
+    TransactionBuilder builder;
+    builder.set_fee_payer(payer).set_recent_blockhash(filled_key(9));
+    builder.add_memo("order-17");
+    builder.add_transfer_checked(source, mint, destination, owner, 2500000, 6).add_references({reference});
+    // Re-used accounts with stronger privileges are merged, not duplicated
+    builder.add_instruction(system_transfer(payer, mint, 1));
+
+    auto keys = builder.account_keys();
+    std::vector<PublicKey> expected = {
+        payer,
+        owner,                                  // Read-only signer
+        mint, destination, source,              // Writable, by key
+        system_program_id(), reference, token_program_id(), memo_program_id(),  // Read-only, by key
+    };
+    std::sort(expected.begin() + 5, expected.end());
+    EXPECT_EQ(keys, expected);
+    EXPECT_EQ(builder.num_required_signatures(), 2u);
+
+    auto bytes = builder.serialize();
+    EXPECT_EQ(slice(bytes, 129, 3), (std::vector<uint8_t>{2, 1, 4}));
+
+    // Reuse keeps the configuration but not the instructions
+    builder.clear_instructions();
+    EXPECT_THROW(builder.serialize(), TransactionException);
+    builder.add_system_transfer(payer, destination, 1);
+    EXPECT_EQ(builder.num_required_signatures(), 1u);
+}
+
+TEST_F(TransactionTest, V0MovesAccountsIntoLookupTable) {
+    PublicKey payer = filled_key(1);
+    PublicKey recipient = filled_key(2);
+    PublicKey reference = filled_key(4);
+    auto table = std::make_shared<AddressLookupTable>();
+    table->key = filled_key(7);
+    table->addresses = {filled_key(9), reference, payer, recipient, system_program_id()};
+
+    TransactionBuilder builder;
+    builder.set_version(MessageVersion::V0).set_fee_payer(payer).set_recent_blockhash(filled_key(3));
+    builder.add_lookup_table(table);
+    builder.add_system_transfer(payer, recipient, 5).add_references({reference});
+
+    // Signers and invoked programs stay static
+    EXPECT_EQ(builder.account_keys(), (std::vector<PublicKey>{payer, system_program_id()}));
+
+    auto bytes = builder.serialize();
+    ASSERT_EQ(bytes.size(), 1u + 64 + 1 + 3 + 1 + 64 + 32 + 1 + 1 + 1 + 3 + 1 + 12 + 1 + 32 + 1 + 1 + 1 + 1);
+    EXPECT_EQ(bytes[65], 0x80);
+    EXPECT_EQ(slice(bytes, 66, 3), (std::vector<uint8_t>{1, 0, 1}));
+    // Loaded writable accounts come after the static keys, then read-only ones
+    EXPECT_EQ(slice(bytes, 166, 6), (std::vector<uint8_t>{1, 1, 3, 0, 2, 3}));
+    EXPECT_EQ(slice(bytes, 186, 32), key_bytes(table->key));
+    EXPECT_EQ(slice(bytes, 218, 4), (std::vector<uint8_t>{1, 3, 1, 1}));
+
+    // Legacy messages ignore lookup tables
+    builder.set_version(MessageVersion::LEGACY);
+    EXPECT_EQ(builder.account_keys().size(), 4u);
+}
+
+TEST_F(TransactionTest, RejectsIncompleteOrOversizedTransactions) {
+    PublicKey payer = filled_key(1);
+    TransactionBuilder builder;
+    builder.add_system_transfer(payer, filled_key(2), 1);
+    EXPECT_THROW(builder.serialize(), TransactionException);
+    builder.set_fee_payer(payer);
+    EXPECT_THROW(builder.serialize(), TransactionException);
+    builder.set_recent_blockhash(filled_key(3));
+
+    uint8_t small[100];
+    EXPECT_THROW(builder.serialize(small, sizeof(small)), TransactionException);
+
+    builder.add_memo(std::string(1100, 'x'));
+    EXPECT_GT(builder.serialized_size(), TransactionBuilder::MAX_TRANSACTION_SIZE);
+    uint8_t large[4096];
+    EXPECT_THROW(builder.serialize(large, sizeof(large)), TransactionException);
+
+    TransactionBuilder empty;
+    EXPECT_THROW(empty.add_references({payer}), TransactionException);
+}
+
+TEST_F(TransactionTest, DurableNonceAdvancesFirst) {
+    PublicKey payer = filled_key(1);
+    PublicKey recipient = filled_key(2);
+    Blockhash nonce = filled_key(3);
+    PublicKey nonce_account = filled_key(4);
+
+    TransactionBuilder builder;
+    builder.set_fee_payer(payer).set_recent_blockhash(filled_key(9)).set_durable_nonce(nonce_account, payer, nonce);
+    builder.add_system_transfer(payer, recipient, 1);
+
+    auto keys = builder.account_keys();
+    ASSERT_EQ(keys.size(), 5u);
+    auto index = [&](const PublicKey& key) {
+        return static_cast<uint8_t>(std::find(keys.begin(), keys.end(), key) - keys.begin());
+    };
+    auto bytes = builder.serialize();
+    size_t blockhash = 1 + 64 + 3 + 1 + 32 * keys.size();
+    EXPECT_EQ(slice(bytes, blockhash, 32), key_bytes(nonce));  // The nonce replaces the blockhash
+    EXPECT_EQ(bytes[blockhash + 32], 2);                       // Instruction count
+    EXPECT_EQ(slice(bytes, blockhash + 33, 10), (std::vector<uint8_t>{
+        index(system_program_id()),
+        3, index(nonce_account), index(sysvar_recent_blockhashes_id()), index(payer),
+        4, 4, 0, 0, 0}));                                      // Data: AdvanceNonceAccount
+
+    // The advance alone is a valid transaction
+    builder.clear_instructions();
+    EXPECT_EQ(builder.account_keys().size(), 4u);
+    EXPECT_NO_THROW(builder.serialize());
+
+    builder.clear_durable_nonce();
+    EXPECT_THROW(builder.serialize(), TransactionException);
+}
+
+TEST_F(TransactionTest, ReusedBuilderThroughput) {
+    PublicKey payer = filled_key(1);
+    PublicKey reference = filled_key(4);
+    TransactionBuilder builder;
+    builder.set_fee_payer(payer).set_recent_blockhash(filled_key(3));
+    uint8_t buffer[TransactionBuilder::MAX_TRANSACTION_SIZE];
+
+    const int count = 20000;
+    size_t total = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; ++i) {
+        builder.clear_instructions();
+        builder.add_system_transfer(payer, filled_key(static_cast<uint8_t>(i)), static_cast<uint64_t>(i));
+        builder.add_references({reference});
+        total += builder.serialize(buffer, sizeof(buffer));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GT(total, 0u);
+    // Generous bound that still catches accidental quadratic work or per-call setup
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+}
+
+TEST_F(TransactionTest, AdapterBuildsTransferTransaction) {
+    Blockhash blockhash = filled_key(3);
+    PublicKey mint = filled_key(5);
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue& params) {
+        if (method == "getMultipleAccounts") {
+            // A 6-decimal mint, and a program that is not one
+            std::vector<uint8_t> data(82, 0);
+            data[44] = 6;
+            data[45] = 1;
+            bool is_mint = params.as_array().at(0).as_array().at(0).as_string() == mint.to_base58();
+            std::string owner = is_mint ? token_program_id().to_base58() : "BPFLoaderUpgradeab1e11111111111111111111111";
+            return R"({"context":{"slot":321},"value":[{"data":[")" + base64_encode(data.data(), data.size()) +
+                   R"(","base64"],"executable":false,"lamports":1461600,"owner":")" + owner +
+                   R"(","rentEpoch":0,"space":82}]})";
+        }
+        EXPECT_EQ(method, "getLatestBlockhash");
+        return R"({"context":{"slot":321},"value":{"blockhash":")" + blockhash.to_base58() +
+               R"(","lastValidBlockHeight":1000}})";
+    });
+    SolanaNetworkAdapter adapter(server.url());
+
+    auto latest = adapter.get_latest_blockhash().get();
+    EXPECT_EQ(latest.blockhash, blockhash.to_base58());
+    EXPECT_EQ(latest.last_valid_block_height, 1000u);
+    EXPECT_EQ(latest.slot, 321u);
+
+    PublicKey payer = filled_key(1);
+    PublicKey recipient = filled_key(2);
+    PublicKey reference = filled_key(4);
+    TransferRequest request(SVMNetwork::SOLANA, recipient.to_base58(), "1.5");
+    request.memo = "invoice 7";
+    request.references = {reference.to_base58()};
+    EXPECT_THROW(adapter.create_transfer_transaction(request).get(), TransactionException);
+
+    request.account = payer.to_base58();
+    std::string transaction = adapter.create_transfer_transaction(request).get();
+
+    TransactionBuilder expected;
+    expected.set_fee_payer(payer).set_recent_blockhash(blockhash);
+    expected.add_memo("invoice 7");
+    expected.add_system_transfer(payer, recipient, 1500000000).add_references({reference});
+    EXPECT_EQ(transaction, expected.serialize_base64());
+
+    // Token transfers go between associated token accounts in the mint's units
+    request.spl_token = mint.to_base58();
+    transaction = adapter.create_transfer_transaction(request).get();
+    TransactionBuilder expected_token;
+    expected_token.set_fee_payer(payer).set_recent_blockhash(blockhash);
+    expected_token.add_memo("invoice 7");
+    expected_token.add_transfer_checked(derive_associated_token_address(payer, mint).address, mint,
+                                        derive_associated_token_address(recipient, mint).address, payer, 1500000, 6)
+        .add_references({reference});
+    EXPECT_EQ(transaction, expected_token.serialize_base64());
+
+    request.spl_token = token_program_id().to_base58();
+    EXPECT_THROW(adapter.create_transfer_transaction(request).get(), TransactionException);
+}
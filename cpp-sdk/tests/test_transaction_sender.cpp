@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "svm-pay/network/transaction_sender.hpp"
+#include "svm-pay/core/base64.hpp"
+#include "svm-pay/core/exceptions.hpp"
+#include "svm-pay/core/transaction.hpp"
+#include "stand_in_rpc_server.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace svm_pay;
+
+namespace {
+
+const char PENDING_STATUS[] = R"({"context":{"slot":8},"value":[null]})";
+const char CONFIRMED_STATUS[] =
+    R"({"context":{"slot":8},"value":[{"slot":8,"confirmations":1,"err":null,"confirmationStatus":"confirmed"}]})";
+const char FAILED_STATUS[] =
+    R"({"context":{"slot":8},"value":[{"slot":8,"confirmations":1,"err":{"InstructionError":[0,"Custom"]},"confirmationStatus":"confirmed"}]})";
+
+struct SignedTransaction {
+    std::string base64;
+    std::string signature;
+};
+
+SignedTransaction signed_transfer(uint64_t lamports) {
+    Keypair payer = Keypair::generate();
+    TransactionBuilder builder;
+    builder.set_fee_payer(payer.public_key())
+        .set_recent_blockhash(PublicKey::from_base58("11111111111111111111111111111111"))
+        .add_system_transfer(payer.public_key(), PublicKey::from_base58("11111111111111111111111111111113"), lamports);
+    uint8_t wire[TransactionBuilder::MAX_TRANSACTION_SIZE];
+    size_t size = builder.serialize_signed({payer}, wire, sizeof(wire));
+    return {base64_encode(wire, size), transaction_signature(wire, size)};
+}
+
+std::unique_ptr<SvmNetworkAdapter> adapter_for(const svm_pay_test::StandInRpcServer& server) {
+    EndpointPoolConfig config;
+    config.urls.push_back(server.url());
+    config.retry.max_attempts = 1;
+    return std::make_unique<SvmNetworkAdapter>(SVMNetwork::SOLANA, config, std::make_shared<RpcTransport>());
+}
+
+TransactionSenderConfig fast() {
+    TransactionSenderConfig config;
+    config.interval = std::chrono::milliseconds(20);
+    config.send.skip_preflight = true;
+    return config;
+}
+
+} // namespace
+
+class TransactionSenderTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(TransactionSenderTest, RebroadcastsUntilConfirmed) {
+    SignedTransaction transaction = signed_transfer(1000);
+    std::mutex mutex;
+    std::vector<std::string> send_params;
+    std::atomic<int> status_checks{0};
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue& params) -> std::string {
+        if (method == "sendTransaction") {
+            std::lock_guard<std::mutex> lock(mutex);
+            send_params.push_back(params.dump());
+            return "\"" + transaction.signature + "\"";
+        }
+        if (method == "getSignatureStatuses") {
+            return ++status_checks < 3 ? PENDING_STATUS : CONFIRMED_STATUS;
+        }
+        if (method == "getBlockHeight") {
+            return "100";
+        }
+        return "null";
+    });
+    auto adapter = adapter_for(server);
+    TransactionSender sender(*adapter, fast());
+
+    EXPECT_EQ(sender.send(transaction.base64, 200).get(), PaymentStatus::CONFIRMED);
+    EXPECT_EQ(sender.pending_count(), 0u);
+    EXPECT_EQ(sender.broadcast_count(), 3u);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_FALSE(send_params.empty());
+    EXPECT_NE(send_params.front().find("\"skipPreflight\":true"), std::string::npos);
+    EXPECT_NE(send_params.front().find("\"maxRetries\":0"), std::string::npos);
+}
+
+TEST_F(TransactionSenderTest, ExpiresOnceBlockHeightPasses) {
+    SignedTransaction transaction = signed_transfer(1000);
+    std::atomic<uint64_t> height{98};
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue&) -> std::string {
+        if (method == "sendTransaction") {
+            throw std::runtime_error("Transaction simulation failed: Blockhash not found");
+        }
+        if (method == "getSignatureStatuses") {
+            return PENDING_STATUS;
+        }
+        if (method == "getBlockHeight") {
+            return std::to_string(height++);
+        }
+        return "null";
+    });
+    auto adapter = adapter_for(server);
+    TransactionSender sender(*adapter, fast());
+
+    // Failed sends keep the pipeline going; only the height ends it
+    EXPECT_EQ(sender.send(transaction.base64, 100).get(), PaymentStatus::EXPIRED);
+    EXPECT_GT(height.load(), 101u);
+    EXPECT_GE(sender.broadcast_count(), 3u);
+}
+
+TEST_F(TransactionSenderTest, ReportsTransactionsThatLandedWithAnError) {
+    SignedTransaction transaction = signed_transfer(1000);
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue&) -> std::string {
+        if (method == "sendTransaction") {
+            return "\"" + transaction.signature + "\"";
+        }
+        if (method == "getSignatureStatuses") {
+            return FAILED_STATUS;
+        }
+        return "1";
+    });
+    auto adapter = adapter_for(server);
+    TransactionSender sender(*adapter, fast());
+
+    EXPECT_EQ(sender.send(transaction.base64, 200).get(), PaymentStatus::FAILED);
+}
+
+TEST_F(TransactionSenderTest, DeduplicatesBySignature) {
+    SignedTransaction transaction = signed_transfer(1000);
+    std::atomic<bool> landed{false};
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue&) -> std::string {
+        if (method == "sendTransaction") {
+            return "\"" + transaction.signature + "\"";
+        }
+        if (method == "getSignatureStatuses") {
+            return landed ? CONFIRMED_STATUS : PENDING_STATUS;
+        }
+        return "100";
+    });
+    auto adapter = adapter_for(server);
+    TransactionSender sender(*adapter, fast());
+
+    auto first = sender.send(transaction.base64, 200);
+    auto second = sender.send(transaction.base64, 200);
+    EXPECT_EQ(sender.pending_count(), 1u);
+    landed = true;
+    EXPECT_EQ(first.get(), PaymentStatus::CONFIRMED);
+    EXPECT_EQ(second.get(), PaymentStatus::CONFIRMED);
+
+    // A finished signature answers from memory without another broadcast
+    uint64_t broadcasts = sender.broadcast_count();
+    EXPECT_EQ(sender.send(transaction.base64, 200).get(), PaymentStatus::CONFIRMED);
+    EXPECT_EQ(sender.broadcast_count(), broadcasts);
+}
+
+TEST_F(TransactionSenderTest, StopsOnCancellationAndRejectsUnsignedTransactions) {
+    SignedTransaction transaction = signed_transfer(1000);
+    svm_pay_test::StandInRpcServer server([&](const std::string& method, const JsonValue&) -> std::string {
+        if (method == "sendTransaction") {
+            return "\"" + transaction.signature + "\"";
+        }
+        if (method == "getSignatureStatuses") {
+            return PENDING_STATUS;
+        }
+        return "100";
+    });
+    auto adapter = adapter_for(server);
+    TransactionSender sender(*adapter, fast());
+
+    CancellationSource cancel;
+    CallOptions options;
+    options.cancellation = cancel.token();
+    auto result = sender.send(transaction.base64, 200, options);
+    cancel.cancel();
+    EXPECT_THROW(result.get(), OperationCancelledException);
+
+    TransactionBuilder builder;
+    builder.set_fee_payer(PublicKey::from_base58("11111111111111111111111111111112"))
+        .set_recent_blockhash(PublicKey::from_base58("11111111111111111111111111111111"))
+        .add_system_transfer(PublicKey::from_base58("11111111111111111111111111111112"),
+                             PublicKey::from_base58("11111111111111111111111111111113"), 1);
+    EXPECT_THROW(sender.send(builder.serialize_base64(), 200), TransactionException);
+    EXPECT_THROW(sender.send("not base64!", 200), TransactionException);
+}